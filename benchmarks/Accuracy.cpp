@@ -0,0 +1,296 @@
+#include "DMath/Accuracy.hpp"
+#include "DMath/ArrayMath.hpp"
+#include "DMath/Trigonometric.hpp"
+#include "DMath/VectorBatch.hpp"
+#include "DMath/Matrix/Matrix.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// Validates the fast kernels against high precision references before they are enabled in production.
+// Each kernel runs over random and adversarial inputs, and its max and mean ULP error are printed next to its throughput.
+// Exits with 1 when a kernel exceeds its error budget.
+//
+// Usage: AccuracyBenchmark [--filter <substring of the name>] [--seconds <timing per kernel>] [--budget <name>=<max ulp>[:<mean ulp>]]...
+
+namespace
+{
+	constexpr size_t randomCount = size_t(1) << 18;
+	constexpr long double pi = 3.141592653589793238462643383279502884L;
+
+	struct Options
+	{
+		const char* filter = nullptr;
+		double seconds = Math::Setup::accuracyTimingSeconds;
+		std::map<std::string, Math::ErrorBudget> budgets;
+	};
+
+	class Harness
+	{
+	public:
+		explicit Harness(const Options& options) :
+			options(options) {}
+
+		[[nodiscard]] bool IsSelected(const char* name) const
+		{
+			return options.filter == nullptr || std::strstr(name, options.filter) != nullptr;
+		}
+
+		[[nodiscard]] double GetSeconds() const
+		{
+			return options.seconds;
+		}
+
+		// defaultBudget is the kernel's documented accuracy, unless overridden with --budget.
+		void Report(const char* name, const Math::AccuracyReport& report, Math::ErrorBudget defaultBudget, double worstInput)
+		{
+			const auto found = options.budgets.find(name);
+			const Math::ErrorBudget budget = found != options.budgets.end() ? found->second : defaultBudget;
+			const bool isWithin = report.IsWithin(budget);
+			failureCount += !isWithin;
+			std::printf("  %-28s %8zu %12.3f %10.4f %11.3e %15.8g %9.3f %10.1f  %s", name, report.sampleCount, report.maxUlp, report.meanUlp,
+				report.maxAbsoluteError, worstInput, report.nanosecondsPerElement, budget.maxUlp, isWithin ? "ok" : "FAIL");
+			if (report.nonFiniteMismatchCount > 0)
+				std::printf(" (%zu non-finite mismatches)", report.nonFiniteMismatchCount);
+			std::printf("\n");
+		}
+
+		[[nodiscard]] size_t GetFailureCount() const
+		{
+			return failureCount;
+		}
+
+	private:
+		Options options;
+		size_t failureCount = 0;
+	};
+
+	template<typename T>
+	std::vector<T> GetInputs(T min, T max, long double period, bool isLogUniform)
+	{
+		std::vector<T> inputs = isLogUniform ? Math::GetLogUniformInputs<T>(randomCount, min, max, 1) : Math::GetRandomInputs<T>(randomCount, min, max, 1);
+		const std::vector<T> adversarial = Math::GetAdversarialInputs<T>(min, max, period);
+		inputs.insert(inputs.end(), adversarial.begin(), adversarial.end());
+		return inputs;
+	}
+
+	// kernel(inputs, outputs) against reference(input) for every input.
+	template<typename T, typename Kernel, typename Reference>
+	void CheckUnary(Harness& harness, const char* name, Math::ErrorBudget budget, const std::vector<T>& inputs, Kernel&& kernel, Reference&& reference)
+	{
+		if (!harness.IsSelected(name))
+			return;
+
+		std::vector<T> outputs(inputs.size());
+		std::vector<long double> references(inputs.size());
+		for (size_t i = 0; i < inputs.size(); i++)
+			references[i] = reference((long double)inputs[i]);
+
+		const auto report = Math::MeasureAccuracy<T>([&]() { kernel(inputs, outputs); }, outputs, references, harness.GetSeconds());
+		harness.Report(name, report, budget, double(inputs[report.worstIndex]));
+	}
+
+	// Sine and cosine in long double. Degrees are reduced to [-45, 45] exactly first, so multiples of 90 give exact zeros and poles.
+	template<Math::AngleUnit unit>
+	void GetReference(long double angle, long double& sin, long double& cos)
+	{
+		if constexpr (unit == Math::AngleUnit::Radians)
+		{
+			sin = std::sin(angle);
+			cos = std::cos(angle);
+		}
+		else
+		{
+			const long double quadrant = std::nearbyint(angle / 90.0L);
+			const long double radians = (angle - 90.0L * quadrant) * (pi / 180.0L);
+			const long double reducedSin = std::sin(radians);
+			const long double reducedCos = std::cos(radians);
+			switch (int(quadrant - 4.0L * std::floor(quadrant / 4.0L)))
+			{
+			case 0: sin = reducedSin; cos = reducedCos; break;
+			case 1: sin = reducedCos; cos = -reducedSin; break;
+			case 2: sin = -reducedSin; cos = -reducedCos; break;
+			default: sin = -reducedCos; cos = reducedSin; break;
+			}
+		}
+	}
+
+	template<Math::AngleUnit unit, Math::TrigPrecision precision>
+	void CheckTrigonometric(Harness& harness, const char* precisionName, Math::ErrorBudget sinCosBudget, Math::ErrorBudget tanBudget)
+	{
+		constexpr bool isRadians = unit == Math::AngleUnit::Radians;
+		const float limit = Math::detail::Trigonometric::reductionLimit<unit>;
+		const std::vector<float> inputs = GetInputs<float>(-limit, limit, isRadians ? pi / 2.0L : 90.0L, false);
+		const std::string prefix = std::string(isRadians ? "Radians/" : "Degrees/") + precisionName;
+
+		const auto getSin = [](long double angle) { long double sin, cos; GetReference<unit>(angle, sin, cos); return sin; };
+		const auto getCos = [](long double angle) { long double sin, cos; GetReference<unit>(angle, sin, cos); return cos; };
+		// Exact poles take the sign of the sine, like the kernels do.
+		const auto getTan = [](long double angle) { long double sin, cos; GetReference<unit>(angle, sin, cos); return sin / (cos == 0.0L ? 0.0L : cos); };
+		CheckUnary(harness, (prefix + "/Sin").c_str(), sinCosBudget, inputs,
+			[](const auto& input, auto& output) { Math::Sin<unit, precision>(input, output); }, getSin);
+		CheckUnary(harness, (prefix + "/Cos").c_str(), sinCosBudget, inputs,
+			[](const auto& input, auto& output) { Math::Cos<unit, precision>(input, output); }, getCos);
+		CheckUnary(harness, (prefix + "/Tan").c_str(), tanBudget, inputs,
+			[](const auto& input, auto& output) { Math::Tan<unit, precision>(input, output); }, getTan);
+	}
+
+	// Components of the normalized vectors against long double normalization.
+	template<Math::NormalizePrecision precision>
+	void CheckNormalize(Harness& harness, const char* name, Math::ErrorBudget budget)
+	{
+		if (!harness.IsSelected(name))
+			return;
+
+		const std::vector<float> components = Math::GetLogUniformInputs<float>(randomCount * 3, 1e-15f, 1e15f, 2);
+		std::vector<Math::Vector3D> vectors(randomCount);
+		std::vector<long double> references(randomCount * 3);
+		for (size_t i = 0; i < randomCount; i++)
+		{
+			// Signs from the low bits, magnitudes from the log-uniform inputs, so vectors mix very different component sizes.
+			for (size_t component = 0; component < 3; component++)
+				vectors[i][component] = (i >> component) & 1 ? -components[i * 3 + component] : components[i * 3 + component];
+			const long double x = vectors[i].x, y = vectors[i].y, z = vectors[i].z;
+			const long double magnitude = std::sqrt(x * x + y * y + z * z);
+			references[i * 3] = x / magnitude;
+			references[i * 3 + 1] = y / magnitude;
+			references[i * 3 + 2] = z / magnitude;
+		}
+
+		std::vector<Math::Vector3D> normalized(randomCount);
+		const Math::Span<const float> results(normalized.data()->GetData(), normalized.size() * 3);
+		const auto report = Math::MeasureAccuracy<float>([&]() { Math::NormalizeVectors<3, float, precision>(vectors, normalized); }, results, references, harness.GetSeconds());
+		harness.Report(name, report, budget, double(vectors[report.worstIndex / 3][report.worstIndex % 3]));
+	}
+
+	// Elements of the scalar Matrix inverse against a long double Gauss-Jordan elimination.
+	void CheckMatrixInverse(Harness& harness, const char* name, Math::ErrorBudget budget)
+	{
+		if (!harness.IsSelected(name))
+			return;
+
+		constexpr size_t matrixCount = size_t(1) << 14;
+		const std::vector<float> elements = Math::GetRandomInputs<float>(matrixCount * 16, -1.f, 1.f, 3);
+		std::vector<Math::Matrix4x4> matrices(matrixCount);
+		std::vector<long double> references(matrixCount * 16);
+		for (size_t i = 0; i < matrixCount; i++)
+		{
+			// Diagonally dominant, which keeps the condition number, and the error any algorithm has, bounded.
+			long double augmented[4][8] = {};
+			for (size_t x = 0; x < 4; x++)
+			{
+				for (size_t y = 0; y < 4; y++)
+				{
+					matrices[i][x][y] = elements[i * 16 + x * 4 + y] + (x == y ? 4.f : 0.f);
+					augmented[y][x] = matrices[i][x][y];
+				}
+				augmented[x][4 + x] = 1.0L;
+			}
+			for (size_t column = 0; column < 4; column++)
+			{
+				const long double pivot = augmented[column][column];
+				for (size_t j = 0; j < 8; j++)
+					augmented[column][j] /= pivot;
+				for (size_t row = 0; row < 4; row++)
+				{
+					const long double factor = row == column ? 0.0L : augmented[row][column];
+					for (size_t j = 0; j < 8; j++)
+						augmented[row][j] -= factor * augmented[column][j];
+				}
+			}
+			for (size_t x = 0; x < 4; x++)
+			{
+				for (size_t y = 0; y < 4; y++)
+					references[i * 16 + x * 4 + y] = augmented[y][4 + x];
+			}
+		}
+
+		std::vector<Math::Matrix4x4> inverses(matrixCount);
+		const Math::Span<const float> results(inverses.data()->GetData(), inverses.size() * 16);
+		const auto report = Math::MeasureAccuracy<float>([&]()
+		{
+			for (size_t i = 0; i < matrixCount; i++)
+				inverses[i] = *matrices[i].GetInverse();
+		}, results, references, harness.GetSeconds());
+		harness.Report(name, report, budget, double(elements[report.worstIndex]));
+	}
+
+	bool ParseOptions(int argumentCount, char** arguments, Options& options)
+	{
+		for (int i = 1; i < argumentCount; i++)
+		{
+			const bool hasValue = i + 1 < argumentCount;
+			if (std::strcmp(arguments[i], "--filter") == 0 && hasValue)
+				options.filter = arguments[++i];
+			else if (std::strcmp(arguments[i], "--seconds") == 0 && hasValue)
+				options.seconds = std::atof(arguments[++i]);
+			else if (std::strcmp(arguments[i], "--budget") == 0 && hasValue && std::strchr(arguments[i + 1], '=') != nullptr)
+			{
+				const std::string budget = arguments[++i];
+				const size_t separator = budget.find('=');
+				Math::ErrorBudget& value = options.budgets[budget.substr(0, separator)];
+				value.maxUlp = std::atof(budget.c_str() + separator + 1);
+				const size_t meanSeparator = budget.find(':', separator);
+				if (meanSeparator != std::string::npos)
+					value.meanUlp = std::atof(budget.c_str() + meanSeparator + 1);
+			}
+			else
+			{
+				std::fprintf(stderr, "Usage: %s [--filter <substring>] [--seconds <timing per kernel>] [--budget <name>=<max ulp>[:<mean ulp>]]...\n", arguments[0]);
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+int main(int argumentCount, char** arguments)
+{
+	Options options;
+	if (!ParseOptions(argumentCount, arguments, options))
+		return 2;
+	Harness harness(options);
+
+	std::printf("  %-28s %8s %12s %10s %11s %15s %9s %10s\n", "kernel", "samples", "max ulp", "mean ulp", "max abs", "worst input", "ns/elem", "budget");
+
+	const std::vector<float> positiveFloats = GetInputs<float>(std::numeric_limits<float>::min(), std::numeric_limits<float>::max(), 0.0L, true);
+	CheckUnary(harness, "RSqrt/float", { 4.0, 1.0 }, positiveFloats,
+		[](const auto& input, auto& output) { for (size_t i = 0; i < input.size(); i++) output[i] = Math::RSqrt(input[i]); },
+		[](long double x) { return 1.0L / std::sqrt(x); });
+	const std::vector<double> positiveDoubles = GetInputs<double>(std::numeric_limits<double>::min(), std::numeric_limits<double>::max(), 0.0L, true);
+	CheckUnary(harness, "RSqrt/double", { 1.5, 0.5 }, positiveDoubles,
+		[](const auto& input, auto& output) { for (size_t i = 0; i < input.size(); i++) output[i] = Math::RSqrt(input[i]); },
+		[](long double x) { return 1.0L / std::sqrt(x); });
+
+	CheckTrigonometric<Math::AngleUnit::Radians, Math::TrigPrecision::Fast>(harness, "Fast", { 12000.0 }, { 24000.0 });
+	CheckTrigonometric<Math::AngleUnit::Radians, Math::TrigPrecision::Medium>(harness, "Medium", { 40.0 }, { 80.0 });
+	CheckTrigonometric<Math::AngleUnit::Radians, Math::TrigPrecision::Full>(harness, "Full", { 4.0 }, { 8.0 });
+	CheckTrigonometric<Math::AngleUnit::Degrees, Math::TrigPrecision::Full>(harness, "Full", { 4.0 }, { 8.0 });
+
+	const std::vector<float> logInputs = GetInputs<float>(std::numeric_limits<float>::min(), std::numeric_limits<float>::max(), 0.0L, true);
+	CheckUnary(harness, "ArrayMath/Log", { 1.5 }, logInputs,
+		[](const auto& input, auto& output) { Math::Log(input, output); },
+		[](long double x) { return std::log(x); });
+	const std::vector<float> powInputs = GetInputs<float>(1e-3f, 1e3f, 0.0L, true);
+	CheckUnary(harness, "ArrayMath/Pow", { 3.5 }, powInputs,
+		[](const auto& input, auto& output) { Math::Pow(input, 2.5f, output); },
+		[](long double x) { return std::pow(x, 2.5L); });
+	const std::vector<float> hypotInputs = GetInputs<float>(-1e18f, 1e18f, 0.0L, false);
+	CheckUnary(harness, "ArrayMath/Hypot", { 1.5 }, hypotInputs,
+		[](const auto& input, auto& output) { Math::Hypot(input, input, output); },
+		[](long double x) { return std::hypot(x, x); });
+
+	CheckNormalize<Math::NormalizePrecision::Full>(harness, "NormalizeVectors/Full", { 3.0 });
+	CheckNormalize<Math::NormalizePrecision::Fast>(harness, "NormalizeVectors/Fast", { 6.0 });
+	// Elements close to zero have huge relative errors after cancellation, so the inverse is held to its mean and absolute errors.
+	CheckMatrixInverse(harness, "Matrix4x4/GetInverse", { std::numeric_limits<double>::infinity(), 4.0, 1e-6 });
+
+	if (harness.GetFailureCount() > 0)
+		std::printf("%zu kernels exceed their error budget.\n", harness.GetFailureCount());
+	return harness.GetFailureCount() > 0 ? 1 : 0;
+}
\ No newline at end of file
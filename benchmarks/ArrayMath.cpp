@@ -0,0 +1,191 @@
+#include "DMath/ArrayMath.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t valueCount = size_t(1) << 20;
+	constexpr size_t repeatCount = 16;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	// Distance in representable floats, sign changes included. NaNs only match NaNs.
+	int64_t GetUlpDistance(float a, float b)
+	{
+		if (std::isnan(a) || std::isnan(b))
+			return std::isnan(a) && std::isnan(b) ? 0 : INT32_MAX;
+		const auto toOrdered = [](float value)
+		{
+			int32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits < 0 ? int64_t(INT32_MIN) - bits : int64_t(bits);
+		};
+		const int64_t distance = toOrdered(a) - toOrdered(b);
+		return distance < 0 ? -distance : distance;
+	}
+
+	template<typename Reference>
+	int64_t GetMaxUlp(const std::vector<float>& values, Reference&& reference)
+	{
+		int64_t maxUlp = 0;
+		for (size_t i = 0; i < values.size(); i++)
+			maxUlp = std::max(maxUlp, GetUlpDistance(values[i], reference(i)));
+		return maxUlp;
+	}
+
+	// Bitwise comparison, so that the signs of zeros count.
+	template<typename Reference>
+	size_t GetMismatchCount(const std::vector<float>& values, Reference&& reference)
+	{
+		size_t mismatchCount = 0;
+		for (size_t i = 0; i < values.size(); i++)
+		{
+			const float expected = reference(i);
+			mismatchCount += std::memcmp(&values[i], &expected, sizeof(float)) != 0 && !(std::isnan(values[i]) && std::isnan(expected));
+		}
+		return mismatchCount;
+	}
+
+	std::vector<float> GetValues(uint32_t seed, float min, float max)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> value(min, max);
+		std::vector<float> values(valueCount);
+		for (auto& element : values)
+			element = value(rng);
+		return values;
+	}
+
+	// Log-uniform positive values over the whole float range, with the special values at the start.
+	std::vector<float> GetPositiveValues(uint32_t seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> mantissa(1.f, 2.f);
+		std::uniform_int_distribution<int> exponent(-149, 127);
+		std::vector<float> values(valueCount);
+		for (auto& element : values)
+			element = std::ldexp(mantissa(rng), exponent(rng));
+		const float special[] = { 0.f, -0.f, -1.f, 1.f, std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::denorm_min() };
+		std::copy(std::begin(special), std::end(special), values.begin());
+		return values;
+	}
+
+	void ReportAccuracy()
+	{
+		std::printf("accuracy over %zu values\n", valueCount);
+		const std::vector<float> values = GetValues(1, -1e6f, 1e6f);
+		std::vector<float> small = GetValues(2, -8.f, 8.f);
+		// Halfway cases and negative zero.
+		for (size_t i = 0; i < 1024; i++)
+			small[i] = float(int(i) - 512) * 0.5f;
+		small[1024] = -0.f;
+		std::vector<float> output(valueCount);
+
+		Math::Abs(small, output);
+		std::printf("  Abs    %zu mismatches\n", GetMismatchCount(output, [&](size_t i) { return Math::Abs(small[i]); }));
+		Math::Floor(small, output);
+		std::printf("  Floor  %zu mismatches\n", GetMismatchCount(output, [&](size_t i) { return Math::Floor(small[i]); }));
+		Math::Ceil(small, output);
+		std::printf("  Ceil   %zu mismatches\n", GetMismatchCount(output, [&](size_t i) { return Math::Ceil(small[i]); }));
+		Math::Round(small, output);
+		std::printf("  Round  %zu mismatches\n", GetMismatchCount(output, [&](size_t i) { return Math::Round(small[i]); }));
+		Math::Round(values, output);
+		std::printf("  Round  %zu mismatches over [-1e6, 1e6]\n", GetMismatchCount(output, [&](size_t i) { return Math::Round(values[i]); }));
+		Math::Clamp(small, -2.f, 3.f, output);
+		std::printf("  Clamp  %zu mismatches\n", GetMismatchCount(output, [&](size_t i) { return Math::Clamp(small[i], -2.f, 3.f); }));
+		Math::Lerp(small, values, 0.3f, output);
+		std::printf("  Lerp   %zu mismatches\n", GetMismatchCount(output, [&](size_t i) { return Math::Lerp(small[i], values[i], 0.3f); }));
+		Math::LerpClamped(small, values, 0.3f, -100.f, 100.f, output);
+		std::printf("  LerpClamped %zu mismatches\n", GetMismatchCount(output, [&](size_t i) { return Math::Clamp(Math::Lerp(small[i], values[i], 0.3f), -100.f, 100.f); }));
+
+		const std::vector<float> positive = GetPositiveValues(3);
+		Math::Log(positive, output);
+		std::printf("  Log    %lld ulp\n", (long long)GetMaxUlp(output, [&](size_t i) { return float(std::log(double(positive[i]))); }));
+
+		const std::vector<float> unit = GetValues(4, 0.f, 1.f);
+		Math::Pow(unit, 2.2f, output);
+		std::printf("  Pow    %lld ulp for x^2.2 in [0, 1]\n", (long long)GetMaxUlp(output, [&](size_t i) { return float(std::pow(double(unit[i]), double(2.2f))); }));
+		const std::vector<float> exponents = GetValues(5, -40.f, 40.f);
+		Math::Pow(positive, exponents, output);
+		std::printf("  Pow    %lld ulp for x^y with y in [-40, 40]\n", (long long)GetMaxUlp(output, [&](size_t i) { return float(std::pow(double(positive[i]), double(exponents[i]))); }));
+
+		std::vector<float> signedPositive = positive;
+		for (size_t i = 0; i < signedPositive.size(); i += 2)
+			signedPositive[i] = -signedPositive[i];
+		Math::Hypot(positive, signedPositive, output);
+		std::printf("  Hypot  %lld ulp\n", (long long)GetMaxUlp(output, [&](size_t i) { return float(std::hypot(double(positive[i]), double(signedPositive[i]))); }));
+		const std::vector<float> reversed(positive.rbegin(), positive.rend());
+		Math::Hypot(positive, reversed, signedPositive, output);
+		std::printf("  Hypot  %lld ulp, 3 arguments\n", (long long)GetMaxUlp(output, [&](size_t i)
+		{
+			// Some standard libraries give NaN instead of infinity for 3 arguments. Double precision cannot overflow here.
+			const double x = positive[i], y = reversed[i], z = signedPositive[i];
+			if (std::isinf(x) || std::isinf(y) || std::isinf(z))
+				return std::numeric_limits<float>::infinity();
+			return float(std::sqrt(x * x + y * y + z * z));
+		}));
+	}
+
+	template<typename Func>
+	double Measure(Func&& func)
+	{
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+			func();
+		return SecondsSince(start) / repeatCount;
+	}
+
+	void Report(const char* name, double scalarSeconds, double batchSeconds, double parallelSeconds)
+	{
+		std::printf("  %-12s scalar %7.3f ms, batch %7.3f ms (%5.1fx), parallel %7.3f ms (%5.1fx)\n", name,
+			scalarSeconds * 1e3, batchSeconds * 1e3, scalarSeconds / batchSeconds, parallelSeconds * 1e3, scalarSeconds / parallelSeconds);
+	}
+}
+
+int main()
+{
+	ReportAccuracy();
+
+	const std::vector<float> a = GetValues(6, 0.f, 100.f);
+	const std::vector<float> b = GetValues(7, -100.f, 100.f);
+	std::vector<float> output(valueCount);
+
+	std::printf("%zu values, %zu float lanes, %zu threads\n", valueCount, Math::detail::Simd::floatLaneCount, Math::GetParallelThreadCount());
+	Report("Floor",
+		Measure([&]() { for (size_t i = 0; i < valueCount; i++) output[i] = Math::Floor(b[i]); }),
+		Measure([&]() { Math::Floor(b, output); }),
+		Measure([&]() { Math::Floor_Parallel(b, output); }));
+	Report("Round",
+		Measure([&]() { for (size_t i = 0; i < valueCount; i++) output[i] = Math::Round(b[i]); }),
+		Measure([&]() { Math::Round(b, output); }),
+		Measure([&]() { Math::Round_Parallel(b, output); }));
+	Report("LerpClamped",
+		Measure([&]() { for (size_t i = 0; i < valueCount; i++) output[i] = Math::Clamp(Math::Lerp(a[i], b[i], 0.25f), -10.f, 10.f); }),
+		Measure([&]() { Math::LerpClamped(a, b, 0.25f, -10.f, 10.f, output); }),
+		Measure([&]() { Math::LerpClamped_Parallel(a, b, 0.25f, -10.f, 10.f, output); }));
+	Report("Log",
+		Measure([&]() { for (size_t i = 0; i < valueCount; i++) output[i] = Math::Log(a[i]); }),
+		Measure([&]() { Math::Log(a, output); }),
+		Measure([&]() { Math::Log_Parallel(a, output); }));
+	Report("Pow",
+		Measure([&]() { for (size_t i = 0; i < valueCount; i++) output[i] = Math::Pow(a[i], 2.2f); }),
+		Measure([&]() { Math::Pow(a, 2.2f, output); }),
+		Measure([&]() { Math::Pow_Parallel(a, 2.2f, output); }));
+	Report("Hypot",
+		Measure([&]() { for (size_t i = 0; i < valueCount; i++) output[i] = Math::Hypot(a[i], b[i]); }),
+		Measure([&]() { Math::Hypot(a, b, output); }),
+		Measure([&]() { Math::Hypot_Parallel(a, b, output); }));
+}
\ No newline at end of file
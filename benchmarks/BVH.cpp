@@ -0,0 +1,109 @@
+#include "DMath/BVH.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Tessellated sphere with noisy radius, roughly 2 * segments^2 triangles.
+	std::vector<Math::Triangle<float>> MakeSphereMesh(size_t segments)
+	{
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> noise(0.95f, 1.05f);
+
+		std::vector<Math::Vector3D> vertices;
+		for (size_t y = 0; y <= segments; y++)
+		{
+			const float theta = Math::pi * float(y) / float(segments);
+			for (size_t x = 0; x <= segments; x++)
+			{
+				const float phi = 2 * Math::pi * float(x) / float(segments);
+				const float radius = 10.f * noise(rng);
+				vertices.push_back(Math::Vector3D{ radius * std::sin(theta) * std::cos(phi), radius * std::cos(theta), radius * std::sin(theta) * std::sin(phi) });
+			}
+		}
+
+		std::vector<Math::Triangle<float>> triangles;
+		for (size_t y = 0; y < segments; y++)
+		{
+			for (size_t x = 0; x < segments; x++)
+			{
+				const size_t i0 = y * (segments + 1) + x;
+				const size_t i1 = i0 + 1;
+				const size_t i2 = i0 + segments + 1;
+				const size_t i3 = i2 + 1;
+				triangles.push_back(Math::Triangle<float>{ vertices[i0], vertices[i2], vertices[i1] });
+				triangles.push_back(Math::Triangle<float>{ vertices[i1], vertices[i2], vertices[i3] });
+			}
+		}
+		return triangles;
+	}
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+}
+
+int main()
+{
+	constexpr size_t rayCount = 1 << 20;
+
+	for (size_t segments : { 128, 512, 1024 })
+	{
+		const auto triangles = MakeSphereMesh(segments);
+
+		auto start = Clock::now();
+		Math::TriangleMeshBVH<float> bvh{ Math::Span<const Math::Triangle<float>>(triangles) };
+		const double buildSeconds = SecondsSince(start);
+
+		Math::BVH4<float>::BuildSettings serialSettings;
+		serialSettings.parallel = false;
+		start = Clock::now();
+		Math::TriangleMeshBVH<float> serialBvh{ Math::Span<const Math::Triangle<float>>(triangles), serialSettings };
+		const double serialBuildSeconds = SecondsSince(start);
+
+		// Rays from a shell around the mesh towards random points near its center.
+		std::mt19937 rng(2);
+		std::uniform_real_distribution<float> unit(-1.f, 1.f);
+		std::vector<Math::Ray<float>> rays(rayCount);
+		for (auto& ray : rays)
+		{
+			Math::Vector3D origin{ unit(rng), unit(rng), unit(rng) };
+			origin = origin.GetNormalized() * 30.f;
+			const Math::Vector3D target{ unit(rng) * 5.f, unit(rng) * 5.f, unit(rng) * 5.f };
+			ray = Math::Ray<float>{ origin, (target - origin).GetNormalized() };
+		}
+
+		size_t hitCount = 0;
+		start = Clock::now();
+		for (const auto& ray : rays)
+			hitCount += bvh.Intersect(ray).has_value();
+		const double closestSeconds = SecondsSince(start);
+
+		size_t occludedCount = 0;
+		start = Clock::now();
+		for (const auto& ray : rays)
+			occludedCount += bvh.IsOccluded(ray);
+		const double anySeconds = SecondsSince(start);
+
+		std::vector<uint8_t> hits(rayCount);
+		start = Clock::now();
+		Math::ParallelFor(0, rayCount, 4096, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+				hits[i] = bvh.Intersect(rays[i]).has_value();
+		});
+		const double parallelSeconds = SecondsSince(start);
+
+		std::printf("%zu triangles, %zu nodes\n", triangles.size(), bvh.GetBVH().GetNodes().size());
+		std::printf("  build:          %8.2f ms (serial %8.2f ms)\n", buildSeconds * 1e3, serialBuildSeconds * 1e3);
+		std::printf("  closest hit:    %8.2f Mrays/s (%zu hits)\n", rayCount / closestSeconds * 1e-6, hitCount);
+		std::printf("  any hit:        %8.2f Mrays/s (%zu hits)\n", rayCount / anySeconds * 1e-6, occludedCount);
+		std::printf("  closest hit MT: %8.2f Mrays/s (%zu threads)\n", rayCount / parallelSeconds * 1e-6, Math::GetParallelThreadCount());
+	}
+}
\ No newline at end of file
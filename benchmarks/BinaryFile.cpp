@@ -0,0 +1,122 @@
+#include "DMath/BinaryFile.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t pointCount = size_t(1) << 22;
+	constexpr size_t repeatCount = 4;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	template<typename Func>
+	double Measure(Func&& func)
+	{
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+			func();
+		return SecondsSince(start) / repeatCount;
+	}
+
+	// Reads every element, so that a mapped file is paged in and each load is measured to the point of use.
+	float Sum(Math::Span<const Math::Vector3D> points)
+	{
+		float sum = 0.f;
+		for (const auto& point : points)
+			sum += point.x + point.y + point.z;
+		return sum;
+	}
+
+	bool WriteText(const char* path, const std::vector<Math::Vector3D>& points)
+	{
+		std::FILE* file = std::fopen(path, "w");
+		if (file == nullptr)
+			return false;
+		for (const auto& point : points)
+			std::fprintf(file, "%.9g %.9g %.9g\n", point.x, point.y, point.z);
+		return std::fclose(file) == 0;
+	}
+
+	std::vector<Math::Vector3D> ReadText(const char* path)
+	{
+		std::vector<Math::Vector3D> points;
+		std::FILE* file = std::fopen(path, "rb");
+		if (file == nullptr)
+			return points;
+		std::string text;
+		char chunk[1 << 16];
+		for (size_t readCount; (readCount = std::fread(chunk, 1, sizeof(chunk), file)) > 0;)
+			text.append(chunk, readCount);
+		std::fclose(file);
+
+		const char* position = text.c_str();
+		for (char* end;;)
+		{
+			Math::Vector3D point;
+			point.x = std::strtof(position, &end);
+			if (end == position)
+				break;
+			point.y = std::strtof(end, &end);
+			point.z = std::strtof(end, &end);
+			position = end;
+			points.push_back(point);
+		}
+		return points;
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<float> coordinate(-1000.f, 1000.f);
+	std::vector<Math::Vector3D> points(pointCount);
+	for (auto& point : points)
+		point = { coordinate(rng), coordinate(rng), coordinate(rng) };
+
+	const std::filesystem::path directory = std::filesystem::temp_directory_path();
+	const std::string binaryPath = (directory / "DMathBinaryFileBenchmark.bin").string();
+	const std::string textPath = (directory / "DMathBinaryFileBenchmark.txt").string();
+	if (!Math::WriteBinaryFile<Math::Vector3D>(binaryPath.c_str(), points) || !WriteText(textPath.c_str(), points))
+	{
+		std::printf("cannot write to %s\n", directory.string().c_str());
+		return 1;
+	}
+
+	const float expectedSum = Sum(points);
+	bool isEqual = true;
+	const double textSeconds = Measure([&]() { isEqual &= Sum(ReadText(textPath.c_str())) == expectedSum; });
+	const double readSeconds = Measure([&]()
+	{
+		const Math::BinaryFile file(binaryPath.c_str(), Math::BinaryFileAccess::Read);
+		isEqual &= Sum(file.GetElements<Math::Vector3D>()) == expectedSum;
+	});
+	bool isMapped = false;
+	const double mapSeconds = Measure([&]()
+	{
+		const Math::BinaryFile file(binaryPath.c_str(), Math::BinaryFileAccess::Map);
+		isMapped = file.IsMapped();
+		isEqual &= Sum(file.GetElements<Math::Vector3D>()) == expectedSum;
+	});
+	const double openSeconds = Measure([&]() { isEqual &= Math::BinaryFile(binaryPath.c_str()).GetElements<Math::Vector3D>().size() == pointCount; });
+
+	std::printf("%zu points, %.1f MB binary, %.1f MB text, loaded data %s\n", pointCount,
+		std::filesystem::file_size(binaryPath) / 1e6, std::filesystem::file_size(textPath) / 1e6, isEqual ? "matches" : "DIFFERS");
+	std::printf("  text parse        %8.3f ms\n", textSeconds * 1e3);
+	std::printf("  binary read       %8.3f ms (%6.1fx)\n", readSeconds * 1e3, textSeconds / readSeconds);
+	std::printf("  binary %-10s %8.3f ms (%6.1fx)\n", isMapped ? "map" : "fallback", mapSeconds * 1e3, textSeconds / mapSeconds);
+	std::printf("  open only         %8.3f ms\n", openSeconds * 1e3);
+
+	std::filesystem::remove(binaryPath);
+	std::filesystem::remove(textPath);
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+# Times BuildTimeBenchmark, built against the header only DMath::DMath, and BuildTimeBenchmarkCompiled, built against DMath::Compiled.
+# Reports the full build of each, with DMath::Compiled itself built beforehand, and the rebuild after one translation unit changed.
+#
+#	cmake [-DBUILD_DIR=<dir>] [-DBUILD_TYPE=Debug] [-DREPEAT_COUNT=3] -P benchmarks/BuildTime.cmake
+#
+# Options go before -P. BUILD_DIR is configured from scratch and defaults to build-time in the current directory.
+
+cmake_minimum_required(VERSION 3.23)
+
+get_filename_component(SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+if (NOT DEFINED BUILD_DIR)
+	set(BUILD_DIR "${CMAKE_CURRENT_BINARY_DIR}/build-time")
+endif()
+if (NOT DEFINED BUILD_TYPE)
+	set(BUILD_TYPE Debug)
+endif()
+if (NOT DEFINED REPEAT_COUNT)
+	set(REPEAT_COUNT 3)
+endif()
+
+function(run)
+	execute_process(COMMAND ${ARGN} RESULT_VARIABLE result OUTPUT_VARIABLE output ERROR_VARIABLE output)
+	if (NOT result EQUAL 0)
+		message(FATAL_ERROR "Failed: ${ARGN}\n${output}")
+	endif()
+endfunction()
+
+# Seconds since the epoch, with microseconds.
+function(get_time outputVariable)
+	string(TIMESTAMP time "%s.%f" UTC)
+	set(${outputVariable} ${time} PARENT_SCOPE)
+endfunction()
+
+function(get_elapsed start outputVariable)
+	get_time(end)
+	# math() is integer only, so the difference is taken in microseconds.
+	string(REPLACE "." "" start "${start}")
+	string(REPLACE "." "" end "${end}")
+	math(EXPR microseconds "${end} - ${start}")
+	math(EXPR milliseconds "${microseconds} / 1000")
+	set(${outputVariable} ${milliseconds} PARENT_SCOPE)
+endfunction()
+
+# Builds target REPEAT_COUNT times, each time after deleting its objects, or after touching the first unit, and reports the fastest.
+function(time_build target isIncremental)
+	set(best "")
+	foreach(repeat RANGE 1 ${REPEAT_COUNT})
+		if (isIncremental)
+			file(TOUCH "${BUILD_DIR}/BuildTime/Unit1.cpp")
+		else()
+			file(GLOB_RECURSE objects "${BUILD_DIR}/CMakeFiles/${target}.dir/*.o" "${BUILD_DIR}/CMakeFiles/${target}.dir/*.obj"
+				"${BUILD_DIR}/CMakeFiles/${target}.dir/*.gch" "${BUILD_DIR}/CMakeFiles/${target}.dir/*.pch")
+			if (objects)
+				file(REMOVE ${objects})
+			endif()
+		endif()
+
+		get_time(start)
+		run(${CMAKE_COMMAND} --build "${BUILD_DIR}" --target ${target})
+		get_elapsed(${start} elapsed)
+		if (best STREQUAL "" OR elapsed LESS best)
+			set(best ${elapsed})
+		endif()
+	endforeach()
+
+	if (isIncremental)
+		set(kind "one unit changed")
+	else()
+		set(kind "full")
+	endif()
+	message(STATUS "${target}, ${kind}: ${best} ms")
+endfunction()
+
+file(REMOVE_RECURSE "${BUILD_DIR}")
+run(${CMAKE_COMMAND} -S "${SOURCE_DIR}" -B "${BUILD_DIR}" -DCMAKE_BUILD_TYPE=${BUILD_TYPE} -DCOMPILE_BENCHMARKS=1 -DCOMPILE_LIBRARY=1)
+run(${CMAKE_COMMAND} --build "${BUILD_DIR}" --target DMathCompiled)
+
+foreach(target BuildTimeBenchmark BuildTimeBenchmarkCompiled)
+	time_build(${target} FALSE)
+	time_build(${target} TRUE)
+endforeach()
\ No newline at end of file
@@ -0,0 +1,20 @@
+// Calls the configured units of BuildTimeUnit.cpp.in, so that both variants of BuildTimeBenchmark link like an application.
+// The build time is what is measured, run benchmarks/BuildTime.cmake to time them.
+
+#include <cstdio>
+
+float RunUnit1(float seed);
+float RunUnit2(float seed);
+float RunUnit3(float seed);
+float RunUnit4(float seed);
+float RunUnit5(float seed);
+float RunUnit6(float seed);
+float RunUnit7(float seed);
+float RunUnit8(float seed);
+
+int main()
+{
+	const float sum = RunUnit1(1.0f) + RunUnit2(2.0f) + RunUnit3(3.0f) + RunUnit4(4.0f) + RunUnit5(5.0f) + RunUnit6(6.0f) + RunUnit7(7.0f) + RunUnit8(8.0f);
+	std::printf("%f\n", sum);
+	return 0;
+}
\ No newline at end of file
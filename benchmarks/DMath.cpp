@@ -0,0 +1,510 @@
+#include "DMath/Vector/Vector.hpp"
+#include "DMath/Matrix/Matrix.hpp"
+#include "DMath/LinearEquation.hpp"
+#include "DMath/LinearTransform3D.hpp"
+#include "DMath/UnitQuaternion.hpp"
+#include "DMath/Simd.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+
+// Throughput of the core value types: vectors, matrices, linear equations, quaternions and transform builders,
+// for each size and scalar type. Prints a table, and with --json writes the results for regression tracking.
+//
+// Usage: DMathBenchmarks [--json <path>, - for stdout] [--filter <substring of the name>] [--min-time <seconds per benchmark>]
+//
+// Every benchmark runs its operation over elementCount inputs per pass. Passes are doubled until a sample takes
+// minSeconds / sampleCount, and the best and median of sampleCount samples are reported in nanoseconds per operation.
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Small enough for every input and output array to stay in the L1 cache, so the timings show the arithmetic.
+	constexpr size_t elementCount = 256;
+	constexpr size_t sampleCount = 7;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	// Keeps the compiler from discarding results, or moving them out of the timed loop.
+	template<typename T>
+	void DoNotOptimize(const T& value)
+	{
+#if defined( __GNUC__ )
+		asm volatile("" : : "r"(&value) : "memory");
+#else
+		static const volatile T* sink;
+		sink = &value;
+#endif
+	}
+
+	template<typename T>
+	constexpr const char* typeName = std::is_same_v<T, float> ? "float" : "double";
+
+	struct Options
+	{
+		const char* jsonPath = nullptr;
+		const char* filter = nullptr;
+		double minSeconds = 0.1;
+	};
+
+	struct Result
+	{
+		std::string group;
+		std::string operation;
+		std::string size;
+		std::string type;
+		size_t operationCount;
+		double bestNanoseconds;
+		double medianNanoseconds;
+	};
+
+	class Suite
+	{
+	public:
+		explicit Suite(const Options& options) :
+			options(options), printTable(options.jsonPath == nullptr || std::strcmp(options.jsonPath, "-") != 0) {}
+
+		// pass() applies the operation to all elementCount inputs once.
+		template<typename Func>
+		void Run(const char* group, const char* operation, const std::string& size, const char* type, Func&& pass)
+		{
+			const std::string name = std::string(group) + "/" + operation + "/" + size + "/" + type;
+			if (options.filter != nullptr && name.find(options.filter) == std::string::npos)
+				return;
+
+			const auto measure = [&](size_t passCount)
+			{
+				const auto start = Clock::now();
+				for (size_t i = 0; i < passCount; i++)
+					pass();
+				return SecondsSince(start);
+			};
+
+			size_t passCount = 1;
+			while (measure(passCount) < options.minSeconds / sampleCount && passCount < (size_t(1) << 30))
+				passCount *= 2;
+
+			std::vector<double> samples(sampleCount);
+			for (auto& sample : samples)
+				sample = measure(passCount) * 1e9 / double(passCount * elementCount);
+			std::sort(samples.begin(), samples.end());
+
+			results.push_back(Result{ group, operation, size, type, passCount * elementCount, samples.front(), samples[sampleCount / 2] });
+			if (printTable)
+				std::printf("  %-48s %10.3f ns  (median %10.3f ns)\n", name.c_str(), samples.front(), samples[sampleCount / 2]);
+		}
+
+		void PrintGroup(const char* group) const
+		{
+			if (printTable)
+				std::printf("%s\n", group);
+		}
+
+		bool WriteJson() const
+		{
+			if (options.jsonPath == nullptr)
+				return true;
+
+			const bool toStdout = std::strcmp(options.jsonPath, "-") == 0;
+			std::FILE* file = toStdout ? stdout : std::fopen(options.jsonPath, "w");
+			if (file == nullptr)
+			{
+				std::fprintf(stderr, "Could not open %s for writing.\n", options.jsonPath);
+				return false;
+			}
+
+			std::fprintf(file, "{\n  \"context\": {\n");
+			std::fprintf(file, "    \"timestamp\": %lld,\n", (long long)std::time(nullptr));
+			std::fprintf(file, "    \"compiler\": \"%s\",\n", GetCompiler().c_str());
+			std::fprintf(file, "    \"simd\": \"%s\",\n", GetInstructionSet());
+			std::fprintf(file, "    \"elementsPerPass\": %zu,\n", elementCount);
+			std::fprintf(file, "    \"samples\": %zu,\n", sampleCount);
+			std::fprintf(file, "    \"unit\": \"ns/op\"\n  },\n  \"benchmarks\": [\n");
+			for (size_t i = 0; i < results.size(); i++)
+			{
+				const Result& result = results[i];
+				std::fprintf(file, "    { \"name\": \"%s/%s/%s/%s\", \"group\": \"%s\", \"operation\": \"%s\", \"size\": \"%s\", \"type\": \"%s\", "
+					"\"operations\": %zu, \"best\": %.4f, \"median\": %.4f }%s\n",
+					result.group.c_str(), result.operation.c_str(), result.size.c_str(), result.type.c_str(),
+					result.group.c_str(), result.operation.c_str(), result.size.c_str(), result.type.c_str(),
+					result.operationCount, result.bestNanoseconds, result.medianNanoseconds, i + 1 < results.size() ? "," : "");
+			}
+			std::fprintf(file, "  ]\n}\n");
+
+			const bool success = std::ferror(file) == 0;
+			if (!toStdout)
+				std::fclose(file);
+			return success;
+		}
+
+	private:
+		Options options;
+		bool printTable;
+		std::vector<Result> results;
+
+		static std::string GetCompiler()
+		{
+#if defined( __clang__ )
+			return std::string("clang ") + __clang_version__;
+#elif defined( __GNUC__ )
+			return std::string("gcc ") + __VERSION__;
+#elif defined( _MSC_VER )
+			return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+			return "unknown";
+#endif
+		}
+
+		static const char* GetInstructionSet()
+		{
+#if defined( DMATH_SIMD_AVX512 )
+			return "AVX-512";
+#elif defined( DMATH_SIMD_AVX2 )
+			return "AVX2";
+#elif defined( DMATH_SIMD_AVX )
+			return "AVX";
+#elif defined( DMATH_SIMD_SSE2 )
+			return "SSE2";
+#else
+			return "scalar";
+#endif
+		}
+	};
+
+	template<typename T>
+	T RandomValue(std::mt19937& rng)
+	{
+		return std::uniform_real_distribution<T>(T(-1), T(1))(rng);
+	}
+
+	template<size_t length, typename T>
+	Math::Vector<length, T> RandomVector(std::mt19937& rng)
+	{
+		Math::Vector<length, T> vector{};
+		for (size_t i = 0; i < length; i++)
+			vector[i] = RandomValue<T>(rng);
+		return vector;
+	}
+
+	// Diagonally dominant, so the matrices are invertible and their equations solvable without pivoting.
+	template<size_t width, size_t height, typename T>
+	Math::Matrix<width, height, T> RandomMatrix(std::mt19937& rng)
+	{
+		Math::Matrix<width, height, T> matrix{};
+		for (size_t x = 0; x < width; x++)
+		{
+			for (size_t y = 0; y < height; y++)
+				matrix[x][y] = RandomValue<T>(rng) + (x == y ? T(width) : T(0));
+		}
+		return matrix;
+	}
+
+	template<typename T>
+	Math::UnitQuaternion<T> RandomQuaternion(std::mt19937& rng)
+	{
+		const Math::Vector<4, T> components = RandomVector<4, T>(rng);
+		const T inverseMagnitude = T(1) / std::sqrt(components.MagnitudeSqrd());
+		return Math::UnitQuaternion<T>::FromComponents(components.x * inverseMagnitude, components.y * inverseMagnitude, components.z * inverseMagnitude, components.w * inverseMagnitude);
+	}
+
+	template<typename Value, typename Generator>
+	std::vector<Value> Generate(Generator&& generator)
+	{
+		std::vector<Value> values(elementCount);
+		for (auto& value : values)
+			value = generator();
+		return values;
+	}
+
+	template<size_t length, typename T>
+	void BenchmarkVector(Suite& suite, std::mt19937& rng)
+	{
+		using VectorType = Math::Vector<length, T>;
+		const std::string size = std::to_string(length);
+		const auto left = Generate<VectorType>([&]() { return RandomVector<length, T>(rng); });
+		const auto right = Generate<VectorType>([&]() { return RandomVector<length, T>(rng); });
+		std::vector<VectorType> vectors(elementCount);
+		std::vector<T> scalars(elementCount);
+
+		suite.Run("Vector", "Add", size, typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				vectors[i] = left[i] + right[i];
+			DoNotOptimize(vectors);
+		});
+		suite.Run("Vector", "Dot", size, typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				scalars[i] = VectorType::Dot(left[i], right[i]);
+			DoNotOptimize(scalars);
+		});
+		suite.Run("Vector", "Magnitude", size, typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				scalars[i] = left[i].Magnitude();
+			DoNotOptimize(scalars);
+		});
+		suite.Run("Vector", "GetNormalized", size, typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				vectors[i] = left[i].GetNormalized();
+			DoNotOptimize(vectors);
+		});
+		if constexpr (length == 3)
+		{
+			suite.Run("Vector", "Cross", size, typeName<T>, [&]()
+			{
+				for (size_t i = 0; i < elementCount; i++)
+					vectors[i] = VectorType::Cross(left[i], right[i]);
+				DoNotOptimize(vectors);
+			});
+		}
+	}
+
+	template<size_t width, typename T>
+	void BenchmarkMatrix(Suite& suite, std::mt19937& rng)
+	{
+		using MatrixType = Math::Matrix<width, width, T>;
+		const std::string size = std::to_string(width) + "x" + std::to_string(width);
+		const auto left = Generate<MatrixType>([&]() { return RandomMatrix<width, width, T>(rng); });
+		const auto right = Generate<MatrixType>([&]() { return RandomMatrix<width, width, T>(rng); });
+		const auto vectors = Generate<Math::Vector<width, T>>([&]() { return RandomVector<width, T>(rng); });
+		std::vector<MatrixType> matrices(elementCount);
+		std::vector<Math::Vector<width, T>> products(elementCount);
+		std::vector<T> scalars(elementCount);
+
+		suite.Run("Matrix", "Multiply", size, typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				matrices[i] = left[i] * right[i];
+			DoNotOptimize(matrices);
+		});
+		suite.Run("Matrix", "MultiplyVector", size, typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				products[i] = left[i] * vectors[i];
+			DoNotOptimize(products);
+		});
+		suite.Run("Matrix", "GetDeterminant", size, typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				scalars[i] = left[i].GetDeterminant();
+			DoNotOptimize(scalars);
+		});
+		suite.Run("Matrix", "GetInverse", size, typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				matrices[i] = *left[i].GetInverse();
+			DoNotOptimize(matrices);
+		});
+		suite.Run("Matrix", "GetTransposed", size, typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				matrices[i] = left[i].GetTransposed();
+			DoNotOptimize(matrices);
+		});
+	}
+
+	template<size_t unknownCount, typename T>
+	void BenchmarkLinearEquation(Suite& suite, std::mt19937& rng)
+	{
+		const auto equations = Generate<Math::Matrix<unknownCount + 1, unknownCount, T>>([&]() { return RandomMatrix<unknownCount + 1, unknownCount, T>(rng); });
+		std::vector<Math::Vector<unknownCount, T>> solutions(elementCount);
+
+		suite.Run("LinearEquation", "SolveLinearEquation", std::to_string(unknownCount), typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				solutions[i] = *Math::SolveLinearEquation<unknownCount, T>(equations[i]);
+			DoNotOptimize(solutions);
+		});
+	}
+
+	template<typename T>
+	void BenchmarkQuaternion(Suite& suite, std::mt19937& rng)
+	{
+		using QuaternionType = Math::UnitQuaternion<T>;
+		const auto left = Generate<QuaternionType>([&]() { return RandomQuaternion<T>(rng); });
+		const auto right = Generate<QuaternionType>([&]() { return RandomQuaternion<T>(rng); });
+		std::vector<QuaternionType> quaternions(elementCount);
+		std::vector<Math::Matrix<4, 3, T>> reducedMatrices(elementCount);
+		std::vector<Math::Matrix<4, 4, T>> matrices(elementCount);
+
+		suite.Run("UnitQuaternion", "Multiply", "4", typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				quaternions[i] = left[i] * right[i];
+			DoNotOptimize(quaternions);
+		});
+		suite.Run("UnitQuaternion", "MultiplyQuaternions", "4", typeName<T>, [&]()
+		{
+			Math::MultiplyQuaternions<T>(left, right, quaternions);
+			DoNotOptimize(quaternions);
+		});
+		suite.Run("UnitQuaternion", "GetInverse", "4", typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				quaternions[i] = left[i].GetInverse();
+			DoNotOptimize(quaternions);
+		});
+		suite.Run("UnitQuaternion", "ToMatrix", "4x3", typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				reducedMatrices[i] = Math::Matrix<4, 3, T>(left[i]);
+			DoNotOptimize(reducedMatrices);
+		});
+		suite.Run("UnitQuaternion", "ToMatrix", "4x4", typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				matrices[i] = Math::Matrix<4, 4, T>(left[i]);
+			DoNotOptimize(matrices);
+		});
+	}
+
+	// The projections and Multiply_Reduced are templates, the other builders are float only.
+	template<typename T>
+	void BenchmarkLinearTransform3D(Suite& suite, std::mt19937& rng)
+	{
+		namespace LinTran3D = Math::LinearTransform3D;
+		const auto left = Generate<Math::Matrix<4, 3, T>>([&]() { return RandomMatrix<4, 3, T>(rng); });
+		const auto right = Generate<Math::Matrix<4, 3, T>>([&]() { return RandomMatrix<4, 3, T>(rng); });
+		const auto values = Generate<T>([&]() { return RandomValue<T>(rng) + T(2); });
+		std::vector<Math::Matrix<4, 3, T>> reducedMatrices(elementCount);
+		std::vector<Math::Matrix<4, 4, T>> matrices(elementCount);
+
+		suite.Run("LinearTransform3D", "Multiply_Reduced", "4x3", typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				reducedMatrices[i] = LinTran3D::Multiply_Reduced(left[i], right[i]);
+			DoNotOptimize(reducedMatrices);
+		});
+		suite.Run("LinearTransform3D", "Perspective_RH_ZO", "4x4", typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				matrices[i] = LinTran3D::Perspective_RH_ZO<T>(values[i], T(16) / T(9), T(0.1), T(100));
+			DoNotOptimize(matrices);
+		});
+		suite.Run("LinearTransform3D", "Orthographic_RH_ZO", "4x4", typeName<T>, [&]()
+		{
+			for (size_t i = 0; i < elementCount; i++)
+				matrices[i] = LinTran3D::Orthographic_RH_ZO<T>(-values[i], values[i], -values[i], values[i], T(0.1), T(100));
+			DoNotOptimize(matrices);
+		});
+
+		if constexpr (std::is_same_v<T, float>)
+		{
+			const auto vectors = Generate<Math::Vector3D>([&]() { return RandomVector<3, float>(rng) + Math::Vector3D{ 0.f, 0.f, 2.f }; });
+			const auto quaternions = Generate<Math::UnitQuaternion<float>>([&]() { return RandomQuaternion<float>(rng); });
+			std::vector<Math::Matrix3x3> rotations(elementCount);
+
+			suite.Run("LinearTransform3D", "Translate", "4x4", typeName<T>, [&]()
+			{
+				for (size_t i = 0; i < elementCount; i++)
+					matrices[i] = LinTran3D::Translate(vectors[i]);
+				DoNotOptimize(matrices);
+			});
+			suite.Run("LinearTransform3D", "Scale", "4x4", typeName<T>, [&]()
+			{
+				for (size_t i = 0; i < elementCount; i++)
+					matrices[i] = LinTran3D::Scale_Homo(vectors[i]);
+				DoNotOptimize(matrices);
+			});
+			suite.Run("LinearTransform3D", "RotateAxis", "3x3", typeName<T>, [&]()
+			{
+				for (size_t i = 0; i < elementCount; i++)
+					rotations[i] = LinTran3D::Rotate<Math::AngleUnit::Radians>(vectors[i], values[i]);
+				DoNotOptimize(rotations);
+			});
+			suite.Run("LinearTransform3D", "RotateEuler", "3x3", typeName<T>, [&]()
+			{
+				for (size_t i = 0; i < elementCount; i++)
+					rotations[i] = LinTran3D::Rotate<Math::AngleUnit::Radians>(vectors[i]);
+				DoNotOptimize(rotations);
+			});
+			suite.Run("LinearTransform3D", "RotateQuaternion", "4x4", typeName<T>, [&]()
+			{
+				for (size_t i = 0; i < elementCount; i++)
+					matrices[i] = LinTran3D::Rotate_Homo(quaternions[i]);
+				DoNotOptimize(matrices);
+			});
+			suite.Run("LinearTransform3D", "LookAt_RH", "4x4", typeName<T>, [&]()
+			{
+				for (size_t i = 0; i < elementCount; i++)
+					matrices[i] = LinTran3D::LookAt_RH(vectors[i], -vectors[i].GetNormalized(), Math::Vector3D::Up());
+				DoNotOptimize(matrices);
+			});
+		}
+	}
+
+	template<typename T>
+	void BenchmarkType(Suite& suite)
+	{
+		std::mt19937 rng(1);
+
+		suite.PrintGroup("Vector");
+		BenchmarkVector<2, T>(suite, rng);
+		BenchmarkVector<3, T>(suite, rng);
+		BenchmarkVector<4, T>(suite, rng);
+		BenchmarkVector<8, T>(suite, rng);
+
+		suite.PrintGroup("Matrix");
+		BenchmarkMatrix<2, T>(suite, rng);
+		BenchmarkMatrix<3, T>(suite, rng);
+		BenchmarkMatrix<4, T>(suite, rng);
+
+		suite.PrintGroup("LinearEquation");
+		BenchmarkLinearEquation<2, T>(suite, rng);
+		BenchmarkLinearEquation<3, T>(suite, rng);
+		BenchmarkLinearEquation<4, T>(suite, rng);
+
+		suite.PrintGroup("UnitQuaternion");
+		BenchmarkQuaternion<T>(suite, rng);
+
+		suite.PrintGroup("LinearTransform3D");
+		BenchmarkLinearTransform3D<T>(suite, rng);
+	}
+
+	bool ParseOptions(int argumentCount, char** arguments, Options& options)
+	{
+		for (int i = 1; i < argumentCount; i++)
+		{
+			const bool hasValue = i + 1 < argumentCount;
+			if (std::strcmp(arguments[i], "--json") == 0 && hasValue)
+				options.jsonPath = arguments[++i];
+			else if (std::strcmp(arguments[i], "--filter") == 0 && hasValue)
+				options.filter = arguments[++i];
+			else if (std::strcmp(arguments[i], "--min-time") == 0 && hasValue)
+				options.minSeconds = std::atof(arguments[++i]);
+			else
+			{
+				std::fprintf(stderr, "Usage: %s [--json <path>, - for stdout] [--filter <substring>] [--min-time <seconds>]\n", arguments[0]);
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+int main(int argumentCount, char** arguments)
+{
+	Options options;
+	if (!ParseOptions(argumentCount, arguments, options))
+		return 1;
+
+	Suite suite(options);
+	BenchmarkType<float>(suite);
+	BenchmarkType<double>(suite);
+	return suite.WriteJson() ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "DMath/Vector/Vector.hpp"
+#include "DMath/Format.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t vectorCount = size_t(1) << 20;
+	constexpr size_t repeatCount = 4;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	template<typename Func>
+	double Measure(Func&& func)
+	{
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+			func();
+		return SecondsSince(start) / repeatCount;
+	}
+
+	void Report(const char* name, size_t byteCount, double referenceSeconds, double seconds)
+	{
+		std::printf("  %-32s %8.3f ms %8.1f MB/s (%5.1fx)\n", name, seconds * 1e3, byteCount / seconds / 1e6, referenceSeconds / seconds);
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<float> coordinate(-1000.f, 1000.f);
+	std::vector<Math::Vector3D> vectors(vectorCount);
+	for (auto& vector : vectors)
+		vector = { coordinate(rng), coordinate(rng), coordinate(rng) };
+
+	// The stream based ToString this replaces.
+	const auto streamToString = [](const Math::Vector3D& vector)
+	{
+		std::ostringstream stream;
+		stream.flags(std::ios::fixed);
+		stream.precision(4);
+		stream << '(' << vector.x << ", " << vector.y << ", " << vector.z << ')';
+		return stream.str();
+	};
+
+	size_t checksum = 0;
+	size_t toStringBytes = 0;
+	for (const auto& vector : vectors)
+		toStringBytes += vector.ToString().size();
+	const double streamSeconds = Measure([&]()
+	{
+		for (const auto& vector : vectors)
+			checksum += streamToString(vector).size();
+	});
+	const double toStringSeconds = Measure([&]()
+	{
+		for (const auto& vector : vectors)
+			checksum += vector.ToString().size();
+	});
+	std::vector<char> buffer(vectorCount * 64);
+	const double toCharsSeconds = Measure([&]()
+	{
+		char* position = buffer.data();
+		for (const auto& vector : vectors)
+			position = Math::ToChars(position, buffer.data() + buffer.size(), vector).ptr;
+		checksum += size_t(position - buffer.data());
+	});
+	std::printf("%zu vectors, ToString format\n", vectorCount);
+	Report("ostringstream", toStringBytes, streamSeconds, streamSeconds);
+	Report("ToString", toStringBytes, streamSeconds, toStringSeconds);
+	Report("ToChars", toStringBytes, streamSeconds, toCharsSeconds);
+
+	// Text that reads back exactly, one vector per line.
+	Math::FormatResult formatResult{};
+	const double formatSeconds = Measure([&]() { formatResult = Math::FormatElements<Math::Vector3D>(vectors, buffer); });
+	const double printfSeconds = Measure([&]()
+	{
+		size_t offset = 0;
+		for (const auto& vector : vectors)
+			offset += size_t(std::snprintf(buffer.data() + offset, buffer.size() - offset, "%.9g %.9g %.9g\n", vector.x, vector.y, vector.z));
+		checksum += offset;
+	});
+	// The snprintf loop overwrote the buffer, the text is written again for parsing.
+	const Math::FormatResult rewriteResult = Math::FormatElements<Math::Vector3D>(vectors, buffer);
+	if (formatResult.elementCount != vectorCount || rewriteResult.elementCount != vectorCount || rewriteResult.charCount != formatResult.charCount
+		|| formatResult.charCount > buffer.size())
+	{
+		std::printf("FormatElements wrote %zu of %zu vectors\n", rewriteResult.elementCount, vectorCount);
+		return 1;
+	}
+	const Math::Span<const char> text(buffer.data(), formatResult.charCount);
+	std::vector<Math::Vector3D> parsed(vectorCount);
+	Math::ParseResult parseResult{};
+	const double parseSeconds = Measure([&]() { parseResult = Math::ParseElements<Math::Vector3D>(text, parsed); });
+	const std::string textString(text.data(), text.size());
+	const double strtofSeconds = Measure([&]()
+	{
+		char* position = const_cast<char*>(textString.c_str());
+		for (auto& vector : parsed)
+		{
+			vector.x = std::strtof(position, &position);
+			vector.y = std::strtof(position, &position);
+			vector.z = std::strtof(position, &position);
+		}
+	});
+	// Likewise for the strtof loop.
+	const Math::ParseResult reparseResult = Math::ParseElements<Math::Vector3D>(text, parsed);
+	if (parseResult.elementCount != vectorCount || reparseResult.elementCount != vectorCount || reparseResult.charCount > text.size())
+	{
+		std::printf("ParseElements read %zu of %zu vectors\n", reparseResult.elementCount, vectorCount);
+		return 1;
+	}
+	const bool isEqual = std::memcmp(parsed.data(), vectors.data(), vectorCount * sizeof(Math::Vector3D)) == 0;
+	std::printf("%zu vectors, shortest exact format, parsed text %s\n", vectorCount, isEqual ? "matches" : "DIFFERS");
+	Report("snprintf", formatResult.charCount, printfSeconds, printfSeconds);
+	Report("FormatElements", formatResult.charCount, printfSeconds, formatSeconds);
+	Report("strtof", formatResult.charCount, strtofSeconds, strtofSeconds);
+	Report("ParseElements", formatResult.charCount, strtofSeconds, parseSeconds);
+	std::printf("checksum %zu\n", checksum);
+}
\ No newline at end of file
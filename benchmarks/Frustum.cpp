@@ -0,0 +1,206 @@
+#include "DMath/Frustum.hpp"
+#include "DMath/LinearTransform3D.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t objectCount = size_t(1) << 20;
+	constexpr size_t repeatCount = 16;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	template<typename Func>
+	double Measure(Func&& func)
+	{
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+			func();
+		return SecondsSince(start) / repeatCount;
+	}
+
+	// Index of the plane the point is furthest outside of, or closest to leaving.
+	size_t GetClosestPlane(const Math::Frustum<float>& frustum, const Math::Vector3D& point)
+	{
+		size_t closest = 0;
+		for (size_t plane = 1; plane < frustum.planes.size(); plane++)
+		{
+			if (frustum.planes[plane].SignedDistance(point) < frustum.planes[closest].SignedDistance(point))
+				closest = plane;
+		}
+		return closest;
+	}
+
+	struct Spheres
+	{
+		std::vector<float> centerX, centerY, centerZ, radius;
+
+		Math::SphereBatch<float> GetBatch(size_t offset, size_t count) const
+		{
+			return { { centerX.data() + offset, count }, { centerY.data() + offset, count }, { centerZ.data() + offset, count }, { radius.data() + offset, count } };
+		}
+	};
+
+	struct AABBs
+	{
+		std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+
+		Math::AABBBatch<float> GetBatch(size_t offset, size_t count) const
+		{
+			return
+			{
+				{ minX.data() + offset, count }, { minY.data() + offset, count }, { minZ.data() + offset, count },
+				{ maxX.data() + offset, count }, { maxY.data() + offset, count }, { maxZ.data() + offset, count }
+			};
+		}
+	};
+
+	// Objects that touch their closest plane to within about an ulp of their coordinates,
+	// so that any difference in how the kernels round shows in the bits.
+	Spheres GetBoundarySpheres(const Math::Frustum<float>& frustum, std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> horizontal(-150.f, 150.f);
+		std::uniform_real_distribution<float> depth(-120.f, 10.f);
+		std::uniform_real_distribution<float> jitter(-1e-7f, 1e-7f);
+		Spheres spheres;
+		for (size_t i = 0; i < objectCount; i++)
+		{
+			const Math::Vector3D center{ horizontal(rng), horizontal(rng), depth(rng) };
+			const float distance = frustum.planes[GetClosestPlane(frustum, center)].SignedDistance(center);
+			spheres.centerX.push_back(center.x);
+			spheres.centerY.push_back(center.y);
+			spheres.centerZ.push_back(center.z);
+			spheres.radius.push_back(std::abs(distance) + center.Magnitude() * jitter(rng));
+		}
+		return spheres;
+	}
+
+	AABBs GetBoundaryAABBs(const Math::Frustum<float>& frustum, std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> horizontal(-150.f, 150.f);
+		std::uniform_real_distribution<float> depth(-120.f, 10.f);
+		std::uniform_real_distribution<float> extent(0.1f, 5.f);
+		std::uniform_real_distribution<float> jitter(-1e-7f, 1e-7f);
+		AABBs boxes;
+		for (size_t i = 0; i < objectCount; i++)
+		{
+			Math::Vector3D min{ horizontal(rng), horizontal(rng), depth(rng) };
+			Math::Vector3D max = min + Math::Vector3D{ extent(rng), extent(rng), extent(rng) };
+
+			// Moves the box along the normal of the plane its positive vertex is closest to leaving, until that vertex is on the plane.
+			size_t closest = 0;
+			float closestDistance = 0.f;
+			for (size_t plane = 0; plane < frustum.planes.size(); plane++)
+			{
+				const auto& normal = frustum.planes[plane].normal;
+				const Math::Vector3D positiveVertex{ normal.x >= 0.f ? max.x : min.x, normal.y >= 0.f ? max.y : min.y, normal.z >= 0.f ? max.z : min.z };
+				const float distance = frustum.planes[plane].SignedDistance(positiveVertex);
+				if (plane == 0 || distance < closestDistance)
+				{
+					closest = plane;
+					closestDistance = distance;
+				}
+			}
+			const auto& normal = frustum.planes[closest].normal;
+			const Math::Vector3D offset = normal * ((-closestDistance + max.Magnitude() * jitter(rng)) / normal.MagnitudeSqrd());
+			min += offset;
+			max += offset;
+
+			boxes.minX.push_back(min.x);
+			boxes.minY.push_back(min.y);
+			boxes.minZ.push_back(min.z);
+			boxes.maxX.push_back(max.x);
+			boxes.maxY.push_back(max.y);
+			boxes.maxZ.push_back(max.z);
+		}
+		return boxes;
+	}
+
+	// Culls the objects in full blocks, then every object again alone, a batch of one that always takes the remainder path.
+	// Returns how many bits differ, which must be none. Also counts the objects Frustum::IntersectsSphere or IntersectsAABB
+	// decide otherwise, those may differ where the compiler contracts their multiply-adds.
+	template<typename Objects, typename Cull, typename Intersects>
+	size_t CompareBlockAndTail(const char* name, const Objects& objects, Cull&& cull, Intersects&& intersects)
+	{
+		std::vector<uint32_t> mask(Math::GetVisibilityMaskLength(objectCount));
+		cull(objects.GetBatch(0, objectCount), Math::Span<uint32_t>(mask.data(), mask.size()));
+
+		size_t mismatchCount = 0;
+		size_t intersectsMismatchCount = 0;
+		size_t visibleCount = 0;
+		for (size_t i = 0; i < objectCount; i++)
+		{
+			uint32_t tailMask = 0;
+			cull(objects.GetBatch(i, 1), Math::Span<uint32_t>(&tailMask, 1));
+			const bool visible = Math::IsVisible(mask, i);
+			mismatchCount += visible != bool(tailMask & 1u);
+			intersectsMismatchCount += visible != intersects(i);
+			visibleCount += visible;
+		}
+		std::printf("%s: %zu of %zu boundary objects visible, %zu mismatches between block and tail, %zu with the single object test\n",
+			name, visibleCount, objectCount, mismatchCount, intersectsMismatchCount);
+		return mismatchCount;
+	}
+
+	void ReportSpeed(const char* name, double scalarSeconds, double batchSeconds, double parallelSeconds)
+	{
+		std::printf("  %-8s scalar %7.3f ms, batch %7.3f ms (%5.1fx), parallel %7.3f ms (%5.1fx)\n",
+			name, scalarSeconds * 1e3, batchSeconds * 1e3, scalarSeconds / batchSeconds, parallelSeconds * 1e3, scalarSeconds / parallelSeconds);
+	}
+}
+
+int main()
+{
+	// A camera off the origin and the axes, so that every plane has a distance and a normal with three non-zero components.
+	const Math::Matrix4x4 view = Math::LinearTransform3D::LookAt_RH({ 3.f, 2.f, 1.f }, Math::Vector3D{ -0.3f, -0.1f, -1.f }.GetNormalized(), { 0.f, 1.f, 0.f });
+	const auto frustum = Math::Frustum<float>::FromMatrix_ZO(Math::LinearTransform3D::Perspective_RH_ZO(60.f, 16.f / 9.f, 0.1f, 100.f) * view);
+
+	std::mt19937 rng(1);
+	const Spheres spheres = GetBoundarySpheres(frustum, rng);
+	const AABBs boxes = GetBoundaryAABBs(frustum, rng);
+
+	std::printf("%zu objects, %zu float lanes, %zu threads\n", objectCount, Math::detail::Simd::floatLaneCount, Math::GetParallelThreadCount());
+	size_t mismatchCount = 0;
+	mismatchCount += CompareBlockAndTail("spheres", spheres,
+		[&](const Math::SphereBatch<float>& batch, Math::Span<uint32_t> mask) { Math::CullSpheres(frustum, batch, mask); },
+		[&](size_t i) { return frustum.IntersectsSphere({ spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i] }, spheres.radius[i]); });
+	mismatchCount += CompareBlockAndTail("AABBs", boxes,
+		[&](const Math::AABBBatch<float>& batch, Math::Span<uint32_t> mask) { Math::CullAABBs(frustum, batch, mask); },
+		[&](size_t i) { return frustum.IntersectsAABB({ boxes.minX[i], boxes.minY[i], boxes.minZ[i] }, { boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i] }); });
+
+	std::vector<uint32_t> mask(Math::GetVisibilityMaskLength(objectCount));
+	const Math::Span<uint32_t> maskSpan(mask.data(), mask.size());
+	const auto sphereBatch = spheres.GetBatch(0, objectCount);
+	const auto boxBatch = boxes.GetBatch(0, objectCount);
+	std::vector<uint8_t> visible(objectCount);
+
+	ReportSpeed("spheres",
+		Measure([&]()
+		{
+			for (size_t i = 0; i < objectCount; i++)
+				visible[i] = frustum.IntersectsSphere({ spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i] }, spheres.radius[i]);
+		}),
+		Measure([&]() { Math::CullSpheres(frustum, sphereBatch, maskSpan); }),
+		Measure([&]() { Math::CullSpheres_Parallel(frustum, sphereBatch, maskSpan); }));
+	ReportSpeed("AABBs",
+		Measure([&]()
+		{
+			for (size_t i = 0; i < objectCount; i++)
+				visible[i] = frustum.IntersectsAABB({ boxes.minX[i], boxes.minY[i], boxes.minZ[i] }, { boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i] });
+		}),
+		Measure([&]() { Math::CullAABBs(frustum, boxBatch, maskSpan); }),
+		Measure([&]() { Math::CullAABBs_Parallel(frustum, boxBatch, maskSpan); }));
+
+	if (mismatchCount != 0)
+		return 1;
+}
\ No newline at end of file
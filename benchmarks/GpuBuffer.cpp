@@ -0,0 +1,103 @@
+#include "DMath/GpuBuffer.hpp"
+#include "DMath/Memory.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Larger than the last level cache, as a frame's worth of instance data would be.
+	constexpr size_t elementCount = size_t(1) << 20;
+	constexpr size_t repeatCount = 16;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	template<typename Func>
+	double Measure(Func&& func)
+	{
+		func();
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+			func();
+		return SecondsSince(start) / repeatCount;
+	}
+
+	// Element by element with ordinary stores, padding zeroed up front, as buffers are filled without PackBuffer.
+	template<Math::BufferLayout layout, typename T, typename Place>
+	void PackByHand(const std::vector<T>& elements, std::byte* destination, Place&& place)
+	{
+		constexpr size_t stride = Math::GetBufferStride<T>(layout);
+		for (size_t i = 0; i < elements.size(); i++)
+		{
+			std::byte* target = destination + i * stride;
+			std::memset(target, 0, stride);
+			place(elements[i], target);
+		}
+	}
+
+	template<Math::BufferLayout layout, typename T, typename Place>
+	void Report(const char* name, const std::vector<T>& elements, Place&& place)
+	{
+		constexpr size_t stride = Math::GetBufferStride<T>(layout);
+		const size_t byteCount = elements.size() * stride;
+		auto* buffer = static_cast<std::byte*>(::operator new(byteCount, std::align_val_t(Math::Setup::allocationAlignment)));
+
+		const double handSeconds = Measure([&]() { PackByHand<layout>(elements, buffer, place); });
+		std::vector<std::byte> expected(buffer, buffer + byteCount);
+		const double packSeconds = Measure([&]() { Math::PackBuffer<layout>(Math::Span<const T>(elements), buffer); });
+		const bool isSame = std::memcmp(expected.data(), buffer, byteCount) == 0;
+
+		std::printf("  %-26s %3zu B stride, by hand %7.3f ms, PackBuffer %7.3f ms (%5.2fx, %5.2f GB/s)%s\n", name, stride, handSeconds * 1e3, packSeconds * 1e3,
+			handSeconds / packSeconds, double(byteCount) / packSeconds * 1e-9, isSame ? "" : "  MISMATCH");
+		::operator delete(buffer, std::align_val_t(Math::Setup::allocationAlignment));
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<float> value(-1.f, 1.f);
+	std::vector<Math::Vector3D> points(elementCount);
+	for (auto& point : points)
+		point = { value(rng), value(rng), value(rng) };
+	std::vector<Math::Matrix3x3> normalMatrices(elementCount);
+	for (auto& matrix : normalMatrices)
+	{
+		for (size_t i = 0; i < 9; i++)
+			matrix.At(i) = value(rng);
+	}
+	std::vector<Math::Matrix4x4> transforms(elementCount);
+	for (auto& transform : transforms)
+	{
+		for (size_t i = 0; i < 16; i++)
+			transform.At(i) = value(rng);
+	}
+
+	std::printf("%zu elements\n", elementCount);
+	Report<Math::BufferLayout::Std140>("Vector3D std140", points, [](const Math::Vector3D& point, std::byte* target)
+	{
+		std::memcpy(target, &point, sizeof(point));
+	});
+	Report<Math::BufferLayout::Std140>("Matrix3x3 std140", normalMatrices, [](const Math::Matrix3x3& matrix, std::byte* target)
+	{
+		for (size_t x = 0; x < 3; x++)
+			std::memcpy(target + x * 16, matrix[x], 3 * sizeof(float));
+	});
+	Report<Math::BufferLayout::Rows3x4>("Matrix4x4 Rows3x4", transforms, [](const Math::Matrix4x4& transform, std::byte* target)
+	{
+		const Math::Matrix<4, 4> rows = transform.GetTransposed();
+		std::memcpy(target, rows.GetData(), 12 * sizeof(float));
+	});
+	Report<Math::BufferLayout::Std430>("Matrix4x4 std430", transforms, [](const Math::Matrix4x4& transform, std::byte* target)
+	{
+		std::memcpy(target, transform.GetData(), sizeof(transform));
+	});
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "DMath/KdTree.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t pointCount = size_t(1) << 18;
+	constexpr size_t queryCount = size_t(1) << 14;
+	constexpr size_t bruteForceQueryCount = 256;
+	constexpr size_t k = 8;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	template<size_t length>
+	std::vector<Math::Vector<length, float>> MakePoints(size_t count, unsigned seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> coordinate(-1.f, 1.f);
+		std::vector<Math::Vector<length, float>> points(count);
+		for (auto& point : points)
+		{
+			for (size_t i = 0; i < length; i++)
+				point[i] = coordinate(rng);
+		}
+		return points;
+	}
+
+	template<size_t length>
+	void Run()
+	{
+		using Tree = Math::KdTree<length, float>;
+		const auto points = MakePoints<length>(pointCount, 1);
+		const auto queries = MakePoints<length>(queryCount, 2);
+
+		auto start = Clock::now();
+		const Tree tree = Tree::Build(points);
+		const double buildSeconds = SecondsSince(start);
+		start = Clock::now();
+		const Tree parallelTree = Tree::Build_Parallel(points);
+		const double parallelBuildSeconds = SecondsSince(start);
+
+		std::vector<typename Tree::Neighbor> neighbors(queryCount * k);
+		std::vector<uint32_t> counts(queryCount);
+		start = Clock::now();
+		tree.FindNearest(queries, k, neighbors, counts);
+		const double querySeconds = SecondsSince(start);
+		start = Clock::now();
+		parallelTree.FindNearest_Parallel(queries, k, neighbors, counts);
+		const double parallelQuerySeconds = SecondsSince(start);
+
+		// Brute force keeps the k best in the same bounded heap, on a subset of the queries.
+		size_t mismatchCount = 0;
+		std::vector<typename Tree::Neighbor> bruteForce(k);
+		start = Clock::now();
+		for (size_t q = 0; q < bruteForceQueryCount; q++)
+		{
+			Math::detail::KdTree::BoundedNeighborHeap<typename Tree::Neighbor> heap(bruteForce);
+			float bound = std::numeric_limits<float>::max();
+			for (size_t i = 0; i < points.size(); i++)
+			{
+				const float distanceSqrd = Math::detail::KdTree::GetDistanceSqrd(queries[q], points[i]);
+				if (distanceSqrd <= bound)
+					bound = heap.Push(uint32_t(i), distanceSqrd, std::numeric_limits<float>::max());
+			}
+			heap.Finish();
+			for (size_t i = 0; i < k; i++)
+				mismatchCount += bruteForce[i].distanceSqrd != neighbors[q * k + i].distanceSqrd;
+		}
+		const double bruteForceSeconds = SecondsSince(start) / bruteForceQueryCount * queryCount;
+
+		// Radius of the average k-th neighbor, so every dimension finds about k points.
+		double meanKthDistance = 0.0;
+		for (size_t q = 0; q < queryCount; q++)
+			meanKthDistance += std::sqrt(double(neighbors[q * k + k - 1].distanceSqrd));
+		const auto radius = float(meanKthDistance / queryCount);
+		std::vector<typename Tree::Neighbor> inRadius;
+		start = Clock::now();
+		for (size_t q = 0; q < queryCount; q++)
+			tree.FindInRadius(queries[q], radius, inRadius);
+		const double radiusSeconds = SecondsSince(start);
+
+		std::printf("%zuD, %zu points, %zu queries, k = %zu, %zu threads\n", length, pointCount, queryCount, k, Math::GetParallelThreadCount());
+		std::printf("  build:       %8.2f ms, parallel %8.2f ms\n", buildSeconds * 1e3, parallelBuildSeconds * 1e3);
+		std::printf("  kNN:         %8.2f ms (%7.2f Mqueries/s), parallel %8.2f ms (%7.2f Mqueries/s)\n", querySeconds * 1e3, queryCount / querySeconds * 1e-6, parallelQuerySeconds * 1e3, queryCount / parallelQuerySeconds * 1e-6);
+		std::printf("  brute force: %8.2f ms (estimated from %zu queries, %zu mismatches), %.0fx slower\n", bruteForceSeconds * 1e3, bruteForceQueryCount, mismatchCount, bruteForceSeconds / querySeconds);
+		std::printf("  radius %.3f: %8.2f ms, %.2f neighbors per query\n", radius, radiusSeconds * 1e3, double(inRadius.size()) / queryCount);
+	}
+}
+
+int main()
+{
+	Run<2>();
+	Run<3>();
+	Run<6>();
+}
\ No newline at end of file
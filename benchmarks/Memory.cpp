@@ -0,0 +1,93 @@
+#include "DMath/Morton.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t elementCount = size_t(1) << 16;
+	constexpr size_t repeatCount = 256;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	template<typename Func>
+	double Measure(Func&& func)
+	{
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+			func();
+		return SecondsSince(start) / repeatCount;
+	}
+
+	void ReportAllocations(const char* operation, const Math::AllocationStats& stats)
+	{
+		std::printf("  %-16s %3zu allocations, peak %8zu bytes, reserved %8zu bytes\n", operation, stats.allocationCount, stats.peakBytes, stats.reservedBytes);
+	}
+
+	// Sorting restores the order, so every repeat starts from the same keys.
+	template<typename Func>
+	double MeasureSort(const std::vector<uint32_t>& keys, Func&& sort)
+	{
+		std::vector<uint32_t> sortedKeys(keys.size());
+		std::vector<uint32_t> values(keys.size());
+		return Measure([&]()
+		{
+			sortedKeys = keys;
+			sort(Math::Span<uint32_t>(sortedKeys), Math::Span<uint32_t>(values));
+		});
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<float> coordinate(-100.f, 100.f);
+	std::vector<uint32_t> keys(elementCount);
+	for (auto& key : keys)
+		key = rng();
+	std::vector<Math::Vector3D> points(elementCount);
+	for (auto& point : points)
+		point = { coordinate(rng), coordinate(rng), coordinate(rng) };
+
+	Math::Arena& workspace = Math::GetThreadArena();
+	std::printf("allocations per operation\n");
+	Math::SetAllocationHook(ReportAllocations);
+	std::vector<uint32_t> sortedKeys = keys;
+	Math::RadixSort(Math::Span<uint32_t>(sortedKeys), workspace);
+	(void)Math::GetMortonOrder<float>(points, workspace);
+	Math::SetAllocationHook(nullptr);
+
+	std::printf("%zu elements, heap scratch against a reused arena\n", elementCount);
+	const double heapSortSeconds = MeasureSort(keys, [](auto keys, auto values) { Math::RadixSort(keys, values); });
+	const double arenaSortSeconds = MeasureSort(keys, [&](auto keys, auto values) { Math::RadixSort(keys, values, workspace); });
+	std::printf("  RadixSort       heap %7.3f ms, arena %7.3f ms (%5.2fx)\n", heapSortSeconds * 1e3, arenaSortSeconds * 1e3, heapSortSeconds / arenaSortSeconds);
+	const double heapOrderSeconds = Measure([&]() { (void)Math::GetMortonOrder<float>(points); });
+	const double arenaOrderSeconds = Measure([&]() { (void)Math::GetMortonOrder<float>(points, workspace); });
+	std::printf("  GetMortonOrder  heap %7.3f ms, arena %7.3f ms (%5.2fx)\n", heapOrderSeconds * 1e3, arenaOrderSeconds * 1e3, heapOrderSeconds / arenaOrderSeconds);
+
+	// Fixed size nodes, as in a tree built and torn down repeatedly.
+	Math::Pool pool(sizeof(Math::Vector3D) * 4);
+	std::vector<void*> nodes(elementCount);
+	const double heapNodeSeconds = Measure([&]()
+	{
+		for (auto& node : nodes)
+			node = ::operator new(pool.GetElementSize(), std::align_val_t(Math::Setup::allocationAlignment));
+		for (auto node : nodes)
+			::operator delete(node, std::align_val_t(Math::Setup::allocationAlignment));
+	});
+	const double poolNodeSeconds = Measure([&]()
+	{
+		for (auto& node : nodes)
+			node = pool.Allocate();
+		for (auto node : nodes)
+			pool.Deallocate(node);
+	});
+	std::printf("  %zu-byte nodes   heap %7.3f ms, pool  %7.3f ms (%5.2fx)\n", pool.GetElementSize(), heapNodeSeconds * 1e3, poolNodeSeconds * 1e3, heapNodeSeconds / poolNodeSeconds);
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "DMath/BVH.hpp"
+#include "DMath/Morton.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t gridSize = 96;
+	constexpr size_t neighborCount = 6;
+	constexpr size_t passCount = 8;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	// Direct-mapped cache of 64-byte lines. A rough stand-in for hardware counters,
+	// only meant to compare how many lines the same pass pulls in under different orderings.
+	class CacheModel
+	{
+	public:
+		explicit CacheModel(size_t capacityBytes) :
+			lines(capacityBytes / 64, ~uintptr_t(0))
+		{
+		}
+
+		void Access(const void* address)
+		{
+			const auto line = reinterpret_cast<uintptr_t>(address) / 64;
+			const size_t set = size_t(line) % lines.size();
+			if (lines[set] != line)
+			{
+				lines[set] = line;
+				misses++;
+			}
+		}
+
+		size_t misses = 0;
+
+	private:
+		std::vector<uintptr_t> lines;
+	};
+
+	struct Particles
+	{
+		std::vector<Math::Vector3D> positions;
+		// neighborCount entries per particle.
+		std::vector<uint32_t> neighbors;
+	};
+
+	// Jittered lattice in random order, each particle linked to its six lattice neighbors.
+	Particles MakeShuffledParticles()
+	{
+		const size_t count = gridSize * gridSize * gridSize;
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> jitter(-0.25f, 0.25f);
+
+		std::vector<uint32_t> shuffled(count);
+		for (size_t i = 0; i < count; i++)
+			shuffled[i] = uint32_t(i);
+		std::shuffle(shuffled.begin(), shuffled.end(), rng);
+
+		const auto getLatticeIndex = [](size_t x, size_t y, size_t z) { return (z * gridSize + y) * gridSize + x; };
+		Particles particles;
+		particles.positions.resize(count);
+		particles.neighbors.resize(count * neighborCount);
+		for (size_t z = 0; z < gridSize; z++)
+		{
+			for (size_t y = 0; y < gridSize; y++)
+			{
+				for (size_t x = 0; x < gridSize; x++)
+				{
+					const uint32_t index = shuffled[getLatticeIndex(x, y, z)];
+					particles.positions[index] = Math::Vector3D{ float(x) + jitter(rng), float(y) + jitter(rng), float(z) + jitter(rng) };
+
+					const size_t neighborLattice[neighborCount] =
+					{
+						getLatticeIndex((x + 1) % gridSize, y, z),
+						getLatticeIndex((x + gridSize - 1) % gridSize, y, z),
+						getLatticeIndex(x, (y + 1) % gridSize, z),
+						getLatticeIndex(x, (y + gridSize - 1) % gridSize, z),
+						getLatticeIndex(x, y, (z + 1) % gridSize),
+						getLatticeIndex(x, y, (z + gridSize - 1) % gridSize)
+					};
+					for (size_t i = 0; i < neighborCount; i++)
+						particles.neighbors[index * neighborCount + i] = shuffled[neighborLattice[i]];
+				}
+			}
+		}
+		return particles;
+	}
+
+	Particles SortParticles(const Particles& particles, const std::vector<uint32_t>& order)
+	{
+		const size_t count = particles.positions.size();
+		std::vector<uint32_t> newIndices(count);
+		for (size_t i = 0; i < count; i++)
+			newIndices[order[i]] = uint32_t(i);
+
+		Particles sorted;
+		sorted.positions.resize(count);
+		Math::ApplyPermutation_Parallel<Math::Vector3D>(order, particles.positions, sorted.positions);
+		sorted.neighbors.resize(particles.neighbors.size());
+		for (size_t i = 0; i < count; i++)
+		{
+			for (size_t j = 0; j < neighborCount; j++)
+				sorted.neighbors[i * neighborCount + j] = newIndices[particles.neighbors[order[i] * neighborCount + j]];
+		}
+		return sorted;
+	}
+
+	// Smoothing-style pass reading every particle's neighbors.
+	float NeighborPass(const Particles& particles, std::vector<Math::Vector3D>& output)
+	{
+		float checksum = 0.f;
+		for (size_t i = 0; i < particles.positions.size(); i++)
+		{
+			Math::Vector3D sum = particles.positions[i];
+			for (size_t j = 0; j < neighborCount; j++)
+				sum += particles.positions[particles.neighbors[i * neighborCount + j]];
+			output[i] = sum * (1.f / float(neighborCount + 1));
+			checksum += output[i].x;
+		}
+		return checksum;
+	}
+
+	size_t CountNeighborMisses(const Particles& particles, size_t cacheBytes)
+	{
+		CacheModel cache(cacheBytes);
+		for (size_t i = 0; i < particles.positions.size(); i++)
+		{
+			cache.Access(&particles.positions[i]);
+			for (size_t j = 0; j < neighborCount; j++)
+				cache.Access(&particles.positions[particles.neighbors[i * neighborCount + j]]);
+		}
+		return cache.misses;
+	}
+
+	void ReportNeighborPass(const char* name, const Particles& particles)
+	{
+		std::vector<Math::Vector3D> output(particles.positions.size());
+		float checksum = 0.f;
+		const auto start = Clock::now();
+		for (size_t pass = 0; pass < passCount; pass++)
+			checksum += NeighborPass(particles, output);
+		const double seconds = SecondsSince(start) / passCount;
+
+		const size_t l1Misses = CountNeighborMisses(particles, 32 * 1024);
+		const size_t l2Misses = CountNeighborMisses(particles, 1024 * 1024);
+		std::printf("  %-10s %8.2f ms/pass, modelled misses 32 KiB: %9zu, 1 MiB: %9zu (checksum %.1f)\n", name, seconds * 1e3, l1Misses, l2Misses, checksum);
+	}
+}
+
+int main()
+{
+	const Particles shuffled = MakeShuffledParticles();
+	const size_t count = shuffled.positions.size();
+	std::printf("%zu particles\n", count);
+
+	{
+		const Math::AABB3D<float> bounds = Math::ComputeBounds<float>(shuffled.positions);
+		std::vector<uint32_t> codes30(count);
+		std::vector<uint64_t> codes63(count);
+
+		auto start = Clock::now();
+		Math::ComputeMortonCodes30<float>(shuffled.positions, bounds, codes30);
+		const double encode30Seconds = SecondsSince(start);
+		start = Clock::now();
+		Math::ComputeMortonCodes63<float>(shuffled.positions, bounds, codes63);
+		const double encode63Seconds = SecondsSince(start);
+
+		std::vector<uint32_t> payload(count);
+		start = Clock::now();
+		Math::RadixSort(Math::Span<uint64_t>(codes63), Math::Span<uint32_t>(payload));
+		const double sortSeconds = SecondsSince(start);
+		Math::ComputeMortonCodes63<float>(shuffled.positions, bounds, codes63);
+		start = Clock::now();
+		Math::RadixSort_Parallel(Math::Span<uint64_t>(codes63), Math::Span<uint32_t>(payload));
+		const double parallelSortSeconds = SecondsSince(start);
+
+		std::printf("  encode 30-bit %.2f ms, 63-bit %.2f ms\n", encode30Seconds * 1e3, encode63Seconds * 1e3);
+		std::printf("  radix sort 64-bit keys + payload %.2f ms (parallel %.2f ms, %zu threads)\n", sortSeconds * 1e3, parallelSortSeconds * 1e3, Math::GetParallelThreadCount());
+	}
+
+	const auto start = Clock::now();
+	const std::vector<uint32_t> order = Math::GetMortonOrder_Parallel<float>(shuffled.positions);
+	const double orderSeconds = SecondsSince(start);
+	const Particles sorted = SortParticles(shuffled, order);
+	std::printf("  Morton order %.2f ms\n", orderSeconds * 1e3);
+
+	std::printf("Neighbor pass\n");
+	ReportNeighborPass("shuffled", shuffled);
+	ReportNeighborPass("Morton", sorted);
+
+	std::printf("BVH build over particle bounds\n");
+	std::vector<Math::AABB3D<float>> bounds(count);
+	for (size_t i = 0; i < count; i++)
+		bounds[i] = Math::AABB3D<float>::FromCenterExtents(shuffled.positions[i], Math::Vector3D{ 0.5f, 0.5f, 0.5f });
+	for (const auto method : { Math::BVHBuildMethod::BinnedSAH, Math::BVHBuildMethod::Linear })
+	{
+		Math::BVH4<float>::BuildSettings settings;
+		settings.method = method;
+		const auto buildStart = Clock::now();
+		const auto bvh = Math::BVH4<float>::Build(bounds, settings);
+		std::printf("  %-10s %8.2f ms, %zu nodes\n", method == Math::BVHBuildMethod::Linear ? "linear" : "binned SAH", SecondsSince(buildStart) * 1e3, bvh.GetNodes().size());
+	}
+}
\ No newline at end of file
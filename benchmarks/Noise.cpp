@@ -0,0 +1,118 @@
+#include "DMath/Noise.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t pointCount = size_t(1) << 20;
+	constexpr size_t repeatCount = 16;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	template<typename Func>
+	double Measure(Func&& func)
+	{
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+			func();
+		return SecondsSince(start) / repeatCount;
+	}
+
+	std::vector<float> GetValues(uint32_t seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> value(-1000.f, 1000.f);
+		std::vector<float> values(pointCount);
+		for (auto& element : values)
+			element = value(rng);
+		return values;
+	}
+
+	bool IsBitwiseEqual(float a, float b)
+	{
+		return std::memcmp(&a, &b, sizeof(float)) == 0;
+	}
+
+	// Returns the number of scalar and batch results that differ.
+	template<Math::NoiseType type, size_t length>
+	size_t Run(const char* name, const std::vector<float> (&coordinates)[length])
+	{
+		Math::Span<const float> positions[length];
+		std::vector<float> derivativeValues[length];
+		Math::Span<float> derivatives[length];
+		for (size_t axis = 0; axis < length; axis++)
+		{
+			positions[axis] = coordinates[axis];
+			derivativeValues[axis].resize(pointCount);
+			derivatives[axis] = derivativeValues[axis];
+		}
+		const auto getPosition = [&](size_t i)
+		{
+			Math::Vector<length, float> position;
+			for (size_t axis = 0; axis < length; axis++)
+				position[axis] = coordinates[axis][i];
+			return position;
+		};
+		std::vector<float> output(pointCount);
+		const Math::FractalNoiseSettings<float> settings;
+
+		// Batch results against the single position versions, values and derivatives.
+		Math::Noise<type>(positions, output, derivatives);
+		size_t mismatchCount = 0;
+		float maxValue = 0.f;
+		for (size_t i = 0; i < pointCount; i++)
+		{
+			Math::Vector<length, float> derivative;
+			const float value = Math::Noise<type>(getPosition(i), derivative);
+			mismatchCount += !IsBitwiseEqual(value, output[i]);
+			for (size_t axis = 0; axis < length; axis++)
+				mismatchCount += !IsBitwiseEqual(derivative[axis], derivativeValues[axis][i]);
+			maxValue = std::max(maxValue, std::abs(value));
+		}
+		Math::FractalNoise<type>(positions, settings, output);
+		for (size_t i = 0; i < pointCount; i++)
+			mismatchCount += !IsBitwiseEqual(Math::FractalNoise<type>(getPosition(i), settings), output[i]);
+		std::printf("%s: %zu mismatches between scalar and batch, max |noise| %.4f\n", name, mismatchCount, maxValue);
+
+		const double scalarSeconds = Measure([&]()
+		{
+			for (size_t i = 0; i < pointCount; i++)
+				output[i] = Math::Noise<type>(getPosition(i));
+		});
+		const double batchSeconds = Measure([&]() { Math::Noise<type>(positions, output); });
+		const double parallelSeconds = Measure([&]() { Math::Noise_Parallel<type>(positions, output); });
+		const double derivativeSeconds = Measure([&]() { Math::Noise<type>(positions, output, derivatives); });
+		const double fractalSeconds = Measure([&]() { Math::FractalNoise<type>(positions, settings, output); });
+		std::printf("  scalar %7.3f ms, batch %7.3f ms (%5.1fx), parallel %7.3f ms (%5.1fx), batch with derivatives %7.3f ms, %zu octaves %7.3f ms\n",
+			scalarSeconds * 1e3, batchSeconds * 1e3, scalarSeconds / batchSeconds, parallelSeconds * 1e3, scalarSeconds / parallelSeconds,
+			derivativeSeconds * 1e3, settings.octaveCount, fractalSeconds * 1e3);
+		return mismatchCount;
+	}
+}
+
+int main()
+{
+	const std::vector<float> coordinates2[2] = { GetValues(1), GetValues(2) };
+	const std::vector<float> coordinates3[3] = { GetValues(1), GetValues(2), GetValues(3) };
+
+	std::printf("%zu points, %zu float lanes, %zu threads\n", pointCount, Math::detail::Simd::floatLaneCount, Math::GetParallelThreadCount());
+	size_t mismatchCount = 0;
+	mismatchCount += Run<Math::NoiseType::Perlin>("Perlin 2D", coordinates2);
+	mismatchCount += Run<Math::NoiseType::Perlin>("Perlin 3D", coordinates3);
+	mismatchCount += Run<Math::NoiseType::Simplex>("Simplex 2D", coordinates2);
+	mismatchCount += Run<Math::NoiseType::Simplex>("Simplex 3D", coordinates3);
+	// Scalar and batch noise must match bit for bit, whatever the instruction set and contraction flags.
+	if (mismatchCount != 0)
+		return 1;
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "DMath/VectorBatch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t vectorCount = size_t(1) << 20;
+	constexpr size_t repeatCount = 16;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	// Distance in representable floats, sign changes included.
+	int64_t GetUlpDistance(float a, float b)
+	{
+		const auto toOrdered = [](float value)
+		{
+			int32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits < 0 ? int64_t(INT32_MIN) - bits : int64_t(bits);
+		};
+		const int64_t distance = toOrdered(a) - toOrdered(b);
+		return distance < 0 ? -distance : distance;
+	}
+
+	struct Error
+	{
+		int64_t maxUlp = 0;
+		double maxLengthError = 0.0;
+	};
+
+	// Component errors against a double precision normalization, and how far the result is from unit length.
+	void Accumulate(Error& error, const Math::Vector3D& value, const Math::Vector3D& input)
+	{
+		const double magnitude = std::sqrt(double(input.x) * input.x + double(input.y) * input.y + double(input.z) * input.z);
+		for (size_t i = 0; i < 3; i++)
+			error.maxUlp = std::max(error.maxUlp, GetUlpDistance(value[i], float(input[i] / magnitude)));
+		const double length = std::sqrt(double(value.x) * value.x + double(value.y) * value.y + double(value.z) * value.z);
+		error.maxLengthError = std::max(error.maxLengthError, std::abs(length - 1.0));
+	}
+
+	void ReportAccuracy(const std::vector<Math::Vector3D>& vectors)
+	{
+		std::vector<Math::Vector3D> full(vectors.size());
+		std::vector<Math::Vector3D> fast(vectors.size());
+		Math::NormalizeVectors<3, float, Math::NormalizePrecision::Full>(vectors, full);
+		Math::NormalizeVectors<3, float, Math::NormalizePrecision::Fast>(vectors, fast);
+
+		Error scalarFullError, scalarFastError, batchFullError, batchFastError;
+		size_t fullMismatchCount = 0;
+		int64_t fastBatchUlp = 0;
+		int64_t rsqrtUlp = 0;
+		for (size_t i = 0; i < vectors.size(); i++)
+		{
+			const Math::Vector3D scalarFull = vectors[i].GetNormalized();
+			const Math::Vector3D scalarFast = vectors[i].GetNormalized_Fast();
+			Accumulate(scalarFullError, scalarFull, vectors[i]);
+			Accumulate(scalarFastError, scalarFast, vectors[i]);
+			Accumulate(batchFullError, full[i], vectors[i]);
+			Accumulate(batchFastError, fast[i], vectors[i]);
+			fullMismatchCount += scalarFull != full[i];
+			for (size_t component = 0; component < 3; component++)
+				fastBatchUlp = std::max(fastBatchUlp, GetUlpDistance(scalarFast[component], fast[i][component]));
+
+			const float magnitudeSqrd = vectors[i].MagnitudeSqrd();
+			rsqrtUlp = std::max(rsqrtUlp, GetUlpDistance(Math::RSqrt(magnitudeSqrd), float(1.0 / std::sqrt(double(magnitudeSqrd)))));
+		}
+
+		const auto report = [](const char* name, const Error& error)
+		{
+			std::printf("  %-20s %3lld ulp, unit length error %.2e\n", name, (long long)error.maxUlp, error.maxLengthError);
+		};
+		std::printf("accuracy over %zu vectors, RSqrt within %lld ulp\n", vectors.size(), (long long)rsqrtUlp);
+		report("GetNormalized", scalarFullError);
+		report("GetNormalized_Fast", scalarFastError);
+		report("batch full", batchFullError);
+		report("batch fast", batchFastError);
+		std::printf("  batch full differs from GetNormalized for %zu vectors, batch fast from GetNormalized_Fast by up to %lld ulp\n",
+			fullMismatchCount, (long long)fastBatchUlp);
+	}
+
+	template<typename Func>
+	double Measure(Func&& func)
+	{
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+			func();
+		return SecondsSince(start) / repeatCount;
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<float> component(-1000.f, 1000.f);
+	std::vector<Math::Vector3D> vectors(vectorCount);
+	for (auto& vector : vectors)
+	{
+		do
+			vector = { component(rng), component(rng), component(rng) };
+		while (vector.MagnitudeSqrd() == 0.f);
+	}
+	// Tiny and huge magnitudes.
+	for (size_t i = 0; i < 4096; i++)
+		vectors[i] *= std::ldexp(1.f, int(i % 80) - 60);
+
+	ReportAccuracy(vectors);
+
+	std::vector<Math::Vector3D> output(vectorCount);
+	const double scalarFullSeconds = Measure([&]()
+	{
+		for (size_t i = 0; i < vectorCount; i++)
+			output[i] = vectors[i].GetNormalized();
+	});
+	const double scalarFastSeconds = Measure([&]()
+	{
+		for (size_t i = 0; i < vectorCount; i++)
+			output[i] = vectors[i].GetNormalized_Fast();
+	});
+	const double batchFullSeconds = Measure([&]() { Math::NormalizeVectors<3, float, Math::NormalizePrecision::Full>(vectors, output); });
+	const double batchFastSeconds = Measure([&]() { Math::NormalizeVectors<3, float, Math::NormalizePrecision::Fast>(vectors, output); });
+	const double parallelSeconds = Measure([&]() { Math::NormalizeVectors_Parallel<3, float, Math::NormalizePrecision::Fast>(vectors, output); });
+
+	const auto report = [](const char* name, double seconds, double baseline)
+	{
+		std::printf("  %-22s %8.3f ms (%7.1f M/s, %5.1fx)\n", name, seconds * 1e3, vectorCount / seconds * 1e-6, baseline / seconds);
+	};
+	std::printf("normalizing %zu Vector3D, %zu float lanes, %zu threads\n", vectorCount, Math::detail::Simd::floatLaneCount, Math::GetParallelThreadCount());
+	report("GetNormalized", scalarFullSeconds, scalarFullSeconds);
+	report("GetNormalized_Fast", scalarFastSeconds, scalarFullSeconds);
+	report("batch full", batchFullSeconds, scalarFullSeconds);
+	report("batch fast", batchFastSeconds, scalarFullSeconds);
+	report("parallel fast", parallelSeconds, scalarFullSeconds);
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "DMath/Parallel.hpp"
+#include "DMath/Noise.hpp"
+#include "DMath/VectorBatch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t elementCount = size_t(1) << 20;
+	constexpr size_t repeatCount = 16;
+	constexpr size_t dispatchRepeatCount = 1024;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	template<typename Func>
+	double Measure(size_t count, Func&& func)
+	{
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < count; repeat++)
+			func();
+		return SecondsSince(start) / count;
+	}
+
+	// ParallelFor as it was before the thread pool, with threads started on every call.
+	template<typename Func>
+	void SpawningParallelFor(size_t threadCount, size_t begin, size_t end, size_t grainSize, Func&& func)
+	{
+		const size_t chunkCount = (end - begin + grainSize - 1) / grainSize;
+		threadCount = std::min(threadCount, chunkCount);
+		std::atomic<size_t> nextChunk{ 0 };
+		auto worker = [&]()
+		{
+			for (size_t chunk = nextChunk.fetch_add(1); chunk < chunkCount; chunk = nextChunk.fetch_add(1))
+			{
+				const size_t chunkBegin = begin + chunk * grainSize;
+				func(chunkBegin, std::min(chunkBegin + grainSize, end));
+			}
+		};
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i + 1 < threadCount; i++)
+			threads.emplace_back(worker);
+		worker();
+		for (auto& thread : threads)
+			thread.join();
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<float> coordinate(-100.f, 100.f);
+	std::vector<float> coordinates[3];
+	for (auto& axis : coordinates)
+	{
+		axis.resize(elementCount);
+		for (auto& value : axis)
+			value = coordinate(rng);
+	}
+	const Math::Span<const float> positions[3] = { coordinates[0], coordinates[1], coordinates[2] };
+	std::vector<Math::Vector3D> vectors(elementCount);
+	for (size_t i = 0; i < elementCount; i++)
+		vectors[i] = { coordinates[0][i], coordinates[1][i], coordinates[2][i] };
+	std::vector<float> noise(elementCount);
+	std::vector<Math::Vector3D> normalized(elementCount);
+	const Math::FractalNoiseSettings<float> settings;
+	std::atomic<size_t> chunkCount{ 0 };
+
+	std::printf("%zu elements, %u hardware threads\n", elementCount, std::thread::hardware_concurrency());
+	std::printf("  threads  FractalNoise 3D        NormalizeVectors      64 empty chunks  spawning threads\n");
+	double noiseReference = 0.0;
+	double normalizeReference = 0.0;
+	for (size_t threadCount = 1; threadCount <= 64; threadCount *= 2)
+	{
+		Math::ThreadPool threadPool(threadCount);
+		Math::SetParallelExecutor(&threadPool);
+
+		const double noiseSeconds = Measure(repeatCount, [&]() { Math::FractalNoise_Parallel<Math::NoiseType::Simplex>(positions, settings, noise, 4096); });
+		const double normalizeSeconds = Measure(repeatCount, [&]() { Math::NormalizeVectors_Parallel<3, float>(vectors, normalized, 4096); });
+		const double dispatchSeconds = Measure(dispatchRepeatCount, [&]() { Math::ParallelFor(0, 64, 1, [&](size_t, size_t) { chunkCount.fetch_add(1, std::memory_order_relaxed); }); });
+		const double spawnSeconds = Measure(dispatchRepeatCount / 16, [&]() { SpawningParallelFor(threadCount, 0, 64, 1, [&](size_t, size_t) { chunkCount.fetch_add(1, std::memory_order_relaxed); }); });
+		if (threadCount == 1)
+		{
+			noiseReference = noiseSeconds;
+			normalizeReference = normalizeSeconds;
+		}
+		std::printf("  %7zu  %8.3f ms (%5.2fx)   %8.3f ms (%5.2fx)   %9.2f us     %9.2f us\n", threadCount,
+			noiseSeconds * 1e3, noiseReference / noiseSeconds, normalizeSeconds * 1e3, normalizeReference / normalizeSeconds, dispatchSeconds * 1e6, spawnSeconds * 1e6);
+	}
+	Math::SetParallelExecutor(nullptr);
+	std::printf("%zu chunks run\n", chunkCount.load());
+}
\ No newline at end of file
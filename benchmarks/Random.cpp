@@ -0,0 +1,121 @@
+#include "DMath/Random.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t sampleCount = size_t(1) << 20;
+	constexpr size_t repeatCount = 16;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	template<typename Func>
+	double Measure(Func&& func)
+	{
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+			func();
+		return SecondsSince(start) / repeatCount;
+	}
+
+	void Report(const char* name, double referenceSeconds, double seconds)
+	{
+		std::printf("  %-28s %7.3f ms (%5.1fx)\n", name, seconds * 1e3, referenceSeconds / seconds);
+	}
+
+	// Mean of the first and second moments, against their expected values for the distribution.
+	template<typename Vector>
+	void ReportMoments(const char* name, const std::vector<Vector>& points, size_t axis, double expectedMean, double expectedSquare)
+	{
+		double sum = 0.0;
+		double squareSum = 0.0;
+		for (const auto& point : points)
+		{
+			sum += point[axis];
+			squareSum += double(point[axis]) * point[axis];
+		}
+		std::printf("  %-20s mean %+.4f (%+.4f), mean square %.4f (%.4f)\n", name, sum / points.size(), expectedMean, squareSum / points.size(), expectedSquare);
+	}
+}
+
+int main()
+{
+	Math::RandomGenerator generator(1);
+	std::vector<float> values(sampleCount);
+	std::vector<Math::Vector3D> points(sampleCount);
+	std::vector<Math::Vector2D> diskPoints(sampleCount);
+	std::vector<Math::UnitQuaternion<float>> rotations(sampleCount);
+
+	std::printf("moments over %zu samples, expected in parentheses\n", sampleCount);
+	Math::SampleUnitSphere(generator, points);
+	ReportMoments("sphere z", points, 2, 0.0, 1.0 / 3.0);
+	Math::SampleUnitHemisphere(generator, points);
+	ReportMoments("hemisphere z", points, 2, 0.5, 1.0 / 3.0);
+	Math::SampleCosineHemisphere(generator, points);
+	ReportMoments("cosine hemisphere z", points, 2, 2.0 / 3.0, 0.5);
+	Math::SampleUnitBall(generator, points);
+	ReportMoments("ball x", points, 0, 0.0, 0.2);
+	Math::SampleUnitDisk(generator, diskPoints);
+	ReportMoments("disk x", diskPoints, 0, 0.0, 0.25);
+	Math::SampleRotations(generator, rotations);
+	ReportMoments("rotation s", rotations, 0, 0.0, 0.25);
+
+	std::printf("%zu samples, %zu float lanes\n", sampleCount, Math::detail::Simd::floatLaneCount);
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> uniform(0.f, 1.f);
+	const double referenceUniformSeconds = Measure([&]()
+	{
+		for (auto& value : values)
+			value = uniform(engine);
+	});
+	Math::Xoshiro128Plus xoshiro(1);
+	const double xoshiroSeconds = Measure([&]()
+	{
+		for (auto& value : values)
+			value = xoshiro.NextFloat();
+	});
+	const double batchUniformSeconds = Measure([&]() { generator.FillUniform(values); });
+	std::printf("uniform floats\n");
+	Report("std::mt19937", referenceUniformSeconds, referenceUniformSeconds);
+	Report("Xoshiro128Plus", referenceUniformSeconds, xoshiroSeconds);
+	Report("RandomGenerator", referenceUniformSeconds, batchUniformSeconds);
+
+	const double referenceSphereSeconds = Measure([&]()
+	{
+		for (auto& point : points)
+		{
+			const float z = 1.f - 2.f * uniform(engine);
+			const float angle = 2.f * Math::pi * uniform(engine);
+			const float radius = std::sqrt(std::max(1.f - z * z, 0.f));
+			point = { radius * std::cos(angle), radius * std::sin(angle), z };
+		}
+	});
+	const double referenceRotationSeconds = Measure([&]()
+	{
+		for (auto& rotation : rotations)
+		{
+			const float u = uniform(engine);
+			const float angle1 = 2.f * Math::pi * uniform(engine);
+			const float angle2 = 2.f * Math::pi * uniform(engine);
+			const float radius1 = std::sqrt(1.f - u);
+			const float radius2 = std::sqrt(u);
+			rotation = Math::UnitQuaternion<float>::FromComponents(radius2 * std::cos(angle2), radius1 * std::sin(angle1), radius1 * std::cos(angle1), radius2 * std::sin(angle2));
+		}
+	});
+	std::printf("samplers against std::mt19937 and libm\n");
+	Report("SampleUnitSphere", referenceSphereSeconds, Measure([&]() { Math::SampleUnitSphere(generator, points); }));
+	Report("SampleUnitHemisphere", referenceSphereSeconds, Measure([&]() { Math::SampleUnitHemisphere(generator, points); }));
+	Report("SampleCosineHemisphere", referenceSphereSeconds, Measure([&]() { Math::SampleCosineHemisphere(generator, points); }));
+	Report("SampleUnitBall", referenceSphereSeconds, Measure([&]() { Math::SampleUnitBall(generator, points); }));
+	Report("SampleRotations", referenceRotationSeconds, Measure([&]() { Math::SampleRotations(generator, rotations); }));
+}
\ No newline at end of file
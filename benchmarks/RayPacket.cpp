@@ -0,0 +1,177 @@
+#include "DMath/RayPacket.hpp"
+
+#include <bitset>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t rayCount = 1024;
+	constexpr size_t triangleCount = 1024;
+	constexpr size_t repeatCount = 16;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	void Report(const char* name, double seconds, size_t checksum)
+	{
+		const double tests = double(rayCount) * triangleCount * repeatCount;
+		std::printf("  %-22s %8.1f M intersections/s (checksum %zu)\n", name, tests / seconds * 1e-6, checksum);
+	}
+
+	template<size_t Width>
+	void BenchmarkRayPackets(const std::vector<Math::Ray<float>>& rays, const std::vector<Math::Triangle<float>>& triangles)
+	{
+		std::vector<Math::RayPacket<Width>> packets;
+		for (size_t i = 0; i < rays.size(); i += Width)
+			packets.push_back(Math::RayPacket<Width>::FromRays(Math::Span<const Math::Ray<float>>(rays.data() + i, Width)));
+
+		size_t checksum = 0;
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+		{
+			for (auto packet : packets)
+			{
+				auto hit = Math::RayPacketHit<Width>::Miss();
+				for (size_t i = 0; i < triangles.size(); i++)
+					Math::IntersectRayPacketTriangle(packet, triangles[i], uint32_t(i), hit);
+				for (size_t lane = 0; lane < Width; lane++)
+					checksum += hit.IsHit(lane);
+			}
+		}
+		char name[32];
+		std::snprintf(name, sizeof(name), "%zu rays x 1 triangle", Width);
+		Report(name, SecondsSince(start), checksum);
+	}
+
+	template<size_t Width>
+	void BenchmarkBoxPackets(const std::vector<Math::Ray<float>>& rays, const std::vector<Math::AABB3D<float>>& boxes)
+	{
+		std::vector<Math::RayPacket<Width>> packets;
+		for (size_t i = 0; i < rays.size(); i += Width)
+			packets.push_back(Math::RayPacket<Width>::FromRays(Math::Span<const Math::Ray<float>>(rays.data() + i, Width)));
+
+		size_t checksum = 0;
+		alignas(64) float entry[Width];
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+		{
+			for (const auto& packet : packets)
+			{
+				for (const auto& box : boxes)
+					checksum += std::bitset<32>(Math::IntersectRayPacketAABB(packet, box, entry)).count();
+			}
+		}
+		char name[32];
+		std::snprintf(name, sizeof(name), "%zu rays x 1 box", Width);
+		Report(name, SecondsSince(start), checksum);
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<float> position(-10.f, 10.f);
+	std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+	std::vector<Math::Triangle<float>> triangles(triangleCount);
+	std::vector<Math::AABB3D<float>> boxes(triangleCount);
+	for (size_t i = 0; i < triangleCount; i++)
+	{
+		const Math::Vector3D center{ position(rng), position(rng), position(rng) };
+		triangles[i] = Math::Triangle<float>
+		{
+			center + Math::Vector3D{ unit(rng), unit(rng), unit(rng) },
+			center + Math::Vector3D{ unit(rng), unit(rng), unit(rng) },
+			center + Math::Vector3D{ unit(rng), unit(rng), unit(rng) }
+		};
+		boxes[i] = triangles[i].GetAABB();
+	}
+
+	std::vector<Math::Ray<float>> rays(rayCount);
+	for (auto& ray : rays)
+	{
+		const Math::Vector3D origin{ position(rng), position(rng), position(rng) };
+		const Math::Vector3D target{ position(rng), position(rng), position(rng) };
+		ray = Math::Ray<float>{ origin, (target - origin).GetNormalized() };
+	}
+
+	std::printf("Ray-triangle\n");
+	{
+		size_t checksum = 0;
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+		{
+			for (const auto& ray : rays)
+			{
+				float tMax = std::numeric_limits<float>::max();
+				bool hit = false;
+				for (const auto& triangle : triangles)
+				{
+					if (const auto result = Math::IntersectRayTriangle(ray, triangle, 0.f, tMax))
+					{
+						tMax = result->distance;
+						hit = true;
+					}
+				}
+				checksum += hit;
+			}
+		}
+		Report("scalar", SecondsSince(start), checksum);
+	}
+	BenchmarkRayPackets<4>(rays, triangles);
+	BenchmarkRayPackets<8>(rays, triangles);
+	BenchmarkRayPackets<16>(rays, triangles);
+	{
+		std::vector<Math::TrianglePacket<8>> packets;
+		for (size_t i = 0; i < triangles.size(); i += 8)
+			packets.push_back(Math::TrianglePacket<8>::FromTriangles(Math::Span<const Math::Triangle<float>>(triangles.data() + i, 8), uint32_t(i)));
+
+		size_t checksum = 0;
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+		{
+			for (const auto& ray : rays)
+			{
+				float tMax = std::numeric_limits<float>::max();
+				bool hit = false;
+				for (const auto& packet : packets)
+				{
+					if (const auto result = Math::IntersectRayTrianglePacket(ray, packet, 0.f, tMax))
+					{
+						tMax = result->distance;
+						hit = true;
+					}
+				}
+				checksum += hit;
+			}
+		}
+		Report("1 ray x 8 triangles", SecondsSince(start), checksum);
+	}
+
+	std::printf("Ray-box\n");
+	{
+		size_t checksum = 0;
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+		{
+			for (const auto& ray : rays)
+			{
+				const Math::Vector3D inverseDirection = ray.GetInverseDirection();
+				for (const auto& box : boxes)
+					checksum += Math::IntersectRayAABB(ray, inverseDirection, box).has_value();
+			}
+		}
+		Report("scalar", SecondsSince(start), checksum);
+	}
+	BenchmarkBoxPackets<4>(rays, boxes);
+	BenchmarkBoxPackets<8>(rays, boxes);
+	BenchmarkBoxPackets<16>(rays, boxes);
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "DMath/SpatialHashGrid.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t repeatCount = 4;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+}
+
+int main()
+{
+	// SPH-like density: about 30 neighbors inside the smoothing radius.
+	constexpr float radius = 1.f;
+	constexpr float neighborTarget = 30.f;
+	for (size_t pointCount : { size_t(1) << 16, size_t(1) << 20, size_t(1) << 22 })
+	{
+		const float volume = float(pointCount) * (4.f / 3.f * 3.14159265f * radius * radius * radius) / neighborTarget;
+		const float halfExtent = 0.5f * std::cbrt(volume);
+
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> position(-halfExtent, halfExtent);
+		std::vector<Math::Vector3D> points(pointCount);
+		for (auto& point : points)
+			point = Math::Vector3D{ position(rng), position(rng), position(rng) };
+
+		Math::SpatialHashGrid<float> grid(radius);
+		auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+			grid.Build(points);
+		const double buildSeconds = SecondsSince(start) / repeatCount;
+
+		start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+			grid.Build_Parallel(points);
+		const double parallelBuildSeconds = SecondsSince(start) / repeatCount;
+
+		// Queries from every particle, as in a density pass.
+		std::vector<uint32_t> offsets;
+		std::vector<uint32_t> neighbors;
+		start = Clock::now();
+		grid.QueryRadius(grid.GetSortedPositions(), radius, offsets, neighbors);
+		const double querySeconds = SecondsSince(start);
+
+		start = Clock::now();
+		grid.QueryRadius_Parallel(grid.GetSortedPositions(), radius, offsets, neighbors);
+		const double parallelQuerySeconds = SecondsSince(start);
+
+		size_t pairCount = 0;
+		start = Clock::now();
+		grid.ForEachPairInRadius(radius, [&](uint32_t, uint32_t, float) { pairCount++; });
+		const double pairSeconds = SecondsSince(start);
+
+		std::atomic<size_t> parallelPairCount{ 0 };
+		start = Clock::now();
+		grid.ForEachPairInRadius_Parallel(radius, [&](uint32_t, uint32_t, float) { parallelPairCount.fetch_add(1, std::memory_order_relaxed); });
+		const double parallelPairSeconds = SecondsSince(start);
+
+		std::printf("%zu points, %.1f neighbors per point, %zu threads\n", pointCount, double(neighbors.size()) / double(pointCount), Math::GetParallelThreadCount());
+		std::printf("  rebuild:        %8.2f ms (%7.1f Mpoints/s), parallel %8.2f ms (%7.1f Mpoints/s)\n", buildSeconds * 1e3, pointCount / buildSeconds * 1e-6, parallelBuildSeconds * 1e3, pointCount / parallelBuildSeconds * 1e-6);
+		std::printf("  radius queries: %8.2f ms (%7.2f Mqueries/s), parallel %8.2f ms (%7.2f Mqueries/s)\n", querySeconds * 1e3, pointCount / querySeconds * 1e-6, parallelQuerySeconds * 1e3, pointCount / parallelQuerySeconds * 1e-6);
+		std::printf("  all pairs:      %8.2f ms (%zu pairs), parallel %8.2f ms (%zu pairs)\n", pairSeconds * 1e3, pairCount, parallelPairSeconds * 1e3, parallelPairCount.load());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "DMath/Spline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t sampleCount = size_t(1) << 20;
+	constexpr size_t controlPointCount = 1024;
+	constexpr size_t repeatCount = 16;
+
+	using Spline = Math::Spline<Math::SplineType::CatmullRom, 3, float>;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	template<typename Func>
+	double Measure(Func&& func)
+	{
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+			func();
+		return SecondsSince(start) / repeatCount;
+	}
+
+	std::vector<Math::Vector3D> GetControlPoints(uint32_t seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> value(-100.f, 100.f);
+		std::vector<Math::Vector3D> points(controlPointCount);
+		for (auto& point : points)
+			point = { value(rng), value(rng), value(rng) };
+		return points;
+	}
+
+	size_t GetMismatchCount(const std::vector<Math::Vector3D>& a, const std::vector<Math::Vector3D>& b)
+	{
+		size_t mismatchCount = 0;
+		for (size_t i = 0; i < a.size(); i++)
+			mismatchCount += a[i] != b[i];
+		return mismatchCount;
+	}
+
+	void ReportInterpolation()
+	{
+		// Degree 7 polynomial through samples of cos on Chebyshev nodes.
+		constexpr size_t degree = 7;
+		double x[degree + 1];
+		double y[degree + 1];
+		for (size_t i = 0; i <= degree; i++)
+		{
+			x[i] = std::cos((2.0 * double(i) + 1.0) / (2.0 * (degree + 1)) * 3.14159265358979323846);
+			y[i] = std::cos(x[i]);
+		}
+		const auto polynomial = Math::Polynomial<degree, double>::Interpolate({ x, degree + 1 }, { y, degree + 1 });
+
+		double maxNodeError = 0.0;
+		for (size_t i = 0; i <= degree; i++)
+			maxNodeError = std::max(maxNodeError, std::abs(polynomial(x[i]) - y[i]));
+		double maxError = 0.0;
+		for (int i = -1000; i <= 1000; i++)
+		{
+			const double value = double(i) / 1000.0;
+			maxError = std::max(maxError, std::abs(polynomial(value) - std::cos(value)));
+		}
+		std::printf("interpolation of cos with degree %zu: %.3g at the nodes, %.3g over [-1, 1]\n", degree, maxNodeError, maxError);
+	}
+}
+
+int main()
+{
+	ReportInterpolation();
+
+	const std::vector<Math::Vector3D> points = GetControlPoints(1);
+	const Spline spline(points);
+
+	// Sorted times for sampling along the curve, shuffled times for random access.
+	std::vector<float> sortedTimes(sampleCount);
+	const float step = spline.GetEndTime() / float(sampleCount - 1);
+	for (size_t i = 0; i < sampleCount; i++)
+		sortedTimes[i] = float(i) * step;
+	std::vector<float> shuffledTimes = sortedTimes;
+	std::shuffle(shuffledTimes.begin(), shuffledTimes.end(), std::mt19937(2));
+
+	std::vector<Math::Vector3D> scalar(sampleCount);
+	std::vector<Math::Vector3D> output(sampleCount);
+	for (size_t i = 0; i < sampleCount; i++)
+		scalar[i] = spline.Evaluate(sortedTimes[i]);
+	spline.Evaluate(sortedTimes, output);
+	std::printf("batch: %zu mismatches against Evaluate\n", GetMismatchCount(scalar, output));
+	spline.Evaluate_Parallel(sortedTimes, output);
+	std::printf("parallel: %zu mismatches against Evaluate\n", GetMismatchCount(scalar, output));
+	spline.Sample(output);
+	std::printf("sample: %zu mismatches against Evaluate\n", GetMismatchCount(scalar, output));
+	for (size_t i = 0; i < sampleCount; i++)
+		scalar[i] = spline.Evaluate(shuffledTimes[i]);
+	spline.Evaluate(shuffledTimes, output);
+	std::printf("batch: %zu mismatches against Evaluate, shuffled\n", GetMismatchCount(scalar, output));
+
+	std::printf("%zu samples of %zu segments, %zu float lanes, %zu threads\n", sampleCount, spline.GetSegmentCount(), Math::detail::Simd::floatLaneCount, Math::GetParallelThreadCount());
+	const double scalarSeconds = Measure([&]()
+	{
+		for (size_t i = 0; i < sampleCount; i++)
+			output[i] = spline.Evaluate(sortedTimes[i]);
+	});
+	const double cursorSeconds = Measure([&]()
+	{
+		auto cursor = spline.GetCursor();
+		for (size_t i = 0; i < sampleCount; i++)
+			output[i] = cursor.Evaluate(sortedTimes[i]);
+	});
+	const double batchSeconds = Measure([&]() { spline.Evaluate(sortedTimes, output); });
+	const double parallelSeconds = Measure([&]() { spline.Evaluate_Parallel(sortedTimes, output); });
+	const double shuffledSeconds = Measure([&]() { spline.Evaluate(shuffledTimes, output); });
+	std::printf("  Evaluate  %7.3f ms\n", scalarSeconds * 1e3);
+	std::printf("  Cursor    %7.3f ms (%5.1fx)\n", cursorSeconds * 1e3, scalarSeconds / cursorSeconds);
+	std::printf("  batch     %7.3f ms (%5.1fx)\n", batchSeconds * 1e3, scalarSeconds / batchSeconds);
+	std::printf("  parallel  %7.3f ms (%5.1fx)\n", parallelSeconds * 1e3, scalarSeconds / parallelSeconds);
+	std::printf("  batch, shuffled %7.3f ms\n", shuffledSeconds * 1e3);
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "DMath/Trigonometric.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr size_t valueCount = size_t(1) << 20;
+	constexpr size_t repeatCount = 16;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	// Distance in representable floats, sign changes included.
+	int64_t GetUlpDistance(float a, float b)
+	{
+		const auto toOrdered = [](float value)
+		{
+			int32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits < 0 ? int64_t(INT32_MIN) - bits : int64_t(bits);
+		};
+		const int64_t distance = toOrdered(a) - toOrdered(b);
+		return distance < 0 ? -distance : distance;
+	}
+
+	struct Error
+	{
+		int64_t maxUlp = 0;
+		double maxAbsolute = 0.0;
+	};
+
+	void Accumulate(Error& error, float value, double reference)
+	{
+		error.maxUlp = std::max(error.maxUlp, GetUlpDistance(value, float(reference)));
+		error.maxAbsolute = std::max(error.maxAbsolute, std::abs(double(value) - reference));
+	}
+
+	// Double precision reference. Degrees are reduced exactly first, so right angles give exact zeros.
+	template<Math::AngleUnit unit>
+	void GetReference(float angle, double& sin, double& cos)
+	{
+		if constexpr (unit == Math::AngleUnit::Radians)
+		{
+			sin = std::sin(double(angle));
+			cos = std::cos(double(angle));
+		}
+		else
+		{
+			const double quadrant = std::nearbyint(double(angle) / 90.0);
+			const double radians = (double(angle) - 90.0 * quadrant) * Math::detail::degToRad<double>;
+			const double reducedSin = std::sin(radians);
+			const double reducedCos = std::cos(radians);
+			switch (int(quadrant - 4.0 * std::floor(quadrant / 4.0)))
+			{
+			case 0: sin = reducedSin; cos = reducedCos; break;
+			case 1: sin = reducedCos; cos = -reducedSin; break;
+			case 2: sin = -reducedSin; cos = -reducedCos; break;
+			default: sin = -reducedCos; cos = reducedSin; break;
+			}
+		}
+	}
+
+	// Errors against the double precision standard library, and whether the batch and single value results agree.
+	template<Math::AngleUnit unit, Math::TrigPrecision precision>
+	void ReportAccuracy(const char* name, const std::vector<float>& angles)
+	{
+		std::vector<float> sin(angles.size());
+		std::vector<float> cos(angles.size());
+		std::vector<float> tan(angles.size());
+		Math::SinCos<unit, precision>(angles, sin, cos);
+		Math::Tan<unit, precision>(angles, tan);
+
+		Error sinError, cosError, tanError;
+		size_t batchMismatchCount = 0;
+		for (size_t i = 0; i < angles.size(); i++)
+		{
+			double referenceSin, referenceCos;
+			GetReference<unit>(angles[i], referenceSin, referenceCos);
+			Accumulate(sinError, sin[i], referenceSin);
+			Accumulate(cosError, cos[i], referenceCos);
+			// Tangent is compared away from the poles only, where its magnitude is bounded.
+			if (std::abs(referenceCos) > 1e-3)
+				Accumulate(tanError, tan[i], referenceSin / referenceCos);
+
+			const Math::SinCosPair single = Math::SinCos<unit, precision>(angles[i]);
+			batchMismatchCount += single.sin != sin[i] || single.cos != cos[i] || Math::Tan<unit, precision>(angles[i]) != tan[i];
+		}
+		std::printf("  %-8s sin %6lld ulp (abs %.2e), cos %6lld ulp (abs %.2e), tan %6lld ulp, %zu batch mismatches\n", name,
+			(long long)sinError.maxUlp, sinError.maxAbsolute, (long long)cosError.maxUlp, cosError.maxAbsolute, (long long)tanError.maxUlp, batchMismatchCount);
+	}
+
+	template<Math::AngleUnit unit>
+	void ReportAccuracy(const char* unitName, float range)
+	{
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> angle(-range, range);
+		std::vector<float> angles(valueCount);
+		for (auto& value : angles)
+			value = angle(rng);
+		// Small arguments and exact right angles, where relative errors show first.
+		for (size_t i = 0; i < 4096; i++)
+		{
+			angles[i] = std::ldexp(float(i + 1), -int(i % 40) - 10);
+			angles[4096 + i] = unit == Math::AngleUnit::Degrees ? 90.f * float(int(i) - 2048) : float(int(i) - 2048) * 1.5707963f;
+		}
+
+		std::printf("%s in [-%g, %g]\n", unitName, range, range);
+		ReportAccuracy<unit, Math::TrigPrecision::Fast>("fast", angles);
+		ReportAccuracy<unit, Math::TrigPrecision::Medium>("medium", angles);
+		ReportAccuracy<unit, Math::TrigPrecision::Full>("full", angles);
+	}
+
+	template<Math::TrigPrecision precision>
+	double MeasureBatch(const std::vector<float>& angles, std::vector<float>& sin, std::vector<float>& cos)
+	{
+		const auto start = Clock::now();
+		for (size_t repeat = 0; repeat < repeatCount; repeat++)
+			Math::SinCos<Math::AngleUnit::Radians, precision>(angles, sin, cos);
+		return SecondsSince(start) / repeatCount;
+	}
+}
+
+int main()
+{
+	ReportAccuracy<Math::AngleUnit::Radians>("radians", 8192.f);
+	ReportAccuracy<Math::AngleUnit::Radians>("radians", 4.f);
+	ReportAccuracy<Math::AngleUnit::Degrees>("degrees", 720.f);
+
+	std::mt19937 rng(2);
+	std::uniform_real_distribution<float> angle(-100.f, 100.f);
+	std::vector<float> angles(valueCount);
+	for (auto& value : angles)
+		value = angle(rng);
+	std::vector<float> sin(valueCount);
+	std::vector<float> cos(valueCount);
+
+	auto start = Clock::now();
+	for (size_t repeat = 0; repeat < repeatCount; repeat++)
+	{
+		for (size_t i = 0; i < valueCount; i++)
+		{
+			sin[i] = std::sin(angles[i]);
+			cos[i] = std::cos(angles[i]);
+		}
+	}
+	const double librarySeconds = SecondsSince(start) / repeatCount;
+
+	start = Clock::now();
+	for (size_t repeat = 0; repeat < repeatCount; repeat++)
+	{
+		for (size_t i = 0; i < valueCount; i++)
+		{
+			const Math::SinCosPair result = Math::SinCos<Math::AngleUnit::Radians>(angles[i]);
+			sin[i] = result.sin;
+			cos[i] = result.cos;
+		}
+	}
+	const double singleSeconds = SecondsSince(start) / repeatCount;
+
+	const double fastSeconds = MeasureBatch<Math::TrigPrecision::Fast>(angles, sin, cos);
+	const double mediumSeconds = MeasureBatch<Math::TrigPrecision::Medium>(angles, sin, cos);
+	const double fullSeconds = MeasureBatch<Math::TrigPrecision::Full>(angles, sin, cos);
+
+	start = Clock::now();
+	for (size_t repeat = 0; repeat < repeatCount; repeat++)
+		Math::SinCos_Parallel<Math::AngleUnit::Radians>(angles, sin, cos);
+	const double parallelSeconds = SecondsSince(start) / repeatCount;
+
+	const auto report = [](const char* name, double seconds, double baseline)
+	{
+		std::printf("  %-22s %8.3f ms (%7.1f M/s, %5.1fx)\n", name, seconds * 1e3, valueCount / seconds * 1e-6, baseline / seconds);
+	};
+	std::printf("sin and cos of %zu values, %zu float lanes, %zu threads\n", valueCount, Math::detail::Simd::floatLaneCount, Math::GetParallelThreadCount());
+	report("std::sin + std::cos", librarySeconds, librarySeconds);
+	report("SinCos single", singleSeconds, librarySeconds);
+	report("SinCos batch fast", fastSeconds, librarySeconds);
+	report("SinCos batch medium", mediumSeconds, librarySeconds);
+	report("SinCos batch full", fullSeconds, librarySeconds);
+	report("SinCos_Parallel full", parallelSeconds, librarySeconds);
+}
\ No newline at end of file
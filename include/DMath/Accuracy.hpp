@@ -0,0 +1,248 @@
+#pragma once
+
+#include "Span.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace Math
+{
+	namespace Setup
+	{
+		// Time MeasureAccuracy spends running a kernel to measure its throughput.
+		constexpr double accuracyTimingSeconds = 0.05;
+	}
+
+	// Largest errors a kernel may have against its reference before it fails validation. Unset limits never fail.
+	struct ErrorBudget
+	{
+		double maxUlp = std::numeric_limits<double>::infinity();
+		double meanUlp = std::numeric_limits<double>::infinity();
+		double maxAbsoluteError = std::numeric_limits<double>::infinity();
+	};
+
+	// Errors of a kernel's results against reference values, and the kernel's throughput.
+	struct AccuracyReport
+	{
+		size_t sampleCount = 0;
+		// Fractional units in the last place of the result type at the reference value. Correctly rounded results are within 0.5.
+		double maxUlp = 0.0;
+		double meanUlp = 0.0;
+		double maxAbsoluteError = 0.0;
+		// Index of the sample with the largest ULP error.
+		size_t worstIndex = 0;
+		// Samples where exactly one of result and reference is NaN, or that are different infinities.
+		// They are left out of the errors above, and fail every budget.
+		size_t nonFiniteMismatchCount = 0;
+		// 0 when the kernel was not timed.
+		double nanosecondsPerElement = 0.0;
+
+		[[nodiscard]] bool IsWithin(const ErrorBudget& budget) const;
+	};
+
+	// |result - reference| in units in the last place of T at reference, subnormals included. Both must be finite.
+	template<typename T>
+	[[nodiscard]] long double GetUlpError(T result, long double reference);
+
+	// Compares results[i] against references[i]. References are long double, where it is wider than T, or results of the scalar code.
+	template<typename T>
+	[[nodiscard]] AccuracyReport CompareToReference(Span<const T> results, Span<const long double> references);
+
+	// Calls kernel(), which processes elementCount elements per call, for about seconds and returns the average time per element.
+	template<typename Kernel>
+	[[nodiscard]] double MeasureNanosecondsPerElement(Kernel&& kernel, size_t elementCount, double seconds = Setup::accuracyTimingSeconds);
+
+	// Calls kernel(), which writes results, compares the results to references, then times kernel() over seconds.
+	template<typename T, typename Kernel>
+	[[nodiscard]] AccuracyReport MeasureAccuracy(Kernel&& kernel, Span<const T> results, Span<const long double> references, double seconds = Setup::accuracyTimingSeconds);
+
+	// count values uniform in [min, max].
+	template<typename T>
+	[[nodiscard]] std::vector<T> GetRandomInputs(size_t count, T min, T max, uint64_t seed = 0);
+	// count values in [min, max] with uniformly distributed logarithms, for kernels over many magnitudes such as RSqrt and Log. min must be positive.
+	template<typename T>
+	[[nodiscard]] std::vector<T> GetLogUniformInputs(size_t count, T min, T max, uint64_t seed = 0);
+	// The inputs within [min, max] where approximations go wrong first: the ends of the range, signed zeros, the smallest normals and subnormals,
+	// and every power of two with its neighbours. With period > 0 also up to maxPeriodCount multiples of period with their two closest
+	// neighbours on either side, such as the multiples of pi / 2 that trigonometric range reductions lose precision around.
+	template<typename T>
+	[[nodiscard]] std::vector<T> GetAdversarialInputs(T min, T max, long double period = 0.0L, size_t maxPeriodCount = 4096);
+
+	namespace detail
+	{
+		namespace Accuracy
+		{
+			template<typename T>
+			void AddWithNeighbours(std::vector<T>& values, T value, size_t neighbourCount)
+			{
+				values.push_back(value);
+				T below = value;
+				T above = value;
+				for (size_t i = 0; i < neighbourCount; i++)
+				{
+					below = std::nextafter(below, -std::numeric_limits<T>::infinity());
+					above = std::nextafter(above, std::numeric_limits<T>::infinity());
+					values.push_back(below);
+					values.push_back(above);
+				}
+			}
+		}
+	}
+}
+
+inline bool Math::AccuracyReport::IsWithin(const ErrorBudget& budget) const
+{
+	return nonFiniteMismatchCount == 0 && maxUlp <= budget.maxUlp && meanUlp <= budget.meanUlp && maxAbsoluteError <= budget.maxAbsoluteError;
+}
+
+template<typename T>
+long double Math::GetUlpError(T result, long double reference)
+{
+	static_assert(std::is_floating_point_v<T>, "DMath error. GetUlpError needs a floating point result type.");
+
+	// The exponent of the smallest normal also gives the spacing of the subnormals.
+	int exponent = std::numeric_limits<T>::min_exponent;
+	if (reference != 0.0L)
+	{
+		(void)std::frexp(reference, &exponent);
+		exponent = std::max(exponent, std::numeric_limits<T>::min_exponent);
+	}
+	const long double ulp = std::ldexp(1.0L, exponent - std::numeric_limits<T>::digits);
+	return std::fabs((long double)result - reference) / ulp;
+}
+
+template<typename T>
+Math::AccuracyReport Math::CompareToReference(Span<const T> results, Span<const long double> references)
+{
+	assert(results.size() == references.size());
+
+	AccuracyReport report;
+	report.sampleCount = results.size();
+	long double ulpSum = 0.0L;
+	size_t finiteCount = 0;
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const long double result = results[i];
+		const long double reference = references[i];
+		if (std::isnan(result) || std::isnan(reference) || std::isinf(result) || std::isinf(reference))
+		{
+			const bool isSame = (std::isnan(result) && std::isnan(reference)) || result == reference;
+			report.nonFiniteMismatchCount += !isSame;
+			continue;
+		}
+
+		const long double ulpError = GetUlpError(results[i], reference);
+		if (ulpError > report.maxUlp)
+		{
+			report.maxUlp = double(ulpError);
+			report.worstIndex = i;
+		}
+		report.maxAbsoluteError = std::max(report.maxAbsoluteError, double(std::fabs(result - reference)));
+		ulpSum += ulpError;
+		finiteCount++;
+	}
+	report.meanUlp = finiteCount == 0 ? 0.0 : double(ulpSum / finiteCount);
+	return report;
+}
+
+template<typename Kernel>
+double Math::MeasureNanosecondsPerElement(Kernel&& kernel, size_t elementCount, double seconds)
+{
+	using Clock = std::chrono::steady_clock;
+
+	kernel();
+	size_t callCount = 0;
+	const auto start = Clock::now();
+	double elapsed = 0.0;
+	do
+	{
+		kernel();
+		callCount++;
+		elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+	} while (elapsed < seconds);
+	return elapsed * 1e9 / double(callCount * std::max<size_t>(elementCount, 1));
+}
+
+template<typename T, typename Kernel>
+Math::AccuracyReport Math::MeasureAccuracy(Kernel&& kernel, Span<const T> results, Span<const long double> references, double seconds)
+{
+	kernel();
+	AccuracyReport report = CompareToReference(results, references);
+	if (seconds > 0.0)
+		report.nanosecondsPerElement = MeasureNanosecondsPerElement(kernel, results.size(), seconds);
+	return report;
+}
+
+template<typename T>
+std::vector<T> Math::GetRandomInputs(size_t count, T min, T max, uint64_t seed)
+{
+	std::mt19937_64 generator(seed);
+	std::uniform_real_distribution<T> distribution(min, max);
+	std::vector<T> values(count);
+	for (auto& value : values)
+		value = distribution(generator);
+	return values;
+}
+
+template<typename T>
+std::vector<T> Math::GetLogUniformInputs(size_t count, T min, T max, uint64_t seed)
+{
+	assert(min > T(0) && min <= max);
+
+	std::mt19937_64 generator(seed);
+	std::uniform_real_distribution<long double> distribution(std::log2((long double)min), std::log2((long double)max));
+	std::vector<T> values(count);
+	for (auto& value : values)
+		value = std::clamp(T(std::exp2(distribution(generator))), min, max);
+	return values;
+}
+
+template<typename T>
+std::vector<T> Math::GetAdversarialInputs(T min, T max, long double period, size_t maxPeriodCount)
+{
+	static_assert(std::is_floating_point_v<T>, "DMath error. GetAdversarialInputs needs a floating point type.");
+	assert(min <= max);
+
+	std::vector<T> values;
+	detail::Accuracy::AddWithNeighbours(values, min, 1);
+	detail::Accuracy::AddWithNeighbours(values, max, 1);
+	for (const T value : { T(0), std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::min() })
+	{
+		detail::Accuracy::AddWithNeighbours(values, value, 1);
+		detail::Accuracy::AddWithNeighbours(values, -value, 1);
+	}
+	for (int exponent = std::numeric_limits<T>::min_exponent - 1; exponent < std::numeric_limits<T>::max_exponent; exponent++)
+	{
+		const T power = std::ldexp(T(1), exponent);
+		detail::Accuracy::AddWithNeighbours(values, power, 1);
+		detail::Accuracy::AddWithNeighbours(values, -power, 1);
+	}
+
+	if (period > 0.0L && maxPeriodCount > 0)
+	{
+		const long double first = std::ceil((long double)min / period);
+		const long double last = std::floor((long double)max / period);
+		if (first <= last)
+		{
+			const long double multipleCount = last - first + 1.0L;
+			const size_t count = size_t(std::min(multipleCount, (long double)maxPeriodCount));
+			for (size_t i = 0; i < count; i++)
+			{
+				// Evenly spread over the range when there are more multiples than maxPeriodCount.
+				const long double multiple = count == 1 ? first : first + std::round((long double)i * (multipleCount - 1.0L) / (long double)(count - 1));
+				detail::Accuracy::AddWithNeighbours(values, T(multiple * period), 2);
+			}
+		}
+	}
+
+	values.erase(std::remove_if(values.begin(), values.end(), [&](T value) { return !(value >= min && value <= max); }), values.end());
+	return values;
+}
\ No newline at end of file
@@ -0,0 +1,759 @@
+#pragma once
+
+#include "Setup.hpp"
+#include "Common.hpp"
+#include "Simd.hpp"
+#include "Span.hpp"
+#include "Parallel.hpp"
+#include "Execution.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace Math
+{
+	// Element-wise versions of the Common.hpp functions over float arrays.
+	// output may be the same span as any of the inputs, to work in place.
+	// Abs, Floor, Ceil, Round, Clamp and Lerp give the same results as their scalar versions.
+	// Log and Hypot are within 1 ULP of the correctly rounded result, Pow within 3 ULP.
+	// The polynomial kernels pay off from AVX on. With SSE2 alone Log runs about as fast as the standard library,
+	// and Pow calls std::pow for every element.
+	// Log and Pow send zero, negative, subnormal and non-finite arguments to the standard library.
+	void Abs(Span<const float> input, Span<float> output);
+	void Floor(Span<const float> input, Span<float> output);
+	void Ceil(Span<const float> input, Span<float> output);
+	// Halfway cases away from zero, like std::round.
+	void Round(Span<const float> input, Span<float> output);
+	void Clamp(Span<const float> input, float min, float max, Span<float> output);
+	void Lerp(Span<const float> input1, Span<const float> input2, float delta, Span<float> output);
+	void Lerp(Span<const float> input1, Span<const float> input2, Span<const float> delta, Span<float> output);
+	// Clamp(Lerp(input1, input2, delta), min, max) in a single pass.
+	void LerpClamped(Span<const float> input1, Span<const float> input2, float delta, float min, float max, Span<float> output);
+	void Log(Span<const float> input, Span<float> output);
+	void Pow(Span<const float> coefficient, float exponent, Span<float> output);
+	void Pow(Span<const float> coefficient, Span<const float> exponent, Span<float> output);
+	void Hypot(Span<const float> x, Span<const float> y, Span<float> output);
+	void Hypot(Span<const float> x, Span<const float> y, Span<const float> z, Span<float> output);
+
+	void Abs_Parallel(Span<const float> input, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	void Floor_Parallel(Span<const float> input, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	void Ceil_Parallel(Span<const float> input, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	void Round_Parallel(Span<const float> input, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	void Clamp_Parallel(Span<const float> input, float min, float max, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	void Lerp_Parallel(Span<const float> input1, Span<const float> input2, float delta, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	void Lerp_Parallel(Span<const float> input1, Span<const float> input2, Span<const float> delta, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	void LerpClamped_Parallel(Span<const float> input1, Span<const float> input2, float delta, float min, float max, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	void Log_Parallel(Span<const float> input, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	void Pow_Parallel(Span<const float> coefficient, float exponent, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	void Pow_Parallel(Span<const float> coefficient, Span<const float> exponent, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	void Hypot_Parallel(Span<const float> x, Span<const float> y, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	void Hypot_Parallel(Span<const float> x, Span<const float> y, Span<const float> z, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	// std::execution::par and par_unseq run the _Parallel versions, other policies the single thread ones.
+	template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Abs(ExecutionPolicy&& policy, Span<const float> input, Span<float> output);
+	template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Floor(ExecutionPolicy&& policy, Span<const float> input, Span<float> output);
+	template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Ceil(ExecutionPolicy&& policy, Span<const float> input, Span<float> output);
+	template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Round(ExecutionPolicy&& policy, Span<const float> input, Span<float> output);
+	template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Clamp(ExecutionPolicy&& policy, Span<const float> input, float min, float max, Span<float> output);
+	template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Lerp(ExecutionPolicy&& policy, Span<const float> input1, Span<const float> input2, float delta, Span<float> output);
+	template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Lerp(ExecutionPolicy&& policy, Span<const float> input1, Span<const float> input2, Span<const float> delta, Span<float> output);
+	template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void LerpClamped(ExecutionPolicy&& policy, Span<const float> input1, Span<const float> input2, float delta, float min, float max, Span<float> output);
+	template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Log(ExecutionPolicy&& policy, Span<const float> input, Span<float> output);
+	template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Pow(ExecutionPolicy&& policy, Span<const float> coefficient, float exponent, Span<float> output);
+	template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Pow(ExecutionPolicy&& policy, Span<const float> coefficient, Span<const float> exponent, Span<float> output);
+	template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Hypot(ExecutionPolicy&& policy, Span<const float> x, Span<const float> y, Span<float> output);
+	template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Hypot(ExecutionPolicy&& policy, Span<const float> x, Span<const float> y, Span<const float> z, Span<float> output);
+
+	namespace detail
+	{
+		namespace ArrayMath
+		{
+			// Calls kernel(lanes, offset) for every register of [0, count), then for the
+			// remaining elements one at a time with Simd::FloatLanes<1> as lanes.
+			template<typename Kernel>
+			void ForEachRegister(size_t count, Kernel&& kernel)
+			{
+				constexpr size_t laneCount = Simd::floatLaneCount;
+				size_t i = 0;
+				if constexpr (laneCount > 1)
+				{
+					for (; i + laneCount <= count; i += laneCount)
+						kernel(Simd::FloatLanes<laneCount>(), i);
+				}
+				for (; i < count; i++)
+					kernel(Simd::FloatLanes<1>(), i);
+			}
+
+			// Calls fallback(lane) for every lane set in mask.
+			template<typename L, typename Fallback>
+			void ForEachSetLane(typename L::Mask mask, Fallback&& fallback)
+			{
+				const uint32_t bits = L::ToBits(mask);
+				for (size_t lane = 0; lane < sizeof(typename L::Register) / sizeof(float); lane++)
+				{
+					if ((bits & (uint32_t(1) << lane)) != 0)
+						fallback(lane);
+				}
+			}
+
+			template<typename L>
+			typename L::Mask Not(typename L::Mask mask)
+			{
+				const auto zero = L::Set(0.f);
+				return L::AndNot(L::Equal(zero, zero), mask);
+			}
+
+			template<typename L>
+			typename L::Register Clamp(typename L::Register x, typename L::Register min, typename L::Register max)
+			{
+				// Operand order of std::clamp, NaN stays NaN.
+				return L::Min(max, L::Max(min, x));
+			}
+
+			template<typename L>
+			typename L::Register Round(typename L::Register x)
+			{
+				const auto truncated = L::Truncate(x);
+				const auto step = L::Select(L::Less(x, L::Set(0.f)), L::Set(-1.f), L::Set(1.f));
+				// The fraction is exact, and NaN for infinities which then stay as they are.
+				const auto fraction = L::Sub(x, truncated);
+				return L::Select(L::GreaterEqual(L::Abs(fraction), L::Set(0.5f)), L::Add(truncated, step), truncated);
+			}
+
+			// Exact product of a and b as high + low, so the results do not depend on fused multiply-add support.
+			// Without it, by Dekker's splitting, for inputs below 2^100 in magnitude.
+			template<typename L>
+			void TwoProduct(typename L::Register a, typename L::Register b, typename L::Register& high, typename L::Register& low)
+			{
+				high = L::Mul(a, b);
+#if defined( DMATH_SIMD_FMA )
+				low = L::MulSub(a, b, high);
+#else
+				const auto splitter = L::Set(4097.f);
+				const auto scaledA = L::Mul(a, splitter);
+				const auto highA = L::Sub(scaledA, L::Sub(scaledA, a));
+				const auto lowA = L::Sub(a, highA);
+				const auto scaledB = L::Mul(b, splitter);
+				const auto highB = L::Sub(scaledB, L::Sub(scaledB, b));
+				const auto lowB = L::Sub(b, highB);
+				low = L::Add(L::Add(L::Add(L::Sub(L::Mul(highA, highB), high), L::Mul(highA, lowB)), L::Mul(lowA, highB)), L::Mul(lowA, lowB));
+#endif
+			}
+
+			// Splits positive normal x into 2^exponent * m with m in [sqrt(0.5), sqrt(2)),
+			// and returns ln(m) as high + low, about 40 bits together.
+			template<typename L>
+			void LogMantissa(typename L::Register x, typename L::Register& exponent, typename L::Register& high, typename L::Register& low)
+			{
+				auto mantissa = L::GetMantissa(x);
+				exponent = L::GetExponent(x);
+				const auto isLarge = L::GreaterEqual(mantissa, L::Set(1.41421356f));
+				mantissa = L::Select(isLarge, L::Mul(mantissa, L::Set(0.5f)), mantissa);
+				exponent = L::Select(isLarge, L::Add(exponent, L::Set(1.f)), exponent);
+
+				// ln(1 + f) = f - f^2 / 2 + f^3 * P(f), Cephes coefficients. f is exact.
+				const auto f = L::Sub(mantissa, L::Set(1.f));
+				typename L::Register squareHigh, squareLow;
+				TwoProduct<L>(f, f, squareHigh, squareLow);
+				auto polynomial = L::Set(7.0376836292e-2f);
+				polynomial = L::Add(L::Mul(polynomial, f), L::Set(-1.1514610310e-1f));
+				polynomial = L::Add(L::Mul(polynomial, f), L::Set(1.1676998740e-1f));
+				polynomial = L::Add(L::Mul(polynomial, f), L::Set(-1.2420140846e-1f));
+				polynomial = L::Add(L::Mul(polynomial, f), L::Set(1.4249322787e-1f));
+				polynomial = L::Add(L::Mul(polynomial, f), L::Set(-1.6668057665e-1f));
+				polynomial = L::Add(L::Mul(polynomial, f), L::Set(2.0000714765e-1f));
+				polynomial = L::Add(L::Mul(polynomial, f), L::Set(-2.4999993993e-1f));
+				polynomial = L::Add(L::Mul(polynomial, f), L::Set(3.3333331174e-1f));
+				const auto tail = L::Mul(L::Mul(f, squareHigh), polynomial);
+
+				// |f| is at least f^2 / 2, so the sum is exact as high + low.
+				const auto halfSquare = L::Mul(squareHigh, L::Set(-0.5f));
+				high = L::Add(f, halfSquare);
+				low = L::Sub(halfSquare, L::Sub(high, f));
+				low = L::Add(low, L::Sub(tail, L::Mul(squareLow, L::Set(0.5f))));
+			}
+
+			// 2^x for x in [-0.5, 0.5], Cephes coefficients.
+			template<typename L>
+			typename L::Register Exp2Reduced(typename L::Register x)
+			{
+				auto polynomial = L::Set(1.535336188319500e-4f);
+				polynomial = L::Add(L::Mul(polynomial, x), L::Set(1.339887440266574e-3f));
+				polynomial = L::Add(L::Mul(polynomial, x), L::Set(9.618437357674640e-3f));
+				polynomial = L::Add(L::Mul(polynomial, x), L::Set(5.550332471162809e-2f));
+				polynomial = L::Add(L::Mul(polynomial, x), L::Set(2.402264791363012e-1f));
+				polynomial = L::Add(L::Mul(polynomial, x), L::Set(6.931472028550421e-1f));
+				return L::Add(L::Mul(polynomial, x), L::Set(1.f));
+			}
+
+			template<typename L>
+			typename L::Mask IsLogOutOfRange(typename L::Register x)
+			{
+				const auto inRange = L::And(L::GreaterEqual(x, L::Set(std::numeric_limits<float>::min())), L::Less(x, L::Set(std::numeric_limits<float>::infinity())));
+				return Not<L>(inRange);
+			}
+
+			template<typename L>
+			typename L::Register Log(typename L::Register x)
+			{
+				typename L::Register exponent, high, low;
+				LogMantissa<L>(x, exponent, high, low);
+				// ln(2) split so that exponent * ln2High is exact.
+				const auto ln2High = L::Set(0.693359375f);
+				const auto ln2Low = L::Set(-2.12194440e-4f);
+				return L::Add(L::Add(L::Mul(exponent, ln2High), high), L::Add(low, L::Mul(exponent, ln2Low)));
+			}
+
+			template<typename L>
+			typename L::Mask IsPowOutOfRange(typename L::Register x, typename L::Register y)
+			{
+				// Large exponents are left out so that TwoProduct cannot overflow.
+				return L::Or(IsLogOutOfRange<L>(x), Not<L>(L::Less(L::Abs(y), L::Set(1e30f))));
+			}
+
+			// x^y as 2^(y * log2(x)) with y * log2(x) carried in extended precision.
+			template<typename L>
+			typename L::Register Pow(typename L::Register x, typename L::Register y)
+			{
+				typename L::Register exponent, high, low;
+				LogMantissa<L>(x, exponent, high, low);
+
+				// log2(m) = ln(m) * log2(e)
+				const auto log2eHigh = L::Set(1.44269502162933349609375f);
+				const auto log2eLow = L::Set(1.925963033500011e-8f);
+				typename L::Register log2High, log2Low;
+				TwoProduct<L>(high, log2eHigh, log2High, log2Low);
+				log2Low = L::Add(log2Low, L::Add(L::Mul(high, log2eLow), L::Mul(low, log2eHigh)));
+
+				typename L::Register mantissaHigh, mantissaLow, exponentHigh, exponentLow;
+				TwoProduct<L>(y, log2High, mantissaHigh, mantissaLow);
+				mantissaLow = L::Add(mantissaLow, L::Mul(y, log2Low));
+				TwoProduct<L>(y, exponent, exponentHigh, exponentLow);
+
+				// Integral parts are taken off each high part exactly before summing.
+				const auto exponentInteger = L::Round(exponentHigh);
+				const auto mantissaInteger = L::Round(mantissaHigh);
+				auto fraction = L::Add(L::Sub(exponentHigh, exponentInteger), L::Sub(mantissaHigh, mantissaInteger));
+				fraction = L::Add(fraction, L::Add(exponentLow, mantissaLow));
+				const auto fractionInteger = L::Round(fraction);
+				fraction = L::Sub(fraction, fractionInteger);
+
+				// Results beyond 2^130 or below 2^-160 are rounded to infinity or zero by the scaling anyway.
+				auto integer = L::Add(L::Add(exponentInteger, mantissaInteger), fractionInteger);
+				integer = L::Min(L::Max(integer, L::Set(-160.f)), L::Set(130.f));
+				// Two steps keep every intermediate normal, so subnormal results are rounded once.
+				const auto firstStep = L::Floor(L::Mul(integer, L::Set(0.5f)));
+				const auto result = L::Ldexp(L::Ldexp(Exp2Reduced<L>(fraction), firstStep), L::Sub(integer, firstStep));
+
+				const auto total = L::Add(exponentHigh, mantissaHigh);
+				const auto overflow = L::Select(L::Less(L::Set(0.f), total), L::Set(std::numeric_limits<float>::infinity()), L::Set(0.f));
+				return L::Select(L::Less(L::Abs(total), L::Set(300.f)), result, overflow);
+			}
+
+			// Scaled by a power of 2 of the largest magnitude, so that the squares can neither overflow nor underflow.
+			template<typename L>
+			typename L::Register GetHypotScale(typename L::Register largest)
+			{
+				return L::Min(L::Max(L::GetExponent(largest), L::Set(-126.f)), L::Set(126.f));
+			}
+
+			template<typename L>
+			typename L::Register Hypot(typename L::Register x, typename L::Register y)
+			{
+				const auto absX = L::Abs(x);
+				const auto absY = L::Abs(y);
+				const auto scale = GetHypotScale<L>(L::Max(absX, absY));
+				const auto inverseScale = L::Sub(L::Set(0.f), scale);
+				const auto scaledX = L::Ldexp(x, inverseScale);
+				const auto scaledY = L::Ldexp(y, inverseScale);
+				const auto result = L::Ldexp(L::Sqrt(L::Add(L::Mul(scaledX, scaledX), L::Mul(scaledY, scaledY))), scale);
+
+				const auto infinity = L::Set(std::numeric_limits<float>::infinity());
+				return L::Select(L::Or(L::Equal(absX, infinity), L::Equal(absY, infinity)), infinity, result);
+			}
+
+			template<typename L>
+			typename L::Register Hypot(typename L::Register x, typename L::Register y, typename L::Register z)
+			{
+				const auto absX = L::Abs(x);
+				const auto absY = L::Abs(y);
+				const auto absZ = L::Abs(z);
+				const auto scale = GetHypotScale<L>(L::Max(L::Max(absX, absY), absZ));
+				const auto inverseScale = L::Sub(L::Set(0.f), scale);
+				const auto scaledX = L::Ldexp(x, inverseScale);
+				const auto scaledY = L::Ldexp(y, inverseScale);
+				const auto scaledZ = L::Ldexp(z, inverseScale);
+				const auto sum = L::Add(L::Add(L::Mul(scaledX, scaledX), L::Mul(scaledY, scaledY)), L::Mul(scaledZ, scaledZ));
+				const auto result = L::Ldexp(L::Sqrt(sum), scale);
+
+				const auto infinity = L::Set(std::numeric_limits<float>::infinity());
+				return L::Select(L::Or(L::Or(L::Equal(absX, infinity), L::Equal(absY, infinity)), L::Equal(absZ, infinity)), infinity, result);
+			}
+
+			// Applies op(lanes, x) to every element.
+			template<typename Op>
+			void UnaryRange(const float* input, float* output, size_t count, Op&& op)
+			{
+				ForEachRegister(count, [=](auto lanes, size_t offset)
+				{
+					using L = decltype(lanes);
+					L::StoreUnaligned(output + offset, op(lanes, L::LoadUnaligned(input + offset)));
+				});
+			}
+
+			inline void LogRange(const float* input, float* output, size_t count)
+			{
+				ForEachRegister(count, [=](auto lanes, size_t offset)
+				{
+					using L = decltype(lanes);
+					const auto x = L::LoadUnaligned(input + offset);
+					const auto outOfRange = IsLogOutOfRange<L>(x);
+					if (L::ToBits(outOfRange) == 0)
+					{
+						L::StoreUnaligned(output + offset, Log<L>(x));
+						return;
+					}
+
+					// The output may alias the input, so the inputs are kept aside first.
+					alignas(64) float inputs[sizeof(typename L::Register) / sizeof(float)];
+					L::StoreUnaligned(inputs, x);
+					L::StoreUnaligned(output + offset, Log<L>(x));
+					ForEachSetLane<L>(outOfRange, [&](size_t lane) { output[offset + lane] = std::log(inputs[lane]); });
+				});
+			}
+
+			// Four lanes without fused multiply-add split every product by hand, which makes the kernel slower than std::pow.
+#if defined( DMATH_SIMD_FMA )
+			constexpr bool powUsesLibrary = false;
+#else
+			constexpr bool powUsesLibrary = Simd::floatLaneCount == 4;
+#endif
+
+			// exponent is read with the given stride, 0 for a single exponent.
+			inline void PowRange(const float* coefficient, const float* exponent, size_t exponentStride, float* output, size_t count)
+			{
+				if constexpr (powUsesLibrary)
+				{
+					for (size_t i = 0; i < count; i++)
+						output[i] = std::pow(coefficient[i], exponent[i * exponentStride]);
+					return;
+				}
+
+				ForEachRegister(count, [=](auto lanes, size_t offset)
+				{
+					using L = decltype(lanes);
+					const auto x = L::LoadUnaligned(coefficient + offset);
+					const auto y = exponentStride == 0 ? L::Set(*exponent) : L::LoadUnaligned(exponent + offset);
+					const auto outOfRange = IsPowOutOfRange<L>(x, y);
+					if (L::ToBits(outOfRange) == 0)
+					{
+						L::StoreUnaligned(output + offset, Pow<L>(x, y));
+						return;
+					}
+
+					alignas(64) float coefficients[sizeof(typename L::Register) / sizeof(float)];
+					alignas(64) float exponents[sizeof(typename L::Register) / sizeof(float)];
+					L::StoreUnaligned(coefficients, x);
+					L::StoreUnaligned(exponents, y);
+					L::StoreUnaligned(output + offset, Pow<L>(x, y));
+					ForEachSetLane<L>(outOfRange, [&](size_t lane) { output[offset + lane] = std::pow(coefficients[lane], exponents[lane]); });
+				});
+			}
+
+			// delta is read with the given stride, 0 for a single delta. Clamped when min <= max.
+			inline void LerpRange(const float* input1, const float* input2, const float* delta, size_t deltaStride, float min, float max, float* output, size_t count)
+			{
+				const bool clamp = min <= max;
+				ForEachRegister(count, [=](auto lanes, size_t offset)
+				{
+					using L = decltype(lanes);
+					const auto a = L::LoadUnaligned(input1 + offset);
+					const auto b = L::LoadUnaligned(input2 + offset);
+					const auto t = deltaStride == 0 ? L::Set(*delta) : L::LoadUnaligned(delta + offset);
+					// Same expression as the scalar Lerp.
+					const auto result = L::Add(L::Mul(L::Sub(b, a), t), a);
+					L::StoreUnaligned(output + offset, clamp ? Clamp<L>(result, L::Set(min), L::Set(max)) : result);
+				});
+			}
+
+			inline void HypotRange(const float* x, const float* y, const float* z, float* output, size_t count)
+			{
+				ForEachRegister(count, [=](auto lanes, size_t offset)
+				{
+					using L = decltype(lanes);
+					const auto xValues = L::LoadUnaligned(x + offset);
+					const auto yValues = L::LoadUnaligned(y + offset);
+					if (z == nullptr)
+						L::StoreUnaligned(output + offset, Hypot<L>(xValues, yValues));
+					else
+						L::StoreUnaligned(output + offset, Hypot<L>(xValues, yValues, L::LoadUnaligned(z + offset)));
+				});
+			}
+
+			// Splits [0, count) with ParallelFor and calls range(begin, count) for every chunk.
+			template<typename Range>
+			void ParallelRange(size_t count, size_t grainSize, Range&& range)
+			{
+				ParallelFor(0, count, grainSize, [&](size_t begin, size_t end) { range(begin, end - begin); });
+			}
+		}
+	}
+}
+
+inline void Math::Abs(Span<const float> input, Span<float> output)
+{
+	assert(output.size() == input.size());
+
+	detail::ArrayMath::UnaryRange(input.data(), output.data(), input.size(), [](auto lanes, auto x) { return decltype(lanes)::Abs(x); });
+}
+
+inline void Math::Floor(Span<const float> input, Span<float> output)
+{
+	assert(output.size() == input.size());
+
+	detail::ArrayMath::UnaryRange(input.data(), output.data(), input.size(), [](auto lanes, auto x) { return decltype(lanes)::Floor(x); });
+}
+
+inline void Math::Ceil(Span<const float> input, Span<float> output)
+{
+	assert(output.size() == input.size());
+
+	detail::ArrayMath::UnaryRange(input.data(), output.data(), input.size(), [](auto lanes, auto x) { return decltype(lanes)::Ceil(x); });
+}
+
+inline void Math::Round(Span<const float> input, Span<float> output)
+{
+	assert(output.size() == input.size());
+
+	detail::ArrayMath::UnaryRange(input.data(), output.data(), input.size(), [](auto lanes, auto x) { return detail::ArrayMath::Round<decltype(lanes)>(x); });
+}
+
+inline void Math::Clamp(Span<const float> input, float min, float max, Span<float> output)
+{
+	assert(output.size() == input.size());
+	assert(min <= max);
+
+	detail::ArrayMath::UnaryRange(input.data(), output.data(), input.size(), [=](auto lanes, auto x)
+	{
+		using L = decltype(lanes);
+		return detail::ArrayMath::Clamp<L>(x, L::Set(min), L::Set(max));
+	});
+}
+
+inline void Math::Lerp(Span<const float> input1, Span<const float> input2, float delta, Span<float> output)
+{
+	assert(input2.size() == input1.size() && output.size() == input1.size());
+
+	detail::ArrayMath::LerpRange(input1.data(), input2.data(), &delta, 0, 1.f, 0.f, output.data(), input1.size());
+}
+
+inline void Math::Lerp(Span<const float> input1, Span<const float> input2, Span<const float> delta, Span<float> output)
+{
+	assert(input2.size() == input1.size() && delta.size() == input1.size() && output.size() == input1.size());
+
+	detail::ArrayMath::LerpRange(input1.data(), input2.data(), delta.data(), 1, 1.f, 0.f, output.data(), input1.size());
+}
+
+inline void Math::LerpClamped(Span<const float> input1, Span<const float> input2, float delta, float min, float max, Span<float> output)
+{
+	assert(input2.size() == input1.size() && output.size() == input1.size());
+	assert(min <= max);
+
+	detail::ArrayMath::LerpRange(input1.data(), input2.data(), &delta, 0, min, max, output.data(), input1.size());
+}
+
+inline void Math::Log(Span<const float> input, Span<float> output)
+{
+	assert(output.size() == input.size());
+
+	detail::ArrayMath::LogRange(input.data(), output.data(), input.size());
+}
+
+inline void Math::Pow(Span<const float> coefficient, float exponent, Span<float> output)
+{
+	assert(output.size() == coefficient.size());
+
+	detail::ArrayMath::PowRange(coefficient.data(), &exponent, 0, output.data(), coefficient.size());
+}
+
+inline void Math::Pow(Span<const float> coefficient, Span<const float> exponent, Span<float> output)
+{
+	assert(exponent.size() == coefficient.size() && output.size() == coefficient.size());
+
+	detail::ArrayMath::PowRange(coefficient.data(), exponent.data(), 1, output.data(), coefficient.size());
+}
+
+inline void Math::Hypot(Span<const float> x, Span<const float> y, Span<float> output)
+{
+	assert(y.size() == x.size() && output.size() == x.size());
+
+	detail::ArrayMath::HypotRange(x.data(), y.data(), nullptr, output.data(), x.size());
+}
+
+inline void Math::Hypot(Span<const float> x, Span<const float> y, Span<const float> z, Span<float> output)
+{
+	assert(y.size() == x.size() && z.size() == x.size() && output.size() == x.size());
+
+	detail::ArrayMath::HypotRange(x.data(), y.data(), z.data(), output.data(), x.size());
+}
+
+inline void Math::Abs_Parallel(Span<const float> input, Span<float> output, size_t grainSize)
+{
+	assert(output.size() == input.size());
+
+	detail::ArrayMath::ParallelRange(input.size(), grainSize, [&](size_t begin, size_t count)
+	{
+		Abs(input.subspan(begin, count), output.subspan(begin, count));
+	});
+}
+
+inline void Math::Floor_Parallel(Span<const float> input, Span<float> output, size_t grainSize)
+{
+	assert(output.size() == input.size());
+
+	detail::ArrayMath::ParallelRange(input.size(), grainSize, [&](size_t begin, size_t count)
+	{
+		Floor(input.subspan(begin, count), output.subspan(begin, count));
+	});
+}
+
+inline void Math::Ceil_Parallel(Span<const float> input, Span<float> output, size_t grainSize)
+{
+	assert(output.size() == input.size());
+
+	detail::ArrayMath::ParallelRange(input.size(), grainSize, [&](size_t begin, size_t count)
+	{
+		Ceil(input.subspan(begin, count), output.subspan(begin, count));
+	});
+}
+
+inline void Math::Round_Parallel(Span<const float> input, Span<float> output, size_t grainSize)
+{
+	assert(output.size() == input.size());
+
+	detail::ArrayMath::ParallelRange(input.size(), grainSize, [&](size_t begin, size_t count)
+	{
+		Round(input.subspan(begin, count), output.subspan(begin, count));
+	});
+}
+
+inline void Math::Clamp_Parallel(Span<const float> input, float min, float max, Span<float> output, size_t grainSize)
+{
+	assert(output.size() == input.size());
+
+	detail::ArrayMath::ParallelRange(input.size(), grainSize, [&](size_t begin, size_t count)
+	{
+		Clamp(input.subspan(begin, count), min, max, output.subspan(begin, count));
+	});
+}
+
+inline void Math::Lerp_Parallel(Span<const float> input1, Span<const float> input2, float delta, Span<float> output, size_t grainSize)
+{
+	assert(input2.size() == input1.size() && output.size() == input1.size());
+
+	detail::ArrayMath::ParallelRange(input1.size(), grainSize, [&](size_t begin, size_t count)
+	{
+		Lerp(input1.subspan(begin, count), input2.subspan(begin, count), delta, output.subspan(begin, count));
+	});
+}
+
+inline void Math::Lerp_Parallel(Span<const float> input1, Span<const float> input2, Span<const float> delta, Span<float> output, size_t grainSize)
+{
+	assert(input2.size() == input1.size() && delta.size() == input1.size() && output.size() == input1.size());
+
+	detail::ArrayMath::ParallelRange(input1.size(), grainSize, [&](size_t begin, size_t count)
+	{
+		Lerp(input1.subspan(begin, count), input2.subspan(begin, count), delta.subspan(begin, count), output.subspan(begin, count));
+	});
+}
+
+inline void Math::LerpClamped_Parallel(Span<const float> input1, Span<const float> input2, float delta, float min, float max, Span<float> output, size_t grainSize)
+{
+	assert(input2.size() == input1.size() && output.size() == input1.size());
+
+	detail::ArrayMath::ParallelRange(input1.size(), grainSize, [&](size_t begin, size_t count)
+	{
+		LerpClamped(input1.subspan(begin, count), input2.subspan(begin, count), delta, min, max, output.subspan(begin, count));
+	});
+}
+
+inline void Math::Log_Parallel(Span<const float> input, Span<float> output, size_t grainSize)
+{
+	assert(output.size() == input.size());
+
+	detail::ArrayMath::ParallelRange(input.size(), grainSize, [&](size_t begin, size_t count)
+	{
+		Log(input.subspan(begin, count), output.subspan(begin, count));
+	});
+}
+
+inline void Math::Pow_Parallel(Span<const float> coefficient, float exponent, Span<float> output, size_t grainSize)
+{
+	assert(output.size() == coefficient.size());
+
+	detail::ArrayMath::ParallelRange(coefficient.size(), grainSize, [&](size_t begin, size_t count)
+	{
+		Pow(coefficient.subspan(begin, count), exponent, output.subspan(begin, count));
+	});
+}
+
+inline void Math::Pow_Parallel(Span<const float> coefficient, Span<const float> exponent, Span<float> output, size_t grainSize)
+{
+	assert(exponent.size() == coefficient.size() && output.size() == coefficient.size());
+
+	detail::ArrayMath::ParallelRange(coefficient.size(), grainSize, [&](size_t begin, size_t count)
+	{
+		Pow(coefficient.subspan(begin, count), exponent.subspan(begin, count), output.subspan(begin, count));
+	});
+}
+
+inline void Math::Hypot_Parallel(Span<const float> x, Span<const float> y, Span<float> output, size_t grainSize)
+{
+	assert(y.size() == x.size() && output.size() == x.size());
+
+	detail::ArrayMath::ParallelRange(x.size(), grainSize, [&](size_t begin, size_t count)
+	{
+		Hypot(x.subspan(begin, count), y.subspan(begin, count), output.subspan(begin, count));
+	});
+}
+
+inline void Math::Hypot_Parallel(Span<const float> x, Span<const float> y, Span<const float> z, Span<float> output, size_t grainSize)
+{
+	assert(y.size() == x.size() && z.size() == x.size() && output.size() == x.size());
+
+	detail::ArrayMath::ParallelRange(x.size(), grainSize, [&](size_t begin, size_t count)
+	{
+		Hypot(x.subspan(begin, count), y.subspan(begin, count), z.subspan(begin, count), output.subspan(begin, count));
+	});
+}
+
+template<typename ExecutionPolicy, typename>
+void Math::Abs(ExecutionPolicy&&, Span<const float> input, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Abs_Parallel(input, output);
+	else
+		Abs(input, output);
+}
+
+template<typename ExecutionPolicy, typename>
+void Math::Floor(ExecutionPolicy&&, Span<const float> input, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Floor_Parallel(input, output);
+	else
+		Floor(input, output);
+}
+
+template<typename ExecutionPolicy, typename>
+void Math::Ceil(ExecutionPolicy&&, Span<const float> input, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Ceil_Parallel(input, output);
+	else
+		Ceil(input, output);
+}
+
+template<typename ExecutionPolicy, typename>
+void Math::Round(ExecutionPolicy&&, Span<const float> input, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Round_Parallel(input, output);
+	else
+		Round(input, output);
+}
+
+template<typename ExecutionPolicy, typename>
+void Math::Clamp(ExecutionPolicy&&, Span<const float> input, float min, float max, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Clamp_Parallel(input, min, max, output);
+	else
+		Clamp(input, min, max, output);
+}
+
+template<typename ExecutionPolicy, typename>
+void Math::Lerp(ExecutionPolicy&&, Span<const float> input1, Span<const float> input2, float delta, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Lerp_Parallel(input1, input2, delta, output);
+	else
+		Lerp(input1, input2, delta, output);
+}
+
+template<typename ExecutionPolicy, typename>
+void Math::Lerp(ExecutionPolicy&&, Span<const float> input1, Span<const float> input2, Span<const float> delta, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Lerp_Parallel(input1, input2, delta, output);
+	else
+		Lerp(input1, input2, delta, output);
+}
+
+template<typename ExecutionPolicy, typename>
+void Math::LerpClamped(ExecutionPolicy&&, Span<const float> input1, Span<const float> input2, float delta, float min, float max, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		LerpClamped_Parallel(input1, input2, delta, min, max, output);
+	else
+		LerpClamped(input1, input2, delta, min, max, output);
+}
+
+template<typename ExecutionPolicy, typename>
+void Math::Log(ExecutionPolicy&&, Span<const float> input, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Log_Parallel(input, output);
+	else
+		Log(input, output);
+}
+
+template<typename ExecutionPolicy, typename>
+void Math::Pow(ExecutionPolicy&&, Span<const float> coefficient, float exponent, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Pow_Parallel(coefficient, exponent, output);
+	else
+		Pow(coefficient, exponent, output);
+}
+
+template<typename ExecutionPolicy, typename>
+void Math::Pow(ExecutionPolicy&&, Span<const float> coefficient, Span<const float> exponent, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Pow_Parallel(coefficient, exponent, output);
+	else
+		Pow(coefficient, exponent, output);
+}
+
+template<typename ExecutionPolicy, typename>
+void Math::Hypot(ExecutionPolicy&&, Span<const float> x, Span<const float> y, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Hypot_Parallel(x, y, output);
+	else
+		Hypot(x, y, output);
+}
+
+template<typename ExecutionPolicy, typename>
+void Math::Hypot(ExecutionPolicy&&, Span<const float> x, Span<const float> y, Span<const float> z, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Hypot_Parallel(x, y, z, output);
+	else
+		Hypot(x, y, z, output);
+}
\ No newline at end of file
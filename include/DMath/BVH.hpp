@@ -0,0 +1,1024 @@
+#pragma once
+
+#include "Common.hpp"
+#include "Vector/Vector.hpp"
+#include "BoundingVolume.hpp"
+#include "Ray.hpp"
+#include "Span.hpp"
+#include "Simd.hpp"
+#include "Parallel.hpp"
+#include "Morton.hpp"
+#include "Enum.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Math
+{
+	// Four-wide bounding volume hierarchy over arbitrary primitives, described by their bounding boxes.
+	// Built top-down with binned SAH, or bottom-up from Morton order (LBVH), then collapsed from a binary tree into nodes that each hold the
+	// bounds of up to four children in structure-of-arrays form, so one node visit tests all four children at once.
+	template<typename T = float>
+	class BVH4
+	{
+	public:
+		using ValueType = T;
+
+		struct alignas(64) Node
+		{
+			T minX[4];
+			T minY[4];
+			T minZ[4];
+			T maxX[4];
+			T maxY[4];
+			T maxZ[4];
+			// Index of the child node, or of the first primitive in GetPrimitiveIndices() for leaf children.
+			uint32_t children[4];
+			// Zero for interior children.
+			uint32_t primitiveCounts[4];
+			uint32_t childCount;
+
+			[[nodiscard]] constexpr bool IsLeaf(size_t slot) const
+			{
+				return primitiveCounts[slot] != 0;
+			}
+			[[nodiscard]] constexpr AABB3D<T> GetChildBounds(size_t slot) const
+			{
+				return AABB3D<T>{ Vector<3, T>{ minX[slot], minY[slot], minZ[slot] }, Vector<3, T>{ maxX[slot], maxY[slot], maxZ[slot] } };
+			}
+			constexpr void SetChildBounds(size_t slot, const AABB3D<T>& bounds)
+			{
+				minX[slot] = bounds.min.x;
+				minY[slot] = bounds.min.y;
+				minZ[slot] = bounds.min.z;
+				maxX[slot] = bounds.max.x;
+				maxY[slot] = bounds.max.y;
+				maxZ[slot] = bounds.max.z;
+			}
+		};
+
+		struct BuildSettings
+		{
+			BVHBuildMethod method = BVHBuildMethod::BinnedSAH;
+			// Leaves never hold more primitives than this.
+			uint32_t maxLeafSize = 4;
+			// Number of SAH bins per axis. At most 32. Unused by the linear builder.
+			uint32_t binCount = 16;
+			T traversalCost = T(1);
+			T intersectionCost = T(1);
+			bool parallel = true;
+			// Subtrees with fewer primitives than this are built by a single thread. Unused by the linear builder.
+			uint32_t parallelSubtreeSize = 8192;
+		};
+
+		BVH4() = default;
+
+		[[nodiscard]] static BVH4<T> Build(Span<const AABB3D<T>> primitiveBounds, const BuildSettings& settings = BuildSettings{});
+
+		// Recomputes every node's bounds from new primitive bounds, keeping the topology.
+		// primitiveBounds must be indexed like the input to Build.
+		void Refit(Span<const AABB3D<T>> primitiveBounds);
+
+		[[nodiscard]] const std::vector<Node>& GetNodes() const;
+		// Maps the ordered primitive indices passed to the traversal callbacks back to indices in the input to Build.
+		[[nodiscard]] const std::vector<uint32_t>& GetPrimitiveIndices() const;
+		[[nodiscard]] AABB3D<T> GetBounds() const;
+		[[nodiscard]] bool IsEmpty() const;
+
+		// Visits primitives along the ray front to back. intersectPrimitive(orderedIndex, tMax) performs the
+		// primitive test, reduces tMax on a hit and returns true to end the traversal early.
+		template<typename Func>
+		void TraverseRay(const Ray<T>& ray, T tMin, T& tMax, Func&& intersectPrimitive) const;
+
+		// Calls visitPrimitive(orderedIndex) for every primitive in a leaf whose bounds overlap the box.
+		template<typename Func>
+		void QueryAABB(const AABB3D<T>& box, Func&& visitPrimitive) const;
+
+		// Calls visitPrimitive(orderedIndex) for every primitive in a leaf whose bounds overlap the sphere.
+		template<typename Func>
+		void QuerySphere(const Sphere<T>& sphere, Func&& visitPrimitive) const;
+
+	private:
+		std::vector<Node> nodes;
+		std::vector<uint32_t> primitiveIndices;
+
+		static_assert(std::is_floating_point_v<T>, "DMath error. Math::BVH4 must be of floating point type.");
+	};
+
+	// BVH4 over a static or deforming triangle mesh. Triangles are stored in traversal order.
+	template<typename T = float>
+	class TriangleMeshBVH
+	{
+	public:
+		using ValueType = T;
+
+		TriangleMeshBVH() = default;
+		explicit TriangleMeshBVH(Span<const Triangle<T>> triangles, const typename BVH4<T>::BuildSettings& settings = typename BVH4<T>::BuildSettings{});
+
+		// Closest hit. RayHit::primitiveIndex is the index of the triangle in the constructor input.
+		[[nodiscard]] std::optional<RayHit<T>> Intersect(const Ray<T>& ray, T tMin = T(0), T tMax = std::numeric_limits<T>::max()) const;
+		// Any hit. Cheaper than Intersect, intended for shadow and visibility rays.
+		[[nodiscard]] bool IsOccluded(const Ray<T>& ray, T tMin = T(0), T tMax = std::numeric_limits<T>::max()) const;
+
+		// Appends the indices of triangles whose bounds overlap the box.
+		void QueryAABB(const AABB3D<T>& box, std::vector<uint32_t>& triangleIndices) const;
+		// Appends the indices of triangles that intersect the sphere.
+		void QuerySphere(const Sphere<T>& sphere, std::vector<uint32_t>& triangleIndices) const;
+
+		// Updates vertex positions of a deforming mesh. Triangles must be in the same order as in the constructor.
+		void Refit(Span<const Triangle<T>> triangles);
+
+		[[nodiscard]] const BVH4<T>& GetBVH() const;
+
+	private:
+		BVH4<T> bvh;
+		std::vector<Triangle<T>> orderedTriangles;
+	};
+
+	namespace detail
+	{
+		namespace BVH
+		{
+			constexpr uint32_t maxBinCount = 32;
+			// Ranges with at least this many primitives are binned by several threads.
+			constexpr uint32_t parallelBinningSize = 1u << 16;
+
+			template<typename T>
+			struct BuildNode
+			{
+				AABB3D<T> bounds;
+				uint32_t left;
+				uint32_t right;
+				uint32_t first;
+				// Non-zero for leaves.
+				uint32_t count;
+			};
+
+			template<typename T>
+			struct BuildTask
+			{
+				uint32_t nodeIndex;
+				uint32_t first;
+				uint32_t count;
+			};
+
+			template<typename T>
+			struct Bin
+			{
+				AABB3D<T> bounds = AABB3D<T>::Empty();
+				uint32_t count = 0;
+			};
+
+			template<typename T>
+			struct BinSet
+			{
+				std::array<std::array<Bin<T>, maxBinCount>, 3> bins;
+				AABB3D<T> bounds = AABB3D<T>::Empty();
+				AABB3D<T> centroidBounds = AABB3D<T>::Empty();
+
+				void Merge(const BinSet<T>& other)
+				{
+					for (size_t axis = 0; axis < 3; axis++)
+					{
+						for (size_t i = 0; i < maxBinCount; i++)
+						{
+							bins[axis][i].bounds.Merge(other.bins[axis][i].bounds);
+							bins[axis][i].count += other.bins[axis][i].count;
+						}
+					}
+					bounds.Merge(other.bounds);
+					centroidBounds.Merge(other.centroidBounds);
+				}
+			};
+
+			template<typename T>
+			struct BuildContext
+			{
+				Span<const AABB3D<T>> primitiveBounds;
+				std::vector<Vector<3, T>> centroids;
+				std::vector<uint32_t> indices;
+				typename BVH4<T>::BuildSettings settings;
+			};
+
+			template<typename T>
+			[[nodiscard]] inline uint32_t GetBinIndex(T centroid, T centroidMin, T binScale, uint32_t binCount)
+			{
+				const auto bin = int64_t((centroid - centroidMin) * binScale);
+				return uint32_t(std::clamp<int64_t>(bin, 0, int64_t(binCount) - 1));
+			}
+
+			template<typename T>
+			void ComputeRangeBounds(const BuildContext<T>& context, uint32_t begin, uint32_t end, AABB3D<T>& bounds, AABB3D<T>& centroidBounds)
+			{
+				for (uint32_t i = begin; i < end; i++)
+				{
+					const uint32_t primitive = context.indices[i];
+					bounds.Merge(context.primitiveBounds[primitive]);
+					centroidBounds.Merge(context.centroids[primitive]);
+				}
+			}
+
+			template<typename T>
+			void BinRange(const BuildContext<T>& context, uint32_t begin, uint32_t end, const AABB3D<T>& centroidBounds, BinSet<T>& binSet)
+			{
+				const uint32_t binCount = context.settings.binCount;
+				T binScales[3];
+				for (size_t axis = 0; axis < 3; axis++)
+				{
+					const T extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+					binScales[axis] = extent > T(0) ? T(binCount) / extent : T(0);
+				}
+
+				for (uint32_t i = begin; i < end; i++)
+				{
+					const uint32_t primitive = context.indices[i];
+					const auto& centroid = context.centroids[primitive];
+					const auto& primitiveBounds = context.primitiveBounds[primitive];
+					for (size_t axis = 0; axis < 3; axis++)
+					{
+						auto& bin = binSet.bins[axis][GetBinIndex(centroid[axis], centroidBounds.min[axis], binScales[axis], binCount)];
+						bin.bounds.Merge(primitiveBounds);
+						bin.count++;
+					}
+				}
+			}
+
+			// Computes the bounds of the range, picks the best SAH split and partitions the range around it.
+			// Returns the number of primitives moved to the left child, or 0 when the range should become a leaf.
+			template<typename T>
+			[[nodiscard]] uint32_t SplitRange(BuildContext<T>& context, uint32_t first, uint32_t count, AABB3D<T>& bounds)
+			{
+				const auto& settings = context.settings;
+				const uint32_t end = first + count;
+				const bool parallel = settings.parallel && count >= parallelBinningSize;
+				constexpr uint32_t chunkSize = parallelBinningSize / 4;
+
+				AABB3D<T> centroidBounds = AABB3D<T>::Empty();
+				bounds = AABB3D<T>::Empty();
+				if (parallel)
+				{
+					std::vector<std::pair<AABB3D<T>, AABB3D<T>>> partials((count + chunkSize - 1) / chunkSize, { AABB3D<T>::Empty(), AABB3D<T>::Empty() });
+					ParallelFor(first, end, chunkSize, [&](size_t begin, size_t chunkEnd)
+					{
+						auto& partial = partials[(begin - first) / chunkSize];
+						ComputeRangeBounds(context, uint32_t(begin), uint32_t(chunkEnd), partial.first, partial.second);
+					});
+					for (const auto& partial : partials)
+					{
+						bounds.Merge(partial.first);
+						centroidBounds.Merge(partial.second);
+					}
+				}
+				else
+					ComputeRangeBounds(context, first, end, bounds, centroidBounds);
+
+				if (count <= 1)
+					return 0;
+
+				BinSet<T> binSet;
+				if (parallel)
+				{
+					std::vector<BinSet<T>> partials((count + chunkSize - 1) / chunkSize);
+					ParallelFor(first, end, chunkSize, [&](size_t begin, size_t chunkEnd)
+					{
+						BinRange(context, uint32_t(begin), uint32_t(chunkEnd), centroidBounds, partials[(begin - first) / chunkSize]);
+					});
+					for (const auto& partial : partials)
+						binSet.Merge(partial);
+				}
+				else
+					BinRange(context, first, end, centroidBounds, binSet);
+
+				// Sweeps each axis from both ends to evaluate the SAH cost of every bin boundary.
+				const uint32_t binCount = settings.binCount;
+				const T inverseArea = T(1) / std::max(bounds.SurfaceArea(), std::numeric_limits<T>::min());
+				T bestCost = std::numeric_limits<T>::max();
+				size_t bestAxis = 0;
+				uint32_t bestSplit = 0;
+				for (size_t axis = 0; axis < 3; axis++)
+				{
+					if (!(centroidBounds.max[axis] > centroidBounds.min[axis]))
+						continue;
+
+					const auto& bins = binSet.bins[axis];
+					std::array<T, maxBinCount> rightAreas;
+					std::array<uint32_t, maxBinCount> rightCounts;
+					AABB3D<T> rightBounds = AABB3D<T>::Empty();
+					uint32_t rightCount = 0;
+					for (uint32_t i = binCount - 1; i > 0; i--)
+					{
+						rightBounds.Merge(bins[i].bounds);
+						rightCount += bins[i].count;
+						rightAreas[i] = rightBounds.SurfaceArea();
+						rightCounts[i] = rightCount;
+					}
+
+					AABB3D<T> leftBounds = AABB3D<T>::Empty();
+					uint32_t leftCount = 0;
+					for (uint32_t i = 0; i < binCount - 1; i++)
+					{
+						leftBounds.Merge(bins[i].bounds);
+						leftCount += bins[i].count;
+						if (leftCount == 0 || rightCounts[i + 1] == 0)
+							continue;
+						const T cost = settings.traversalCost + settings.intersectionCost * inverseArea * (leftBounds.SurfaceArea() * T(leftCount) + rightAreas[i + 1] * T(rightCounts[i + 1]));
+						if (cost < bestCost)
+						{
+							bestCost = cost;
+							bestAxis = axis;
+							bestSplit = i + 1;
+						}
+					}
+				}
+
+				const T leafCost = settings.intersectionCost * T(count);
+				if (bestSplit == 0)
+				{
+					// Every centroid falls in one bin. Splits by index if the range is too big for a leaf.
+					if (count <= settings.maxLeafSize)
+						return 0;
+					return count / 2;
+				}
+				if (count <= settings.maxLeafSize && leafCost <= bestCost)
+					return 0;
+
+				const T centroidMin = centroidBounds.min[bestAxis];
+				const T binScale = T(binCount) / (centroidBounds.max[bestAxis] - centroidMin);
+				const auto middle = std::partition(context.indices.begin() + first, context.indices.begin() + end, [&](uint32_t primitive)
+				{
+					return GetBinIndex(context.centroids[primitive][bestAxis], centroidMin, binScale, binCount) < bestSplit;
+				});
+				const auto leftCount = uint32_t(middle - (context.indices.begin() + first));
+				if (leftCount == 0 || leftCount == count)
+					return count / 2;
+				return leftCount;
+			}
+
+			// Builds the subtree rooted at nodes[rootIndex]. Tasks smaller than deferSize are appended to deferredTasks instead of being built.
+			template<typename T>
+			void BuildSubtree(BuildContext<T>& context, std::vector<BuildNode<T>>& nodes, uint32_t rootIndex, uint32_t first, uint32_t count, uint32_t deferSize, std::vector<BuildTask<T>>* deferredTasks)
+			{
+				std::vector<BuildTask<T>> stack;
+				stack.push_back(BuildTask<T>{ rootIndex, first, count });
+				while (!stack.empty())
+				{
+					const BuildTask<T> task = stack.back();
+					stack.pop_back();
+
+					if (deferredTasks && task.count < deferSize)
+					{
+						deferredTasks->push_back(task);
+						continue;
+					}
+
+					AABB3D<T> bounds;
+					const uint32_t leftCount = SplitRange(context, task.first, task.count, bounds);
+					nodes[task.nodeIndex].bounds = bounds;
+					if (leftCount == 0)
+					{
+						nodes[task.nodeIndex].first = task.first;
+						nodes[task.nodeIndex].count = task.count;
+						continue;
+					}
+
+					const auto leftIndex = uint32_t(nodes.size());
+					nodes.push_back(BuildNode<T>{});
+					nodes.push_back(BuildNode<T>{});
+					nodes[task.nodeIndex].left = leftIndex;
+					nodes[task.nodeIndex].right = leftIndex + 1;
+					nodes[task.nodeIndex].count = 0;
+					stack.push_back(BuildTask<T>{ leftIndex + 1, task.first + leftCount, task.count - leftCount });
+					stack.push_back(BuildTask<T>{ leftIndex, task.first, leftCount });
+				}
+			}
+
+			template<typename T>
+			void BuildBinaryTree(BuildContext<T>& context, std::vector<BuildNode<T>>& nodes)
+			{
+				const auto primitiveCount = uint32_t(context.indices.size());
+				nodes.push_back(BuildNode<T>{});
+
+				const bool parallel = context.settings.parallel && GetParallelThreadCount() > 1 && primitiveCount >= context.settings.parallelSubtreeSize;
+				if (!parallel)
+				{
+					BuildSubtree(context, nodes, 0, 0, primitiveCount, 0, static_cast<std::vector<BuildTask<T>>*>(nullptr));
+					return;
+				}
+
+				// Builds the top of the tree on this thread, leaving the small subtrees to be built concurrently.
+				std::vector<BuildTask<T>> deferredTasks;
+				BuildSubtree(context, nodes, 0, 0, primitiveCount, context.settings.parallelSubtreeSize, &deferredTasks);
+
+				std::vector<std::vector<BuildNode<T>>> subtrees(deferredTasks.size());
+				ParallelFor(0, deferredTasks.size(), 1, [&](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						subtrees[i].push_back(BuildNode<T>{});
+						BuildSubtree(context, subtrees[i], 0, deferredTasks[i].first, deferredTasks[i].count, 0, static_cast<std::vector<BuildTask<T>>*>(nullptr));
+					}
+				});
+
+				// Stitches each subtree in place of its placeholder node.
+				for (size_t i = 0; i < deferredTasks.size(); i++)
+				{
+					const auto offset = uint32_t(nodes.size()) - 1;
+					auto& subtree = subtrees[i];
+					for (auto& node : subtree)
+					{
+						if (node.count == 0)
+						{
+							node.left += offset;
+							node.right += offset;
+						}
+					}
+					nodes[deferredTasks[i].nodeIndex] = subtree[0];
+					nodes.insert(nodes.end(), subtree.begin() + 1, subtree.end());
+				}
+			}
+
+			[[nodiscard]] inline int CountLeadingZeros(uint64_t value)
+			{
+				assert(value != 0);
+#if defined( _MSC_VER )
+				unsigned long index;
+				_BitScanReverse64(&index, value);
+				return 63 - int(index);
+#else
+				return __builtin_clzll(value);
+#endif
+			}
+
+			// Length of the common prefix of the keys at sorted positions i and j, or -1 when j is out of range.
+			// Equal codes are told apart by their positions, as in Karras 2012.
+			[[nodiscard]] inline int GetCommonPrefixLength(const std::vector<uint64_t>& codes, int64_t i, int64_t j)
+			{
+				if (j < 0 || j >= int64_t(codes.size()))
+					return -1;
+				if (codes[size_t(i)] == codes[size_t(j)])
+					return 64 + CountLeadingZeros(uint64_t(i ^ j));
+				return CountLeadingZeros(codes[size_t(i)] ^ codes[size_t(j)]);
+			}
+
+			// Builds a binary radix tree over primitives sorted by the Morton codes of their centroids (Karras 2012).
+			// Internal node i is nodes[i] and leaf i is nodes[primitiveCount - 1 + i], so every node is built independently.
+			// Bounds are then merged bottom-up: the second child to arrive at a parent computes its bounds.
+			template<typename T>
+			void BuildLinearTree(BuildContext<T>& context, std::vector<BuildNode<T>>& nodes)
+			{
+				const auto primitiveCount = uint32_t(context.indices.size());
+				const bool parallel = context.settings.parallel;
+				const size_t grainSize = parallel ? Setup::defaultParallelGrainSize : primitiveCount;
+				const Span<const Vector<3, T>> centroids(context.centroids);
+
+				std::vector<uint64_t> codes(primitiveCount);
+				if (parallel)
+				{
+					ComputeMortonCodes63_Parallel<T>(centroids, ComputeBounds_Parallel<T>(centroids, grainSize), Span<uint64_t>(codes), grainSize);
+					RadixSort_Parallel(Span<uint64_t>(codes), Span<uint32_t>(context.indices), grainSize);
+				}
+				else
+				{
+					ComputeMortonCodes63<T>(centroids, ComputeBounds<T>(centroids), Span<uint64_t>(codes));
+					Math::RadixSort(Span<uint64_t>(codes), Span<uint32_t>(context.indices));
+				}
+
+				if (primitiveCount == 1)
+				{
+					nodes.push_back(BuildNode<T>{ context.primitiveBounds[context.indices[0]], 0, 0, 0, 1 });
+					return;
+				}
+
+				const uint32_t leafOffset = primitiveCount - 1;
+				nodes.resize(size_t(primitiveCount) * 2 - 1);
+				std::vector<uint32_t> parents(nodes.size());
+				ParallelFor(0, leafOffset, grainSize, [&](size_t begin, size_t end)
+				{
+					for (size_t node = begin; node < end; node++)
+					{
+						const auto i = int64_t(node);
+						const int direction = GetCommonPrefixLength(codes, i, i + 1) > GetCommonPrefixLength(codes, i, i - 1) ? 1 : -1;
+						const int minPrefix = GetCommonPrefixLength(codes, i, i - direction);
+
+						// Finds the other end of the range with an exponential then a binary search.
+						int64_t maxLength = 2;
+						while (GetCommonPrefixLength(codes, i, i + maxLength * direction) > minPrefix)
+							maxLength *= 2;
+						int64_t length = 0;
+						for (int64_t step = maxLength / 2; step > 0; step /= 2)
+						{
+							if (GetCommonPrefixLength(codes, i, i + (length + step) * direction) > minPrefix)
+								length += step;
+						}
+						const int64_t j = i + length * direction;
+
+						// Finds the position where the prefix shared by the whole range ends.
+						const int nodePrefix = GetCommonPrefixLength(codes, i, j);
+						int64_t split = 0;
+						int64_t step = length;
+						do
+						{
+							step = (step + 1) / 2;
+							if (split + step < length && GetCommonPrefixLength(codes, i, i + (split + step) * direction) > nodePrefix)
+								split += step;
+						} while (step > 1);
+						const int64_t splitPosition = i + split * direction + std::min(direction, 0);
+
+						const auto first = uint32_t(std::min(i, j));
+						const auto last = uint32_t(std::max(i, j));
+						const auto left = uint32_t(first == splitPosition ? leafOffset + splitPosition : splitPosition);
+						const auto right = uint32_t(last == splitPosition + 1 ? leafOffset + splitPosition + 1 : splitPosition + 1);
+						const uint32_t count = last - first + 1;
+						nodes[node].left = left;
+						nodes[node].right = right;
+						nodes[node].first = first;
+						// Small ranges become leaves. Their descendants stay in the array but are never reached.
+						nodes[node].count = count <= context.settings.maxLeafSize ? count : 0;
+						parents[left] = uint32_t(node);
+						parents[right] = uint32_t(node);
+					}
+				});
+
+				std::vector<std::atomic<uint32_t>> arrivals(leafOffset);
+				ParallelFor(0, primitiveCount, grainSize, [&](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						const size_t leaf = leafOffset + i;
+						nodes[leaf] = BuildNode<T>{ context.primitiveBounds[context.indices[i]], 0, 0, uint32_t(i), 1 };
+
+						for (uint32_t node = parents[leaf];; node = parents[node])
+						{
+							if (arrivals[node].fetch_add(1, std::memory_order_acq_rel) == 0)
+								break;
+							nodes[node].bounds = nodes[nodes[node].left].bounds.GetMerged(nodes[nodes[node].right].bounds);
+							if (node == 0)
+								break;
+						}
+					}
+				});
+			}
+
+			// Converts the binary node into a four-wide node, pulling up grandchildren with the largest surface area.
+			template<typename T>
+			uint32_t CollapseNode(const std::vector<BuildNode<T>>& binaryNodes, uint32_t binaryIndex, std::vector<typename BVH4<T>::Node>& nodes)
+			{
+				const auto nodeIndex = uint32_t(nodes.size());
+				nodes.emplace_back();
+
+				std::array<uint32_t, 4> slots;
+				uint32_t slotCount = 0;
+				const auto& binaryNode = binaryNodes[binaryIndex];
+				if (binaryNode.count != 0)
+					slots[slotCount++] = binaryIndex;
+				else
+				{
+					slots[slotCount++] = binaryNode.left;
+					slots[slotCount++] = binaryNode.right;
+				}
+
+				while (slotCount < 4)
+				{
+					uint32_t largestSlot = slotCount;
+					T largestArea = T(-1);
+					for (uint32_t i = 0; i < slotCount; i++)
+					{
+						const auto& candidate = binaryNodes[slots[i]];
+						if (candidate.count == 0 && candidate.bounds.SurfaceArea() > largestArea)
+						{
+							largestArea = candidate.bounds.SurfaceArea();
+							largestSlot = i;
+						}
+					}
+					if (largestSlot == slotCount)
+						break;
+					const auto& expanded = binaryNodes[slots[largestSlot]];
+					slots[largestSlot] = expanded.left;
+					slots[slotCount++] = expanded.right;
+				}
+
+				for (uint32_t slot = 0; slot < 4; slot++)
+				{
+					if (slot < slotCount)
+					{
+						const auto& child = binaryNodes[slots[slot]];
+						nodes[nodeIndex].SetChildBounds(slot, child.bounds);
+						nodes[nodeIndex].primitiveCounts[slot] = child.count;
+						if (child.count != 0)
+							nodes[nodeIndex].children[slot] = child.first;
+						else
+						{
+							// Recursion may reallocate the node array, so the node is indexed again afterwards.
+							const uint32_t childIndex = CollapseNode(binaryNodes, slots[slot], nodes);
+							nodes[nodeIndex].children[slot] = childIndex;
+						}
+					}
+					else
+					{
+						nodes[nodeIndex].SetChildBounds(slot, AABB3D<T>::Empty());
+						nodes[nodeIndex].primitiveCounts[slot] = 0;
+						nodes[nodeIndex].children[slot] = 0;
+					}
+				}
+				nodes[nodeIndex].childCount = slotCount;
+				return nodeIndex;
+			}
+
+			// Stack with inline storage, for traversal without allocation in the common case.
+			template<typename Entry, size_t inlineCapacity = 128>
+			class TraversalStack
+			{
+			public:
+				void Push(const Entry& entry)
+				{
+					if (size < inlineCapacity)
+						inlineEntries[size] = entry;
+					else
+						overflow.push_back(entry);
+					size++;
+				}
+				[[nodiscard]] Entry Pop()
+				{
+					assert(size > 0);
+					size--;
+					if (size < inlineCapacity)
+						return inlineEntries[size];
+					const Entry entry = overflow.back();
+					overflow.pop_back();
+					return entry;
+				}
+				[[nodiscard]] bool IsEmpty() const
+				{
+					return size == 0;
+				}
+
+			private:
+				Entry inlineEntries[inlineCapacity];
+				std::vector<Entry> overflow;
+				size_t size = 0;
+			};
+
+			// Slab test of the ray against the node's four children. Returns a bitmask of the children hit, with their entry distances.
+			template<typename T>
+			[[nodiscard]] inline uint32_t IntersectChildren(const typename BVH4<T>::Node& node, const Vector<3, T>& origin, const Vector<3, T>& inverseDirection, T tMin, T tMax, T(&entryDistances)[4])
+			{
+				const uint32_t validMask = (1u << node.childCount) - 1;
+#if defined( DMATH_SIMD_SSE2 )
+				if constexpr (std::is_same_v<T, float>)
+				{
+					const __m128 originX = _mm_set1_ps(origin.x);
+					const __m128 originY = _mm_set1_ps(origin.y);
+					const __m128 originZ = _mm_set1_ps(origin.z);
+					const __m128 inverseX = _mm_set1_ps(inverseDirection.x);
+					const __m128 inverseY = _mm_set1_ps(inverseDirection.y);
+					const __m128 inverseZ = _mm_set1_ps(inverseDirection.z);
+					const __m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minX), originX), inverseX);
+					const __m128 t2x = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxX), originX), inverseX);
+					const __m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minY), originY), inverseY);
+					const __m128 t2y = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxY), originY), inverseY);
+					const __m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minZ), originZ), inverseZ);
+					const __m128 t2z = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxZ), originZ), inverseZ);
+					const __m128 entry = _mm_max_ps(_mm_max_ps(_mm_min_ps(t1x, t2x), _mm_min_ps(t1y, t2y)), _mm_max_ps(_mm_min_ps(t1z, t2z), _mm_set1_ps(tMin)));
+					const __m128 exit = _mm_min_ps(_mm_min_ps(_mm_max_ps(t1x, t2x), _mm_max_ps(t1y, t2y)), _mm_min_ps(_mm_max_ps(t1z, t2z), _mm_set1_ps(tMax)));
+					_mm_storeu_ps(entryDistances, entry);
+					return uint32_t(_mm_movemask_ps(_mm_cmple_ps(entry, exit))) & validMask;
+				}
+#endif
+				uint32_t mask = 0;
+				for (size_t slot = 0; slot < 4; slot++)
+				{
+					const T t1x = (node.minX[slot] - origin.x) * inverseDirection.x;
+					const T t2x = (node.maxX[slot] - origin.x) * inverseDirection.x;
+					const T t1y = (node.minY[slot] - origin.y) * inverseDirection.y;
+					const T t2y = (node.maxY[slot] - origin.y) * inverseDirection.y;
+					const T t1z = (node.minZ[slot] - origin.z) * inverseDirection.z;
+					const T t2z = (node.maxZ[slot] - origin.z) * inverseDirection.z;
+					const T entry = std::max(std::max(std::min(t1x, t2x), std::min(t1y, t2y)), std::max(std::min(t1z, t2z), tMin));
+					const T exit = std::min(std::min(std::max(t1x, t2x), std::max(t1y, t2y)), std::min(std::max(t1z, t2z), tMax));
+					entryDistances[slot] = entry;
+					mask |= uint32_t(entry <= exit) << slot;
+				}
+				return mask & validMask;
+			}
+		}
+	}
+}
+
+template<typename T>
+Math::BVH4<T> Math::BVH4<T>::Build(Span<const AABB3D<T>> primitiveBounds, const BuildSettings& settings)
+{
+	assert(settings.binCount >= 2 && settings.binCount <= detail::BVH::maxBinCount);
+	assert(settings.maxLeafSize >= 1);
+	assert(primitiveBounds.size() < std::numeric_limits<uint32_t>::max());
+
+	BVH4<T> bvh;
+	const auto primitiveCount = uint32_t(primitiveBounds.size());
+	if (primitiveCount == 0)
+		return bvh;
+
+	detail::BVH::BuildContext<T> context;
+	context.primitiveBounds = primitiveBounds;
+	context.settings = settings;
+	context.centroids.resize(primitiveCount);
+	context.indices.resize(primitiveCount);
+	ParallelFor(0, primitiveCount, settings.parallel ? Setup::defaultParallelGrainSize : primitiveCount, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			context.centroids[i] = primitiveBounds[i].GetCenter();
+			context.indices[i] = uint32_t(i);
+		}
+	});
+
+	std::vector<detail::BVH::BuildNode<T>> binaryNodes;
+	binaryNodes.reserve(size_t(primitiveCount) * 2);
+	if (settings.method == BVHBuildMethod::Linear)
+		detail::BVH::BuildLinearTree(context, binaryNodes);
+	else
+		detail::BVH::BuildBinaryTree(context, binaryNodes);
+
+	bvh.nodes.reserve(binaryNodes.size() / 2 + 1);
+	detail::BVH::CollapseNode(binaryNodes, 0, bvh.nodes);
+	bvh.primitiveIndices = std::move(context.indices);
+	return bvh;
+}
+
+template<typename T>
+void Math::BVH4<T>::Refit(Span<const AABB3D<T>> primitiveBounds)
+{
+	assert(primitiveBounds.size() == primitiveIndices.size());
+
+	// Children are always stored after their parent, so a reverse sweep visits them first.
+	for (size_t i = nodes.size(); i-- > 0;)
+	{
+		Node& node = nodes[i];
+		for (uint32_t slot = 0; slot < node.childCount; slot++)
+		{
+			AABB3D<T> bounds = AABB3D<T>::Empty();
+			if (node.IsLeaf(slot))
+			{
+				const uint32_t first = node.children[slot];
+				for (uint32_t primitive = first; primitive < first + node.primitiveCounts[slot]; primitive++)
+					bounds.Merge(primitiveBounds[primitiveIndices[primitive]]);
+			}
+			else
+			{
+				const Node& child = nodes[node.children[slot]];
+				for (uint32_t childSlot = 0; childSlot < child.childCount; childSlot++)
+					bounds.Merge(child.GetChildBounds(childSlot));
+			}
+			node.SetChildBounds(slot, bounds);
+		}
+	}
+}
+
+template<typename T>
+const std::vector<typename Math::BVH4<T>::Node>& Math::BVH4<T>::GetNodes() const { return nodes; }
+
+template<typename T>
+const std::vector<uint32_t>& Math::BVH4<T>::GetPrimitiveIndices() const { return primitiveIndices; }
+
+template<typename T>
+Math::AABB3D<T> Math::BVH4<T>::GetBounds() const
+{
+	AABB3D<T> bounds = AABB3D<T>::Empty();
+	if (!nodes.empty())
+	{
+		for (uint32_t slot = 0; slot < nodes[0].childCount; slot++)
+			bounds.Merge(nodes[0].GetChildBounds(slot));
+	}
+	return bounds;
+}
+
+template<typename T>
+bool Math::BVH4<T>::IsEmpty() const { return nodes.empty(); }
+
+template<typename T>
+template<typename Func>
+void Math::BVH4<T>::TraverseRay(const Ray<T>& ray, T tMin, T& tMax, Func&& intersectPrimitive) const
+{
+	if (nodes.empty())
+		return;
+
+	struct Entry
+	{
+		uint32_t nodeIndex;
+		T entryDistance;
+	};
+
+	const Vector<3, T> inverseDirection = ray.GetInverseDirection();
+	detail::BVH::TraversalStack<Entry> stack;
+	stack.Push(Entry{ 0, tMin });
+	while (!stack.IsEmpty())
+	{
+		const Entry entry = stack.Pop();
+		// The closest hit may have moved in front of this node since it was pushed.
+		if (entry.entryDistance > tMax)
+			continue;
+
+		const Node& node = nodes[entry.nodeIndex];
+		T entryDistances[4];
+		uint32_t hitMask = detail::BVH::IntersectChildren<T>(node, ray.origin, inverseDirection, tMin, tMax, entryDistances);
+
+		Entry interiorHits[4];
+		uint32_t interiorHitCount = 0;
+		while (hitMask != 0)
+		{
+			uint32_t slot = 0;
+			while (!((hitMask >> slot) & 1u))
+				slot++;
+			hitMask &= hitMask - 1;
+
+			if (node.IsLeaf(slot))
+			{
+				const uint32_t first = node.children[slot];
+				for (uint32_t primitive = first; primitive < first + node.primitiveCounts[slot]; primitive++)
+				{
+					if (intersectPrimitive(primitive, tMax))
+						return;
+				}
+			}
+			else
+			{
+				// Insertion sort so the nearest child ends up on top of the stack.
+				uint32_t position = interiorHitCount++;
+				while (position > 0 && interiorHits[position - 1].entryDistance < entryDistances[slot])
+				{
+					interiorHits[position] = interiorHits[position - 1];
+					position--;
+				}
+				interiorHits[position] = Entry{ node.children[slot], entryDistances[slot] };
+			}
+		}
+		for (uint32_t i = 0; i < interiorHitCount; i++)
+			stack.Push(interiorHits[i]);
+	}
+}
+
+template<typename T>
+template<typename Func>
+void Math::BVH4<T>::QueryAABB(const AABB3D<T>& box, Func&& visitPrimitive) const
+{
+	if (nodes.empty())
+		return;
+
+	detail::BVH::TraversalStack<uint32_t> stack;
+	stack.Push(0);
+	while (!stack.IsEmpty())
+	{
+		const Node& node = nodes[stack.Pop()];
+		for (uint32_t slot = 0; slot < node.childCount; slot++)
+		{
+			const bool overlaps = node.minX[slot] <= box.max.x && box.min.x <= node.maxX[slot]
+				&& node.minY[slot] <= box.max.y && box.min.y <= node.maxY[slot]
+				&& node.minZ[slot] <= box.max.z && box.min.z <= node.maxZ[slot];
+			if (!overlaps)
+				continue;
+
+			if (node.IsLeaf(slot))
+			{
+				const uint32_t first = node.children[slot];
+				for (uint32_t primitive = first; primitive < first + node.primitiveCounts[slot]; primitive++)
+					visitPrimitive(primitive);
+			}
+			else
+				stack.Push(node.children[slot]);
+		}
+	}
+}
+
+template<typename T>
+template<typename Func>
+void Math::BVH4<T>::QuerySphere(const Sphere<T>& sphere, Func&& visitPrimitive) const
+{
+	if (nodes.empty())
+		return;
+
+	const T radiusSqrd = Sqrd(sphere.radius);
+	detail::BVH::TraversalStack<uint32_t> stack;
+	stack.Push(0);
+	while (!stack.IsEmpty())
+	{
+		const Node& node = nodes[stack.Pop()];
+		for (uint32_t slot = 0; slot < node.childCount; slot++)
+		{
+			const T dx = std::max(std::max(node.minX[slot] - sphere.center.x, sphere.center.x - node.maxX[slot]), T(0));
+			const T dy = std::max(std::max(node.minY[slot] - sphere.center.y, sphere.center.y - node.maxY[slot]), T(0));
+			const T dz = std::max(std::max(node.minZ[slot] - sphere.center.z, sphere.center.z - node.maxZ[slot]), T(0));
+			if (dx * dx + dy * dy + dz * dz > radiusSqrd)
+				continue;
+
+			if (node.IsLeaf(slot))
+			{
+				const uint32_t first = node.children[slot];
+				for (uint32_t primitive = first; primitive < first + node.primitiveCounts[slot]; primitive++)
+					visitPrimitive(primitive);
+			}
+			else
+				stack.Push(node.children[slot]);
+		}
+	}
+}
+
+template<typename T>
+Math::TriangleMeshBVH<T>::TriangleMeshBVH(Span<const Triangle<T>> triangles, const typename BVH4<T>::BuildSettings& settings)
+{
+	std::vector<AABB3D<T>> triangleBounds(triangles.size());
+	ParallelFor(0, triangles.size(), Setup::defaultParallelGrainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+			triangleBounds[i] = triangles[i].GetAABB();
+	});
+
+	bvh = BVH4<T>::Build(Span<const AABB3D<T>>(triangleBounds), settings);
+
+	const auto& primitiveIndices = bvh.GetPrimitiveIndices();
+	orderedTriangles.resize(primitiveIndices.size());
+	for (size_t i = 0; i < primitiveIndices.size(); i++)
+		orderedTriangles[i] = triangles[primitiveIndices[i]];
+}
+
+template<typename T>
+std::optional<Math::RayHit<T>> Math::TriangleMeshBVH<T>::Intersect(const Ray<T>& ray, T tMin, T tMax) const
+{
+	std::optional<RayHit<T>> closestHit;
+	bvh.TraverseRay(ray, tMin, tMax, [&](uint32_t primitive, T& currentMax)
+	{
+		const auto hit = IntersectRayTriangle(ray, orderedTriangles[primitive], tMin, currentMax);
+		if (hit)
+		{
+			currentMax = hit->distance;
+			closestHit = hit;
+			closestHit->primitiveIndex = primitive;
+		}
+		return false;
+	});
+
+	if (closestHit)
+		closestHit->primitiveIndex = bvh.GetPrimitiveIndices()[closestHit->primitiveIndex];
+	return closestHit;
+}
+
+template<typename T>
+bool Math::TriangleMeshBVH<T>::IsOccluded(const Ray<T>& ray, T tMin, T tMax) const
+{
+	bool occluded = false;
+	bvh.TraverseRay(ray, tMin, tMax, [&](uint32_t primitive, T& currentMax)
+	{
+		occluded = IntersectRayTriangle(ray, orderedTriangles[primitive], tMin, currentMax).has_value();
+		return occluded;
+	});
+	return occluded;
+}
+
+template<typename T>
+void Math::TriangleMeshBVH<T>::QueryAABB(const AABB3D<T>& box, std::vector<uint32_t>& triangleIndices) const
+{
+	const auto& primitiveIndices = bvh.GetPrimitiveIndices();
+	bvh.QueryAABB(box, [&](uint32_t primitive)
+	{
+		if (orderedTriangles[primitive].GetAABB().Intersects(box))
+			triangleIndices.push_back(primitiveIndices[primitive]);
+	});
+}
+
+template<typename T>
+void Math::TriangleMeshBVH<T>::QuerySphere(const Sphere<T>& sphere, std::vector<uint32_t>& triangleIndices) const
+{
+	const auto& primitiveIndices = bvh.GetPrimitiveIndices();
+	const T radiusSqrd = Sqrd(sphere.radius);
+	bvh.QuerySphere(sphere, [&](uint32_t primitive)
+	{
+		if ((orderedTriangles[primitive].GetClosestPoint(sphere.center) - sphere.center).MagnitudeSqrd() <= radiusSqrd)
+			triangleIndices.push_back(primitiveIndices[primitive]);
+	});
+}
+
+template<typename T>
+void Math::TriangleMeshBVH<T>::Refit(Span<const Triangle<T>> triangles)
+{
+	const auto& primitiveIndices = bvh.GetPrimitiveIndices();
+	assert(triangles.size() == primitiveIndices.size());
+
+	std::vector<AABB3D<T>> triangleBounds(triangles.size());
+	ParallelFor(0, triangles.size(), Setup::defaultParallelGrainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			triangleBounds[i] = triangles[i].GetAABB();
+			orderedTriangles[i] = triangles[primitiveIndices[i]];
+		}
+	});
+	bvh.Refit(Span<const AABB3D<T>>(triangleBounds));
+}
+
+template<typename T>
+const Math::BVH4<T>& Math::TriangleMeshBVH<T>::GetBVH() const { return bvh; }
\ No newline at end of file
@@ -0,0 +1,453 @@
+#pragma once
+
+#include "Vector/Vector.hpp"
+#include "Enum.hpp"
+#include "Memory.hpp"
+#include "Span.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if defined( _WIN32 )
+#	define DMATH_FILE_MAPPING_WIN32
+#	if !defined( WIN32_LEAN_AND_MEAN )
+#		define WIN32_LEAN_AND_MEAN
+#		define DMATH_UNDEF_WIN32_LEAN_AND_MEAN
+#	endif
+#	if !defined( NOMINMAX )
+#		define NOMINMAX
+#		define DMATH_UNDEF_NOMINMAX
+#	endif
+#	include <windows.h>
+#	if defined( DMATH_UNDEF_WIN32_LEAN_AND_MEAN )
+#		undef WIN32_LEAN_AND_MEAN
+#		undef DMATH_UNDEF_WIN32_LEAN_AND_MEAN
+#	endif
+#	if defined( DMATH_UNDEF_NOMINMAX )
+#		undef NOMINMAX
+#		undef DMATH_UNDEF_NOMINMAX
+#	endif
+#elif __has_include(<sys/mman.h>)
+#	define DMATH_FILE_MAPPING_POSIX
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace Math
+{
+	// Start of a DMath binary container. The elements follow at dataOffset, tightly packed in the byte order of the writer.
+	struct BinaryFileHeader
+	{
+		char magic[4];
+		uint32_t version;
+		// 0x01020304 as stored by the writer.
+		uint32_t byteOrderMark;
+		uint32_t scalarType;
+		// Columns of a matrix, length of a vector and 1 for scalars.
+		uint32_t width;
+		// Rows of a matrix and 1 otherwise.
+		uint32_t height;
+		uint32_t elementSize;
+		// Alignment of dataOffset within the file.
+		uint32_t alignment;
+		uint64_t count;
+		uint64_t dataOffset;
+		uint8_t reserved[16];
+	};
+
+	// Writes the elements as a binary container, in native byte order. Returns false if the file could not be written.
+	// T is a scalar, Vector or Matrix of float, double, int32_t or uint32_t.
+	template<typename T>
+	[[nodiscard]] bool WriteBinaryFile(const char* path, Span<const T> elements);
+
+	// Read only view of a binary container.
+	// A mapped file is not read until its elements are accessed, and several processes share its pages.
+	// Files in the other byte order are read and converted instead of mapped.
+	class BinaryFile
+	{
+	public:
+		BinaryFile() = default;
+		explicit BinaryFile(const char* path, BinaryFileAccess access = BinaryFileAccess::Map);
+		~BinaryFile();
+		BinaryFile(BinaryFile&& other) noexcept;
+		BinaryFile& operator=(BinaryFile&& other) noexcept;
+		BinaryFile(const BinaryFile&) = delete;
+		BinaryFile& operator=(const BinaryFile&) = delete;
+
+		// Closes the current file first.
+		BinaryFileStatus Open(const char* path, BinaryFileAccess access = BinaryFileAccess::Map);
+		void Close();
+
+		[[nodiscard]] BinaryFileStatus GetStatus() const;
+		[[nodiscard]] bool IsOpen() const;
+		[[nodiscard]] bool IsMapped() const;
+		[[nodiscard]] const BinaryFileHeader& GetHeader() const;
+
+		// Whether the file holds elements of type T.
+		template<typename T>
+		[[nodiscard]] bool Holds() const;
+		// The elements without copying them, empty unless Holds<T>(). Valid until the file is closed.
+		template<typename T>
+		[[nodiscard]] Span<const T> GetElements() const;
+
+	private:
+		BinaryFileHeader header{};
+		BinaryFileStatus status = BinaryFileStatus::Closed;
+		void* mapping = nullptr;
+		size_t mappingSize = 0;
+		std::byte* buffer = nullptr;
+		const std::byte* elements = nullptr;
+
+		[[nodiscard]] BinaryFileStatus Map(const char* path);
+		[[nodiscard]] BinaryFileStatus Read(const char* path);
+	};
+
+	namespace detail
+	{
+		namespace BinaryFile
+		{
+			constexpr char magic[4] = { 'D', 'M', 'T', 'H' };
+			constexpr uint32_t version = 1;
+			constexpr uint32_t byteOrderMark = 0x01020304u;
+			constexpr uint32_t alignment = 64;
+
+			static_assert(sizeof(BinaryFileHeader) == alignment, "DMath error. The binary container header must fill one alignment unit.");
+
+			template<typename T>
+			struct ScalarTraits;
+			template<>
+			struct ScalarTraits<float> { static constexpr BinaryScalarType type = BinaryScalarType::Float32; };
+			template<>
+			struct ScalarTraits<double> { static constexpr BinaryScalarType type = BinaryScalarType::Float64; };
+			template<>
+			struct ScalarTraits<int32_t> { static constexpr BinaryScalarType type = BinaryScalarType::Int32; };
+			template<>
+			struct ScalarTraits<uint32_t> { static constexpr BinaryScalarType type = BinaryScalarType::UInt32; };
+
+			template<typename T>
+			struct ElementTraits
+			{
+				static constexpr BinaryScalarType scalarType = ScalarTraits<T>::type;
+				static constexpr uint32_t width = 1;
+				static constexpr uint32_t height = 1;
+			};
+
+			template<size_t length, typename T>
+			struct ElementTraits<Math::Vector<length, T>>
+			{
+				static constexpr BinaryScalarType scalarType = ScalarTraits<T>::type;
+				static constexpr uint32_t width = uint32_t(length);
+				static constexpr uint32_t height = 1;
+			};
+
+			template<size_t widthValue, size_t heightValue, typename T>
+			struct ElementTraits<Math::Matrix<widthValue, heightValue, T>>
+			{
+				static constexpr BinaryScalarType scalarType = ScalarTraits<T>::type;
+				static constexpr uint32_t width = uint32_t(widthValue);
+				static constexpr uint32_t height = uint32_t(heightValue);
+			};
+
+			[[nodiscard]] constexpr size_t GetScalarSize(uint32_t scalarType)
+			{
+				return scalarType == uint32_t(BinaryScalarType::Float64) ? 8 : 4;
+			}
+
+			template<typename T>
+			[[nodiscard]] T SwapBytes(T value)
+			{
+				unsigned char bytes[sizeof(T)];
+				std::memcpy(bytes, &value, sizeof(T));
+				for (size_t i = 0; i < sizeof(T) / 2; i++)
+					std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+				std::memcpy(&value, bytes, sizeof(T));
+				return value;
+			}
+
+			template<typename Scalar>
+			void SwapScalars(std::byte* data, size_t byteCount)
+			{
+				for (size_t offset = 0; offset < byteCount; offset += sizeof(Scalar))
+				{
+					Scalar value;
+					std::memcpy(&value, data + offset, sizeof(Scalar));
+					value = SwapBytes(value);
+					std::memcpy(data + offset, &value, sizeof(Scalar));
+				}
+			}
+
+			inline void SwapHeader(BinaryFileHeader& header)
+			{
+				header.version = SwapBytes(header.version);
+				header.byteOrderMark = SwapBytes(header.byteOrderMark);
+				header.scalarType = SwapBytes(header.scalarType);
+				header.width = SwapBytes(header.width);
+				header.height = SwapBytes(header.height);
+				header.elementSize = SwapBytes(header.elementSize);
+				header.alignment = SwapBytes(header.alignment);
+				header.count = SwapBytes(header.count);
+				header.dataOffset = SwapBytes(header.dataOffset);
+			}
+
+			// Checks the header in native byte order against the size of the file it came from.
+			[[nodiscard]] inline BinaryFileStatus Validate(const BinaryFileHeader& header, uint64_t fileSize)
+			{
+				if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.byteOrderMark != byteOrderMark)
+					return BinaryFileStatus::InvalidFormat;
+				if (header.version > version)
+					return BinaryFileStatus::UnsupportedVersion;
+				if (header.scalarType > uint32_t(BinaryScalarType::UInt32)
+					|| uint64_t(header.width) * header.height * GetScalarSize(header.scalarType) != header.elementSize
+					|| header.dataOffset < sizeof(BinaryFileHeader)
+					|| header.dataOffset > fileSize
+					|| (header.elementSize != 0 && header.count > (fileSize - header.dataOffset) / header.elementSize))
+					return BinaryFileStatus::InvalidFormat;
+				// Mapped elements are used in place, so the data must start on the alignment of the element type,
+				// which is the scalar size for every type the header describes, and on the alignment the header declares.
+				if (header.alignment == 0 || (header.alignment & (header.alignment - 1)) != 0
+					|| header.dataOffset % std::max<uint64_t>(GetScalarSize(header.scalarType), header.alignment) != 0)
+					return BinaryFileStatus::InvalidFormat;
+				return BinaryFileStatus::Ok;
+			}
+		}
+	}
+}
+
+template<typename T>
+bool Math::WriteBinaryFile(const char* path, Span<const T> elements)
+{
+	static_assert(std::is_trivially_copyable_v<T>, "DMath error. Math::WriteBinaryFile elements must be trivially copyable.");
+
+	using Traits = detail::BinaryFile::ElementTraits<T>;
+	static_assert(sizeof(T) == Traits::width * Traits::height * detail::BinaryFile::GetScalarSize(uint32_t(Traits::scalarType)), "DMath error. Math::WriteBinaryFile elements must be tightly packed.");
+
+	BinaryFileHeader header{};
+	std::memcpy(header.magic, detail::BinaryFile::magic, sizeof(header.magic));
+	header.version = detail::BinaryFile::version;
+	header.byteOrderMark = detail::BinaryFile::byteOrderMark;
+	header.scalarType = uint32_t(Traits::scalarType);
+	header.width = Traits::width;
+	header.height = Traits::height;
+	header.elementSize = uint32_t(sizeof(T));
+	header.alignment = detail::BinaryFile::alignment;
+	header.count = elements.size();
+	header.dataOffset = sizeof(BinaryFileHeader);
+
+	std::FILE* file = std::fopen(path, "wb");
+	if (file == nullptr)
+		return false;
+	bool isWritten = std::fwrite(&header, sizeof(header), 1, file) == 1;
+	if (isWritten && !elements.empty())
+		isWritten = std::fwrite(elements.data(), sizeof(T), elements.size(), file) == elements.size();
+	return std::fclose(file) == 0 && isWritten;
+}
+
+inline Math::BinaryFile::BinaryFile(const char* path, BinaryFileAccess access)
+{
+	Open(path, access);
+}
+
+inline Math::BinaryFile::~BinaryFile()
+{
+	Close();
+}
+
+inline Math::BinaryFile::BinaryFile(BinaryFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+inline Math::BinaryFile& Math::BinaryFile::operator=(BinaryFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		header = other.header;
+		status = std::exchange(other.status, BinaryFileStatus::Closed);
+		mapping = std::exchange(other.mapping, nullptr);
+		mappingSize = std::exchange(other.mappingSize, 0);
+		buffer = std::exchange(other.buffer, nullptr);
+		elements = std::exchange(other.elements, nullptr);
+	}
+	return *this;
+}
+
+inline Math::BinaryFileStatus Math::BinaryFile::Open(const char* path, BinaryFileAccess access)
+{
+	Close();
+	const BinaryFileStatus result = access == BinaryFileAccess::Map ? Map(path) : Read(path);
+	if (result != BinaryFileStatus::Ok)
+		Close();
+	status = result;
+	return status;
+}
+
+inline void Math::BinaryFile::Close()
+{
+	if (mapping != nullptr)
+	{
+#if defined( DMATH_FILE_MAPPING_WIN32 )
+		UnmapViewOfFile(mapping);
+#elif defined( DMATH_FILE_MAPPING_POSIX )
+		munmap(mapping, mappingSize);
+#endif
+	}
+	if (buffer != nullptr)
+		detail::Memory::Release(buffer);
+	header = BinaryFileHeader{};
+	status = BinaryFileStatus::Closed;
+	mapping = nullptr;
+	mappingSize = 0;
+	buffer = nullptr;
+	elements = nullptr;
+}
+
+inline Math::BinaryFileStatus Math::BinaryFile::Map(const char* path)
+{
+#if defined( DMATH_FILE_MAPPING_WIN32 )
+	const HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return BinaryFileStatus::CannotOpen;
+	LARGE_INTEGER fileSize;
+	const bool hasSize = GetFileSizeEx(file, &fileSize) != 0;
+	if (!hasSize || uint64_t(fileSize.QuadPart) < sizeof(BinaryFileHeader))
+	{
+		CloseHandle(file);
+		return hasSize ? BinaryFileStatus::InvalidFormat : BinaryFileStatus::CannotOpen;
+	}
+	const HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (fileMapping != nullptr)
+	{
+		mapping = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(fileMapping);
+	}
+	CloseHandle(file);
+	if (mapping == nullptr)
+		return Read(path);
+	mappingSize = size_t(fileSize.QuadPart);
+#elif defined( DMATH_FILE_MAPPING_POSIX )
+	const int file = open(path, O_RDONLY);
+	if (file < 0)
+		return BinaryFileStatus::CannotOpen;
+	struct stat fileInfo;
+	const bool hasSize = fstat(file, &fileInfo) == 0;
+	if (!hasSize || uint64_t(fileInfo.st_size) < sizeof(BinaryFileHeader))
+	{
+		close(file);
+		return hasSize ? BinaryFileStatus::InvalidFormat : BinaryFileStatus::CannotOpen;
+	}
+	void* const view = mmap(nullptr, size_t(fileInfo.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (view == MAP_FAILED)
+		return Read(path);
+	mapping = view;
+	mappingSize = size_t(fileInfo.st_size);
+#else
+	return Read(path);
+#endif
+
+	std::memcpy(&header, mapping, sizeof(header));
+	if (header.byteOrderMark != detail::BinaryFile::byteOrderMark)
+	{
+		// The elements need converting, which a read only mapping cannot hold.
+		Close();
+		return Read(path);
+	}
+	const BinaryFileStatus result = detail::BinaryFile::Validate(header, mappingSize);
+	elements = static_cast<const std::byte*>(mapping) + header.dataOffset;
+	return result;
+}
+
+inline Math::BinaryFileStatus Math::BinaryFile::Read(const char* path)
+{
+	std::FILE* file = std::fopen(path, "rb");
+	if (file == nullptr)
+		return BinaryFileStatus::CannotOpen;
+
+	const auto finish = [&](BinaryFileStatus result)
+	{
+		std::fclose(file);
+		return result;
+	};
+
+	if (std::fread(&header, sizeof(header), 1, file) != 1)
+		return finish(BinaryFileStatus::InvalidFormat);
+	const bool isSwapped = header.byteOrderMark == detail::BinaryFile::SwapBytes(detail::BinaryFile::byteOrderMark);
+	if (isSwapped)
+		detail::BinaryFile::SwapHeader(header);
+	// The file size is not known here, a short read reports truncation instead.
+	const BinaryFileStatus result = detail::BinaryFile::Validate(header, UINT64_MAX);
+	if (result != BinaryFileStatus::Ok)
+		return finish(result);
+	if (header.elementSize != 0 && header.count > SIZE_MAX / header.elementSize)
+		return finish(BinaryFileStatus::InvalidFormat);
+
+	const size_t byteCount = size_t(header.count) * header.elementSize;
+	if (header.dataOffset > sizeof(header) && (header.dataOffset > uint64_t(LONG_MAX) || std::fseek(file, long(header.dataOffset), SEEK_SET) != 0))
+		return finish(BinaryFileStatus::InvalidFormat);
+	buffer = detail::Memory::Reserve(std::max<size_t>(byteCount, 1));
+	if (std::fread(buffer, 1, byteCount, file) != byteCount)
+		return finish(BinaryFileStatus::InvalidFormat);
+
+	if (isSwapped)
+	{
+		if (detail::BinaryFile::GetScalarSize(header.scalarType) == 8)
+			detail::BinaryFile::SwapScalars<uint64_t>(buffer, byteCount);
+		else
+			detail::BinaryFile::SwapScalars<uint32_t>(buffer, byteCount);
+		header.byteOrderMark = detail::BinaryFile::byteOrderMark;
+	}
+	elements = buffer;
+	return finish(BinaryFileStatus::Ok);
+}
+
+inline Math::BinaryFileStatus Math::BinaryFile::GetStatus() const
+{
+	return status;
+}
+
+inline bool Math::BinaryFile::IsOpen() const
+{
+	return status == BinaryFileStatus::Ok;
+}
+
+inline bool Math::BinaryFile::IsMapped() const
+{
+	return mapping != nullptr;
+}
+
+inline const Math::BinaryFileHeader& Math::BinaryFile::GetHeader() const
+{
+	return header;
+}
+
+template<typename T>
+bool Math::BinaryFile::Holds() const
+{
+	using Traits = detail::BinaryFile::ElementTraits<T>;
+	return IsOpen()
+		&& header.scalarType == uint32_t(Traits::scalarType)
+		&& header.width == Traits::width
+		&& header.height == Traits::height
+		&& header.elementSize == sizeof(T);
+}
+
+template<typename T>
+Math::Span<const T> Math::BinaryFile::GetElements() const
+{
+	static_assert(std::is_trivially_copyable_v<T>, "DMath error. Math::BinaryFile elements must be trivially copyable.");
+	static_assert(alignof(T) <= detail::BinaryFile::GetScalarSize(uint32_t(detail::BinaryFile::ElementTraits<T>::scalarType)), "DMath error. Math::BinaryFile elements cannot be aligned beyond their scalar size.");
+
+	if (!Holds<T>())
+		return Span<const T>();
+	return Span<const T>(reinterpret_cast<const T*>(elements), size_t(header.count));
+}
\ No newline at end of file
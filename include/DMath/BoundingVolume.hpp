@@ -0,0 +1,929 @@
+#pragma once
+
+#include "Common.hpp"
+#include "Setup.hpp"
+#include "Matrix/Matrix.hpp"
+#include "Vector/Vector.hpp"
+#include "Span.hpp"
+#include "Parallel.hpp"
+#include "Execution.hpp"
+#include "Instrumentation.hpp"
+
+#include <array>
+#include <cassert>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace Math
+{
+	template<typename T>
+	struct Sphere;
+
+	template<typename T = float>
+	struct AABB3D
+	{
+		using ValueType = T;
+
+		Vector<3, T> min;
+		Vector<3, T> max;
+
+		// Returns a box that contains nothing. Merging anything into it yields that thing's bounds.
+		[[nodiscard]] static constexpr AABB3D<T> Empty()
+		{
+			return AABB3D<T>{ Vector<3, T>::SingleValue(std::numeric_limits<T>::max()), Vector<3, T>::SingleValue(std::numeric_limits<T>::lowest()) };
+		}
+		[[nodiscard]] static constexpr AABB3D<T> FromCenterExtents(const Vector<3, T>& center, const Vector<3, T>& halfExtents)
+		{
+			return AABB3D<T>{ center - halfExtents, center + halfExtents };
+		}
+		[[nodiscard]] static AABB3D<T> FromPoints(Span<const Vector<3, T>> points);
+
+		[[nodiscard]] constexpr bool IsEmpty() const
+		{
+			return min.x > max.x || min.y > max.y || min.z > max.z;
+		}
+
+		[[nodiscard]] constexpr Vector<3, T> GetCenter() const
+		{
+			return Vector<3, T>{ (min.x + max.x) / T(2), (min.y + max.y) / T(2), (min.z + max.z) / T(2) };
+		}
+		[[nodiscard]] constexpr Vector<3, T> GetHalfExtents() const
+		{
+			return Vector<3, T>{ (max.x - min.x) / T(2), (max.y - min.y) / T(2), (max.z - min.z) / T(2) };
+		}
+		[[nodiscard]] constexpr Vector<3, T> GetSize() const
+		{
+			return max - min;
+		}
+		[[nodiscard]] constexpr T SurfaceArea() const
+		{
+			const Vector<3, T> size = GetSize();
+			return T(2) * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+		[[nodiscard]] constexpr T Volume() const
+		{
+			const Vector<3, T> size = GetSize();
+			return size.x * size.y * size.z;
+		}
+
+		[[nodiscard]] constexpr bool Contains(const Vector<3, T>& point) const
+		{
+			return min.x <= point.x && point.x <= max.x
+				&& min.y <= point.y && point.y <= max.y
+				&& min.z <= point.z && point.z <= max.z;
+		}
+		[[nodiscard]] constexpr bool Contains(const AABB3D<T>& other) const
+		{
+			return min.x <= other.min.x && other.max.x <= max.x
+				&& min.y <= other.min.y && other.max.y <= max.y
+				&& min.z <= other.min.z && other.max.z <= max.z;
+		}
+		[[nodiscard]] constexpr bool Intersects(const AABB3D<T>& other) const
+		{
+			return min.x <= other.max.x && other.min.x <= max.x
+				&& min.y <= other.max.y && other.min.y <= max.y
+				&& min.z <= other.max.z && other.min.z <= max.z;
+		}
+		[[nodiscard]] constexpr bool Intersects(const Sphere<T>& sphere) const;
+
+		[[nodiscard]] constexpr T DistanceSqrd(const Vector<3, T>& point) const
+		{
+			T sum = T(0);
+			for (size_t i = 0; i < 3; i++)
+			{
+				if (point[i] < min[i])
+					sum += Sqrd(min[i] - point[i]);
+				else if (point[i] > max[i])
+					sum += Sqrd(point[i] - max[i]);
+			}
+			return sum;
+		}
+
+		[[nodiscard]] constexpr std::optional<AABB3D<T>> GetIntersection(const AABB3D<T>& other) const
+		{
+			if (!Intersects(other))
+				return {};
+			return AABB3D<T>
+			{
+				Vector<3, T>{ std::max(min.x, other.min.x), std::max(min.y, other.min.y), std::max(min.z, other.min.z) },
+				Vector<3, T>{ std::min(max.x, other.max.x), std::min(max.y, other.max.y), std::min(max.z, other.max.z) }
+			};
+		}
+
+		[[nodiscard]] constexpr AABB3D<T> GetMerged(const AABB3D<T>& other) const
+		{
+			return AABB3D<T>
+			{
+				Vector<3, T>{ std::min(min.x, other.min.x), std::min(min.y, other.min.y), std::min(min.z, other.min.z) },
+				Vector<3, T>{ std::max(max.x, other.max.x), std::max(max.y, other.max.y), std::max(max.z, other.max.z) }
+			};
+		}
+		constexpr void Merge(const AABB3D<T>& other)
+		{
+			*this = GetMerged(other);
+		}
+		constexpr void Merge(const Vector<3, T>& point)
+		{
+			min = Vector<3, T>{ std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z) };
+			max = Vector<3, T>{ std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z) };
+		}
+
+		// Arvo's method, in center/extents form. Transforms the center, then sums the
+		// absolute value of the linear part applied to the half extents. Exact for affine transforms.
+		[[nodiscard]] AABB3D<T> GetTransformed(const Matrix<4, 3, T>& transform) const
+		{
+			const Vector<3, T> center = GetCenter();
+			const Vector<3, T> halfExtents = GetHalfExtents();
+			Vector<3, T> newCenter;
+			Vector<3, T> newHalfExtents;
+			for (size_t y = 0; y < 3; y++)
+			{
+				newCenter[y] = transform[0][y] * center.x + transform[1][y] * center.y + transform[2][y] * center.z + transform[3][y];
+				newHalfExtents[y] = Abs(transform[0][y]) * halfExtents.x + Abs(transform[1][y]) * halfExtents.y + Abs(transform[2][y]) * halfExtents.z;
+			}
+			return FromCenterExtents(newCenter, newHalfExtents);
+		}
+		void Transform(const Matrix<4, 3, T>& transform)
+		{
+			*this = GetTransformed(transform);
+		}
+
+		[[nodiscard]] constexpr bool operator==(const AABB3D<T>& rhs) const
+		{
+			return min == rhs.min && max == rhs.max;
+		}
+		[[nodiscard]] constexpr bool operator!=(const AABB3D<T>& rhs) const
+		{
+			return min != rhs.min || max != rhs.max;
+		}
+
+		static_assert(std::is_arithmetic_v<T>, "DMath error. Math::AABB3D must be of arithmetic type.");
+	};
+
+	template<typename T = float>
+	struct Sphere
+	{
+		using ValueType = T;
+
+		Vector<3, T> center;
+		T radius;
+
+		// Ritter's bounding sphere. Not minimal, but within a few percent of it and linear time.
+		[[nodiscard]] static Sphere<T> FromPoints(Span<const Vector<3, T>> points);
+
+		[[nodiscard]] constexpr bool Contains(const Vector<3, T>& point) const
+		{
+			return (point - center).MagnitudeSqrd() <= Sqrd(radius);
+		}
+		[[nodiscard]] constexpr bool Intersects(const Sphere<T>& other) const
+		{
+			return (other.center - center).MagnitudeSqrd() <= Sqrd(radius + other.radius);
+		}
+		[[nodiscard]] constexpr bool Intersects(const AABB3D<T>& box) const
+		{
+			return box.DistanceSqrd(center) <= Sqrd(radius);
+		}
+
+		[[nodiscard]] constexpr AABB3D<T> GetAABB() const
+		{
+			return AABB3D<T>::FromCenterExtents(center, Vector<3, T>::SingleValue(radius));
+		}
+
+		// Returns the smallest sphere enclosing both spheres.
+		[[nodiscard]] Sphere<T> GetMerged(const Sphere<T>& other) const
+		{
+			const Vector<3, T> offset = other.center - center;
+			const T distance = offset.Magnitude();
+			if (distance + other.radius <= radius)
+				return *this;
+			if (distance + radius <= other.radius)
+				return other;
+			const T newRadius = (distance + radius + other.radius) / T(2);
+			return Sphere<T>{ center + offset * ((newRadius - radius) / distance), newRadius };
+		}
+		void Merge(const Sphere<T>& other)
+		{
+			*this = GetMerged(other);
+		}
+
+		// The radius is scaled by the largest column length of the 3x3 part, the largest axis scale of the transform.
+		// The result stays conservative under rotation and non-uniform scale, not under shear.
+		[[nodiscard]] Sphere<T> GetTransformed(const Matrix<4, 3, T>& transform) const
+		{
+			Vector<3, T> newCenter;
+			for (size_t y = 0; y < 3; y++)
+				newCenter[y] = transform[0][y] * center.x + transform[1][y] * center.y + transform[2][y] * center.z + transform[3][y];
+			T maxColumnLengthSqrd = T(0);
+			for (size_t x = 0; x < 3; x++)
+			{
+				const T columnLengthSqrd = Sqrd(transform[x][0]) + Sqrd(transform[x][1]) + Sqrd(transform[x][2]);
+				maxColumnLengthSqrd = std::max(maxColumnLengthSqrd, columnLengthSqrd);
+			}
+			return Sphere<T>{ newCenter, radius * Sqrt(maxColumnLengthSqrd) };
+		}
+		void Transform(const Matrix<4, 3, T>& transform)
+		{
+			*this = GetTransformed(transform);
+		}
+
+		static_assert(std::is_floating_point_v<T>, "DMath error. Math::Sphere must be of floating point type.");
+	};
+
+	// Oriented bounding box. The columns of orientation are the box's local axes and must be orthonormal.
+	template<typename T = float>
+	struct OBB
+	{
+		using ValueType = T;
+
+		Vector<3, T> center;
+		Matrix<3, 3, T> orientation;
+		Vector<3, T> halfExtents;
+
+		[[nodiscard]] static OBB<T> FromAABB(const AABB3D<T>& box)
+		{
+			return OBB<T>{ box.GetCenter(), Matrix<3, 3, T>::Identity(), box.GetHalfExtents() };
+		}
+
+		[[nodiscard]] constexpr Vector<3, T> GetAxis(size_t index) const
+		{
+			assert(index < 3);
+			return Vector<3, T>{ orientation[index][0], orientation[index][1], orientation[index][2] };
+		}
+
+		[[nodiscard]] constexpr bool Contains(const Vector<3, T>& point) const
+		{
+			const Vector<3, T> offset = point - center;
+			for (size_t i = 0; i < 3; i++)
+			{
+				if (Abs(Vector<3, T>::Dot(offset, GetAxis(i))) > halfExtents[i])
+					return false;
+			}
+			return true;
+		}
+
+		[[nodiscard]] constexpr AABB3D<T> GetAABB() const
+		{
+			Vector<3, T> newHalfExtents;
+			for (size_t y = 0; y < 3; y++)
+				newHalfExtents[y] = Abs(orientation[0][y]) * halfExtents.x + Abs(orientation[1][y]) * halfExtents.y + Abs(orientation[2][y]) * halfExtents.z;
+			return AABB3D<T>::FromCenterExtents(center, newHalfExtents);
+		}
+
+		// Separating axis test over the 15 candidate axes (Gottschalk et al.).
+		[[nodiscard]] bool Intersects(const OBB<T>& other) const;
+		[[nodiscard]] bool Intersects(const AABB3D<T>& box) const
+		{
+			return Intersects(OBB<T>::FromAABB(box));
+		}
+
+		// Scale in the transform is moved into the half extents so the orientation stays orthonormal.
+		[[nodiscard]] OBB<T> GetTransformed(const Matrix<4, 3, T>& transform) const
+		{
+			OBB<T> newBox;
+			for (size_t y = 0; y < 3; y++)
+				newBox.center[y] = transform[0][y] * center.x + transform[1][y] * center.y + transform[2][y] * center.z + transform[3][y];
+			for (size_t x = 0; x < 3; x++)
+			{
+				Vector<3, T> axis;
+				for (size_t y = 0; y < 3; y++)
+					axis[y] = transform[0][y] * orientation[x][0] + transform[1][y] * orientation[x][1] + transform[2][y] * orientation[x][2];
+				const T scale = axis.Magnitude();
+				newBox.halfExtents[x] = halfExtents[x] * scale;
+				for (size_t y = 0; y < 3; y++)
+					newBox.orientation[x][y] = axis[y] / scale;
+			}
+			return newBox;
+		}
+		void Transform(const Matrix<4, 3, T>& transform)
+		{
+			*this = GetTransformed(transform);
+		}
+
+		static_assert(std::is_floating_point_v<T>, "DMath error. Math::OBB must be of floating point type.");
+	};
+
+	// Structure-of-arrays view of spheres, as consumed by the batch functions.
+	template<typename T = float>
+	struct SphereBatch
+	{
+		Span<const T> centerX;
+		Span<const T> centerY;
+		Span<const T> centerZ;
+		Span<const T> radius;
+
+		[[nodiscard]] constexpr size_t Size() const
+		{
+			assert(centerY.size() == centerX.size() && centerZ.size() == centerX.size() && radius.size() == centerX.size());
+			return centerX.size();
+		}
+	};
+
+	// Structure-of-arrays view of axis aligned boxes, as consumed by the batch functions.
+	template<typename T = float>
+	struct AABBBatch
+	{
+		Span<const T> minX;
+		Span<const T> minY;
+		Span<const T> minZ;
+		Span<const T> maxX;
+		Span<const T> maxY;
+		Span<const T> maxZ;
+
+		[[nodiscard]] constexpr size_t Size() const
+		{
+			assert(minY.size() == minX.size() && minZ.size() == minX.size());
+			assert(maxX.size() == minX.size() && maxY.size() == minX.size() && maxZ.size() == minX.size());
+			return minX.size();
+		}
+	};
+
+	// Structure-of-arrays storage of axis aligned boxes.
+	template<typename T = float>
+	struct AABB3DSoA
+	{
+		using ValueType = T;
+
+		std::vector<T> minX;
+		std::vector<T> minY;
+		std::vector<T> minZ;
+		std::vector<T> maxX;
+		std::vector<T> maxY;
+		std::vector<T> maxZ;
+
+		[[nodiscard]] size_t Size() const
+		{
+			return minX.size();
+		}
+		void Resize(size_t count)
+		{
+			for (auto* component : { &minX, &minY, &minZ, &maxX, &maxY, &maxZ })
+				component->resize(count);
+		}
+		void Reserve(size_t count)
+		{
+			for (auto* component : { &minX, &minY, &minZ, &maxX, &maxY, &maxZ })
+				component->reserve(count);
+		}
+		void Clear()
+		{
+			for (auto* component : { &minX, &minY, &minZ, &maxX, &maxY, &maxZ })
+				component->clear();
+		}
+		void PushBack(const AABB3D<T>& box)
+		{
+			minX.push_back(box.min.x);
+			minY.push_back(box.min.y);
+			minZ.push_back(box.min.z);
+			maxX.push_back(box.max.x);
+			maxY.push_back(box.max.y);
+			maxZ.push_back(box.max.z);
+		}
+
+		[[nodiscard]] AABB3D<T> Get(size_t index) const
+		{
+			assert(index < Size());
+			return AABB3D<T>{ Vector<3, T>{ minX[index], minY[index], minZ[index] }, Vector<3, T>{ maxX[index], maxY[index], maxZ[index] } };
+		}
+		void Set(size_t index, const AABB3D<T>& box)
+		{
+			assert(index < Size());
+			minX[index] = box.min.x;
+			minY[index] = box.min.y;
+			minZ[index] = box.min.z;
+			maxX[index] = box.max.x;
+			maxY[index] = box.max.y;
+			maxZ[index] = box.max.z;
+		}
+
+		[[nodiscard]] AABBBatch<T> AsBatch() const
+		{
+			return AABBBatch<T>{ minX, minY, minZ, maxX, maxY, maxZ };
+		}
+	};
+
+	// Structure-of-arrays storage of spheres.
+	template<typename T = float>
+	struct SphereSoA
+	{
+		using ValueType = T;
+
+		std::vector<T> centerX;
+		std::vector<T> centerY;
+		std::vector<T> centerZ;
+		std::vector<T> radius;
+
+		[[nodiscard]] size_t Size() const
+		{
+			return centerX.size();
+		}
+		void Resize(size_t count)
+		{
+			for (auto* component : { &centerX, &centerY, &centerZ, &radius })
+				component->resize(count);
+		}
+		void Reserve(size_t count)
+		{
+			for (auto* component : { &centerX, &centerY, &centerZ, &radius })
+				component->reserve(count);
+		}
+		void Clear()
+		{
+			for (auto* component : { &centerX, &centerY, &centerZ, &radius })
+				component->clear();
+		}
+		void PushBack(const Sphere<T>& sphere)
+		{
+			centerX.push_back(sphere.center.x);
+			centerY.push_back(sphere.center.y);
+			centerZ.push_back(sphere.center.z);
+			radius.push_back(sphere.radius);
+		}
+
+		[[nodiscard]] Sphere<T> Get(size_t index) const
+		{
+			assert(index < Size());
+			return Sphere<T>{ Vector<3, T>{ centerX[index], centerY[index], centerZ[index] }, radius[index] };
+		}
+		void Set(size_t index, const Sphere<T>& sphere)
+		{
+			assert(index < Size());
+			centerX[index] = sphere.center.x;
+			centerY[index] = sphere.center.y;
+			centerZ[index] = sphere.center.z;
+			radius[index] = sphere.radius;
+		}
+
+		[[nodiscard]] SphereBatch<T> AsBatch() const
+		{
+			return SphereBatch<T>{ centerX, centerY, centerZ, radius };
+		}
+	};
+
+	// Structure-of-arrays storage of oriented boxes. orientation holds the 9 matrix elements in column-major order.
+	template<typename T = float>
+	struct OBBSoA
+	{
+		using ValueType = T;
+
+		std::vector<T> centerX;
+		std::vector<T> centerY;
+		std::vector<T> centerZ;
+		std::array<std::vector<T>, 9> orientation;
+		std::vector<T> halfExtentX;
+		std::vector<T> halfExtentY;
+		std::vector<T> halfExtentZ;
+
+		[[nodiscard]] size_t Size() const
+		{
+			return centerX.size();
+		}
+		void Resize(size_t count)
+		{
+			for (auto* component : { &centerX, &centerY, &centerZ, &halfExtentX, &halfExtentY, &halfExtentZ })
+				component->resize(count);
+			for (auto& component : orientation)
+				component.resize(count);
+		}
+		void Reserve(size_t count)
+		{
+			for (auto* component : { &centerX, &centerY, &centerZ, &halfExtentX, &halfExtentY, &halfExtentZ })
+				component->reserve(count);
+			for (auto& component : orientation)
+				component.reserve(count);
+		}
+		void Clear()
+		{
+			for (auto* component : { &centerX, &centerY, &centerZ, &halfExtentX, &halfExtentY, &halfExtentZ })
+				component->clear();
+			for (auto& component : orientation)
+				component.clear();
+		}
+		void PushBack(const OBB<T>& box)
+		{
+			Resize(Size() + 1);
+			Set(Size() - 1, box);
+		}
+
+		[[nodiscard]] OBB<T> Get(size_t index) const
+		{
+			assert(index < Size());
+			OBB<T> box;
+			box.center = Vector<3, T>{ centerX[index], centerY[index], centerZ[index] };
+			for (size_t i = 0; i < 9; i++)
+				box.orientation.data[i] = orientation[i][index];
+			box.halfExtents = Vector<3, T>{ halfExtentX[index], halfExtentY[index], halfExtentZ[index] };
+			return box;
+		}
+		void Set(size_t index, const OBB<T>& box)
+		{
+			assert(index < Size());
+			centerX[index] = box.center.x;
+			centerY[index] = box.center.y;
+			centerZ[index] = box.center.z;
+			for (size_t i = 0; i < 9; i++)
+				orientation[i][index] = box.orientation.data[i];
+			halfExtentX[index] = box.halfExtents.x;
+			halfExtentY[index] = box.halfExtents.y;
+			halfExtentZ[index] = box.halfExtents.z;
+		}
+	};
+
+	template<typename T>
+	[[nodiscard]] AABB3D<T> ComputeBounds(Span<const Vector<3, T>> points);
+	template<typename T>
+	[[nodiscard]] AABB3D<T> ComputeBounds_Parallel(Span<const Vector<3, T>> points, size_t grainSize = Setup::defaultParallelGrainSize);
+	// std::execution::par and par_unseq run ComputeBounds_Parallel, other policies ComputeBounds.
+	template<typename T, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	[[nodiscard]] AABB3D<T> ComputeBounds(ExecutionPolicy&& policy, Span<const Vector<3, T>> points);
+	template<typename T>
+	[[nodiscard]] AABB3D<T> ComputeBounds(const AABBBatch<T>& boxes);
+
+	// Transforms every box by the same matrix.
+	template<typename T>
+	void TransformAABBs(const Matrix<4, 3, T>& transform, const AABBBatch<T>& input, AABB3DSoA<T>& output);
+	// Transforms box i by transforms[i]. Typical refit of local bounds into world space.
+	template<typename T>
+	void TransformAABBs(Span<const Matrix<4, 3, T>> transforms, const AABBBatch<T>& input, AABB3DSoA<T>& output);
+	template<typename T>
+	void TransformAABBs_Parallel(Span<const Matrix<4, 3, T>> transforms, const AABBBatch<T>& input, AABB3DSoA<T>& output, size_t grainSize = Setup::defaultParallelGrainSize);
+	// std::execution::par and par_unseq run TransformAABBs_Parallel, other policies TransformAABBs.
+	template<typename T, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void TransformAABBs(ExecutionPolicy&& policy, Span<const Matrix<4, 3, T>> transforms, const AABBBatch<T>& input, AABB3DSoA<T>& output);
+
+	template<typename T>
+	void TransformSpheres(Span<const Matrix<4, 3, T>> transforms, const SphereBatch<T>& input, SphereSoA<T>& output);
+	template<typename T>
+	void TransformOBBs(Span<const Matrix<4, 3, T>> transforms, const OBBSoA<T>& input, OBBSoA<T>& output);
+	template<typename T>
+	void ComputeAABBs(const OBBSoA<T>& input, AABB3DSoA<T>& output);
+
+	namespace detail
+	{
+		namespace BoundingVolume
+		{
+			template<typename T>
+			void TransformAABBRange(Span<const Math::Matrix<4, 3, T>> transforms, const AABBBatch<T>& input, AABB3DSoA<T>& output, size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					const auto& transform = transforms[i];
+					const T centerX = (input.minX[i] + input.maxX[i]) / T(2);
+					const T centerY = (input.minY[i] + input.maxY[i]) / T(2);
+					const T centerZ = (input.minZ[i] + input.maxZ[i]) / T(2);
+					const T extentX = (input.maxX[i] - input.minX[i]) / T(2);
+					const T extentY = (input.maxY[i] - input.minY[i]) / T(2);
+					const T extentZ = (input.maxZ[i] - input.minZ[i]) / T(2);
+
+					const T newCenterX = transform[0][0] * centerX + transform[1][0] * centerY + transform[2][0] * centerZ + transform[3][0];
+					const T newCenterY = transform[0][1] * centerX + transform[1][1] * centerY + transform[2][1] * centerZ + transform[3][1];
+					const T newCenterZ = transform[0][2] * centerX + transform[1][2] * centerY + transform[2][2] * centerZ + transform[3][2];
+					const T newExtentX = Abs(transform[0][0]) * extentX + Abs(transform[1][0]) * extentY + Abs(transform[2][0]) * extentZ;
+					const T newExtentY = Abs(transform[0][1]) * extentX + Abs(transform[1][1]) * extentY + Abs(transform[2][1]) * extentZ;
+					const T newExtentZ = Abs(transform[0][2]) * extentX + Abs(transform[1][2]) * extentY + Abs(transform[2][2]) * extentZ;
+
+					output.minX[i] = newCenterX - newExtentX;
+					output.minY[i] = newCenterY - newExtentY;
+					output.minZ[i] = newCenterZ - newExtentZ;
+					output.maxX[i] = newCenterX + newExtentX;
+					output.maxY[i] = newCenterY + newExtentY;
+					output.maxZ[i] = newCenterZ + newExtentZ;
+				}
+			}
+		}
+	}
+}
+
+template<typename T>
+constexpr bool Math::AABB3D<T>::Intersects(const Sphere<T>& sphere) const
+{
+	return DistanceSqrd(sphere.center) <= Sqrd(sphere.radius);
+}
+
+template<typename T>
+Math::AABB3D<T> Math::AABB3D<T>::FromPoints(Span<const Vector<3, T>> points)
+{
+	return ComputeBounds<T>(points);
+}
+
+template<typename T>
+Math::Sphere<T> Math::Sphere<T>::FromPoints(Span<const Vector<3, T>> points)
+{
+	if (points.empty())
+		return Sphere<T>{ Vector<3, T>::Zero(), T(0) };
+
+	auto findFarthest = [&](const Vector<3, T>& from)
+	{
+		size_t farthest = 0;
+		T farthestDistanceSqrd = T(0);
+		for (size_t i = 0; i < points.size(); i++)
+		{
+			const T distanceSqrd = (points[i] - from).MagnitudeSqrd();
+			if (distanceSqrd > farthestDistanceSqrd)
+			{
+				farthestDistanceSqrd = distanceSqrd;
+				farthest = i;
+			}
+		}
+		return points[farthest];
+	};
+
+	const Vector<3, T> a = findFarthest(points[0]);
+	const Vector<3, T> b = findFarthest(a);
+	Sphere<T> sphere{ (a + b) * T(0.5), (b - a).Magnitude() / T(2) };
+
+	// Grows the sphere just enough to include each outlying point.
+	for (const auto& point : points)
+	{
+		const Vector<3, T> offset = point - sphere.center;
+		const T distanceSqrd = offset.MagnitudeSqrd();
+		if (distanceSqrd > Sqrd(sphere.radius))
+		{
+			const T distance = Sqrt(distanceSqrd);
+			const T newRadius = (sphere.radius + distance) / T(2);
+			sphere.center += offset * ((newRadius - sphere.radius) / distance);
+			sphere.radius = newRadius;
+		}
+	}
+	return sphere;
+}
+
+template<typename T>
+bool Math::OBB<T>::Intersects(const OBB<T>& other) const
+{
+	constexpr T epsilon = std::numeric_limits<T>::epsilon() * T(16);
+
+	// Rotation expressing other in this box's frame.
+	T rotation[3][3];
+	T absRotation[3][3];
+	for (size_t i = 0; i < 3; i++)
+	{
+		for (size_t j = 0; j < 3; j++)
+		{
+			rotation[i][j] = Vector<3, T>::Dot(GetAxis(i), other.GetAxis(j));
+			// Epsilon counteracts arithmetic errors when two edges are parallel and their cross product is near null.
+			absRotation[i][j] = Abs(rotation[i][j]) + epsilon;
+		}
+	}
+
+	const Vector<3, T> offsetWorld = other.center - center;
+	const T offset[3] = { Vector<3, T>::Dot(offsetWorld, GetAxis(0)), Vector<3, T>::Dot(offsetWorld, GetAxis(1)), Vector<3, T>::Dot(offsetWorld, GetAxis(2)) };
+	const T a[3] = { halfExtents.x, halfExtents.y, halfExtents.z };
+	const T b[3] = { other.halfExtents.x, other.halfExtents.y, other.halfExtents.z };
+
+	// Axes of this box.
+	for (size_t i = 0; i < 3; i++)
+	{
+		const T radiusB = b[0] * absRotation[i][0] + b[1] * absRotation[i][1] + b[2] * absRotation[i][2];
+		if (Abs(offset[i]) > a[i] + radiusB)
+			return false;
+	}
+
+	// Axes of the other box.
+	for (size_t j = 0; j < 3; j++)
+	{
+		const T radiusA = a[0] * absRotation[0][j] + a[1] * absRotation[1][j] + a[2] * absRotation[2][j];
+		const T distance = offset[0] * rotation[0][j] + offset[1] * rotation[1][j] + offset[2] * rotation[2][j];
+		if (Abs(distance) > radiusA + b[j])
+			return false;
+	}
+
+	// Cross products of one axis from each box.
+	for (size_t i = 0; i < 3; i++)
+	{
+		const size_t i1 = (i + 1) % 3;
+		const size_t i2 = (i + 2) % 3;
+		for (size_t j = 0; j < 3; j++)
+		{
+			const size_t j1 = (j + 1) % 3;
+			const size_t j2 = (j + 2) % 3;
+			const T radiusA = a[i1] * absRotation[i2][j] + a[i2] * absRotation[i1][j];
+			const T radiusB = b[j1] * absRotation[i][j2] + b[j2] * absRotation[i][j1];
+			const T distance = offset[i2] * rotation[i1][j] - offset[i1] * rotation[i2][j];
+			if (Abs(distance) > radiusA + radiusB)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename T>
+Math::AABB3D<T> Math::ComputeBounds(Span<const Vector<3, T>> points)
+{
+	const TraceScope traceScope("ComputeBounds", points.size());
+
+	// Separate accumulators per component keep the loop free of dependencies between lanes, so it vectorizes.
+	T minX = std::numeric_limits<T>::max();
+	T minY = std::numeric_limits<T>::max();
+	T minZ = std::numeric_limits<T>::max();
+	T maxX = std::numeric_limits<T>::lowest();
+	T maxY = std::numeric_limits<T>::lowest();
+	T maxZ = std::numeric_limits<T>::lowest();
+	for (const auto& point : points)
+	{
+		minX = point.x < minX ? point.x : minX;
+		minY = point.y < minY ? point.y : minY;
+		minZ = point.z < minZ ? point.z : minZ;
+		maxX = point.x > maxX ? point.x : maxX;
+		maxY = point.y > maxY ? point.y : maxY;
+		maxZ = point.z > maxZ ? point.z : maxZ;
+	}
+	return AABB3D<T>{ Vector<3, T>{ minX, minY, minZ }, Vector<3, T>{ maxX, maxY, maxZ } };
+}
+
+template<typename T>
+Math::AABB3D<T> Math::ComputeBounds_Parallel(Span<const Vector<3, T>> points, size_t grainSize)
+{
+	const TraceScope traceScope("ComputeBounds", points.size());
+	const size_t chunkCount = (points.size() + grainSize - 1) / grainSize;
+	std::vector<AABB3D<T>> partialBounds(chunkCount, AABB3D<T>::Empty());
+	ParallelFor(0, points.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		partialBounds[begin / grainSize] = ComputeBounds<T>(points.subspan(begin, end - begin));
+	});
+
+	AABB3D<T> bounds = AABB3D<T>::Empty();
+	for (const auto& partial : partialBounds)
+		bounds.Merge(partial);
+	return bounds;
+}
+
+template<typename T, typename ExecutionPolicy, typename>
+Math::AABB3D<T> Math::ComputeBounds(ExecutionPolicy&&, Span<const Vector<3, T>> points)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		return ComputeBounds_Parallel<T>(points);
+	else
+		return ComputeBounds<T>(points);
+}
+
+template<typename T>
+Math::AABB3D<T> Math::ComputeBounds(const AABBBatch<T>& boxes)
+{
+	AABB3D<T> bounds = AABB3D<T>::Empty();
+	const size_t count = boxes.Size();
+	for (size_t i = 0; i < count; i++)
+	{
+		bounds.min.x = boxes.minX[i] < bounds.min.x ? boxes.minX[i] : bounds.min.x;
+		bounds.min.y = boxes.minY[i] < bounds.min.y ? boxes.minY[i] : bounds.min.y;
+		bounds.min.z = boxes.minZ[i] < bounds.min.z ? boxes.minZ[i] : bounds.min.z;
+		bounds.max.x = boxes.maxX[i] > bounds.max.x ? boxes.maxX[i] : bounds.max.x;
+		bounds.max.y = boxes.maxY[i] > bounds.max.y ? boxes.maxY[i] : bounds.max.y;
+		bounds.max.z = boxes.maxZ[i] > bounds.max.z ? boxes.maxZ[i] : bounds.max.z;
+	}
+	return bounds;
+}
+
+template<typename T>
+void Math::TransformAABBs(const Matrix<4, 3, T>& transform, const AABBBatch<T>& input, AABB3DSoA<T>& output)
+{
+	const size_t count = input.Size();
+	output.Resize(count);
+	const TraceScope traceScope("TransformAABBs", count);
+
+	// The transform is loop invariant, so its absolute values are computed once.
+	const T m00 = transform[0][0], m10 = transform[1][0], m20 = transform[2][0], m30 = transform[3][0];
+	const T m01 = transform[0][1], m11 = transform[1][1], m21 = transform[2][1], m31 = transform[3][1];
+	const T m02 = transform[0][2], m12 = transform[1][2], m22 = transform[2][2], m32 = transform[3][2];
+	const T a00 = Abs(m00), a10 = Abs(m10), a20 = Abs(m20);
+	const T a01 = Abs(m01), a11 = Abs(m11), a21 = Abs(m21);
+	const T a02 = Abs(m02), a12 = Abs(m12), a22 = Abs(m22);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const T centerX = (input.minX[i] + input.maxX[i]) / T(2);
+		const T centerY = (input.minY[i] + input.maxY[i]) / T(2);
+		const T centerZ = (input.minZ[i] + input.maxZ[i]) / T(2);
+		const T extentX = (input.maxX[i] - input.minX[i]) / T(2);
+		const T extentY = (input.maxY[i] - input.minY[i]) / T(2);
+		const T extentZ = (input.maxZ[i] - input.minZ[i]) / T(2);
+
+		const T newCenterX = m00 * centerX + m10 * centerY + m20 * centerZ + m30;
+		const T newCenterY = m01 * centerX + m11 * centerY + m21 * centerZ + m31;
+		const T newCenterZ = m02 * centerX + m12 * centerY + m22 * centerZ + m32;
+		const T newExtentX = a00 * extentX + a10 * extentY + a20 * extentZ;
+		const T newExtentY = a01 * extentX + a11 * extentY + a21 * extentZ;
+		const T newExtentZ = a02 * extentX + a12 * extentY + a22 * extentZ;
+
+		output.minX[i] = newCenterX - newExtentX;
+		output.minY[i] = newCenterY - newExtentY;
+		output.minZ[i] = newCenterZ - newExtentZ;
+		output.maxX[i] = newCenterX + newExtentX;
+		output.maxY[i] = newCenterY + newExtentY;
+		output.maxZ[i] = newCenterZ + newExtentZ;
+	}
+}
+
+template<typename T>
+void Math::TransformAABBs(Span<const Matrix<4, 3, T>> transforms, const AABBBatch<T>& input, AABB3DSoA<T>& output)
+{
+	const size_t count = input.Size();
+	assert(transforms.size() == count);
+	output.Resize(count);
+	const TraceScope traceScope("TransformAABBs", count);
+	detail::BoundingVolume::TransformAABBRange(transforms, input, output, 0, count);
+}
+
+template<typename T>
+void Math::TransformAABBs_Parallel(Span<const Matrix<4, 3, T>> transforms, const AABBBatch<T>& input, AABB3DSoA<T>& output, size_t grainSize)
+{
+	const size_t count = input.Size();
+	assert(transforms.size() == count);
+	output.Resize(count);
+	const TraceScope traceScope("TransformAABBs", count);
+	ParallelFor(0, count, grainSize, [&](size_t begin, size_t end)
+	{
+		detail::BoundingVolume::TransformAABBRange(transforms, input, output, begin, end);
+	});
+}
+
+template<typename T, typename ExecutionPolicy, typename>
+void Math::TransformAABBs(ExecutionPolicy&&, Span<const Matrix<4, 3, T>> transforms, const AABBBatch<T>& input, AABB3DSoA<T>& output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		TransformAABBs_Parallel<T>(transforms, input, output);
+	else
+		TransformAABBs<T>(transforms, input, output);
+}
+
+template<typename T>
+void Math::TransformSpheres(Span<const Matrix<4, 3, T>> transforms, const SphereBatch<T>& input, SphereSoA<T>& output)
+{
+	const size_t count = input.Size();
+	assert(transforms.size() == count);
+	output.Resize(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		const auto& transform = transforms[i];
+		const T x = input.centerX[i];
+		const T y = input.centerY[i];
+		const T z = input.centerZ[i];
+		output.centerX[i] = transform[0][0] * x + transform[1][0] * y + transform[2][0] * z + transform[3][0];
+		output.centerY[i] = transform[0][1] * x + transform[1][1] * y + transform[2][1] * z + transform[3][1];
+		output.centerZ[i] = transform[0][2] * x + transform[1][2] * y + transform[2][2] * z + transform[3][2];
+
+		const T scaleSqrdX = Sqrd(transform[0][0]) + Sqrd(transform[0][1]) + Sqrd(transform[0][2]);
+		const T scaleSqrdY = Sqrd(transform[1][0]) + Sqrd(transform[1][1]) + Sqrd(transform[1][2]);
+		const T scaleSqrdZ = Sqrd(transform[2][0]) + Sqrd(transform[2][1]) + Sqrd(transform[2][2]);
+		const T maxScaleSqrd = std::max(scaleSqrdX, std::max(scaleSqrdY, scaleSqrdZ));
+		output.radius[i] = input.radius[i] * Sqrt(maxScaleSqrd);
+	}
+}
+
+template<typename T>
+void Math::TransformOBBs(Span<const Matrix<4, 3, T>> transforms, const OBBSoA<T>& input, OBBSoA<T>& output)
+{
+	const size_t count = input.Size();
+	assert(transforms.size() == count);
+	assert(&input != &output);
+	output.Resize(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		const auto& transform = transforms[i];
+		const T x = input.centerX[i];
+		const T y = input.centerY[i];
+		const T z = input.centerZ[i];
+		output.centerX[i] = transform[0][0] * x + transform[1][0] * y + transform[2][0] * z + transform[3][0];
+		output.centerY[i] = transform[0][1] * x + transform[1][1] * y + transform[2][1] * z + transform[3][1];
+		output.centerZ[i] = transform[0][2] * x + transform[1][2] * y + transform[2][2] * z + transform[3][2];
+
+		const T* halfExtentsIn[3] = { &input.halfExtentX[i], &input.halfExtentY[i], &input.halfExtentZ[i] };
+		T* halfExtentsOut[3] = { &output.halfExtentX[i], &output.halfExtentY[i], &output.halfExtentZ[i] };
+		for (size_t axisIndex = 0; axisIndex < 3; axisIndex++)
+		{
+			const T axisX = input.orientation[axisIndex * 3 + 0][i];
+			const T axisY = input.orientation[axisIndex * 3 + 1][i];
+			const T axisZ = input.orientation[axisIndex * 3 + 2][i];
+			const T newAxisX = transform[0][0] * axisX + transform[1][0] * axisY + transform[2][0] * axisZ;
+			const T newAxisY = transform[0][1] * axisX + transform[1][1] * axisY + transform[2][1] * axisZ;
+			const T newAxisZ = transform[0][2] * axisX + transform[1][2] * axisY + transform[2][2] * axisZ;
+			const T scale = Sqrt(Sqrd(newAxisX) + Sqrd(newAxisY) + Sqrd(newAxisZ));
+			output.orientation[axisIndex * 3 + 0][i] = newAxisX / scale;
+			output.orientation[axisIndex * 3 + 1][i] = newAxisY / scale;
+			output.orientation[axisIndex * 3 + 2][i] = newAxisZ / scale;
+			*halfExtentsOut[axisIndex] = *halfExtentsIn[axisIndex] * scale;
+		}
+	}
+}
+
+template<typename T>
+void Math::ComputeAABBs(const OBBSoA<T>& input, AABB3DSoA<T>& output)
+{
+	const size_t count = input.Size();
+	output.Resize(count);
+	const auto& o = input.orientation;
+	for (size_t i = 0; i < count; i++)
+	{
+		const T extentX = Abs(o[0][i]) * input.halfExtentX[i] + Abs(o[3][i]) * input.halfExtentY[i] + Abs(o[6][i]) * input.halfExtentZ[i];
+		const T extentY = Abs(o[1][i]) * input.halfExtentX[i] + Abs(o[4][i]) * input.halfExtentY[i] + Abs(o[7][i]) * input.halfExtentZ[i];
+		const T extentZ = Abs(o[2][i]) * input.halfExtentX[i] + Abs(o[5][i]) * input.halfExtentY[i] + Abs(o[8][i]) * input.halfExtentZ[i];
+		output.minX[i] = input.centerX[i] - extentX;
+		output.minY[i] = input.centerY[i] - extentY;
+		output.minZ[i] = input.centerZ[i] - extentZ;
+		output.maxX[i] = input.centerX[i] + extentX;
+		output.maxY[i] = input.centerY[i] + extentY;
+		output.maxZ[i] = input.centerZ[i] + extentZ;
+	}
+}
\ No newline at end of file
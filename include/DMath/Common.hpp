@@ -1,7 +1,11 @@
 #pragma once
 
+#include "Setup.hpp"
+#include "Simd.hpp"
+
 #include <cmath>
 #include <algorithm>
+#include <limits>
 
 #include <type_traits>
 
@@ -11,6 +15,41 @@
 
 namespace Math
 {
+	namespace detail
+	{
+		namespace Common
+		{
+			// Newton iteration for constant evaluation. Converges from above once past the first step,
+			// then a last step with the exact residual rounds like the run time square root.
+			template<typename T>
+			[[nodiscard]] constexpr T Sqrt(T input)
+			{
+				if (!(input >= T(0)))
+					return std::numeric_limits<T>::quiet_NaN();
+				if (input == T(0) || input == std::numeric_limits<T>::infinity())
+					return input;
+
+				T estimate = input < T(1) ? T(1) : input;
+				while (true)
+				{
+					const T next = (estimate + input / estimate) / T(2);
+					if (next >= estimate)
+						break;
+					estimate = next;
+				}
+
+				// estimate * estimate == square + error exactly, through Veltkamp splitting.
+				constexpr T splitter = T((1ull << (std::numeric_limits<T>::digits + 1) / 2) + 1);
+				const T scaled = estimate * splitter;
+				const T high = scaled - (scaled - estimate);
+				const T low = estimate - high;
+				const T square = estimate * estimate;
+				const T error = ((high * high - square) + T(2) * high * low) + low * low;
+				return estimate + ((input - square) - error) / (T(2) * estimate);
+			}
+		}
+	}
+
 	template<typename T>
 	[[nodiscard]] auto Abs(T input)
 	{
@@ -68,14 +107,14 @@ namespace Math
 	template<typename T>
 	[[nodiscard]] constexpr auto Clamp(T value, T min, T max) -> T
 	{
-		static_assert(std::is_arithmetic_v<T>, "Input of " __FUNCTION__ " requires type T to be an arithmetic type.");
+		static_assert(std::is_arithmetic_v<T>, "Input of Math::Clamp requires type T to be an arithmetic type.");
 		return std::clamp(value, min, max);
 	}
 
 	template<typename T>
 	[[nodiscard]] auto Floor(T input)
 	{
-		static_assert(std::is_arithmetic_v<T>, "Input of " __FUNCTION__ " must be of numeric type.");
+		static_assert(std::is_arithmetic_v<T>, "Input of Math::Floor must be of numeric type.");
 		return std::floor(input);
 	}
 
@@ -119,14 +158,14 @@ namespace Math
 	template<typename T>
 	[[nodiscard]] constexpr T Min(T a, T b)
 	{
-		static_assert(std::is_arithmetic<T>::value , "Error. Argument of " __FUNCTION__ " must be arithmetic types.");
+		static_assert(std::is_arithmetic<T>::value , "Error. Argument of Math::Min must be arithmetic types.");
 		return std::min(a, b);
 	}
 
 	template<typename T>
 	[[nodiscard]] constexpr auto Max(T a, T b)
 	{
-		static_assert(std::is_arithmetic<T>::value, "Error. Argument of " __FUNCTION__ " must be arithmetic types.");
+		static_assert(std::is_arithmetic<T>::value, "Error. Argument of Math::Max must be arithmetic types.");
 		return std::max(a, b);
 	}
 
@@ -151,14 +190,33 @@ namespace Math
 		return input * input;
 	}
 
-	[[nodiscard]] inline float Sqrt(float input)
+	[[nodiscard]] constexpr float Sqrt(float input)
 	{
+		if (DMATH_IS_CONSTANT_EVALUATED())
+			return float(detail::Common::Sqrt(double(input)));
 		return sqrtf(input);
 	}
 
-	[[nodiscard]] inline double Sqrt(double input)
+	[[nodiscard]] constexpr double Sqrt(double input)
+	{
+		if (DMATH_IS_CONSTANT_EVALUATED())
+			return detail::Common::Sqrt(input);
+		return std::sqrt(input);
+	}
+
+	// 1 / Sqrt(input) from the hardware estimate and one Newton step, within a few ULP.
+	// input must be positive and finite, zero gives NaN.
+	[[nodiscard]] constexpr float RSqrt(float input)
+	{
+		if (DMATH_IS_CONSTANT_EVALUATED())
+			return 1.f / Sqrt(input);
+		const float estimate = detail::Simd::FloatLanes<1>::RSqrtEstimate(input);
+		return estimate * (1.5f - 0.5f * input * estimate * estimate);
+	}
+
+	[[nodiscard]] constexpr double RSqrt(double input)
 	{
-		return sqrtl(input);
+		return 1.0 / Sqrt(input);
 	}
 
 	template<typename T>
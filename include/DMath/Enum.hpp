@@ -21,4 +21,143 @@ namespace Math
 		OpenGL,
 		Vulkan
 	};
+
+	// Order of Matrix elements in memory, and in brace initialization and GetData.
+	enum class MatrixLayout : unsigned char
+	{
+		// Columns one after another, as OpenGL, Vulkan and GLSL expect by default.
+		ColumnMajor,
+		// Rows one after another, as DirectXMath and HLSL row_major matrices expect.
+		RowMajor
+	};
+
+	// Rules for placing scalars, Vectors and Matrices in a GPU buffer, see GpuBuffer.hpp.
+	enum class BufferLayout : unsigned char
+	{
+		// GLSL uniform blocks. Array elements and matrix columns start on 16 bytes.
+		Std140,
+		// GLSL storage buffers and push constants. Arrays of scalars and two component vectors are packed,
+		// three component vectors still take 16 bytes.
+		Std430,
+		// Affine transforms as three rows of four floats, 48 bytes, as in VkTransformMatrixKHR and D3D12 ray tracing instances.
+		Rows3x4
+	};
+
+	enum class BufferLayoutStatus : unsigned char
+	{
+		Ok,
+		// The type has no placement in the layout, such as a Vector3D in Rows3x4.
+		UnsupportedType,
+		// The member does not start on the alignment the layout requires.
+		MisalignedOffset,
+		// The array stride differs from the layout, or several elements were given for a member that is not an array.
+		ArrayStrideMismatch,
+		// The distance between matrix columns, or rows in Rows3x4, differs from the layout.
+		MatrixStrideMismatch,
+		// The elements end past the end of the buffer.
+		OutOfBounds
+	};
+
+	enum class FrustumPlane : unsigned char
+	{
+		Left,
+		Right,
+		Bottom,
+		Top,
+		Near,
+		Far
+	};
+
+	enum class BVHBuildMethod : unsigned char
+	{
+		// Top-down binned surface area heuristic. Slower to build, faster to traverse.
+		BinnedSAH,
+		// Bottom-up from primitives sorted along a Morton curve. Fast to build and fully parallel.
+		Linear
+	};
+
+	enum class NormalizePrecision : unsigned char
+	{
+		// Divides by the square root of the squared magnitude, like GetNormalized.
+		Full,
+		// Multiplies by an estimated reciprocal square root refined with one Newton step.
+		Fast
+	};
+
+	enum class SplineType : unsigned char
+	{
+		// Piecewise cubic Bezier, every segment shares its end point with the next. 3n + 1 control points.
+		Bezier,
+		// Uniform Catmull-Rom, passes through every control point but the first and last.
+		CatmullRom,
+		// Uniform cubic B-spline, twice continuously differentiable and passes through none of the control points in general.
+		BSpline
+	};
+
+	enum class NoiseType : unsigned char
+	{
+		// Gradients on the corners of the square or cube around the position, blended with a quintic fade.
+		Perlin,
+		// Gradients on the corners of the triangle or tetrahedron around the position. Fewer corners and no directional artifacts.
+		Simplex
+	};
+
+	enum class BinaryScalarType : unsigned char
+	{
+		Float32,
+		Float64,
+		Int32,
+		UInt32
+	};
+
+	enum class BinaryFileAccess : unsigned char
+	{
+		// Maps the file into memory, so that pages are read on first access. Reads the file where mapping is not available.
+		Map,
+		// Reads the elements into memory owned by the BinaryFile.
+		Read
+	};
+
+	enum class BinaryFileStatus : unsigned char
+	{
+		// No file was opened, or it was closed.
+		Closed,
+		Ok,
+		// The file does not exist or could not be read.
+		CannotOpen,
+		// The file is not a DMath binary container, or is shorter than its header claims.
+		InvalidFormat,
+		// The file was written by a newer version of the format.
+		UnsupportedVersion
+	};
+
+	// Operations counted by the instrumentation, see Instrumentation.hpp.
+	enum class InstrumentedOperation : unsigned char
+	{
+		// Matrix times matrix.
+		MatrixMultiply,
+		// Matrix times vector.
+		MatrixVectorMultiply,
+		MatrixDeterminant,
+		MatrixInverse,
+		// SolveLinearEquation.
+		LinearEquationSolve,
+		VectorDot,
+		VectorCross,
+		// Normalize and GetNormalized, the _Fast variants and NormalizeVectors, once per vector.
+		VectorNormalize,
+		QuaternionMultiply,
+		// Conversion of a UnitQuaternion to a rotation matrix.
+		QuaternionToMatrix,
+		// LinearTransform3D::Multiply_Reduced of two transforms.
+		TransformMultiply,
+		// LinearTransform3D::Multiply_Reduced of a transform and a point.
+		TransformPoint,
+		// The LinearTransform3D::Rotate functions.
+		TransformRotation,
+		// LinearTransform3D::LookAt, Perspective and Orthographic.
+		TransformCamera,
+		// Number of operations, not an operation.
+		Count
+	};
 }
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+// Standard execution policies select between the single thread and the _Parallel version of DMath's batch operations.
+// libstdc++ runs its parallel algorithms on TBB when TBB is installed, and its <execution> then needs TBB at link time,
+// so there the policy overloads are left out unless DMATH_EXECUTION_POLICIES is defined by a build that links TBB.
+// Standard libraries without policies, such as older libc++, still compile, the policy overloads just never match.
+#if !defined( DMATH_EXECUTION_POLICIES ) && !( defined( _GLIBCXX_USE_TBB_PAR_BACKEND ) && _GLIBCXX_USE_TBB_PAR_BACKEND ) && __has_include(<execution>)
+#	define DMATH_EXECUTION_POLICIES
+#endif
+
+#if defined( DMATH_EXECUTION_POLICIES )
+#	include <execution>
+#endif
+
+namespace Math
+{
+	namespace detail
+	{
+		namespace Execution
+		{
+			template<typename Policy>
+			using PolicyType = std::remove_cv_t<std::remove_reference_t<Policy>>;
+
+#if defined( DMATH_EXECUTION_POLICIES ) && defined( __cpp_lib_execution )
+			template<typename Policy>
+			constexpr bool isPolicy = std::is_execution_policy_v<PolicyType<Policy>>;
+
+			// par and par_unseq run on the parallel executor. seq, unseq and implementation specific policies run on the calling thread,
+			// which still uses the SIMD kernels, as DMath's kernels do not depend on the order elements are processed in.
+			template<typename Policy>
+			constexpr bool isParallel = std::is_same_v<PolicyType<Policy>, std::execution::parallel_policy>
+				|| std::is_same_v<PolicyType<Policy>, std::execution::parallel_unsequenced_policy>;
+#else
+			template<typename Policy>
+			constexpr bool isPolicy = false;
+
+			template<typename Policy>
+			constexpr bool isParallel = false;
+#endif
+
+			// Removes the policy overloads of batch operations from overload resolution for arguments that are not policies.
+			template<typename Policy>
+			using EnableIfPolicy = std::enable_if_t<isPolicy<Policy>>;
+		}
+	}
+}
\ No newline at end of file
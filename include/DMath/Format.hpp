@@ -0,0 +1,348 @@
+#pragma once
+
+#include "Span.hpp"
+#include "Enum.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace Math
+{
+	template<size_t length, typename T>
+	struct Vector;
+	template<size_t width, size_t height, typename T, MatrixLayout layout>
+	struct Matrix;
+
+	namespace Setup
+	{
+		// Digits after the decimal point of floating point components in ToString and ToChars.
+		constexpr int defaultFormatPrecision = 4;
+	}
+
+	// Precision that writes floating point components as the shortest text that reads back to the same value.
+	constexpr int shortestFormatPrecision = -1;
+
+	// Writes the vector as ToString does, "(x, y, z)", with precision digits after the decimal point of floating point components.
+	// Returns { last, std::errc::value_too_large } if the text does not fit.
+	template<size_t length, typename T>
+	[[nodiscard]] std::to_chars_result ToChars(char* first, char* last, const Vector<length, T>& vector, int precision = Setup::defaultFormatPrecision);
+	// Writes the matrix as ToString does, one row per line.
+	template<size_t width, size_t height, typename T, MatrixLayout layout>
+	[[nodiscard]] std::to_chars_result ToChars(char* first, char* last, const Matrix<width, height, T, layout>& matrix, int precision = Setup::defaultFormatPrecision);
+
+	// Reads the components in order, separated by commas and whitespace, optionally in parentheses.
+	// This covers ToChars output as well as CSV and OBJ style text. The vector is unchanged on error.
+	template<size_t length, typename T>
+	[[nodiscard]] std::from_chars_result FromChars(const char* first, const char* last, Vector<length, T>& vector);
+	// Reads the components row by row, in the order ToChars writes them.
+	template<size_t width, size_t height, typename T, MatrixLayout layout>
+	[[nodiscard]] std::from_chars_result FromChars(const char* first, const char* last, Matrix<width, height, T, layout>& matrix);
+
+	struct FormatResult
+	{
+		size_t elementCount;
+		size_t charCount;
+	};
+
+	struct ParseResult
+	{
+		size_t elementCount;
+		size_t charCount;
+		// std::errc() unless the text stopped parsing before its end and before elements was full.
+		std::errc error;
+	};
+
+	// Writes one Vector or Matrix per line, components separated by separator, such as ' ' for OBJ or ',' for CSV. Matrices are written row by row.
+	// Stops before the first element that does not fit, so that output can be flushed and the rest written after.
+	template<typename T>
+	[[nodiscard]] FormatResult FormatElements(Span<const T> elements, Span<char> output, char separator = ' ', int precision = shortestFormatPrecision);
+	// Reads elements one after another as FromChars does, until elements is full, the text ends or an element fails to parse.
+	template<typename T>
+	[[nodiscard]] ParseResult ParseElements(Span<const char> text, Span<T> elements);
+
+	namespace detail
+	{
+		namespace Format
+		{
+			template<typename T>
+			struct ElementTraits;
+
+			template<size_t length, typename T>
+			struct ElementTraits<Math::Vector<length, T>>
+			{
+				using ValueType = T;
+				static constexpr size_t componentCount = length;
+
+				[[nodiscard]] static const T& Get(const Math::Vector<length, T>& vector, size_t index) { return vector[index]; }
+				[[nodiscard]] static T& Get(Math::Vector<length, T>& vector, size_t index) { return vector[index]; }
+			};
+
+			// Components in reading order, row by row.
+			template<size_t width, size_t height, typename T, MatrixLayout layout>
+			struct ElementTraits<Math::Matrix<width, height, T, layout>>
+			{
+				using ValueType = T;
+				static constexpr size_t componentCount = width * height;
+
+				[[nodiscard]] static const T& Get(const Math::Matrix<width, height, T, layout>& matrix, size_t index) { return matrix[index % width][index / width]; }
+				[[nodiscard]] static T& Get(Math::Matrix<width, height, T, layout>& matrix, size_t index) { return matrix[index % width][index / width]; }
+			};
+
+			template<typename T>
+			[[nodiscard]] constexpr size_t GetMaxComponentLength(int precision)
+			{
+				if constexpr (std::is_floating_point_v<T>)
+				{
+					// Sign, integer digits, point and fraction digits, or the longest shortest form with its exponent.
+					if (precision >= 0)
+						return size_t(std::numeric_limits<T>::max_exponent10) + 3 + size_t(precision);
+					return size_t(std::numeric_limits<T>::max_digits10) + 12;
+				}
+				else
+					return size_t(std::numeric_limits<T>::digits10) + 3;
+			}
+
+			// A float times 10^12 or less is exact in a double, the 24 bit mantissa and 5^12 need 52 bits together.
+			constexpr int maxExactFloatPrecision = 12;
+			constexpr double exactPowersOf10[maxExactFloatPrecision + 1] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12 };
+			constexpr uint64_t integerPowersOf10[maxExactFloatPrecision + 1] = { 1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull };
+
+			// Fixed notation of a float through integer arithmetic, rounded half to even on the exact value like std::to_chars.
+			// Returns a null ptr for values whose scaled magnitude does not fit 63 bits, and for infinity and NaN.
+			[[nodiscard]] inline std::to_chars_result WriteFixedFloat(char* first, char* last, float value, int precision)
+			{
+				const double scaled = std::fabs(double(value) * exactPowersOf10[precision]);
+				if (!(scaled < 9.2e18))
+					return std::to_chars_result{ nullptr, std::errc() };
+				uint64_t integer = uint64_t(scaled);
+				const double fraction = scaled - double(integer);
+				if (fraction > 0.5 || (fraction == 0.5 && (integer & 1) != 0))
+					integer++;
+
+				const auto tooLarge = std::to_chars_result{ last, std::errc::value_too_large };
+				const uint64_t scale = integerPowersOf10[precision];
+				if (std::signbit(value))
+				{
+					if (first == last)
+						return tooLarge;
+					*first++ = '-';
+				}
+				const std::to_chars_result whole = std::to_chars(first, last, integer / scale);
+				if (whole.ec != std::errc() || last - whole.ptr < precision + (precision > 0))
+					return tooLarge;
+				first = whole.ptr;
+				if (precision > 0)
+				{
+					*first++ = '.';
+					uint64_t digits = integer % scale;
+					for (int i = precision - 1; i >= 0; i--)
+					{
+						first[i] = char('0' + digits % 10);
+						digits /= 10;
+					}
+					first += precision;
+				}
+				return std::to_chars_result{ first, std::errc() };
+			}
+
+			template<typename T>
+			[[nodiscard]] std::to_chars_result WriteComponent(char* first, char* last, T value, int precision)
+			{
+				static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "DMath error. Only arithmetic components can be formatted.");
+
+				if constexpr (std::is_same_v<T, float>)
+				{
+					if (precision >= 0 && precision <= maxExactFloatPrecision)
+					{
+						const std::to_chars_result result = WriteFixedFloat(first, last, value, precision);
+						if (result.ptr != nullptr)
+							return result;
+					}
+				}
+				if constexpr (std::is_floating_point_v<T>)
+				{
+					if (precision >= 0)
+						return std::to_chars(first, last, value, std::chars_format::fixed, precision);
+					return std::to_chars(first, last, value);
+				}
+				else
+					return std::to_chars(first, last, value);
+			}
+
+			[[nodiscard]] inline bool IsSeparator(char character)
+			{
+				return character == ' ' || character == ',' || character == '\t' || character == '\n' || character == '\r';
+			}
+
+			[[nodiscard]] inline const char* SkipWhitespace(const char* first, const char* last)
+			{
+				while (first != last && (*first == ' ' || *first == '\t' || *first == '\n' || *first == '\r'))
+					first++;
+				return first;
+			}
+
+			// Components separated by separator, each given by its length, the whole wrapped in opening and closing when they are not 0.
+			template<typename Element>
+			[[nodiscard]] std::to_chars_result Write(char* first, char* last, const Element& element, int precision, const char* separator, size_t separatorLength, size_t rowLength, char opening, char closing)
+			{
+				using Traits = ElementTraits<Element>;
+
+				const auto tooLarge = std::to_chars_result{ last, std::errc::value_too_large };
+				if (opening != 0)
+				{
+					if (first == last)
+						return tooLarge;
+					*first++ = opening;
+				}
+				for (size_t i = 0; i < Traits::componentCount; i++)
+				{
+					if (i > 0)
+					{
+						if (i % rowLength == 0)
+						{
+							if (first == last)
+								return tooLarge;
+							*first++ = '\n';
+						}
+						else
+						{
+							if (size_t(last - first) < separatorLength)
+								return tooLarge;
+							for (size_t c = 0; c < separatorLength; c++)
+								*first++ = separator[c];
+						}
+					}
+					const std::to_chars_result result = WriteComponent(first, last, Traits::Get(element, i), precision);
+					if (result.ec != std::errc())
+						return tooLarge;
+					first = result.ptr;
+				}
+				if (closing != 0)
+				{
+					if (first == last)
+						return tooLarge;
+					*first++ = closing;
+				}
+				return std::to_chars_result{ first, std::errc() };
+			}
+
+			template<typename Element>
+			[[nodiscard]] std::from_chars_result Read(const char* first, const char* last, Element& element)
+			{
+				using Traits = ElementTraits<Element>;
+				using ValueType = typename Traits::ValueType;
+
+				const char* position = SkipWhitespace(first, last);
+				const bool hasParentheses = position != last && *position == '(';
+				if (hasParentheses)
+					position++;
+
+				ValueType components[Traits::componentCount];
+				for (size_t i = 0; i < Traits::componentCount; i++)
+				{
+					while (position != last && IsSeparator(*position))
+						position++;
+					const std::from_chars_result result = std::from_chars(position, last, components[i]);
+					if (result.ec != std::errc())
+						return std::from_chars_result{ first, result.ec };
+					position = result.ptr;
+				}
+
+				if (hasParentheses)
+				{
+					position = SkipWhitespace(position, last);
+					if (position == last || *position != ')')
+						return std::from_chars_result{ first, std::errc::invalid_argument };
+					position++;
+				}
+				for (size_t i = 0; i < Traits::componentCount; i++)
+					Traits::Get(element, i) = components[i];
+				return std::from_chars_result{ position, std::errc() };
+			}
+
+			template<typename Element>
+			[[nodiscard]] std::string ToString(const Element& element)
+			{
+				using Traits = ElementTraits<Element>;
+
+				constexpr int precision = std::is_floating_point_v<typename Traits::ValueType> ? Setup::defaultFormatPrecision : 0;
+				std::string text(Traits::componentCount * (GetMaxComponentLength<typename Traits::ValueType>(precision) + 2) + 2, '\0');
+				const std::to_chars_result result = Math::ToChars(text.data(), text.data() + text.size(), element, precision);
+				text.resize(size_t(result.ptr - text.data()));
+				return text;
+			}
+		}
+	}
+}
+
+template<size_t length, typename T>
+std::to_chars_result Math::ToChars(char* first, char* last, const Vector<length, T>& vector, int precision)
+{
+	return detail::Format::Write(first, last, vector, precision, ", ", 2, length, '(', ')');
+}
+
+template<size_t width, size_t height, typename T, Math::MatrixLayout layout>
+std::to_chars_result Math::ToChars(char* first, char* last, const Matrix<width, height, T, layout>& matrix, int precision)
+{
+	return detail::Format::Write(first, last, matrix, precision, ", ", 2, width, 0, 0);
+}
+
+template<size_t length, typename T>
+std::from_chars_result Math::FromChars(const char* first, const char* last, Vector<length, T>& vector)
+{
+	return detail::Format::Read(first, last, vector);
+}
+
+template<size_t width, size_t height, typename T, Math::MatrixLayout layout>
+std::from_chars_result Math::FromChars(const char* first, const char* last, Matrix<width, height, T, layout>& matrix)
+{
+	return detail::Format::Read(first, last, matrix);
+}
+
+template<typename T>
+Math::FormatResult Math::FormatElements(Span<const T> elements, Span<char> output, char separator, int precision)
+{
+	using Traits = detail::Format::ElementTraits<T>;
+
+	char* const begin = output.data();
+	char* const end = begin + output.size();
+	char* position = begin;
+	size_t elementCount = 0;
+	for (const T& element : elements)
+	{
+		const std::to_chars_result result = detail::Format::Write(position, end, element, precision, &separator, 1, Traits::componentCount, 0, 0);
+		if (result.ec != std::errc() || result.ptr == end)
+			break;
+		position = result.ptr;
+		*position++ = '\n';
+		elementCount++;
+	}
+	return FormatResult{ elementCount, size_t(position - begin) };
+}
+
+template<typename T>
+Math::ParseResult Math::ParseElements(Span<const char> text, Span<T> elements)
+{
+	const char* const begin = text.data();
+	const char* const end = begin + text.size();
+	const char* position = begin;
+	size_t elementCount = 0;
+	while (elementCount < elements.size())
+	{
+		position = detail::Format::SkipWhitespace(position, end);
+		if (position == end)
+			break;
+		const std::from_chars_result result = detail::Format::Read(position, end, elements[elementCount]);
+		if (result.ec != std::errc())
+			return ParseResult{ elementCount, size_t(position - begin), result.ec };
+		position = result.ptr;
+		elementCount++;
+	}
+	return ParseResult{ elementCount, size_t(position - begin), std::errc() };
+}
\ No newline at end of file
@@ -0,0 +1,419 @@
+#pragma once
+
+#include "Setup.hpp"
+#include "Enum.hpp"
+#include "Matrix/Matrix.hpp"
+#include "Vector/Vector.hpp"
+#include "Plane.hpp"
+#include "BoundingVolume.hpp"
+#include "Span.hpp"
+#include "Simd.hpp"
+#include "Parallel.hpp"
+#include "Execution.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+namespace Math
+{
+	// View frustum described by six inward facing planes, indexed by FrustumPlane.
+	template<typename T = float>
+	struct Frustum
+	{
+		using ValueType = T;
+
+		std::array<Plane<T>, 6> planes;
+
+		[[nodiscard]] static Frustum<T> FromMatrix_ZO(const Matrix<4, 4, T>& viewProjection);
+		[[nodiscard]] static Frustum<T> FromMatrix_NO(const Matrix<4, 4, T>& viewProjection);
+		[[nodiscard]] static Frustum<T> FromMatrix(API3D api, const Matrix<4, 4, T>& viewProjection);
+
+		[[nodiscard]] constexpr const Plane<T>& GetPlane(FrustumPlane plane) const
+		{
+			return planes[size_t(plane)];
+		}
+
+		[[nodiscard]] constexpr bool Contains(const Vector<3, T>& point) const
+		{
+			for (const auto& plane : planes)
+			{
+				if (plane.SignedDistance(point) < T(0))
+					return false;
+			}
+			return true;
+		}
+
+		// Conservative test. May report spheres near the frustum corners as intersecting.
+		[[nodiscard]] constexpr bool IntersectsSphere(const Vector<3, T>& center, T radius) const
+		{
+			for (const auto& plane : planes)
+			{
+				if (!(plane.SignedDistance(center) >= -radius))
+					return false;
+			}
+			return true;
+		}
+
+		// Conservative test. May report boxes near the frustum corners as intersecting.
+		[[nodiscard]] constexpr bool IntersectsAABB(const Vector<3, T>& min, const Vector<3, T>& max) const
+		{
+			for (const auto& plane : planes)
+			{
+				const Vector<3, T> positiveVertex
+				{
+					plane.normal.x >= T(0) ? max.x : min.x,
+					plane.normal.y >= T(0) ? max.y : min.y,
+					plane.normal.z >= T(0) ? max.z : min.z
+				};
+				if (!(plane.SignedDistance(positiveVertex) >= T(0)))
+					return false;
+			}
+			return true;
+		}
+
+		[[nodiscard]] constexpr bool Intersects(const Sphere<T>& sphere) const
+		{
+			return IntersectsSphere(sphere.center, sphere.radius);
+		}
+		[[nodiscard]] constexpr bool Intersects(const AABB3D<T>& box) const
+		{
+			return IntersectsAABB(box.min, box.max);
+		}
+	};
+
+	// Visibility masks store one bit per object, 32 objects per word. Bit (i % 32) of word (i / 32) is set when object i is visible.
+	[[nodiscard]] constexpr size_t GetVisibilityMaskLength(size_t objectCount)
+	{
+		return (objectCount + 31) / 32;
+	}
+
+	[[nodiscard]] constexpr bool IsVisible(Span<const uint32_t> visibilityMask, size_t objectIndex)
+	{
+		return (visibilityMask[objectIndex / 32] >> (objectIndex % 32)) & 1u;
+	}
+
+	template<typename T>
+	void CullSpheres(const Frustum<T>& frustum, const SphereBatch<T>& spheres, Span<uint32_t> visibilityMask);
+	template<typename T>
+	void CullAABBs(const Frustum<T>& frustum, const AABBBatch<T>& boxes, Span<uint32_t> visibilityMask);
+
+	template<typename T>
+	void CullSpheres_Parallel(const Frustum<T>& frustum, const SphereBatch<T>& spheres, Span<uint32_t> visibilityMask, size_t grainSize = Setup::defaultParallelGrainSize);
+	template<typename T>
+	void CullAABBs_Parallel(const Frustum<T>& frustum, const AABBBatch<T>& boxes, Span<uint32_t> visibilityMask, size_t grainSize = Setup::defaultParallelGrainSize);
+
+	// std::execution::par and par_unseq run the _Parallel versions, other policies the single thread ones.
+	template<typename T, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void CullSpheres(ExecutionPolicy&& policy, const Frustum<T>& frustum, const SphereBatch<T>& spheres, Span<uint32_t> visibilityMask);
+	template<typename T, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void CullAABBs(ExecutionPolicy&& policy, const Frustum<T>& frustum, const AABBBatch<T>& boxes, Span<uint32_t> visibilityMask);
+
+	namespace detail
+	{
+		namespace Culling
+		{
+			template<typename T>
+			[[nodiscard]] constexpr Plane<T> GetClipRow(const Math::Matrix<4, 4, T>& matrix, size_t row)
+			{
+				return Plane<T>{ Vector<3, T>{ matrix[0][row], matrix[1][row], matrix[2][row] }, matrix[3][row] };
+			}
+
+			template<typename T>
+			[[nodiscard]] constexpr Plane<T> AddPlanes(const Plane<T>& left, const Plane<T>& right)
+			{
+				return Plane<T>{ left.normal + right.normal, left.distance + right.distance };
+			}
+
+			template<typename T>
+			[[nodiscard]] constexpr Plane<T> SubtractPlanes(const Plane<T>& left, const Plane<T>& right)
+			{
+				return Plane<T>{ left.normal - right.normal, left.distance - right.distance };
+			}
+
+			// Plane::SignedDistance of laneCount points, summed in the same order.
+			// Every multiply-add is explicit, so that the vector registers and the remainder, FloatLanes<1>, round alike.
+			template<typename L>
+			[[nodiscard]] typename L::Register GetSignedDistance(const Plane<float>& plane, typename L::Register x, typename L::Register y, typename L::Register z)
+			{
+				auto distance = L::Mul(x, L::Set(plane.normal.x));
+				distance = L::MulAdd(y, L::Set(plane.normal.y), distance);
+				distance = L::MulAdd(z, L::Set(plane.normal.z), distance);
+				return L::Add(distance, L::Set(plane.distance));
+			}
+
+			// Returns the visibility bits of the laneCount spheres starting at index.
+			template<size_t laneCount>
+			[[nodiscard]] uint32_t CullSpheresLanes(const Frustum<float>& frustum, const SphereBatch<float>& spheres, size_t index)
+			{
+				using L = Simd::FloatLanes<laneCount>;
+				const auto centerX = L::LoadUnaligned(spheres.centerX.data() + index);
+				const auto centerY = L::LoadUnaligned(spheres.centerY.data() + index);
+				const auto centerZ = L::LoadUnaligned(spheres.centerZ.data() + index);
+				const auto negRadius = L::Negate(L::LoadUnaligned(spheres.radius.data() + index));
+
+				auto visible = L::GreaterEqual(GetSignedDistance<L>(frustum.planes[0], centerX, centerY, centerZ), negRadius);
+				for (size_t plane = 1; plane < frustum.planes.size(); plane++)
+					visible = L::And(visible, L::GreaterEqual(GetSignedDistance<L>(frustum.planes[plane], centerX, centerY, centerZ), negRadius));
+				return L::ToBits(visible);
+			}
+
+			// Returns the visibility bits of the laneCount boxes starting at index.
+			// The positive vertex of each box only depends on the sign of the plane normal,
+			// so it is selected once per plane rather than once per box.
+			template<size_t laneCount>
+			[[nodiscard]] uint32_t CullAABBsLanes(const Frustum<float>& frustum, const AABBBatch<float>& boxes, size_t index)
+			{
+				using L = Simd::FloatLanes<laneCount>;
+				const auto getDistance = [&](const Plane<float>& plane)
+				{
+					const auto x = L::LoadUnaligned((plane.normal.x >= 0.f ? boxes.maxX : boxes.minX).data() + index);
+					const auto y = L::LoadUnaligned((plane.normal.y >= 0.f ? boxes.maxY : boxes.minY).data() + index);
+					const auto z = L::LoadUnaligned((plane.normal.z >= 0.f ? boxes.maxZ : boxes.minZ).data() + index);
+					return GetSignedDistance<L>(plane, x, y, z);
+				};
+
+				const auto zero = L::Set(0.f);
+				auto visible = L::GreaterEqual(getDistance(frustum.planes[0]), zero);
+				for (size_t plane = 1; plane < frustum.planes.size(); plane++)
+					visible = L::And(visible, L::GreaterEqual(getDistance(frustum.planes[plane]), zero));
+				return L::ToBits(visible);
+			}
+
+			// Returns the visibility bits of the objects [offset, offset + count), count <= Simd::blockLength.
+			template<typename T>
+			[[nodiscard]] uint32_t CullSpheres_Block(const Frustum<T>& frustum, const SphereBatch<T>& spheres, size_t offset, size_t count)
+			{
+				uint32_t mask = 0;
+				size_t i = 0;
+				if constexpr (std::is_same_v<T, float>)
+				{
+					constexpr size_t laneCount = Simd::floatLaneCount;
+					if constexpr (laneCount > 1)
+					{
+						for (; i + laneCount <= count; i += laneCount)
+							mask |= CullSpheresLanes<laneCount>(frustum, spheres, offset + i) << i;
+					}
+					// The remainder runs the same kernel one sphere at a time, so a sphere's bit does not depend on where it is in the batch.
+					for (; i < count; i++)
+						mask |= CullSpheresLanes<1>(frustum, spheres, offset + i) << i;
+				}
+				else
+				{
+					for (; i < count; i++)
+					{
+						const size_t index = offset + i;
+						bool visible = true;
+						for (const auto& plane : frustum.planes)
+						{
+							const T distance = spheres.centerX[index] * plane.normal.x + spheres.centerY[index] * plane.normal.y + spheres.centerZ[index] * plane.normal.z + plane.distance;
+							visible &= distance >= -spheres.radius[index];
+						}
+						mask |= uint32_t(visible) << i;
+					}
+				}
+				return mask;
+			}
+
+			// Returns the visibility bits of the objects [offset, offset + count), count <= Simd::blockLength.
+			template<typename T>
+			[[nodiscard]] uint32_t CullAABBs_Block(const Frustum<T>& frustum, const AABBBatch<T>& boxes, size_t offset, size_t count)
+			{
+				uint32_t mask = 0;
+				size_t i = 0;
+				if constexpr (std::is_same_v<T, float>)
+				{
+					constexpr size_t laneCount = Simd::floatLaneCount;
+					if constexpr (laneCount > 1)
+					{
+						for (; i + laneCount <= count; i += laneCount)
+							mask |= CullAABBsLanes<laneCount>(frustum, boxes, offset + i) << i;
+					}
+					// The remainder runs the same kernel one box at a time, so a box's bit does not depend on where it is in the batch.
+					for (; i < count; i++)
+						mask |= CullAABBsLanes<1>(frustum, boxes, offset + i) << i;
+				}
+				else
+				{
+					for (; i < count; i++)
+					{
+						const size_t index = offset + i;
+						bool visible = true;
+						for (const auto& plane : frustum.planes)
+						{
+							const T x = plane.normal.x >= T(0) ? boxes.maxX[index] : boxes.minX[index];
+							const T y = plane.normal.y >= T(0) ? boxes.maxY[index] : boxes.minY[index];
+							const T z = plane.normal.z >= T(0) ? boxes.maxZ[index] : boxes.minZ[index];
+							visible &= x * plane.normal.x + y * plane.normal.y + z * plane.normal.z + plane.distance >= T(0);
+						}
+						mask |= uint32_t(visible) << i;
+					}
+				}
+				return mask;
+			}
+
+			// Fills the mask words [wordBegin, wordEnd).
+			template<typename T, typename Batch, typename BlockFunc>
+			void CullRange(const Frustum<T>& frustum, const Batch& batch, size_t objectCount, Span<uint32_t> visibilityMask, size_t wordBegin, size_t wordEnd, BlockFunc blockFunc)
+			{
+				constexpr size_t blockLength = Simd::blockLength;
+				static_assert(32 % blockLength == 0, "DMath error. Visibility mask words must hold a whole number of blocks.");
+
+				for (size_t word = wordBegin; word < wordEnd; word++)
+				{
+					uint32_t mask = 0;
+					for (size_t block = 0; block < 32 / blockLength; block++)
+					{
+						const size_t offset = word * 32 + block * blockLength;
+						if (offset >= objectCount)
+							break;
+						const size_t count = std::min(blockLength, objectCount - offset);
+						mask |= blockFunc(frustum, batch, offset, count) << (block * blockLength);
+					}
+					visibilityMask[word] = mask;
+				}
+			}
+		}
+	}
+}
+
+template<typename T>
+Math::Frustum<T> Math::Frustum<T>::FromMatrix_ZO(const Matrix<4, 4, T>& viewProjection)
+{
+	static_assert
+	(
+		std::is_floating_point<T>(),
+		"DMath error. Template argument T in Math::Frustum::FromMatrix_ZO must be floating point type."
+	);
+
+	using namespace detail::Culling;
+	const Plane<T> row0 = GetClipRow(viewProjection, 0);
+	const Plane<T> row1 = GetClipRow(viewProjection, 1);
+	const Plane<T> row2 = GetClipRow(viewProjection, 2);
+	const Plane<T> row3 = GetClipRow(viewProjection, 3);
+
+	Frustum<T> frustum
+	{
+		AddPlanes(row3, row0),
+		SubtractPlanes(row3, row0),
+		AddPlanes(row3, row1),
+		SubtractPlanes(row3, row1),
+		row2,
+		SubtractPlanes(row3, row2)
+	};
+	for (auto& plane : frustum.planes)
+		plane.Normalize();
+	return frustum;
+}
+
+template<typename T>
+Math::Frustum<T> Math::Frustum<T>::FromMatrix_NO(const Matrix<4, 4, T>& viewProjection)
+{
+	static_assert
+	(
+		std::is_floating_point<T>(),
+		"DMath error. Template argument T in Math::Frustum::FromMatrix_NO must be floating point type."
+	);
+
+	using namespace detail::Culling;
+	const Plane<T> row0 = GetClipRow(viewProjection, 0);
+	const Plane<T> row1 = GetClipRow(viewProjection, 1);
+	const Plane<T> row2 = GetClipRow(viewProjection, 2);
+	const Plane<T> row3 = GetClipRow(viewProjection, 3);
+
+	Frustum<T> frustum
+	{
+		AddPlanes(row3, row0),
+		SubtractPlanes(row3, row0),
+		AddPlanes(row3, row1),
+		SubtractPlanes(row3, row1),
+		AddPlanes(row3, row2),
+		SubtractPlanes(row3, row2)
+	};
+	for (auto& plane : frustum.planes)
+		plane.Normalize();
+	return frustum;
+}
+
+template<typename T>
+Math::Frustum<T> Math::Frustum<T>::FromMatrix(API3D api, const Matrix<4, 4, T>& viewProjection)
+{
+#if defined( _MSC_VER )
+	__assume(api == API3D::OpenGL || api == API3D::Vulkan);
+#endif
+
+	switch (api)
+	{
+	case API3D::OpenGL:
+		return FromMatrix_NO(viewProjection);
+	case API3D::Vulkan:
+		return FromMatrix_ZO(viewProjection);
+	default:
+#if defined( _MSC_VER )
+		__assume(0);
+#elif defined( __GNUC__ )
+		__builtin_unreachable();
+#endif
+	}
+}
+
+template<typename T>
+void Math::CullSpheres(const Frustum<T>& frustum, const SphereBatch<T>& spheres, Span<uint32_t> visibilityMask)
+{
+	const size_t count = spheres.Size();
+	assert(visibilityMask.size() >= GetVisibilityMaskLength(count));
+	detail::Culling::CullRange(frustum, spheres, count, visibilityMask, 0, GetVisibilityMaskLength(count), detail::Culling::CullSpheres_Block<T>);
+}
+
+template<typename T>
+void Math::CullAABBs(const Frustum<T>& frustum, const AABBBatch<T>& boxes, Span<uint32_t> visibilityMask)
+{
+	const size_t count = boxes.Size();
+	assert(visibilityMask.size() >= GetVisibilityMaskLength(count));
+	detail::Culling::CullRange(frustum, boxes, count, visibilityMask, 0, GetVisibilityMaskLength(count), detail::Culling::CullAABBs_Block<T>);
+}
+
+template<typename T>
+void Math::CullSpheres_Parallel(const Frustum<T>& frustum, const SphereBatch<T>& spheres, Span<uint32_t> visibilityMask, size_t grainSize)
+{
+	const size_t count = spheres.Size();
+	const size_t wordCount = GetVisibilityMaskLength(count);
+	assert(visibilityMask.size() >= wordCount);
+	// Splits on whole mask words so no two threads write the same word.
+	ParallelFor(0, wordCount, GetVisibilityMaskLength(grainSize), [&](size_t wordBegin, size_t wordEnd)
+	{
+		detail::Culling::CullRange(frustum, spheres, count, visibilityMask, wordBegin, wordEnd, detail::Culling::CullSpheres_Block<T>);
+	});
+}
+
+template<typename T>
+void Math::CullAABBs_Parallel(const Frustum<T>& frustum, const AABBBatch<T>& boxes, Span<uint32_t> visibilityMask, size_t grainSize)
+{
+	const size_t count = boxes.Size();
+	const size_t wordCount = GetVisibilityMaskLength(count);
+	assert(visibilityMask.size() >= wordCount);
+	// Splits on whole mask words so no two threads write the same word.
+	ParallelFor(0, wordCount, GetVisibilityMaskLength(grainSize), [&](size_t wordBegin, size_t wordEnd)
+	{
+		detail::Culling::CullRange(frustum, boxes, count, visibilityMask, wordBegin, wordEnd, detail::Culling::CullAABBs_Block<T>);
+	});
+}
+
+template<typename T, typename ExecutionPolicy, typename>
+void Math::CullSpheres(ExecutionPolicy&&, const Frustum<T>& frustum, const SphereBatch<T>& spheres, Span<uint32_t> visibilityMask)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		CullSpheres_Parallel(frustum, spheres, visibilityMask);
+	else
+		CullSpheres(frustum, spheres, visibilityMask);
+}
+
+template<typename T, typename ExecutionPolicy, typename>
+void Math::CullAABBs(ExecutionPolicy&&, const Frustum<T>& frustum, const AABBBatch<T>& boxes, Span<uint32_t> visibilityMask)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		CullAABBs_Parallel(frustum, boxes, visibilityMask);
+	else
+		CullAABBs(frustum, boxes, visibilityMask);
+}
\ No newline at end of file
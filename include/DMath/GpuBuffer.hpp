@@ -0,0 +1,346 @@
+#pragma once
+
+#include "Matrix/Matrix.hpp"
+#include "Vector/Vector.hpp"
+#include "Enum.hpp"
+#include "Instrumentation.hpp"
+#include "Simd.hpp"
+#include "Span.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Math
+{
+	namespace Setup
+	{
+		// Bytes PackBuffer lays out in a local buffer before streaming them to the destination.
+		constexpr size_t bufferPackingBlockSize = 4096;
+	}
+
+	// Placement of one member of a GPU buffer as the shader sees it, such as glGetProgramResourceiv reports with
+	// GL_OFFSET, GL_ARRAY_STRIDE and GL_MATRIX_STRIDE, or SPIR-V reflection with its Offset, ArrayStride and MatrixStride decorations.
+	struct BufferMemberDescriptor
+	{
+		// Bytes from the start of the buffer to the first element.
+		size_t offset = 0;
+		// Bytes from one element to the next. 0 for a member that is not an array.
+		size_t arrayStride = 0;
+		// Bytes from one matrix column to the next, or one row in Rows3x4. 0 for scalars and vectors.
+		size_t matrixStride = 0;
+	};
+
+	// T is float, int32_t, uint32_t, a Vector of 2 to 4 of them or a Matrix of 2 to 4 columns and rows of them.
+	// Matrices are written column-major in Std140 and Std430, as GLSL expects by default, whatever their MatrixLayout.
+	// Rows3x4 only takes Matrix<4, 3> and Matrix<4, 4> of float, the bottom row of the latter is left out.
+
+	// Alignment the start of an array of T needs in layout. 0 if layout has no placement for T.
+	template<typename T>
+	[[nodiscard]] constexpr size_t GetBufferAlignment(BufferLayout layout);
+	// Bytes from one element of an array of T to the next.
+	template<typename T>
+	[[nodiscard]] constexpr size_t GetBufferStride(BufferLayout layout);
+	// Bytes from one matrix column to the next, or one row in Rows3x4. 0 for scalars and vectors.
+	template<typename T>
+	[[nodiscard]] constexpr size_t GetBufferMatrixStride(BufferLayout layout);
+
+	// Writes the elements as an array in layout to destination, elements.size() * GetBufferStride<T>(layout) bytes, padding as zeros.
+	// Writes with non-temporal SSE2 stores where available, which go around the cache. That suits write-combined memory mapped from
+	// the GPU, and any buffer the CPU does not read back soon. The stores are fenced before returning.
+	template<BufferLayout layout, typename T>
+	void PackBuffer(Span<const T> elements, void* destination);
+
+	// Whether count elements of T placed in a buffer of bufferSize bytes as member describes are where layout puts them.
+	template<typename T>
+	[[nodiscard]] BufferLayoutStatus ValidateBufferMember(BufferLayout layout, const BufferMemberDescriptor& member, size_t count, size_t bufferSize);
+
+	// Validates the member as ValidateBufferMember does, then writes the elements at buffer.data() + member.offset.
+	// Writes nothing unless it returns Ok. A member that is not an array takes a single element and writes no padding after it,
+	// so a Vector3D leaves the 4 bytes that follow it to the next member.
+	template<BufferLayout layout, typename T>
+	[[nodiscard]] BufferLayoutStatus PackBuffer(Span<const T> elements, Span<std::byte> buffer, const BufferMemberDescriptor& member);
+
+	namespace detail
+	{
+		namespace GpuBuffer
+		{
+			template<typename T>
+			constexpr bool isScalar = std::is_same_v<T, float> || std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t>;
+
+			// Components as columns of rows. Scalars and vectors are a single column.
+			template<typename T>
+			struct ElementTraits
+			{
+				using ValueType = T;
+				static constexpr bool isSupported = isScalar<T>;
+				static constexpr bool isMatrix = false;
+				static constexpr bool isRowMajor = false;
+				static constexpr size_t columnCount = 1;
+				static constexpr size_t rowCount = 1;
+
+				[[nodiscard]] static const T& Get(const T& element, size_t, size_t) { return element; }
+			};
+
+			template<size_t length, typename T>
+			struct ElementTraits<Math::Vector<length, T>>
+			{
+				using ValueType = T;
+				static constexpr bool isSupported = isScalar<T> && length >= 2 && length <= 4;
+				static constexpr bool isMatrix = false;
+				static constexpr bool isRowMajor = false;
+				static constexpr size_t columnCount = 1;
+				static constexpr size_t rowCount = length;
+
+				[[nodiscard]] static const T& Get(const Math::Vector<length, T>& vector, size_t, size_t row) { return vector.GetData()[row]; }
+			};
+
+			template<size_t width, size_t height, typename T, MatrixLayout layout>
+			struct ElementTraits<Math::Matrix<width, height, T, layout>>
+			{
+				using ValueType = T;
+				static constexpr bool isSupported = isScalar<T> && width >= 2 && width <= 4 && height >= 2 && height <= 4;
+				static constexpr bool isMatrix = true;
+				static constexpr bool isRowMajor = layout == MatrixLayout::RowMajor;
+				static constexpr size_t columnCount = width;
+				static constexpr size_t rowCount = height;
+
+				[[nodiscard]] static const T& Get(const Math::Matrix<width, height, T, layout>& matrix, size_t column, size_t row)
+				{
+					return matrix.GetData()[matrix.GetIndex(column, row)];
+				}
+			};
+
+			struct Placement
+			{
+				size_t alignment;
+				size_t arrayStride;
+				size_t matrixStride;
+				// Bytes of an element that is not in an array. Less than arrayStride only for three component vectors.
+				size_t size;
+			};
+
+			template<typename T>
+			[[nodiscard]] constexpr Placement GetPlacement(BufferLayout layout, bool isArray)
+			{
+				using Traits = ElementTraits<T>;
+				if constexpr (!Traits::isSupported)
+					return Placement{ 0, 0, 0, 0 };
+				else
+				{
+					if (layout == BufferLayout::Rows3x4)
+					{
+						if constexpr (Traits::isMatrix && Traits::columnCount == 4 && Traits::rowCount >= 3 && std::is_same_v<typename Traits::ValueType, float>)
+							return Placement{ 16, 48, 16, 48 };
+						else
+							return Placement{ 0, 0, 0, 0 };
+					}
+
+					// Scalars align to 4 bytes, two component vectors to 8, three and four component vectors to 16.
+					const size_t vectorAlignment = Traits::rowCount == 3 ? 16 : Traits::rowCount * 4;
+					if (Traits::isMatrix)
+					{
+						// An array of column vectors, which std140 rounds up to 16 bytes.
+						const size_t columnStride = layout == BufferLayout::Std140 ? 16 : vectorAlignment;
+						return Placement{ columnStride, Traits::columnCount * columnStride, columnStride, Traits::columnCount * columnStride };
+					}
+					const size_t alignment = layout == BufferLayout::Std140 && isArray ? 16 : vectorAlignment;
+					const size_t arrayStride = layout == BufferLayout::Std140 ? 16 : vectorAlignment;
+					return Placement{ alignment, arrayStride, 0, Traits::rowCount * 4 };
+				}
+			}
+
+			// Whether the elements already are in memory as layout places them, so that they can be copied as they are.
+			template<BufferLayout layout, typename T>
+			[[nodiscard]] constexpr bool IsPlacedAsInMemory()
+			{
+				using Traits = ElementTraits<T>;
+				constexpr Placement placement = GetPlacement<T>(layout, true);
+				if constexpr (layout == BufferLayout::Rows3x4)
+					return Traits::isRowMajor && Traits::rowCount == 3 && sizeof(T) == placement.arrayStride;
+				else if constexpr (Traits::isMatrix)
+					return !Traits::isRowMajor && Traits::rowCount * 4 == placement.matrixStride && sizeof(T) == placement.arrayStride;
+				else
+					return Traits::rowCount * 4 == placement.arrayStride && sizeof(T) == placement.arrayStride;
+			}
+
+			// memcpy that writes whole aligned 16 byte blocks of destination with non-temporal stores. Needs an _mm_sfence afterwards.
+			inline void StreamCopy(std::byte* destination, const std::byte* source, size_t byteCount)
+			{
+#if defined( DMATH_SIMD_SSE2 )
+				const size_t headCount = std::min(byteCount, (16 - reinterpret_cast<uintptr_t>(destination) % 16) % 16);
+				std::memcpy(destination, source, headCount);
+				size_t i = headCount;
+				for (; i + 16 <= byteCount; i += 16)
+					_mm_stream_si128(reinterpret_cast<__m128i*>(destination + i), _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)));
+				std::memcpy(destination + i, source + i, byteCount - i);
+#else
+				std::memcpy(destination, source, byteCount);
+#endif
+			}
+
+			inline void FenceStreamCopies()
+			{
+#if defined( DMATH_SIMD_SSE2 )
+				_mm_sfence();
+#endif
+			}
+
+			// Bits of the component at offset bytes into an element placed in layout, 0 for padding.
+			template<BufferLayout layout, typename T>
+			[[nodiscard]] uint32_t GetComponentBits(const T& element, size_t offset)
+			{
+				using Traits = ElementTraits<T>;
+				constexpr Placement placement = GetPlacement<T>(layout, true);
+				const size_t major = placement.matrixStride == 0 ? 0 : offset / placement.matrixStride;
+				const size_t minor = (placement.matrixStride == 0 ? offset : offset % placement.matrixStride) / 4;
+				// Rows3x4 runs along rows, the others along columns.
+				const size_t column = layout == BufferLayout::Rows3x4 ? minor : major;
+				const size_t row = layout == BufferLayout::Rows3x4 ? major : minor;
+				uint32_t bits = 0;
+				if (column < Traits::columnCount && row < Traits::rowCount)
+					std::memcpy(&bits, &Traits::Get(element, column, row), sizeof(bits));
+				return bits;
+			}
+
+			// Lays the element out at target, padding included.
+			template<BufferLayout layout, typename T>
+			void PlaceElement(const T& element, std::byte* target)
+			{
+				constexpr size_t stride = GetPlacement<T>(layout, true).arrayStride;
+				for (size_t offset = 0; offset < stride; offset += 4)
+				{
+					const uint32_t bits = GetComponentBits<layout>(element, offset);
+					std::memcpy(target + offset, &bits, sizeof(bits));
+				}
+			}
+
+#if defined( DMATH_SIMD_SSE2 )
+			// Each 16 byte block of an element holds one column, or one row in Rows3x4, when its stride is blockCount * 16.
+			template<BufferLayout layout, typename T>
+			constexpr size_t blockCount = layout == BufferLayout::Rows3x4 ? 3 : ElementTraits<T>::columnCount;
+
+			// Writes the element to a 16 byte aligned target with one non-temporal store per block.
+			template<BufferLayout layout, typename T>
+			void StreamElement(const T& element, std::byte* target)
+			{
+				using Traits = ElementTraits<T>;
+				constexpr bool isByRow = layout == BufferLayout::Rows3x4;
+				constexpr size_t laneCount = isByRow ? 4 : Traits::rowCount;
+				for (size_t block = 0; block < blockCount<layout, T>; block++)
+				{
+					int32_t lanes[4] = {};
+					for (size_t lane = 0; lane < laneCount; lane++)
+						std::memcpy(&lanes[lane], &Traits::Get(element, isByRow ? lane : block, isByRow ? block : lane), sizeof(int32_t));
+					_mm_stream_si128(reinterpret_cast<__m128i*>(target + block * 16), _mm_setr_epi32(lanes[0], lanes[1], lanes[2], lanes[3]));
+				}
+			}
+#endif
+
+			// Writes the first byteCount bytes of the elements as an array in layout.
+			template<BufferLayout layout, typename T>
+			void Pack(Span<const T> elements, std::byte* destination, size_t byteCount)
+			{
+				constexpr size_t stride = GetPlacement<T>(layout, true).arrayStride;
+				if constexpr (IsPlacedAsInMemory<layout, T>())
+				{
+					StreamCopy(destination, reinterpret_cast<const std::byte*>(elements.data()), byteCount);
+					FenceStreamCopies();
+					return;
+				}
+
+#if defined( DMATH_SIMD_SSE2 )
+				// Straight from the elements to the destination when their blocks line up with 16 bytes.
+				if constexpr (stride == blockCount<layout, T> * 16)
+				{
+					if (reinterpret_cast<uintptr_t>(destination) % 16 == 0 && byteCount == elements.size() * stride)
+					{
+						for (size_t i = 0; i < elements.size(); i++)
+							StreamElement<layout>(elements[i], destination + i * stride);
+						FenceStreamCopies();
+						return;
+					}
+				}
+#endif
+
+				// Otherwise through a local block, whose copy handles any alignment and a partial last element.
+				constexpr size_t blockLength = std::max<size_t>(Setup::bufferPackingBlockSize / stride, 1);
+				alignas(16) std::byte block[blockLength * stride];
+				for (size_t begin = 0; begin < elements.size() && begin * stride < byteCount; begin += blockLength)
+				{
+					const size_t end = std::min(begin + blockLength, elements.size());
+					for (size_t i = begin; i < end; i++)
+						PlaceElement<layout>(elements[i], block + (i - begin) * stride);
+					StreamCopy(destination + begin * stride, block, std::min((end - begin) * stride, byteCount - begin * stride));
+				}
+				FenceStreamCopies();
+			}
+		}
+	}
+}
+
+template<typename T>
+constexpr size_t Math::GetBufferAlignment(BufferLayout layout)
+{
+	return detail::GpuBuffer::GetPlacement<T>(layout, true).alignment;
+}
+
+template<typename T>
+constexpr size_t Math::GetBufferStride(BufferLayout layout)
+{
+	return detail::GpuBuffer::GetPlacement<T>(layout, true).arrayStride;
+}
+
+template<typename T>
+constexpr size_t Math::GetBufferMatrixStride(BufferLayout layout)
+{
+	return detail::GpuBuffer::GetPlacement<T>(layout, true).matrixStride;
+}
+
+template<Math::BufferLayout layout, typename T>
+void Math::PackBuffer(Span<const T> elements, void* destination)
+{
+	static_assert(detail::GpuBuffer::GetPlacement<T>(layout, true).arrayStride != 0, "DMath error. This type has no placement in this BufferLayout.");
+	const TraceScope traceScope("PackBuffer", elements.size());
+
+	constexpr size_t stride = detail::GpuBuffer::GetPlacement<T>(layout, true).arrayStride;
+	detail::GpuBuffer::Pack<layout>(elements, static_cast<std::byte*>(destination), elements.size() * stride);
+}
+
+template<typename T>
+Math::BufferLayoutStatus Math::ValidateBufferMember(BufferLayout layout, const BufferMemberDescriptor& member, size_t count, size_t bufferSize)
+{
+	const bool isArray = member.arrayStride != 0;
+	const detail::GpuBuffer::Placement placement = detail::GpuBuffer::GetPlacement<T>(layout, isArray);
+	if (placement.arrayStride == 0)
+		return BufferLayoutStatus::UnsupportedType;
+	if (member.offset % placement.alignment != 0)
+		return BufferLayoutStatus::MisalignedOffset;
+	if (isArray ? member.arrayStride != placement.arrayStride : count > 1)
+		return BufferLayoutStatus::ArrayStrideMismatch;
+	if (member.matrixStride != placement.matrixStride)
+		return BufferLayoutStatus::MatrixStrideMismatch;
+
+	const size_t size = isArray ? count * placement.arrayStride : count * placement.size;
+	if (member.offset > bufferSize || size > bufferSize - member.offset)
+		return BufferLayoutStatus::OutOfBounds;
+	return BufferLayoutStatus::Ok;
+}
+
+template<Math::BufferLayout layout, typename T>
+Math::BufferLayoutStatus Math::PackBuffer(Span<const T> elements, Span<std::byte> buffer, const BufferMemberDescriptor& member)
+{
+	static_assert(detail::GpuBuffer::GetPlacement<T>(layout, true).arrayStride != 0, "DMath error. This type has no placement in this BufferLayout.");
+
+	const BufferLayoutStatus status = ValidateBufferMember<T>(layout, member, elements.size(), buffer.size());
+	if (status != BufferLayoutStatus::Ok)
+		return status;
+
+	const TraceScope traceScope("PackBuffer", elements.size());
+	const detail::GpuBuffer::Placement placement = detail::GpuBuffer::GetPlacement<T>(layout, member.arrayStride != 0);
+	const size_t byteCount = member.arrayStride != 0 ? elements.size() * placement.arrayStride : elements.size() * placement.size;
+	detail::GpuBuffer::Pack<layout>(elements, buffer.data() + member.offset, byteCount);
+	return BufferLayoutStatus::Ok;
+}
\ No newline at end of file
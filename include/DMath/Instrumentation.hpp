@@ -0,0 +1,364 @@
+#pragma once
+
+#include "Setup.hpp"
+#include "Enum.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#if defined( DMATH_INSTRUMENTATION )
+#	include <atomic>
+#	include <chrono>
+#	include <memory>
+#	include <mutex>
+#	include <vector>
+#endif
+
+namespace Math
+{
+	namespace Setup
+	{
+		// Define DMATH_INSTRUMENTATION before including DMath, in every translation unit, to count operations and record traces.
+		// Without it the counters stay zero and every instrumentation point compiles to nothing.
+#if defined( DMATH_INSTRUMENTATION )
+		constexpr bool isInstrumentationEnabled = true;
+#else
+		constexpr bool isInstrumentationEnabled = false;
+#endif
+	}
+
+	// Calls and floating point operations of each InstrumentedOperation on one thread.
+	// FLOPs are estimates of the arithmetic in the operation itself, every add, multiply, divide and square root counting as one.
+	// DMath operations it calls along the way count under their own InstrumentedOperation.
+	struct OperationCounters
+	{
+		std::array<uint64_t, size_t(InstrumentedOperation::Count)> calls{};
+		std::array<uint64_t, size_t(InstrumentedOperation::Count)> flops{};
+
+		[[nodiscard]] uint64_t GetCalls(InstrumentedOperation operation) const;
+		[[nodiscard]] uint64_t GetFlops(InstrumentedOperation operation) const;
+		[[nodiscard]] uint64_t GetTotalCalls() const;
+		[[nodiscard]] uint64_t GetTotalFlops() const;
+
+		// Adds the counters of another thread, or another snapshot.
+		OperationCounters& operator+=(const OperationCounters& rhs);
+		// Counts between two snapshots of the same thread.
+		[[nodiscard]] OperationCounters operator-(const OperationCounters& rhs) const;
+	};
+
+	// Copy of the calling thread's counters. The _Parallel operations count on the threads that run their chunks.
+	[[nodiscard]] OperationCounters GetOperationCounters();
+	// Sets the calling thread's counters to zero.
+	void ResetOperationCounters();
+	[[nodiscard]] const char* GetOperationName(InstrumentedOperation operation);
+
+	// Records a Chrome trace event on the calling thread for its lifetime, while a trace runs.
+	// Chunks the _Parallel operations run on other threads are recorded under the name of the innermost scope of the calling thread.
+	class TraceScope
+	{
+	public:
+		// name must outlive the trace, a string literal in general.
+		explicit TraceScope(const char* name, size_t elementCount = 0);
+		~TraceScope();
+		TraceScope(const TraceScope&) = delete;
+		TraceScope& operator=(const TraceScope&) = delete;
+
+#if defined( DMATH_INSTRUMENTATION )
+	private:
+		const char* name;
+		const char* parentName;
+		size_t elementCount;
+		int64_t begin;
+		bool isRecording;
+#endif
+	};
+
+	// Discards the events of the previous trace and starts recording TraceScopes on every thread.
+	void StartTrace();
+	void StopTrace();
+	// Writes the recorded events as Chrome trace event JSON, to open in chrome://tracing or Perfetto.
+	// Call it after StopTrace, or while no traced operation runs. Returns false if the file could not be written.
+	// Writes an empty trace when instrumentation is disabled.
+	[[nodiscard]] bool WriteChromeTrace(const char* path);
+
+	namespace detail
+	{
+		namespace Instrumentation
+		{
+#if defined( DMATH_INSTRUMENTATION )
+			inline thread_local OperationCounters counters{};
+			// Name of the innermost TraceScope of this thread, passed on to the chunks of ParallelFor.
+			inline thread_local const char* currentTraceName = nullptr;
+
+			struct TraceEvent
+			{
+				const char* name;
+				// Nanoseconds since StartTrace.
+				int64_t begin;
+				int64_t end;
+				size_t elementCount;
+			};
+
+			// Written by its own thread, read by WriteChromeTrace.
+			struct TraceBuffer
+			{
+				std::mutex mutex;
+				std::vector<TraceEvent> events;
+				size_t threadIndex = 0;
+			};
+
+			// Buffers stay registered after their thread exits, so that its events make it into the trace.
+			struct TraceState
+			{
+				std::mutex mutex;
+				std::vector<std::shared_ptr<TraceBuffer>> buffers;
+				std::atomic<bool> isRunning{ false };
+				// steady_clock nanoseconds at StartTrace.
+				std::atomic<int64_t> origin{ 0 };
+			};
+
+			[[nodiscard]] inline TraceState& GetTraceState()
+			{
+				static TraceState state;
+				return state;
+			}
+
+			[[nodiscard]] inline TraceBuffer& GetThreadTraceBuffer()
+			{
+				thread_local std::shared_ptr<TraceBuffer> buffer = []()
+				{
+					auto newBuffer = std::make_shared<TraceBuffer>();
+					TraceState& state = GetTraceState();
+					std::lock_guard<std::mutex> lock(state.mutex);
+					newBuffer->threadIndex = state.buffers.size();
+					state.buffers.push_back(newBuffer);
+					return newBuffer;
+				}();
+				return *buffer;
+			}
+
+			[[nodiscard]] inline int64_t GetTraceTime()
+			{
+				const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+				return now - GetTraceState().origin.load(std::memory_order_relaxed);
+			}
+#endif
+
+			// Adds callCount calls of operation, of flopsPerCall FLOPs each, to the calling thread's counters.
+			// Nothing at compile time or without DMATH_INSTRUMENTATION.
+			constexpr void Count(InstrumentedOperation operation, uint64_t flopsPerCall, uint64_t callCount = 1)
+			{
+#if defined( DMATH_INSTRUMENTATION )
+				if (!DMATH_IS_CONSTANT_EVALUATED())
+				{
+					counters.calls[size_t(operation)] += callCount;
+					counters.flops[size_t(operation)] += flopsPerCall * callCount;
+				}
+#else
+				(void)operation;
+				(void)flopsPerCall;
+				(void)callCount;
+#endif
+			}
+
+			[[nodiscard]] inline const char* GetCurrentTraceName()
+			{
+#if defined( DMATH_INSTRUMENTATION )
+				return currentTraceName;
+#else
+				return nullptr;
+#endif
+			}
+
+			// Cofactor expansion along the first column, as MatrixBaseSquare::GetDeterminant does, without skipping zeros.
+			[[nodiscard]] constexpr uint64_t GetDeterminantFlops(size_t size)
+			{
+				if (size <= 1)
+					return 0;
+				if (size == 2)
+					return 3;
+				return size * GetDeterminantFlops(size - 1) + 3 * size - 1;
+			}
+
+			// Adjugate from the minors, determinant from its first row, then a division per element.
+			[[nodiscard]] constexpr uint64_t GetInverseFlops(size_t size)
+			{
+				return size * size * (GetDeterminantFlops(size - 1) + 1) + 2 * size - 1 + size * size;
+			}
+		}
+	}
+}
+
+inline uint64_t Math::OperationCounters::GetCalls(InstrumentedOperation operation) const
+{
+	return calls[size_t(operation)];
+}
+
+inline uint64_t Math::OperationCounters::GetFlops(InstrumentedOperation operation) const
+{
+	return flops[size_t(operation)];
+}
+
+inline uint64_t Math::OperationCounters::GetTotalCalls() const
+{
+	uint64_t total = 0;
+	for (const uint64_t count : calls)
+		total += count;
+	return total;
+}
+
+inline uint64_t Math::OperationCounters::GetTotalFlops() const
+{
+	uint64_t total = 0;
+	for (const uint64_t count : flops)
+		total += count;
+	return total;
+}
+
+inline Math::OperationCounters& Math::OperationCounters::operator+=(const OperationCounters& rhs)
+{
+	for (size_t i = 0; i < calls.size(); i++)
+	{
+		calls[i] += rhs.calls[i];
+		flops[i] += rhs.flops[i];
+	}
+	return *this;
+}
+
+inline Math::OperationCounters Math::OperationCounters::operator-(const OperationCounters& rhs) const
+{
+	OperationCounters difference;
+	for (size_t i = 0; i < calls.size(); i++)
+	{
+		difference.calls[i] = calls[i] - rhs.calls[i];
+		difference.flops[i] = flops[i] - rhs.flops[i];
+	}
+	return difference;
+}
+
+inline Math::OperationCounters Math::GetOperationCounters()
+{
+#if defined( DMATH_INSTRUMENTATION )
+	return detail::Instrumentation::counters;
+#else
+	return OperationCounters{};
+#endif
+}
+
+inline void Math::ResetOperationCounters()
+{
+#if defined( DMATH_INSTRUMENTATION )
+	detail::Instrumentation::counters = OperationCounters{};
+#endif
+}
+
+inline const char* Math::GetOperationName(InstrumentedOperation operation)
+{
+	constexpr std::array<const char*, size_t(InstrumentedOperation::Count)> names
+	{
+		"MatrixMultiply",
+		"MatrixVectorMultiply",
+		"MatrixDeterminant",
+		"MatrixInverse",
+		"LinearEquationSolve",
+		"VectorDot",
+		"VectorCross",
+		"VectorNormalize",
+		"QuaternionMultiply",
+		"QuaternionToMatrix",
+		"TransformMultiply",
+		"TransformPoint",
+		"TransformRotation",
+		"TransformCamera"
+	};
+	return size_t(operation) < names.size() ? names[size_t(operation)] : "Unknown";
+}
+
+inline Math::TraceScope::TraceScope(const char* name, size_t elementCount)
+#if defined( DMATH_INSTRUMENTATION )
+	: name(name), parentName(detail::Instrumentation::currentTraceName), elementCount(elementCount), begin(0),
+	isRecording(detail::Instrumentation::GetTraceState().isRunning.load(std::memory_order_relaxed))
+{
+	detail::Instrumentation::currentTraceName = name;
+	if (isRecording)
+		begin = detail::Instrumentation::GetTraceTime();
+}
+#else
+{
+	(void)name;
+	(void)elementCount;
+}
+#endif
+
+inline Math::TraceScope::~TraceScope()
+{
+#if defined( DMATH_INSTRUMENTATION )
+	detail::Instrumentation::currentTraceName = parentName;
+	if (!isRecording)
+		return;
+	const int64_t end = detail::Instrumentation::GetTraceTime();
+	detail::Instrumentation::TraceBuffer& buffer = detail::Instrumentation::GetThreadTraceBuffer();
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	buffer.events.push_back({ name, begin, end, elementCount });
+#endif
+}
+
+inline void Math::StartTrace()
+{
+#if defined( DMATH_INSTRUMENTATION )
+	detail::Instrumentation::TraceState& state = detail::Instrumentation::GetTraceState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	for (const auto& buffer : state.buffers)
+	{
+		std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+		buffer->events.clear();
+	}
+	state.origin.store(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
+	state.isRunning.store(true);
+#endif
+}
+
+inline void Math::StopTrace()
+{
+#if defined( DMATH_INSTRUMENTATION )
+	detail::Instrumentation::GetTraceState().isRunning.store(false);
+#endif
+}
+
+inline bool Math::WriteChromeTrace(const char* path)
+{
+	std::FILE* file = std::fopen(path, "w");
+	if (file == nullptr)
+		return false;
+
+	bool isWritten = std::fputs("{\"traceEvents\":[", file) >= 0;
+#if defined( DMATH_INSTRUMENTATION )
+	detail::Instrumentation::TraceState& state = detail::Instrumentation::GetTraceState();
+	std::lock_guard<std::mutex> lock(state.mutex);
+	bool isFirst = true;
+	for (const auto& buffer : state.buffers)
+	{
+		std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+		for (const auto& event : buffer->events)
+		{
+			// Timestamps and durations are in microseconds.
+			isWritten = isWritten && std::fprintf
+			(
+				file,
+				"%s\n{\"name\":\"%s\",\"cat\":\"DMath\",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"elements\":%zu}}",
+				isFirst ? "" : ",",
+				event.name,
+				buffer->threadIndex,
+				double(event.begin) / 1000.0,
+				double(event.end - event.begin) / 1000.0,
+				event.elementCount
+			) >= 0;
+			isFirst = false;
+		}
+	}
+#endif
+	isWritten = isWritten && std::fputs("\n],\"displayTimeUnit\":\"ns\"}\n", file) >= 0;
+	return std::fclose(file) == 0 && isWritten;
+}
\ No newline at end of file
@@ -0,0 +1,408 @@
+#pragma once
+
+#include "Vector/Vector.hpp"
+#include "Span.hpp"
+#include "Parallel.hpp"
+#include "Execution.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace Math
+{
+	// Static k-d tree over points of any dimension.
+	// The tree is implicit: points are reordered so that every subtree is a contiguous range whose
+	// middle element is the splitting point, so nodes need no child pointers and leaves are scanned linearly.
+	template<size_t length, typename T = float>
+	class KdTree
+	{
+	public:
+		using ValueType = T;
+		using PointType = Vector<length, T>;
+		static constexpr size_t dimCount = length;
+
+		struct Neighbor
+		{
+			// Index of the point in the input to Build.
+			uint32_t index;
+			T distanceSqrd;
+		};
+
+		KdTree() = default;
+
+		// Ranges of at most maxLeafSize points are not split further.
+		[[nodiscard]] static KdTree<length, T> Build(Span<const PointType> points, uint32_t maxLeafSize = 8);
+		// Same tree as Build.
+		[[nodiscard]] static KdTree<length, T> Build_Parallel(Span<const PointType> points, uint32_t maxLeafSize = 8);
+		// std::execution::par and par_unseq run Build_Parallel, other policies Build.
+		template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+		[[nodiscard]] static KdTree<length, T> Build(ExecutionPolicy&& policy, Span<const PointType> points, uint32_t maxLeafSize = 8);
+
+		[[nodiscard]] std::optional<Neighbor> FindNearest(const PointType& query, T maxDistance = std::numeric_limits<T>::max()) const;
+		// Finds up to neighbors.size() nearest points within maxDistance, sorted by increasing distance. Returns how many were found.
+		size_t FindNearest(const PointType& query, Span<Neighbor> neighbors, T maxDistance = std::numeric_limits<T>::max()) const;
+		// Appends every point within radius of the query, in no particular order.
+		void FindInRadius(const PointType& query, T radius, std::vector<Neighbor>& neighbors) const;
+
+		// Batched k nearest neighbors. The results of queries[i] are neighbors[i * k] to neighbors[i * k + counts[i]].
+		void FindNearest(Span<const PointType> queries, size_t k, Span<Neighbor> neighbors, Span<uint32_t> counts, T maxDistance = std::numeric_limits<T>::max()) const;
+		void FindNearest_Parallel(Span<const PointType> queries, size_t k, Span<Neighbor> neighbors, Span<uint32_t> counts, T maxDistance = std::numeric_limits<T>::max(), size_t grainSize = 256) const;
+		// std::execution::par and par_unseq run FindNearest_Parallel, other policies the single thread batched FindNearest.
+		template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+		void FindNearest(ExecutionPolicy&& policy, Span<const PointType> queries, size_t k, Span<Neighbor> neighbors, Span<uint32_t> counts, T maxDistance = std::numeric_limits<T>::max()) const;
+
+		[[nodiscard]] size_t GetSize() const;
+		[[nodiscard]] bool IsEmpty() const;
+		// Points in tree order.
+		[[nodiscard]] Span<const PointType> GetPoints() const;
+		// Input index of every point in tree order.
+		[[nodiscard]] Span<const uint32_t> GetIndices() const;
+
+	private:
+		std::vector<PointType> points;
+		std::vector<uint32_t> indices;
+		// Split axis of the node whose splitting point is at the same position. Unused for leaf ranges.
+		std::vector<uint8_t> splitAxes;
+		uint32_t maxLeafSize = 8;
+
+		template<typename Visit>
+		void Traverse(const PointType& query, T& maxDistanceSqrd, Visit&& visit) const;
+
+		static_assert(length >= 1 && length <= 255, "DMath error. Math::KdTree supports between 1 and 255 dimensions.");
+		static_assert(std::is_floating_point_v<T>, "DMath error. Math::KdTree must be of floating point type.");
+	};
+
+	namespace detail
+	{
+		namespace KdTree
+		{
+			struct BuildRange
+			{
+				uint32_t begin;
+				uint32_t end;
+			};
+
+			template<size_t length, typename T>
+			[[nodiscard]] inline T GetDistanceSqrd(const Vector<length, T>& a, const Vector<length, T>& b)
+			{
+				T sum = T(0);
+				for (size_t i = 0; i < length; i++)
+				{
+					const T delta = a[i] - b[i];
+					sum += delta * delta;
+				}
+				return sum;
+			}
+
+			// Splits [begin, end) at its middle along the axis of largest spread.
+			// Returns false for leaf ranges.
+			template<size_t length, typename T>
+			bool SplitRange(Span<const Vector<length, T>> points, std::vector<uint32_t>& indices, std::vector<uint8_t>& splitAxes, BuildRange range, uint32_t maxLeafSize)
+			{
+				if (range.end - range.begin <= maxLeafSize)
+					return false;
+
+				Vector<length, T> min = points[indices[range.begin]];
+				Vector<length, T> max = min;
+				for (uint32_t i = range.begin + 1; i < range.end; i++)
+				{
+					const auto& point = points[indices[i]];
+					for (size_t axis = 0; axis < length; axis++)
+					{
+						min[axis] = std::min(min[axis], point[axis]);
+						max[axis] = std::max(max[axis], point[axis]);
+					}
+				}
+				size_t splitAxis = 0;
+				for (size_t axis = 1; axis < length; axis++)
+				{
+					if (max[axis] - min[axis] > max[splitAxis] - min[splitAxis])
+						splitAxis = axis;
+				}
+
+				const uint32_t middle = range.begin + (range.end - range.begin) / 2;
+				std::nth_element(indices.begin() + range.begin, indices.begin() + middle, indices.begin() + range.end, [&](uint32_t a, uint32_t b)
+				{
+					return points[a][splitAxis] < points[b][splitAxis] || (points[a][splitAxis] == points[b][splitAxis] && a < b);
+				});
+				splitAxes[middle] = uint8_t(splitAxis);
+				return true;
+			}
+
+			// Builds the subtree over range. Ranges smaller than deferSize are appended to deferredRanges instead.
+			template<size_t length, typename T>
+			void BuildSubtree(Span<const Vector<length, T>> points, std::vector<uint32_t>& indices, std::vector<uint8_t>& splitAxes, BuildRange root, uint32_t maxLeafSize, uint32_t deferSize, std::vector<BuildRange>* deferredRanges)
+			{
+				std::vector<BuildRange> stack{ root };
+				while (!stack.empty())
+				{
+					const BuildRange range = stack.back();
+					stack.pop_back();
+					if (deferredRanges && range.end - range.begin < deferSize)
+					{
+						deferredRanges->push_back(range);
+						continue;
+					}
+					if (!SplitRange(points, indices, splitAxes, range, maxLeafSize))
+						continue;
+					const uint32_t middle = range.begin + (range.end - range.begin) / 2;
+					stack.push_back(BuildRange{ middle + 1, range.end });
+					stack.push_back(BuildRange{ range.begin, middle });
+				}
+			}
+
+			// Keeps the k closest neighbors seen so far as a max-heap on distance, in caller provided storage.
+			template<typename Neighbor>
+			class BoundedNeighborHeap
+			{
+			public:
+				explicit BoundedNeighborHeap(Span<Neighbor> storage) :
+					storage(storage)
+				{
+				}
+
+				// Returns the new search bound.
+				template<typename T>
+				T Push(uint32_t index, T distanceSqrd, T bound)
+				{
+					const auto compare = [](const Neighbor& a, const Neighbor& b) { return a.distanceSqrd < b.distanceSqrd; };
+					if (count < storage.size())
+					{
+						storage[count++] = Neighbor{ index, distanceSqrd };
+						std::push_heap(storage.begin(), storage.begin() + count, compare);
+					}
+					else
+					{
+						std::pop_heap(storage.begin(), storage.begin() + count, compare);
+						storage[count - 1] = Neighbor{ index, distanceSqrd };
+						std::push_heap(storage.begin(), storage.begin() + count, compare);
+					}
+					return count == storage.size() ? storage[0].distanceSqrd : bound;
+				}
+
+				// Sorts the neighbors by increasing distance and returns how many there are.
+				size_t Finish()
+				{
+					std::sort_heap(storage.begin(), storage.begin() + count, [](const Neighbor& a, const Neighbor& b) { return a.distanceSqrd < b.distanceSqrd; });
+					return count;
+				}
+
+			private:
+				Span<Neighbor> storage;
+				size_t count = 0;
+			};
+		}
+	}
+}
+
+template<size_t length, typename T>
+Math::KdTree<length, T> Math::KdTree<length, T>::Build(Span<const PointType> inputPoints, uint32_t maxLeafSize)
+{
+	assert(inputPoints.size() < std::numeric_limits<uint32_t>::max());
+	assert(maxLeafSize >= 1);
+
+	KdTree<length, T> tree;
+	const auto pointCount = uint32_t(inputPoints.size());
+	tree.maxLeafSize = maxLeafSize;
+	tree.indices.resize(pointCount);
+	tree.splitAxes.assign(pointCount, 0);
+	for (uint32_t i = 0; i < pointCount; i++)
+		tree.indices[i] = i;
+
+	detail::KdTree::BuildSubtree(inputPoints, tree.indices, tree.splitAxes, detail::KdTree::BuildRange{ 0, pointCount }, maxLeafSize, 0, static_cast<std::vector<detail::KdTree::BuildRange>*>(nullptr));
+
+	tree.points.resize(pointCount);
+	for (uint32_t i = 0; i < pointCount; i++)
+		tree.points[i] = inputPoints[tree.indices[i]];
+	return tree;
+}
+
+template<size_t length, typename T>
+Math::KdTree<length, T> Math::KdTree<length, T>::Build_Parallel(Span<const PointType> inputPoints, uint32_t maxLeafSize)
+{
+	assert(inputPoints.size() < std::numeric_limits<uint32_t>::max());
+	assert(maxLeafSize >= 1);
+
+	using namespace detail::KdTree;
+	KdTree<length, T> tree;
+	const auto pointCount = uint32_t(inputPoints.size());
+	tree.maxLeafSize = maxLeafSize;
+	tree.indices.resize(pointCount);
+	tree.splitAxes.assign(pointCount, 0);
+	ParallelFor(0, pointCount, Setup::defaultParallelGrainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+			tree.indices[i] = uint32_t(i);
+	});
+
+	// The top levels are split on this thread until there are enough independent subtrees to share out.
+	// Subtrees cover disjoint ranges, so they are built concurrently without synchronization.
+	const size_t threadCount = GetParallelThreadCount();
+	const auto deferSize = uint32_t(std::max<size_t>(pointCount / (threadCount * 8), maxLeafSize + 1));
+	std::vector<BuildRange> subtrees;
+	BuildSubtree(inputPoints, tree.indices, tree.splitAxes, BuildRange{ 0, pointCount }, maxLeafSize, threadCount > 1 ? deferSize : 0, threadCount > 1 ? &subtrees : nullptr);
+	ParallelFor(0, subtrees.size(), 1, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+			BuildSubtree(inputPoints, tree.indices, tree.splitAxes, subtrees[i], maxLeafSize, 0, static_cast<std::vector<BuildRange>*>(nullptr));
+	});
+
+	tree.points.resize(pointCount);
+	ParallelFor(0, pointCount, Setup::defaultParallelGrainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+			tree.points[i] = inputPoints[tree.indices[i]];
+	});
+	return tree;
+}
+
+template<size_t length, typename T>
+template<typename ExecutionPolicy, typename>
+Math::KdTree<length, T> Math::KdTree<length, T>::Build(ExecutionPolicy&&, Span<const PointType> points, uint32_t maxLeafSize)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		return Build_Parallel(points, maxLeafSize);
+	else
+		return Build(points, maxLeafSize);
+}
+
+template<size_t length, typename T>
+template<typename Visit>
+void Math::KdTree<length, T>::Traverse(const PointType& query, T& maxDistanceSqrd, Visit&& visit) const
+{
+	using namespace detail::KdTree;
+	struct Entry
+	{
+		uint32_t begin;
+		uint32_t end;
+		// Lower bound of the squared distance from the query to any point of the range.
+		T distanceSqrd;
+	};
+
+	// Only far children are pushed, at most one per level.
+	std::array<Entry, 64> stack;
+	size_t stackSize = 0;
+	stack[stackSize++] = Entry{ 0, uint32_t(points.size()), T(0) };
+	while (stackSize > 0)
+	{
+		Entry entry = stack[--stackSize];
+		if (entry.distanceSqrd > maxDistanceSqrd)
+			continue;
+
+		while (entry.end - entry.begin > maxLeafSize)
+		{
+			const uint32_t middle = entry.begin + (entry.end - entry.begin) / 2;
+			const size_t axis = splitAxes[middle];
+			const T delta = query[axis] - points[middle][axis];
+			const T distanceSqrd = GetDistanceSqrd(query, points[middle]);
+			if (distanceSqrd <= maxDistanceSqrd)
+				maxDistanceSqrd = visit(middle, distanceSqrd);
+
+			const T farDistanceSqrd = delta * delta;
+			Entry farEntry = delta < T(0) ? Entry{ middle + 1, entry.end, farDistanceSqrd } : Entry{ entry.begin, middle, farDistanceSqrd };
+			entry = delta < T(0) ? Entry{ entry.begin, middle, entry.distanceSqrd } : Entry{ middle + 1, entry.end, entry.distanceSqrd };
+			if (farDistanceSqrd <= maxDistanceSqrd && farEntry.end > farEntry.begin)
+			{
+				assert(stackSize < stack.size());
+				stack[stackSize++] = farEntry;
+			}
+		}
+
+		for (uint32_t i = entry.begin; i < entry.end; i++)
+		{
+			const T distanceSqrd = GetDistanceSqrd(query, points[i]);
+			if (distanceSqrd <= maxDistanceSqrd)
+				maxDistanceSqrd = visit(i, distanceSqrd);
+		}
+	}
+}
+
+template<size_t length, typename T>
+std::optional<typename Math::KdTree<length, T>::Neighbor> Math::KdTree<length, T>::FindNearest(const PointType& query, T maxDistance) const
+{
+	Neighbor neighbor;
+	if (FindNearest(query, Span<Neighbor>(&neighbor, 1), maxDistance) == 0)
+		return {};
+	return neighbor;
+}
+
+template<size_t length, typename T>
+size_t Math::KdTree<length, T>::FindNearest(const PointType& query, Span<Neighbor> neighbors, T maxDistance) const
+{
+	if (neighbors.empty() || points.empty())
+		return 0;
+
+	detail::KdTree::BoundedNeighborHeap<Neighbor> heap(neighbors);
+	const T maxDistanceSqrd = maxDistance == std::numeric_limits<T>::max() ? maxDistance : maxDistance * maxDistance;
+	T bound = maxDistanceSqrd;
+	Traverse(query, bound, [&](uint32_t position, T distanceSqrd)
+	{
+		return heap.Push(indices[position], distanceSqrd, maxDistanceSqrd);
+	});
+	return heap.Finish();
+}
+
+template<size_t length, typename T>
+void Math::KdTree<length, T>::FindInRadius(const PointType& query, T radius, std::vector<Neighbor>& neighbors) const
+{
+	if (points.empty())
+		return;
+
+	T radiusSqrd = radius * radius;
+	Traverse(query, radiusSqrd, [&](uint32_t position, T distanceSqrd)
+	{
+		neighbors.push_back(Neighbor{ indices[position], distanceSqrd });
+		return radiusSqrd;
+	});
+}
+
+template<size_t length, typename T>
+void Math::KdTree<length, T>::FindNearest(Span<const PointType> queries, size_t k, Span<Neighbor> neighbors, Span<uint32_t> counts, T maxDistance) const
+{
+	assert(neighbors.size() >= queries.size() * k);
+	assert(counts.size() >= queries.size());
+
+	for (size_t i = 0; i < queries.size(); i++)
+		counts[i] = uint32_t(FindNearest(queries[i], neighbors.subspan(i * k, k), maxDistance));
+}
+
+template<size_t length, typename T>
+void Math::KdTree<length, T>::FindNearest_Parallel(Span<const PointType> queries, size_t k, Span<Neighbor> neighbors, Span<uint32_t> counts, T maxDistance, size_t grainSize) const
+{
+	assert(neighbors.size() >= queries.size() * k);
+	assert(counts.size() >= queries.size());
+
+	ParallelFor(0, queries.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+			counts[i] = uint32_t(FindNearest(queries[i], neighbors.subspan(i * k, k), maxDistance));
+	});
+}
+
+template<size_t length, typename T>
+template<typename ExecutionPolicy, typename>
+void Math::KdTree<length, T>::FindNearest(ExecutionPolicy&&, Span<const PointType> queries, size_t k, Span<Neighbor> neighbors, Span<uint32_t> counts, T maxDistance) const
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		FindNearest_Parallel(queries, k, neighbors, counts, maxDistance);
+	else
+		FindNearest(queries, k, neighbors, counts, maxDistance);
+}
+
+template<size_t length, typename T>
+size_t Math::KdTree<length, T>::GetSize() const { return points.size(); }
+
+template<size_t length, typename T>
+bool Math::KdTree<length, T>::IsEmpty() const { return points.empty(); }
+
+template<size_t length, typename T>
+Math::Span<const typename Math::KdTree<length, T>::PointType> Math::KdTree<length, T>::GetPoints() const { return points; }
+
+template<size_t length, typename T>
+Math::Span<const uint32_t> Math::KdTree<length, T>::GetIndices() const { return indices; }
\ No newline at end of file
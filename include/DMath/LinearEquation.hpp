@@ -31,14 +31,15 @@ namespace Math
 		
 	};
 
-	template<size_t numUnknowns, typename T>
-	constexpr std::optional<Vector<numUnknowns, T>> SolveLinearEquation(const Matrix<numUnknowns + 1, numUnknowns, T>& input)
+	template<size_t numUnknowns, typename T, MatrixLayout layout>
+	constexpr std::optional<Vector<numUnknowns, T>> SolveLinearEquation(const Matrix<numUnknowns + 1, numUnknowns, T, layout>& input)
 	{
 		using LengthType = decltype(numUnknowns);
 		constexpr LengthType width = numUnknowns + 1;
 		constexpr LengthType height = numUnknowns;
+		detail::Instrumentation::Count(InstrumentedOperation::LinearEquationSolve, height * (height - 1) * (2 * width + 1) + height);
 		 
-		Matrix<numUnknowns + 1, numUnknowns, T> copyMatrix = input;
+		Matrix<numUnknowns + 1, numUnknowns, T, layout> copyMatrix = input;
 
 		for (LengthType x = 0; x < height; x++)
 		{
@@ -51,7 +51,7 @@ namespace Math
 
 constexpr Math::Matrix<3, 2> Math::LinearTransform2D::Multiply_Reduced(const Matrix<3, 2>& left, const Matrix<3, 2>& right)
 {
-	Matrix<3, 2> newMatrix;
+	Matrix<3, 2> newMatrix{};
 	for (size_t x = 0; x < 2; x++)
 	{
 		for (size_t y = 0; y < 2; y++)
@@ -78,7 +78,7 @@ constexpr Math::Matrix<3, 2> Math::LinearTransform2D::Multiply_Reduced(const Mat
 template<typename T>
 constexpr Math::Matrix<4, 4, T> Math::LinearTransform2D::AsMat4(const Matrix<3, 2, T>& input)
 {
-	Matrix<4, 4, T> newMatrix;
+	Matrix<4, 4, T> newMatrix{};
 	newMatrix[2][2] = 1;
 	newMatrix[3][3] = 1;
 
@@ -144,8 +144,7 @@ constexpr Math::Vector2D Math::LinearTransform2D::GetTranslation(const Matrix<3,
 template<Math::AngleUnit unit>
 constexpr Math::Matrix2x2 Math::LinearTransform2D::Rotate(float angle)
 {
-	const float cos = Cos<unit>(angle);
-	const float sin = Sin<unit>(angle);
+	const auto [sin, cos] = SinCos<unit>(angle);
 	return Matrix2x2
 	({
 		cos, sin,
@@ -156,8 +155,7 @@ constexpr Math::Matrix2x2 Math::LinearTransform2D::Rotate(float angle)
 template<Math::AngleUnit unit>
 constexpr Math::Matrix3x3 Math::LinearTransform2D::Rotate_Homo(float angle)
 {
-	const float cos = Cos<unit>(angle);
-	const float sin = Sin<unit>(angle);
+	const auto [sin, cos] = SinCos<unit>(angle);
 	return Matrix3x3
 	({
 		cos, sin, 0,
@@ -169,8 +167,7 @@ constexpr Math::Matrix3x3 Math::LinearTransform2D::Rotate_Homo(float angle)
 template<Math::AngleUnit unit>
 constexpr Math::Matrix<3, 2> Math::LinearTransform2D::Rotate_Reduced(float angle)
 {
-	const float cos = Cos<unit>(angle);
-	const float sin = Sin<unit>(angle);
+	const auto [sin, cos] = SinCos<unit>(angle);
 	return Matrix<3, 2>
 	({
 		cos, sin,
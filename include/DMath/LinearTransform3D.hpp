@@ -7,6 +7,7 @@
 #include "UnitQuaternion.hpp"
 #include "Enum.hpp"
 #include "Trigonometric.hpp"
+#include "Instrumentation.hpp"
 
 #include <string_view>
 #include <cassert>
@@ -18,7 +19,8 @@ namespace Math
 		template<typename T>
 		[[nodiscard]] constexpr Matrix<4, 3, T> Multiply_Reduced(const Matrix<4, 3, T>& left, const Matrix<4, 3, T>& right)
 		{
-			Matrix<4, 3, T> newMatrix;
+			detail::Instrumentation::Count(InstrumentedOperation::TransformMultiply, 75);
+			Matrix<4, 3, T> newMatrix{};
 			for (size_t x = 0; x < 3; x++)
 			{
 				for (size_t y = 0; y < 3; y++)
@@ -44,7 +46,8 @@ namespace Math
 		template<typename T>
 		[[nodiscard]] constexpr Vector<3, T> Multiply_Reduced(const Matrix<4, 3, T>& left, const Vector<3, T>& right)
 		{
-			Vector<3, T> newVector;
+			detail::Instrumentation::Count(InstrumentedOperation::TransformPoint, 21);
+			Vector<3, T> newVector{};
 
 			for (size_t y = 0; y < 3; y++)
 			{
@@ -59,7 +62,7 @@ namespace Math
 		template<typename T>
 		[[nodiscard]] constexpr Matrix<4, 4, T> AsMat4(const Matrix<4, 3, T>& input)
 		{
-			Matrix<4, 4, T> newMat;
+			Matrix<4, 4, T> newMat{};
 			for (size_t x = 0; x < 4; x++)
 			{
 				for (size_t y = 0; y < 3; y++)
@@ -87,15 +90,15 @@ namespace Math
 		constexpr Vector<3, T> GetTranslation(const Matrix<4,3, T>& input);
 
 		template<AngleUnit angleUnit = Setup::defaultAngleUnit>
-		[[nodiscard]] Matrix3x3 Rotate(ElementaryAxis axis, float amount);
+		[[nodiscard]] constexpr Matrix3x3 Rotate(ElementaryAxis axis, float amount);
 		template<AngleUnit angleUnit = Setup::defaultAngleUnit>
-		[[nodiscard]] Matrix4x4 Rotate_Homo(ElementaryAxis axis, float amount);
+		[[nodiscard]] constexpr Matrix4x4 Rotate_Homo(ElementaryAxis axis, float amount);
 		template<AngleUnit angleUnit = Setup::defaultAngleUnit>
-		[[nodiscard]] Matrix3x3 Rotate(float x, float y, float z);
+		[[nodiscard]] constexpr Matrix3x3 Rotate(float x, float y, float z);
 		template<AngleUnit angleUnit = Setup::defaultAngleUnit>
-		[[nodiscard]] Matrix3x3 Rotate(const Vector3D& angles);
+		[[nodiscard]] constexpr Matrix3x3 Rotate(const Vector3D& angles);
 		template<AngleUnit angleUnit = Setup::defaultAngleUnit>
-		[[nodiscard]] Matrix3x3 Rotate(const Vector3D& axis, float amount);
+		[[nodiscard]] constexpr Matrix3x3 Rotate(const Vector3D& axis, float amount);
 		template<typename T>
 		[[nodiscard]] constexpr Matrix<3, 3, T> Rotate(const UnitQuaternion<T>& quat);
 		[[nodiscard]] constexpr Matrix4x4 Rotate_Homo(const UnitQuaternion<>& quat);
@@ -198,14 +201,55 @@ constexpr Math::Vector<3, T> Math::LinearTransform3D::GetTranslation(const Matri
 }
 
 template<Math::AngleUnit angleUnit>
-Math::Matrix4x4 Math::LinearTransform3D::Rotate_Homo(ElementaryAxis axis, float amount)
+constexpr Math::Matrix3x3 Math::LinearTransform3D::Rotate(ElementaryAxis axis, float amount)
 {
+	detail::Instrumentation::Count(InstrumentedOperation::TransformRotation, 0);
 #if defined( _MSC_VER )
 	__assume(axis == Math::ElementaryAxis::X || axis == Math::ElementaryAxis::Y || axis == Math::ElementaryAxis::Z);
 #endif
 	assert(axis == Math::ElementaryAxis::X || axis == Math::ElementaryAxis::Y || axis == Math::ElementaryAxis::Z);
-	const float cos = Cos<angleUnit>(amount);
-	const float sin = Sin<angleUnit>(amount);
+	const auto [sin, cos] = SinCos<angleUnit>(amount);
+	switch (axis)
+	{
+	case ElementaryAxis::X:
+		return Matrix3x3
+		({
+			1, 0, 0,
+			0, cos, sin,
+			0, -sin, cos
+		});
+	case ElementaryAxis::Y:
+		return Matrix3x3
+		({
+			cos, 0, -sin,
+			0, 1, 0,
+			sin, 0, cos
+		});
+	case ElementaryAxis::Z:
+		return Matrix3x3
+		({
+			cos, sin, 0,
+			-sin, cos, 0,
+			0, 0, 1
+		});
+	default:
+#if defined( _MSC_VER )
+		__assume(0);
+#elif defined( __GNUC__ )
+		__builtin_unreachable();
+#endif
+	};
+}
+
+template<Math::AngleUnit angleUnit>
+constexpr Math::Matrix4x4 Math::LinearTransform3D::Rotate_Homo(ElementaryAxis axis, float amount)
+{
+	detail::Instrumentation::Count(InstrumentedOperation::TransformRotation, 0);
+#if defined( _MSC_VER )
+	__assume(axis == Math::ElementaryAxis::X || axis == Math::ElementaryAxis::Y || axis == Math::ElementaryAxis::Z);
+#endif
+	assert(axis == Math::ElementaryAxis::X || axis == Math::ElementaryAxis::Y || axis == Math::ElementaryAxis::Z);
+	const auto [sin, cos] = SinCos<angleUnit>(amount);
 	switch (axis)
 	{
 	case ElementaryAxis::X:
@@ -242,23 +286,23 @@ Math::Matrix4x4 Math::LinearTransform3D::Rotate_Homo(ElementaryAxis axis, float
 }
 
 template<Math::AngleUnit angleUnit>
-Math::Matrix3x3 Math::LinearTransform3D::Rotate(float x, float y, float z)
+constexpr Math::Matrix3x3 Math::LinearTransform3D::Rotate(float x, float y, float z)
 {
 	return Rotate<angleUnit>(ElementaryAxis::Z, z) * Rotate<angleUnit>(ElementaryAxis::Y, y) * Rotate<angleUnit>(ElementaryAxis::X, x);
 }
 
 template<Math::AngleUnit angleUnit>
-Math::Matrix3x3 Math::LinearTransform3D::Rotate(const Vector3D& angles)
+constexpr Math::Matrix3x3 Math::LinearTransform3D::Rotate(const Vector3D& angles)
 {
 	return Rotate<angleUnit>(angles.x, angles.y, angles.z);
 }
 
 template<Math::AngleUnit angleUnit>
-Math::Matrix3x3 Math::LinearTransform3D::Rotate(const Vector3D& axisInput, float amount)
+constexpr Math::Matrix3x3 Math::LinearTransform3D::Rotate(const Vector3D& axisInput, float amount)
 {
+	detail::Instrumentation::Count(InstrumentedOperation::TransformRotation, 42);
 	Vector3D axis = axisInput.GetNormalized();
-	const float cos = Cos<angleUnit>(amount);
-	const float sin = Sin<angleUnit>(amount);
+	const auto [sin, cos] = SinCos<angleUnit>(amount);
 	return Matrix3x3
 	{
 		cos + Sqrd(axis.x)*(1 - cos), axis.x*axis.y*(1 - cos) - axis.z*sin, axis.x*axis.z*(1 - cos) + axis.y*sin,
@@ -270,6 +314,7 @@ Math::Matrix3x3 Math::LinearTransform3D::Rotate(const Vector3D& axisInput, float
 template<typename T>
 [[nodiscard]] constexpr Math::Matrix<3, 3, T> Math::LinearTransform3D::Rotate(const UnitQuaternion<T>& quat)
 {
+	detail::Instrumentation::Count(InstrumentedOperation::TransformRotation, 48);
 	const auto& s = quat.GetS();
 	const auto& x = quat.GetX();
 	const auto& y = quat.GetY();
@@ -339,6 +384,7 @@ constexpr Math::Matrix<4, 3> Math::LinearTransform3D::Scale_Reduced(const Vector
 
 inline Math::Matrix4x4 Math::LinearTransform3D::LookAt_LH(const Vector3D& position, const Vector3D& forward, const Vector3D& upVector)
 {
+	detail::Instrumentation::Count(InstrumentedOperation::TransformCamera, 6);
 	Vector3D zAxis = (forward - position).GetNormalized();
 	Vector3D xAxis = Vector3D::Cross(upVector, zAxis).GetNormalized();
 	Vector3D yAxis = Vector3D::Cross(zAxis, xAxis);
@@ -353,6 +399,7 @@ inline Math::Matrix4x4 Math::LinearTransform3D::LookAt_LH(const Vector3D& positi
 
 inline Math::Matrix4x4 Math::LinearTransform3D::LookAt_RH(const Vector3D& position, const Vector3D& forward, const Vector3D& upVector)
 {
+	detail::Instrumentation::Count(InstrumentedOperation::TransformCamera, 6);
 	Vector3D zAxis = (position - forward).GetNormalized();
 	Vector3D xAxis = Vector3D::Cross(upVector, zAxis).GetNormalized();
 	Vector3D yAxis = Vector3D::Cross(zAxis, xAxis);
@@ -373,6 +420,7 @@ inline Math::Matrix<4, 4, T> Math::LinearTransform3D::Perspective_RH_ZO(T fovY,
 		std::is_floating_point<T>(),
 		"DMath error. Template argument T in Math::LinearTransform3D::PerspectiveRH_ZO must be floating point type."
 	);
+	detail::Instrumentation::Count(InstrumentedOperation::TransformCamera, 11);
 
 	const T tanHalfFovy = Tan<AngleUnit::Degrees>(fovY / 2);
 	return Matrix<4, 4, T>
@@ -392,6 +440,7 @@ inline Math::Matrix<4, 4, T> Math::LinearTransform3D::Perspective_RH_NO(T fovY,
 		std::is_floating_point<T>(),
 		"DMath error. Template argument T in Math::LinearTransform3D::PerspectiveRH_NO must be floating point type."
 	);
+	detail::Instrumentation::Count(InstrumentedOperation::TransformCamera, 14);
 
 	const T tanHalfFovy = Tan<AngleUnit::Degrees>(fovY / 2);
 	return Matrix<4, 4, T>
@@ -438,6 +487,7 @@ Math::Matrix<4, 4, T> Math::LinearTransform3D::Orthographic_RH_ZO(T left, T righ
 		std::is_floating_point<T>(),
 		"DMath error. Template argument T in Math::LinearTransform3D::Orthographic_RH_ZO must be floating point type."
 	);
+	detail::Instrumentation::Count(InstrumentedOperation::TransformCamera, 18);
 
 	return Matrix<4, 4, T>
 	({
@@ -456,6 +506,7 @@ Math::Matrix<4, 4, T> Math::LinearTransform3D::Orthographic_RH_NO(T left, T righ
 		std::is_floating_point<T>(),
 		"DMath error. Template argument T in Math::LinearTransform3D::Orthographic_RH_NO must be floating point type."
 	);
+	detail::Instrumentation::Count(InstrumentedOperation::TransformCamera, 18);
 
 	return Matrix<4, 4, T>
 	({
@@ -4,8 +4,6 @@
 
 TO DO LIST:
 Linear Equation class
-Polynomial2D class
-Interpolation to Polynomial2D
 Inverse matrix
 
 */
@@ -14,6 +12,7 @@ Inverse matrix
 
 #include "Trait.hpp"
 #include "Common.hpp"
+#include "ArrayMath.hpp"
 #include "Constant.hpp"
 #include "Enum.hpp"
 #include "Trigonometric.hpp"
@@ -21,9 +20,33 @@ Inverse matrix
 #include "Matrix\Matrix.hpp"
 
 #include "Vector\Vector.hpp"
+#include "VectorBatch.hpp"
+
+#include "Polynomial.hpp"
+#include "Spline.hpp"
+#include "Noise.hpp"
+#include "Random.hpp"
 
 #include "LinearTransform.hpp"
 
 #include "LinearEquation.hpp"
 
-#include "Quaternion.hpp"
\ No newline at end of file
+#include "Quaternion.hpp"
+
+#include "Plane.hpp"
+#include "BoundingVolume.hpp"
+#include "Frustum.hpp"
+#include "Memory.hpp"
+#include "Execution.hpp"
+#include "Instrumentation.hpp"
+#include "BinaryFile.hpp"
+#include "Format.hpp"
+#include "Accuracy.hpp"
+#include "RadixSort.hpp"
+#include "Morton.hpp"
+#include "SpatialHashGrid.hpp"
+#include "KdTree.hpp"
+#include "Ray.hpp"
+#include "BVH.hpp"
+#include "RayPacket.hpp"
+#include "GpuBuffer.hpp"
\ No newline at end of file
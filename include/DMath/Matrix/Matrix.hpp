@@ -2,36 +2,59 @@
 
 #include "MatrixBase.hpp"
 #include "MatrixBaseSquare.hpp"
+#include "../Format.hpp"
+#include "../Span.hpp"
 
+#include <cstring>
 #include <initializer_list>
-#include <sstream>
 
 namespace Math
 {
 	template<size_t length, typename T>
 	struct Vector;
 
-	namespace detail
-	{
-		namespace Matrix
-		{
-			using DefaultValueType = float;
-		}
-	}
-
 	using Matrix2x2 = Matrix<2, 2, float>;
 	using Matrix2x2Int = Matrix<2, 2, uint32_t>;
 	using Matrix3x3 = Matrix<3, 3, float>;
 	using Matrix3x3Int = Matrix<3, 3, uint32_t>;
 	using Matrix4x4 = Matrix<4, 4, float>;
 	using Matrix4x4Int = Matrix<4, 4, uint32_t>;
-
+	// Rows one after another in memory, for APIs such as DirectXMath and HLSL row_major matrices.
 	template<size_t width, size_t height, typename T = detail::Matrix::DefaultValueType>
-	struct Matrix : public std::conditional_t<width == height, detail::MatrixBaseSquare<width, T>, detail::MatrixBase<width, height, T>>
+	using RowMajorMatrix = Matrix<width, height, T, MatrixLayout::RowMajor>;
+
+	// Column or row of a Matrix, length elements that are stride elements apart in its data. T is const in views of const matrices.
+	template<typename T, size_t length, size_t stride>
+	struct MatrixView
+	{
+		static constexpr bool isContiguous = stride == 1;
+
+		T* first;
+
+		[[nodiscard]] static constexpr size_t size()
+		{
+			return length;
+		}
+		[[nodiscard]] constexpr T& operator[](size_t index) const
+		{
+#if defined( _MSC_VER )
+			__assume(index < length);
+#endif
+			assert(index < length);
+			return first[index * stride];
+		}
+	};
+
+	template<size_t width, size_t height, typename T, MatrixLayout layout>
+	struct Matrix : public std::conditional_t<width == height, detail::MatrixBaseSquare<width, T, layout>, detail::MatrixBase<width, height, T, layout>>
 	{
 	public:
-		using ParentType = std::conditional_t<width == height, detail::MatrixBaseSquare<width, T>, detail::MatrixBase<width, height, T>>;
+		using ParentType = std::conditional_t<width == height, detail::MatrixBaseSquare<width, T, layout>, detail::MatrixBase<width, height, T, layout>>;
 		using ValueType = T;
+		using ColumnViewType = MatrixView<T, height, layout == MatrixLayout::ColumnMajor ? 1 : width>;
+		using ConstColumnViewType = MatrixView<const T, height, layout == MatrixLayout::ColumnMajor ? 1 : width>;
+		using RowViewType = MatrixView<T, width, layout == MatrixLayout::ColumnMajor ? height : 1>;
+		using ConstRowViewType = MatrixView<const T, width, layout == MatrixLayout::ColumnMajor ? height : 1>;
 
 		[[nodiscard]] constexpr T& At(size_t i)
 		{
@@ -39,7 +62,7 @@ namespace Math
 			__assume(i < width * height);
 #endif
 			assert(i < width * height);
-			return data[i];
+			return this->data[i];
 		}
 		[[nodiscard]] constexpr const T& At(size_t i) const
 		{
@@ -47,7 +70,7 @@ namespace Math
 			__assume(i < width * height);
 #endif
 			assert(i < width * height);
-			return data[i];
+			return this->data[i];
 		}
 		[[nodiscard]] constexpr T& At(size_t x, size_t y)
 		{
@@ -55,7 +78,7 @@ namespace Math
 			__assume(x < width && y < height);
 #endif
 			assert(x < width && y < height);
-			return data[x * height + y];
+			return this->data[this->GetIndex(x, y)];
 		}
 		[[nodiscard]] constexpr const T& At(size_t x, size_t y) const
 		{
@@ -63,29 +86,68 @@ namespace Math
 			__assume(x < width && y < height);
 #endif
 			assert(x < width && y < height);
-			return data[x * height + y];
+			return this->data[this->GetIndex(x, y)];
 		}
 
 		[[nodiscard]] constexpr T& Back()
 		{
-			return data.back();
+			return this->data.back();
 		}
 		[[nodiscard]] constexpr const T& Back() const
 		{
-			return data.back();
+			return this->data.back();
 		}
 		[[nodiscard]] constexpr T* GetData()
 		{
-			return data.data();
+			return this->data.data();
 		}
 		[[nodiscard]] constexpr const T* GetData() const
 		{
-			return data.data();
+			return this->data.data();
+		}
+
+		[[nodiscard]] constexpr ColumnViewType GetColumn(size_t x)
+		{
+			assert(x < width);
+			return ColumnViewType{ this->data.data() + this->GetIndex(x, 0) };
+		}
+		[[nodiscard]] constexpr ConstColumnViewType GetColumn(size_t x) const
+		{
+			assert(x < width);
+			return ConstColumnViewType{ this->data.data() + this->GetIndex(x, 0) };
+		}
+		[[nodiscard]] constexpr RowViewType GetRow(size_t y)
+		{
+			assert(y < height);
+			return RowViewType{ this->data.data() + this->GetIndex(0, y) };
+		}
+		[[nodiscard]] constexpr ConstRowViewType GetRow(size_t y) const
+		{
+			assert(y < height);
+			return ConstRowViewType{ this->data.data() + this->GetIndex(0, y) };
+		}
+
+		// Same values with the elements in newLayout order.
+		template<MatrixLayout newLayout>
+		[[nodiscard]] constexpr Matrix<width, height, T, newLayout> ToLayout() const
+		{
+			if constexpr (newLayout == layout)
+				return *this;
+			else
+			{
+				Matrix<width, height, T, newLayout> newMatrix{};
+				for (size_t x = 0; x < width; x++)
+				{
+					for (size_t y = 0; y < height; y++)
+						newMatrix.data[newMatrix.GetIndex(x, y)] = this->data[this->GetIndex(x, y)];
+				}
+				return newMatrix;
+			}
 		}
 
-		[[nodiscard]] constexpr Matrix<height, width, T> GetTransposed() const
+		[[nodiscard]] constexpr Matrix<height, width, T, layout> GetTransposed() const
 		{
-			Matrix<height, width, T> temp;
+			Matrix<height, width, T, layout> temp{};
 			for (size_t x = 0; x < width; x++)
 			{
 				for (size_t y = 0; y < height; y++)
@@ -116,165 +178,220 @@ namespace Math
 
 		[[nodiscard]] std::string ToString() const
 		{
-			std::stringstream stream;
-			if constexpr (std::is_floating_point<T>::value)
-			{
-				stream.precision(4);
-				stream.flags(std::ios::fixed);
-			}
-
-			for (size_t y = 0; y < height; y++)
-			{
-				for (size_t x = 0; x < width; x++)
-				{
-					if constexpr (std::is_same<char, T>::value || std::is_same<unsigned char, T>::value)
-						stream << +(*this)[x][y];
-					else
-						stream << (*this)[x][y];
-					if (x < width - 1)
-						stream << ", ";
-				}
-				if (y < height - 1)
-					stream << std::endl;
-			}
-			return stream.str();
+			return detail::Format::ToString(*this);
 		}
 
-		[[nodiscard]] static constexpr Matrix<width, height, T> SingleValue(const T& input)
+		[[nodiscard]] static constexpr Matrix<width, height, T, layout> SingleValue(const T& input)
 		{
-			Matrix<width, height, T> returnMatrix;
+			Matrix<width, height, T, layout> returnMatrix{};
 			for (size_t i = 0; i < width * height; i++)
 				returnMatrix.data[i] = input;
 			return returnMatrix;
 		}
-		[[nodiscard]] static constexpr Matrix<width, height, T> Zero() 
+		[[nodiscard]] static constexpr Matrix<width, height, T, layout> Zero() 
 		{
-			return Matrix<width, height, T>{};
+			return Matrix<width, height, T, layout>{};
 		}
-		[[nodiscard]] static constexpr Matrix<width, height, T> One() 
+		[[nodiscard]] static constexpr Matrix<width, height, T, layout> One() 
 		{ 
-			Matrix<width, height, T> returnMatrix;
+			Matrix<width, height, T, layout> returnMatrix{};
 			for (size_t i = 0; i < width * height; i++)
 				returnMatrix.data[i] = T(1);
 			return returnMatrix;
 		}
 
-		[[nodiscard]] constexpr Matrix<width, height, T> operator+(const Matrix<width, height, T>& rhs) const
+		[[nodiscard]] constexpr Matrix<width, height, T, layout> operator+(const Matrix<width, height, T, layout>& rhs) const
 		{
-			Matrix<width, height, T> newMatrix;
+			Matrix<width, height, T, layout> newMatrix{};
 			for (size_t i = 0; i < width * height; i++)
-				newMatrix.data[i] = data[i] + rhs.data[i];
+				newMatrix.data[i] = this->data[i] + rhs.data[i];
 			return newMatrix;
 		}
-		constexpr Matrix<width, height, T>& operator+=(const Matrix<width, height, T>& rhs)
+		constexpr Matrix<width, height, T, layout>& operator+=(const Matrix<width, height, T, layout>& rhs)
 		{
 			for (size_t i = 0; i < width * height; i++)
-				data[i] += rhs.data[i];
+				this->data[i] += rhs.data[i];
 			return *this;
 		}
-		[[nodiscard]] constexpr Matrix<width, height, T> operator-(const Matrix<width, height, T>& rhs) const
+		[[nodiscard]] constexpr Matrix<width, height, T, layout> operator-(const Matrix<width, height, T, layout>& rhs) const
 		{
-			Matrix<width, height, T> newMatrix;
+			Matrix<width, height, T, layout> newMatrix{};
 			for (size_t i = 0; i < width * height; i++)
-				newMatrix.data[i] = data[i] - rhs.data[i];
+				newMatrix.data[i] = this->data[i] - rhs.data[i];
 			return newMatrix;
 		}
-		constexpr Matrix<width, height, T>& operator-=(const Matrix<width, height, T>& rhs)
+		constexpr Matrix<width, height, T, layout>& operator-=(const Matrix<width, height, T, layout>& rhs)
 		{
 			for (size_t i = 0; i < width * height; i++)
-				data[i] -= rhs.data[i];
+				this->data[i] -= rhs.data[i];
 			return *this;
 		}
-		[[nodiscard]] constexpr Matrix<width, height, T> operator-() const
+		[[nodiscard]] constexpr Matrix<width, height, T, layout> operator-() const
 		{
-			Matrix<width, height, T> newMatrix;
+			Matrix<width, height, T, layout> newMatrix{};
 			for (size_t i = 0; i < width * height; i++)
-				newMatrix.data[i] = -data[i];
+				newMatrix.data[i] = -this->data[i];
 			return newMatrix;
 		}
-		template<size_t widthB>
-		[[nodiscard]] constexpr Matrix<widthB, height, T> operator*(const Matrix<widthB, width, T>& right) const
+		// The product has the layout of the left matrix. The innermost loop runs along its contiguous columns or rows,
+		// and every element still sums its products in order of i, so both layouts give the same results.
+		template<size_t widthB, MatrixLayout layoutB>
+		[[nodiscard]] constexpr Matrix<widthB, height, T, layout> operator*(const Matrix<widthB, width, T, layoutB>& right) const
 		{
-			Matrix<widthB, height, T> newMatrix;
-			for (size_t x = 0; x < widthB; x++)
+			detail::Instrumentation::Count(InstrumentedOperation::MatrixMultiply, 2 * width * height * widthB);
+			Matrix<widthB, height, T, layout> newMatrix{};
+			if constexpr (layout == MatrixLayout::ColumnMajor)
+			{
+				for (size_t x = 0; x < widthB; x++)
+				{
+					for (size_t i = 0; i < width; i++)
+					{
+						const T factor = right.data[right.GetIndex(x, i)];
+						for (size_t y = 0; y < height; y++)
+							newMatrix.data[newMatrix.GetIndex(x, y)] += this->data[this->GetIndex(i, y)] * factor;
+					}
+				}
+			}
+			else
 			{
 				for (size_t y = 0; y < height; y++)
 				{
-					T dot = T(0);
 					for (size_t i = 0; i < width; i++)
-						dot += (*this)[i][y] * right[x][i];
-					newMatrix[x][y] = dot;
+					{
+						const T factor = this->data[this->GetIndex(i, y)];
+						for (size_t x = 0; x < widthB; x++)
+							newMatrix.data[newMatrix.GetIndex(x, y)] += factor * right.data[right.GetIndex(x, i)];
+					}
 				}
 			}
 			return newMatrix;
 		}
 		[[nodiscard]] constexpr Vector<height, T> operator*(const Vector<width, T>& right) const
 		{
-			Vector<height, T> newVector;
-			for (size_t y = 0; y < height; y++)
+			detail::Instrumentation::Count(InstrumentedOperation::MatrixVectorMultiply, 2 * width * height);
+			Vector<height, T> newVector{};
+			if constexpr (layout == MatrixLayout::ColumnMajor)
 			{
-				T dot{};
 				for (size_t i = 0; i < width; i++)
-					dot += (*this)[i][y] * right[i];
-				newVector[y] = dot;
+				{
+					const T factor = right[i];
+					for (size_t y = 0; y < height; y++)
+						newVector[y] += this->data[this->GetIndex(i, y)] * factor;
+				}
+			}
+			else
+			{
+				for (size_t y = 0; y < height; y++)
+				{
+					T dot{};
+					for (size_t i = 0; i < width; i++)
+						dot += this->data[this->GetIndex(i, y)] * right[i];
+					newVector[y] = dot;
+				}
 			}
 			return newVector;
 		}
-		constexpr Matrix<width, height, T>& operator*=(const T& right)
+		constexpr Matrix<width, height, T, layout>& operator*=(const T& right)
 		{
 			for (size_t i = 0; i < width * height; i++)
-				data[i] *= right;
+				this->data[i] *= right;
 			return *this;
 		}
-		[[nodiscard]] constexpr bool operator==(const Matrix<width, height, T>& right) const
+		[[nodiscard]] constexpr bool operator==(const Matrix<width, height, T, layout>& right) const
 		{
 			for (size_t i = 0; i < width * height; i++)
 			{
-				if (data[i] != right.data[i])
+				if (this->data[i] != right.data[i])
 					return false;
 			}
 			return true;
 		}
-		[[nodiscard]] constexpr bool operator!=(const Matrix<width, height, T>& right) const
+		[[nodiscard]] constexpr bool operator!=(const Matrix<width, height, T, layout>& right) const
 		{
 			for (size_t i = 0; i < width * height; i++)
 			{
-				if (data[i] != right.data[i])
+				if (this->data[i] != right.data[i])
 					return true;
 			}
 			return false;
 		}
-		[[nodiscard]] constexpr T* operator[](size_t index)
+		// Column at index, to index further by row. A pointer to the column in column-major matrices, a ColumnViewType in row-major ones.
+		[[nodiscard]] constexpr std::conditional_t<layout == MatrixLayout::ColumnMajor, T*, ColumnViewType> operator[](size_t index)
 		{
 #if defined( _MSC_VER )
-			__assume(index < height);
+			__assume(index < width);
 #endif
-			return data.data() + (index * height);
+			if constexpr (layout == MatrixLayout::ColumnMajor)
+				return this->data.data() + (index * height);
+			else
+				return ColumnViewType{ this->data.data() + index };
 		}
-		[[nodiscard]] constexpr const T* operator[](size_t index) const
+		[[nodiscard]] constexpr std::conditional_t<layout == MatrixLayout::ColumnMajor, const T*, ConstColumnViewType> operator[](size_t index) const
 		{
 #if defined( _MSC_VER )
-			__assume(index < height);
+			__assume(index < width);
 #endif
-			return data.data() + (index * height);
+			if constexpr (layout == MatrixLayout::ColumnMajor)
+				return this->data.data() + (index * height);
+			else
+				return ConstColumnViewType{ this->data.data() + index };
 		}
 	};
 
-	template<size_t width, size_t height, typename T>
-	[[nodiscard]] constexpr auto operator*(const Matrix<width, height, T>& lhs, const T& rhs)
+	template<size_t width, size_t height, typename T, MatrixLayout layout>
+	[[nodiscard]] constexpr auto operator*(const Matrix<width, height, T, layout>& lhs, const T& rhs)
 	{
-		Matrix<width, height, T> newMatrix;
+		Matrix<width, height, T, layout> newMatrix{};
 		for (size_t i = 0; i < width * height; i++)
 			newMatrix.data[i] = lhs.data[i] * rhs;
 		return newMatrix;
 	}
 
-	template<size_t width, size_t height, typename T>
-	[[nodiscard]] constexpr auto operator*(const T& left, const Matrix<width, height, T>& right)
+	template<size_t width, size_t height, typename T, MatrixLayout layout>
+	[[nodiscard]] constexpr auto operator*(const T& left, const Matrix<width, height, T, layout>& right)
 	{
-		Matrix<width, height, T> newMatrix;
+		Matrix<width, height, T, layout> newMatrix{};
 		for (size_t i = 0; i < width * height; i++)
 			newMatrix.data[i] = left * right.data[i];
 		return newMatrix;
 	}
+
+	// Writes the matrices one after another to destination with their elements in targetLayout, such as a mapped GPU buffer.
+	// A single memcpy when targetLayout is the layout of the matrices.
+	template<MatrixLayout targetLayout, size_t width, size_t height, typename T, MatrixLayout layout>
+	void CopyMatrices(Span<const Matrix<width, height, T, layout>> matrices, void* destination)
+	{
+		using MatrixType = Matrix<width, height, T, layout>;
+		static_assert(sizeof(MatrixType) == sizeof(T) * width * height && std::is_trivially_copyable_v<MatrixType>, "DMath error. CopyMatrices needs tightly packed, trivially copyable matrices.");
+
+		if constexpr (targetLayout == layout)
+		{
+			if (!matrices.empty())
+				std::memcpy(destination, matrices.data(), matrices.size() * sizeof(MatrixType));
+		}
+		else
+		{
+			unsigned char* target = static_cast<unsigned char*>(destination);
+			for (size_t i = 0; i < matrices.size(); i++)
+			{
+				const Matrix<width, height, T, targetLayout> converted = matrices[i].template ToLayout<targetLayout>();
+				std::memcpy(target + i * sizeof(MatrixType), converted.GetData(), sizeof(MatrixType));
+			}
+		}
+	}
+
+#if defined( DMATH_COMPILED )
+	// Instantiated in src/Compiled.cpp, see the DMath::Compiled target.
+	extern template struct detail::MatrixBase<2, 2, float, MatrixLayout::ColumnMajor>;
+	extern template struct detail::MatrixBase<3, 3, float, MatrixLayout::ColumnMajor>;
+	extern template struct detail::MatrixBase<4, 4, float, MatrixLayout::ColumnMajor>;
+	extern template struct detail::MatrixBase<4, 3, float, MatrixLayout::ColumnMajor>;
+	extern template struct detail::MatrixBaseSquare<2, float, MatrixLayout::ColumnMajor>;
+	extern template struct detail::MatrixBaseSquare<3, float, MatrixLayout::ColumnMajor>;
+	extern template struct detail::MatrixBaseSquare<4, float, MatrixLayout::ColumnMajor>;
+	extern template struct Matrix<2, 2, float>;
+	extern template struct Matrix<3, 3, float>;
+	extern template struct Matrix<4, 4, float>;
+	extern template struct Matrix<4, 3, float>;
+#endif
 }
\ No newline at end of file
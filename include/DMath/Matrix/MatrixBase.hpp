@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Trait.hpp"
+#include "../Enum.hpp"
 
 #include <string>
 #include <type_traits>
@@ -11,27 +12,46 @@
 
 namespace Math
 {
-	template<size_t width, size_t height, typename T>
+	namespace detail
+	{
+		namespace Matrix
+		{
+			using DefaultValueType = float;
+		}
+	}
+
+	// Element order in memory is a compile-time policy, see MatrixLayout. Both layouts index as [column][row].
+	template<size_t width, size_t height, typename T = detail::Matrix::DefaultValueType, MatrixLayout layout = MatrixLayout::ColumnMajor>
 	struct Matrix;
 
 	namespace detail
 	{
-		template<size_t width, size_t height, typename T>
+		template<size_t width, size_t height, typename T, MatrixLayout layout>
 		struct MatrixBase
 		{
 		public:
-			static constexpr bool isColumnMajor = true;
+			static constexpr MatrixLayout memoryLayout = layout;
+			static constexpr bool isColumnMajor = layout == MatrixLayout::ColumnMajor;
 
 			std::array<T, width * height> data;
 
-			[[nodiscard]] constexpr Math::Matrix<width - 1, height - 1, T> GetMinor(size_t columnIndexToSlice, size_t rowIndexToSlice) const
+			// Position of the element in column x and row y within data.
+			[[nodiscard]] static constexpr size_t GetIndex(size_t x, size_t y)
+			{
+				if constexpr (isColumnMajor)
+					return x * height + y;
+				else
+					return y * width + x;
+			}
+
+			[[nodiscard]] constexpr Math::Matrix<width - 1, height - 1, T, layout> GetMinor(size_t columnIndexToSlice, size_t rowIndexToSlice) const
 			{
 #if defined( _MSC_VER )
 				__assume(columnIndexToSlice < width && rowIndexToSlice < height);
 #endif
 				assert(columnIndexToSlice < width && rowIndexToSlice < height);
 
-				Math::Matrix<width - 1, height - 1, T> newMatrix;
+				Math::Matrix<width - 1, height - 1, T, layout> newMatrix;
 				for (size_t x = 0; x < width; x++)
 				{
 					if (x == columnIndexToSlice)
@@ -42,7 +62,7 @@ namespace Math
 						if (y == rowIndexToSlice)
 							continue;
 
-						newMatrix[x < columnIndexToSlice ? x : x - 1][y < rowIndexToSlice ? y : y - 1] = data[x * height + y];
+						newMatrix[x < columnIndexToSlice ? x : x - 1][y < rowIndexToSlice ? y : y - 1] = this->data[GetIndex(x, y)];
 					}
 				}
 				return newMatrix;
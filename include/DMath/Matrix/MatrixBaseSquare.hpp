@@ -2,70 +2,54 @@
 
 #include "MatrixBase.hpp"
 #include "../Trait.hpp"
+#include "../Instrumentation.hpp"
 
 #include <initializer_list>
 #include <optional>
 
 namespace Math
 {
-	template<size_t width, size_t height, typename T>
+	template<size_t width, size_t height, typename T, MatrixLayout layout>
 	struct Matrix;
 
 	namespace detail
 	{
-		template<size_t width, size_t height, typename T>
+		template<size_t width, size_t height, typename T, MatrixLayout layout>
 		struct MatrixBase;
 
-		template<size_t width, typename T>
-		struct MatrixBaseSquare : public MatrixBase<width, width, T>
+		namespace SquareMatrix
+		{
+			// The minors of GetDeterminant, GetAdjugate and GetInverse go through these, so that only the outermost call is counted.
+			template<size_t width, typename T, MatrixLayout layout>
+			[[nodiscard]] constexpr T GetDeterminant(const MatrixBase<width, width, T, layout>& matrix);
+			template<size_t width, typename T, MatrixLayout layout>
+			[[nodiscard]] constexpr Math::Matrix<width, width, T, layout> GetAdjugate(const MatrixBase<width, width, T, layout>& matrix);
+		}
+
+		template<size_t width, typename T, MatrixLayout layout>
+		struct MatrixBaseSquare : public MatrixBase<width, width, T, layout>
 		{
 		public:
-			using ParentType = MatrixBase<width, width, T>;
+			using ParentType = MatrixBase<width, width, T, layout>;
 
-			[[nodiscard]] constexpr Math::Matrix<width, width, T> GetAdjugate() const
+			[[nodiscard]] constexpr Math::Matrix<width, width, T, layout> GetAdjugate() const
 			{
-				Math::Matrix<width, width, T> newMatrix;
-				for (size_t x = 0; x < width; x++)
-				{
-					int8_t factor = (!(x % 2)) * 2 - 1;
-					for (size_t y = 0; y < width; y++)
-					{
-						newMatrix[y][x] = factor * this->GetMinor(x, y).GetDeterminant();
-						factor = -factor;
-					}
-				}
-				return newMatrix;
+				return SquareMatrix::GetAdjugate(*this);
 			}
 
 			[[nodiscard]] constexpr T GetDeterminant() const
 			{
-				if constexpr (width >= 3)
-				{
-					T determinant = T();
-					int8_t factor = -1;
-					for (size_t x = 0; x < width; x++)
-					{
-						factor = -factor;
-						if (data[x * width] == T(0))
-							continue;
-						determinant += factor * data[x * width] * GetMinor(x, 0).GetDeterminant();
-					}
-					return determinant;
-				}
-				else if constexpr (width == 2)
-					return data[0] * data[width + 1] - data[width] * data[1];
-				else if constexpr (width == 1)
-					return data[0];
-				else
-					return 1;
+				Instrumentation::Count(InstrumentedOperation::MatrixDeterminant, Instrumentation::GetDeterminantFlops(width));
+				return SquareMatrix::GetDeterminant(*this);
 			}
 
-			[[nodiscard]] constexpr std::optional<Math::Matrix<width, width, T>> GetInverse() const
+			[[nodiscard]] constexpr std::optional<Math::Matrix<width, width, T, layout>> GetInverse() const
 			{
-				Math::Matrix<width, width, T> adjugate = GetAdjugate();
+				Instrumentation::Count(InstrumentedOperation::MatrixInverse, Instrumentation::GetInverseFlops(width));
+				Math::Matrix<width, width, T, layout> adjugate = SquareMatrix::GetAdjugate(*this);
 				T determinant = T();
 				for (size_t x = 0; x < width; x++)
-					determinant += data[x * width] * adjugate[0][x];
+					determinant += this->data[this->GetIndex(x, 0)] * adjugate[0][x];
 				if (!(determinant == T()))
 				{
 					for (size_t i = 0; i < width * width; i++)
@@ -81,13 +65,13 @@ namespace Math
 				for (size_t x = 1; x < width; x++)
 				{
 					for (size_t y = 0; y < x; y++)
-						std::swap(data[x * width + y], data[y * width + x]);
+						std::swap(this->data[x * width + y], this->data[y * width + x]);
 				}
 			}
 
-			[[nodiscard]] static constexpr Math::Matrix<width, width, T> Identity()
+			[[nodiscard]] static constexpr Math::Matrix<width, width, T, layout> Identity()
 			{
-				Math::Matrix<width, width, T> temp{};
+				Math::Matrix<width, width, T, layout> temp{};
 				for (size_t x = 0; x < width; x++)
 					temp.data[x * width + x] = T(1);
 				return temp;
@@ -95,8 +79,52 @@ namespace Math
 
 			[[nodiscard]] constexpr bool IsSingular() const
 			{
-				return GetDeterminant() == T(0);
+				return this->GetDeterminant() == T(0);
 			}
 		};
+
+		namespace SquareMatrix
+		{
+			template<size_t width, typename T, MatrixLayout layout>
+			constexpr T GetDeterminant(const MatrixBase<width, width, T, layout>& matrix)
+			{
+				if constexpr (width >= 3)
+				{
+					T determinant = T();
+					int8_t factor = -1;
+					for (size_t x = 0; x < width; x++)
+					{
+						factor = -factor;
+						const T& element = matrix.data[matrix.GetIndex(x, 0)];
+						if (element == T(0))
+							continue;
+						determinant += factor * element * SquareMatrix::GetDeterminant(matrix.GetMinor(x, 0));
+					}
+					return determinant;
+				}
+				else if constexpr (width == 2)
+					return matrix.data[0] * matrix.data[width + 1] - matrix.data[width] * matrix.data[1];
+				else if constexpr (width == 1)
+					return matrix.data[0];
+				else
+					return 1;
+			}
+
+			template<size_t width, typename T, MatrixLayout layout>
+			constexpr Math::Matrix<width, width, T, layout> GetAdjugate(const MatrixBase<width, width, T, layout>& matrix)
+			{
+				Math::Matrix<width, width, T, layout> newMatrix;
+				for (size_t x = 0; x < width; x++)
+				{
+					int8_t factor = (!(x % 2)) * 2 - 1;
+					for (size_t y = 0; y < width; y++)
+					{
+						newMatrix[y][x] = factor * SquareMatrix::GetDeterminant(matrix.GetMinor(x, y));
+						factor = -factor;
+					}
+				}
+				return newMatrix;
+			}
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,340 @@
+#pragma once
+
+#include "Span.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Math
+{
+	namespace Setup
+	{
+		// Alignment of every Arena and Pool allocation, a cache line and the widest SIMD register.
+		constexpr size_t allocationAlignment = 64;
+		// Size of the blocks an Arena reserves, unless a single allocation needs more.
+		constexpr size_t defaultArenaBlockSize = size_t(1) << 20;
+	}
+
+	// Allocations of an Arena or Pool, in total or over one ArenaScope.
+	struct AllocationStats
+	{
+		size_t allocationCount = 0;
+		// Most bytes in use at once.
+		size_t peakBytes = 0;
+		// Bytes reserved from the system.
+		size_t reservedBytes = 0;
+	};
+
+	// Called when an ArenaScope with an operation name closes, with the allocations made within it.
+	// Called on the thread that owns the arena, so the hook must be thread safe when arenas are used from several threads.
+	using AllocationHook = void(*)(const char* operation, const AllocationStats& stats);
+	void SetAllocationHook(AllocationHook hook);
+
+	// Bump allocator for temporaries. Allocations are released together with Reset or at the end of an ArenaScope,
+	// and the reserved blocks are kept for the next use instead of being returned to the system.
+	// Not thread safe, GetThreadArena gives each thread its own.
+	class Arena
+	{
+	public:
+		// Position to roll back to with Reset.
+		struct Marker
+		{
+			size_t blockIndex;
+			size_t offset;
+			size_t usedBytes;
+		};
+
+		explicit Arena(size_t blockSize = Setup::defaultArenaBlockSize);
+		~Arena();
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		// Uninitialized memory aligned to Setup::allocationAlignment.
+		[[nodiscard]] void* Allocate(size_t byteCount);
+		// Uninitialized array of count elements.
+		template<typename T>
+		[[nodiscard]] Span<T> Allocate(size_t count);
+
+		[[nodiscard]] Marker GetMarker() const;
+		// Releases everything allocated since marker was taken.
+		void Reset(Marker marker);
+		void Reset();
+
+		// Bytes from the start of the arena to the current position, the unused ends of filled blocks included.
+		[[nodiscard]] size_t GetUsedBytes() const;
+		[[nodiscard]] const AllocationStats& GetStats() const;
+		// Counts from the current usage again.
+		void ResetStats();
+
+	private:
+		struct Block
+		{
+			std::byte* data;
+			size_t size;
+		};
+
+		std::vector<Block> blocks;
+		size_t blockSize;
+		size_t blockIndex = 0;
+		size_t offset = 0;
+		size_t usedBytes = 0;
+		AllocationStats stats;
+
+		void MoveToNextBlock(size_t byteCount);
+
+		friend class ArenaScope;
+	};
+
+	// The calling thread's arena, for workspaces that do not need to outlive the call.
+	[[nodiscard]] Arena& GetThreadArena();
+
+	// Releases the allocations made in arena during its lifetime, and reports them to the allocation hook if operation is set.
+	// Scopes nest, the arena's totals still include the allocations of closed scopes.
+	class ArenaScope
+	{
+	public:
+		explicit ArenaScope(Arena& arena, const char* operation = nullptr);
+		~ArenaScope();
+		ArenaScope(const ArenaScope&) = delete;
+		ArenaScope& operator=(const ArenaScope&) = delete;
+
+	private:
+		Arena& arena;
+		Arena::Marker marker;
+		AllocationStats outerStats;
+		const char* operation;
+	};
+
+	// Fixed size elements carved out of larger chunks and recycled through a free list.
+	// Not thread safe.
+	class Pool
+	{
+	public:
+		// elementSize is rounded up to a multiple of Setup::allocationAlignment.
+		explicit Pool(size_t elementSize, size_t elementsPerChunk = 64);
+		~Pool();
+		Pool(const Pool&) = delete;
+		Pool& operator=(const Pool&) = delete;
+
+		// Uninitialized memory of the element size, aligned to Setup::allocationAlignment.
+		[[nodiscard]] void* Allocate();
+		void Deallocate(void* element);
+
+		[[nodiscard]] size_t GetElementSize() const;
+		[[nodiscard]] const AllocationStats& GetStats() const;
+		void ResetStats();
+
+	private:
+		struct FreeElement
+		{
+			FreeElement* next;
+		};
+
+		std::vector<std::byte*> chunks;
+		FreeElement* freeList = nullptr;
+		size_t elementSize;
+		size_t elementsPerChunk;
+		size_t usedBytes = 0;
+		AllocationStats stats;
+	};
+
+	namespace detail
+	{
+		namespace Memory
+		{
+			inline std::atomic<AllocationHook> allocationHook{ nullptr };
+
+			[[nodiscard]] constexpr size_t AlignUp(size_t byteCount)
+			{
+				return (byteCount + Setup::allocationAlignment - 1) & ~(Setup::allocationAlignment - 1);
+			}
+
+			[[nodiscard]] inline std::byte* Reserve(size_t byteCount)
+			{
+				return static_cast<std::byte*>(::operator new(byteCount, std::align_val_t(Setup::allocationAlignment)));
+			}
+
+			inline void Release(std::byte* data)
+			{
+				::operator delete(data, std::align_val_t(Setup::allocationAlignment));
+			}
+		}
+	}
+}
+
+inline void Math::SetAllocationHook(AllocationHook hook)
+{
+	detail::Memory::allocationHook.store(hook, std::memory_order_relaxed);
+}
+
+inline Math::Arena::Arena(size_t blockSize) :
+	blockSize(detail::Memory::AlignUp(std::max<size_t>(blockSize, 1))) {}
+
+inline Math::Arena::~Arena()
+{
+	for (const Block& block : blocks)
+		detail::Memory::Release(block.data);
+}
+
+inline void Math::Arena::MoveToNextBlock(size_t byteCount)
+{
+	if (!blocks.empty())
+	{
+		usedBytes += blocks[blockIndex].size - offset;
+		blockIndex++;
+	}
+	offset = 0;
+
+	// Blocks kept from earlier use are reused when large enough, otherwise a new one goes in front of them.
+	if (blockIndex == blocks.size() || blocks[blockIndex].size < byteCount)
+	{
+		const size_t size = std::max(blockSize, byteCount);
+		blocks.insert(blocks.begin() + blockIndex, Block{ detail::Memory::Reserve(size), size });
+		stats.reservedBytes += size;
+	}
+}
+
+inline void* Math::Arena::Allocate(size_t byteCount)
+{
+	// Sizes are rounded up, so that every offset stays aligned.
+	byteCount = detail::Memory::AlignUp(std::max<size_t>(byteCount, 1));
+	if (blocks.empty() || offset + byteCount > blocks[blockIndex].size)
+		MoveToNextBlock(byteCount);
+
+	void* result = blocks[blockIndex].data + offset;
+	offset += byteCount;
+	usedBytes += byteCount;
+	stats.allocationCount++;
+	stats.peakBytes = std::max(stats.peakBytes, usedBytes);
+	return result;
+}
+
+template<typename T>
+Math::Span<T> Math::Arena::Allocate(size_t count)
+{
+	static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>, "DMath error. Math::Arena only allocates arrays of trivially copyable types.");
+	static_assert(alignof(T) <= Setup::allocationAlignment, "DMath error. Math::Arena cannot align beyond Setup::allocationAlignment.");
+	return Span<T>(static_cast<T*>(Allocate(count * sizeof(T))), count);
+}
+
+inline auto Math::Arena::GetMarker() const -> Marker
+{
+	return Marker{ blockIndex, offset, usedBytes };
+}
+
+inline void Math::Arena::Reset(Marker marker)
+{
+	assert(marker.usedBytes <= usedBytes);
+	blockIndex = marker.blockIndex;
+	offset = marker.offset;
+	usedBytes = marker.usedBytes;
+}
+
+inline void Math::Arena::Reset()
+{
+	Reset(Marker{ 0, 0, 0 });
+}
+
+inline size_t Math::Arena::GetUsedBytes() const
+{
+	return usedBytes;
+}
+
+inline const Math::AllocationStats& Math::Arena::GetStats() const
+{
+	return stats;
+}
+
+inline void Math::Arena::ResetStats()
+{
+	stats = AllocationStats{ 0, usedBytes, 0 };
+}
+
+inline Math::Arena& Math::GetThreadArena()
+{
+	thread_local Arena arena;
+	return arena;
+}
+
+inline Math::ArenaScope::ArenaScope(Arena& arena, const char* operation) :
+	arena(arena),
+	marker(arena.GetMarker()),
+	outerStats(arena.GetStats()),
+	operation(operation)
+{
+	arena.ResetStats();
+}
+
+inline Math::ArenaScope::~ArenaScope()
+{
+	const AllocationStats& innerStats = arena.GetStats();
+	const AllocationHook hook = detail::Memory::allocationHook.load(std::memory_order_relaxed);
+	if (operation != nullptr && hook != nullptr)
+		hook(operation, AllocationStats{ innerStats.allocationCount, innerStats.peakBytes - marker.usedBytes, innerStats.reservedBytes });
+
+	arena.stats = AllocationStats
+	{
+		outerStats.allocationCount + innerStats.allocationCount,
+		std::max(outerStats.peakBytes, innerStats.peakBytes),
+		outerStats.reservedBytes + innerStats.reservedBytes
+	};
+	arena.Reset(marker);
+}
+
+inline Math::Pool::Pool(size_t elementSize, size_t elementsPerChunk) :
+	elementSize(detail::Memory::AlignUp(std::max(elementSize, sizeof(FreeElement)))),
+	elementsPerChunk(std::max<size_t>(elementsPerChunk, 1)) {}
+
+inline Math::Pool::~Pool()
+{
+	for (std::byte* chunk : chunks)
+		detail::Memory::Release(chunk);
+}
+
+inline void* Math::Pool::Allocate()
+{
+	if (freeList == nullptr)
+	{
+		const size_t chunkSize = elementSize * elementsPerChunk;
+		std::byte* const chunk = detail::Memory::Reserve(chunkSize);
+		chunks.push_back(chunk);
+		stats.reservedBytes += chunkSize;
+		// Linked in address order, so that fresh elements are handed out front to back.
+		for (size_t i = elementsPerChunk; i > 0; i--)
+			freeList = new (chunk + (i - 1) * elementSize) FreeElement{ freeList };
+	}
+
+	FreeElement* const element = freeList;
+	freeList = element->next;
+	usedBytes += elementSize;
+	stats.allocationCount++;
+	stats.peakBytes = std::max(stats.peakBytes, usedBytes);
+	return element;
+}
+
+inline void Math::Pool::Deallocate(void* element)
+{
+	assert(element != nullptr && usedBytes >= elementSize);
+	freeList = new (element) FreeElement{ freeList };
+	usedBytes -= elementSize;
+}
+
+inline size_t Math::Pool::GetElementSize() const
+{
+	return elementSize;
+}
+
+inline const Math::AllocationStats& Math::Pool::GetStats() const
+{
+	return stats;
+}
+
+inline void Math::Pool::ResetStats()
+{
+	stats = AllocationStats{ 0, usedBytes, 0 };
+}
\ No newline at end of file
@@ -0,0 +1,338 @@
+#pragma once
+
+#include "Vector/Vector.hpp"
+#include "BoundingVolume.hpp"
+#include "RadixSort.hpp"
+#include "Memory.hpp"
+#include "Span.hpp"
+#include "Simd.hpp"
+#include "Parallel.hpp"
+#include "Execution.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace Math
+{
+	// Z-order curve codes. Bit i of x lands in bit 3i of the code, y in 3i + 1 and z in 3i + 2.
+
+	// Interleaves the low 10 bits of each coordinate.
+	[[nodiscard]] inline uint32_t MortonEncode30(uint32_t x, uint32_t y, uint32_t z);
+	[[nodiscard]] inline Vector<3, uint32_t> MortonDecode30(uint32_t code);
+
+	// Interleaves the low 21 bits of each coordinate.
+	[[nodiscard]] inline uint64_t MortonEncode63(uint32_t x, uint32_t y, uint32_t z);
+	[[nodiscard]] inline Vector<3, uint32_t> MortonDecode63(uint64_t code);
+
+	// Quantizes the point to a 1024^3 grid spanning the bounds, then encodes it. Points outside the bounds are clamped.
+	template<typename T>
+	[[nodiscard]] uint32_t GetMortonCode30(const Vector<3, T>& point, const AABB3D<T>& bounds);
+	// Quantizes the point to a 2097152^3 grid spanning the bounds, then encodes it. Points outside the bounds are clamped.
+	template<typename T>
+	[[nodiscard]] uint64_t GetMortonCode63(const Vector<3, T>& point, const AABB3D<T>& bounds);
+
+	template<typename T>
+	void ComputeMortonCodes30(Span<const Vector<3, T>> points, const AABB3D<T>& bounds, Span<uint32_t> codes);
+	template<typename T>
+	void ComputeMortonCodes30_Parallel(Span<const Vector<3, T>> points, const AABB3D<T>& bounds, Span<uint32_t> codes, size_t grainSize = Setup::defaultParallelGrainSize);
+	template<typename T>
+	void ComputeMortonCodes63(Span<const Vector<3, T>> points, const AABB3D<T>& bounds, Span<uint64_t> codes);
+	template<typename T>
+	void ComputeMortonCodes63_Parallel(Span<const Vector<3, T>> points, const AABB3D<T>& bounds, Span<uint64_t> codes, size_t grainSize = Setup::defaultParallelGrainSize);
+	// std::execution::par and par_unseq run the _Parallel version, other policies the single thread one.
+	template<typename T, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void ComputeMortonCodes30(ExecutionPolicy&& policy, Span<const Vector<3, T>> points, const AABB3D<T>& bounds, Span<uint32_t> codes);
+	template<typename T, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void ComputeMortonCodes63(ExecutionPolicy&& policy, Span<const Vector<3, T>> points, const AABB3D<T>& bounds, Span<uint64_t> codes);
+
+	// Returns the permutation that orders the points along the Z-order curve through their bounds.
+	// Reorder point arrays, and any per-point data, with ApplyPermutation.
+	template<typename T>
+	[[nodiscard]] std::vector<uint32_t> GetMortonOrder(Span<const Vector<3, T>> points);
+	template<typename T>
+	[[nodiscard]] std::vector<uint32_t> GetMortonOrder_Parallel(Span<const Vector<3, T>> points, size_t grainSize = Setup::defaultParallelGrainSize);
+	// Takes the codes and sort buffers from workspace, and reports them to the allocation hook as "GetMortonOrder".
+	template<typename T>
+	[[nodiscard]] std::vector<uint32_t> GetMortonOrder(Span<const Vector<3, T>> points, Arena& workspace);
+	template<typename T>
+	[[nodiscard]] std::vector<uint32_t> GetMortonOrder_Parallel(Span<const Vector<3, T>> points, Arena& workspace, size_t grainSize = Setup::defaultParallelGrainSize);
+	template<typename T, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	[[nodiscard]] std::vector<uint32_t> GetMortonOrder(ExecutionPolicy&& policy, Span<const Vector<3, T>> points);
+
+	namespace detail
+	{
+		namespace Morton
+		{
+			// Spreads the low 10 bits so that two zero bits follow each of them.
+			[[nodiscard]] constexpr uint32_t Spread3_10(uint32_t value)
+			{
+				value &= 0x000003FFu;
+				value = (value | (value << 16)) & 0xFF0000FFu;
+				value = (value | (value << 8)) & 0x0300F00Fu;
+				value = (value | (value << 4)) & 0x030C30C3u;
+				value = (value | (value << 2)) & 0x09249249u;
+				return value;
+			}
+
+			[[nodiscard]] constexpr uint32_t Compact3_10(uint32_t value)
+			{
+				value &= 0x09249249u;
+				value = (value | (value >> 2)) & 0x030C30C3u;
+				value = (value | (value >> 4)) & 0x0300F00Fu;
+				value = (value | (value >> 8)) & 0xFF0000FFu;
+				value = (value | (value >> 16)) & 0x000003FFu;
+				return value;
+			}
+
+			// Spreads the low 21 bits so that two zero bits follow each of them.
+			[[nodiscard]] constexpr uint64_t Spread3_21(uint64_t value)
+			{
+				value &= 0x00000000001FFFFFull;
+				value = (value | (value << 32)) & 0x001F00000000FFFFull;
+				value = (value | (value << 16)) & 0x001F0000FF0000FFull;
+				value = (value | (value << 8)) & 0x100F00F00F00F00Full;
+				value = (value | (value << 4)) & 0x10C30C30C30C30C3ull;
+				value = (value | (value << 2)) & 0x1249249249249249ull;
+				return value;
+			}
+
+			[[nodiscard]] constexpr uint64_t Compact3_21(uint64_t value)
+			{
+				value &= 0x1249249249249249ull;
+				value = (value | (value >> 2)) & 0x10C30C30C30C30C3ull;
+				value = (value | (value >> 4)) & 0x100F00F00F00F00Full;
+				value = (value | (value >> 8)) & 0x001F0000FF0000FFull;
+				value = (value | (value >> 16)) & 0x001F00000000FFFFull;
+				value = (value | (value >> 32)) & 0x00000000001FFFFFull;
+				return value;
+			}
+
+			constexpr uint32_t xMask30 = 0x09249249u;
+			constexpr uint64_t xMask63 = 0x1249249249249249ull;
+
+			// Maps the coordinate onto [0, cellCount - 1]. NaN maps to 0.
+			template<typename T>
+			[[nodiscard]] inline uint32_t Quantize(T value, T min, T scale, uint32_t cellCount)
+			{
+				const T cell = (value - min) * scale;
+				if (!(cell > T(0)))
+					return 0;
+				if (cell >= T(cellCount - 1))
+					return cellCount - 1;
+				return uint32_t(cell);
+			}
+
+			template<typename T>
+			[[nodiscard]] inline Vector<3, T> GetQuantizationScale(const AABB3D<T>& bounds, uint32_t cellCount)
+			{
+				Vector<3, T> scale;
+				for (size_t axis = 0; axis < 3; axis++)
+				{
+					const T extent = bounds.max[axis] - bounds.min[axis];
+					scale[axis] = extent > T(0) ? T(cellCount) / extent : T(0);
+				}
+				return scale;
+			}
+
+			template<typename T, typename Code, typename EncodeFunc>
+			void ComputeCodeRange(Span<const Vector<3, T>> points, const AABB3D<T>& bounds, uint32_t cellCount, Span<Code> codes, size_t begin, size_t end, EncodeFunc encode)
+			{
+				const Vector<3, T> scale = GetQuantizationScale(bounds, cellCount);
+				for (size_t i = begin; i < end; i++)
+				{
+					const auto& point = points[i];
+					codes[i] = encode(
+						Quantize(point.x, bounds.min.x, scale.x, cellCount),
+						Quantize(point.y, bounds.min.y, scale.y, cellCount),
+						Quantize(point.z, bounds.min.z, scale.z, cellCount));
+				}
+			}
+
+			template<typename T>
+			void GetOrder(Span<const Vector<3, T>> points, size_t grainSize, bool parallel, Span<uint64_t> codes, Span<uint32_t> order, Arena* workspace)
+			{
+				const AABB3D<T> bounds = parallel ? ComputeBounds_Parallel<T>(points, grainSize) : ComputeBounds<T>(points);
+				ParallelFor(0, points.size(), parallel ? grainSize : std::max<size_t>(points.size(), 1), [&](size_t begin, size_t end)
+				{
+					ComputeCodeRange(points, bounds, 1u << 21, codes, begin, end, MortonEncode63);
+					for (size_t i = begin; i < end; i++)
+						order[i] = uint32_t(i);
+				});
+				detail::RadixSort::Sort(codes, order, parallel ? grainSize : std::max<size_t>(points.size(), 1), workspace);
+			}
+
+			template<typename T>
+			[[nodiscard]] std::vector<uint32_t> GetOrder(Span<const Vector<3, T>> points, size_t grainSize, bool parallel, Arena* workspace)
+			{
+				assert(points.size() <= std::numeric_limits<uint32_t>::max());
+
+				std::vector<uint32_t> order(points.size());
+				if (workspace != nullptr)
+				{
+					ArenaScope scope(*workspace, "GetMortonOrder");
+					GetOrder(points, grainSize, parallel, workspace->Allocate<uint64_t>(points.size()), Span<uint32_t>(order), workspace);
+				}
+				else
+				{
+					std::vector<uint64_t> codes(points.size());
+					GetOrder(points, grainSize, parallel, Span<uint64_t>(codes), Span<uint32_t>(order), workspace);
+				}
+				return order;
+			}
+		}
+	}
+}
+
+inline uint32_t Math::MortonEncode30(uint32_t x, uint32_t y, uint32_t z)
+{
+	using namespace detail::Morton;
+#if defined( DMATH_SIMD_BMI2 )
+	return _pdep_u32(x, xMask30) | _pdep_u32(y, xMask30 << 1) | _pdep_u32(z, xMask30 << 2);
+#else
+	return Spread3_10(x) | (Spread3_10(y) << 1) | (Spread3_10(z) << 2);
+#endif
+}
+
+inline Math::Vector<3, uint32_t> Math::MortonDecode30(uint32_t code)
+{
+	using namespace detail::Morton;
+#if defined( DMATH_SIMD_BMI2 )
+	return Vector<3, uint32_t>{ _pext_u32(code, xMask30), _pext_u32(code, xMask30 << 1), _pext_u32(code, xMask30 << 2) };
+#else
+	return Vector<3, uint32_t>{ Compact3_10(code), Compact3_10(code >> 1), Compact3_10(code >> 2) };
+#endif
+}
+
+inline uint64_t Math::MortonEncode63(uint32_t x, uint32_t y, uint32_t z)
+{
+	using namespace detail::Morton;
+#if defined( DMATH_SIMD_BMI2 ) && ( defined( _M_X64 ) || defined( __x86_64__ ) )
+	return _pdep_u64(x, xMask63) | _pdep_u64(y, xMask63 << 1) | _pdep_u64(z, xMask63 << 2);
+#else
+	return Spread3_21(x) | (Spread3_21(y) << 1) | (Spread3_21(z) << 2);
+#endif
+}
+
+inline Math::Vector<3, uint32_t> Math::MortonDecode63(uint64_t code)
+{
+	using namespace detail::Morton;
+#if defined( DMATH_SIMD_BMI2 ) && ( defined( _M_X64 ) || defined( __x86_64__ ) )
+	return Vector<3, uint32_t>{ uint32_t(_pext_u64(code, xMask63)), uint32_t(_pext_u64(code, xMask63 << 1)), uint32_t(_pext_u64(code, xMask63 << 2)) };
+#else
+	return Vector<3, uint32_t>{ uint32_t(Compact3_21(code)), uint32_t(Compact3_21(code >> 1)), uint32_t(Compact3_21(code >> 2)) };
+#endif
+}
+
+template<typename T>
+uint32_t Math::GetMortonCode30(const Vector<3, T>& point, const AABB3D<T>& bounds)
+{
+	static_assert(std::is_floating_point_v<T>, "DMath error. Template argument T in Math::GetMortonCode30 must be floating point type.");
+
+	using namespace detail::Morton;
+	constexpr uint32_t cellCount = 1u << 10;
+	const Vector<3, T> scale = GetQuantizationScale(bounds, cellCount);
+	return MortonEncode30(
+		Quantize(point.x, bounds.min.x, scale.x, cellCount),
+		Quantize(point.y, bounds.min.y, scale.y, cellCount),
+		Quantize(point.z, bounds.min.z, scale.z, cellCount));
+}
+
+template<typename T>
+uint64_t Math::GetMortonCode63(const Vector<3, T>& point, const AABB3D<T>& bounds)
+{
+	static_assert(std::is_floating_point_v<T>, "DMath error. Template argument T in Math::GetMortonCode63 must be floating point type.");
+
+	using namespace detail::Morton;
+	constexpr uint32_t cellCount = 1u << 21;
+	const Vector<3, T> scale = GetQuantizationScale(bounds, cellCount);
+	return MortonEncode63(
+		Quantize(point.x, bounds.min.x, scale.x, cellCount),
+		Quantize(point.y, bounds.min.y, scale.y, cellCount),
+		Quantize(point.z, bounds.min.z, scale.z, cellCount));
+}
+
+template<typename T>
+void Math::ComputeMortonCodes30(Span<const Vector<3, T>> points, const AABB3D<T>& bounds, Span<uint32_t> codes)
+{
+	assert(points.size() == codes.size());
+	detail::Morton::ComputeCodeRange(points, bounds, 1u << 10, codes, 0, points.size(), MortonEncode30);
+}
+
+template<typename T>
+void Math::ComputeMortonCodes30_Parallel(Span<const Vector<3, T>> points, const AABB3D<T>& bounds, Span<uint32_t> codes, size_t grainSize)
+{
+	assert(points.size() == codes.size());
+	ParallelFor(0, points.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		detail::Morton::ComputeCodeRange(points, bounds, 1u << 10, codes, begin, end, MortonEncode30);
+	});
+}
+
+template<typename T>
+void Math::ComputeMortonCodes63(Span<const Vector<3, T>> points, const AABB3D<T>& bounds, Span<uint64_t> codes)
+{
+	assert(points.size() == codes.size());
+	detail::Morton::ComputeCodeRange(points, bounds, 1u << 21, codes, 0, points.size(), MortonEncode63);
+}
+
+template<typename T>
+void Math::ComputeMortonCodes63_Parallel(Span<const Vector<3, T>> points, const AABB3D<T>& bounds, Span<uint64_t> codes, size_t grainSize)
+{
+	assert(points.size() == codes.size());
+	ParallelFor(0, points.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		detail::Morton::ComputeCodeRange(points, bounds, 1u << 21, codes, begin, end, MortonEncode63);
+	});
+}
+
+template<typename T, typename ExecutionPolicy, typename>
+void Math::ComputeMortonCodes30(ExecutionPolicy&&, Span<const Vector<3, T>> points, const AABB3D<T>& bounds, Span<uint32_t> codes)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		ComputeMortonCodes30_Parallel<T>(points, bounds, codes);
+	else
+		ComputeMortonCodes30<T>(points, bounds, codes);
+}
+
+template<typename T, typename ExecutionPolicy, typename>
+void Math::ComputeMortonCodes63(ExecutionPolicy&&, Span<const Vector<3, T>> points, const AABB3D<T>& bounds, Span<uint64_t> codes)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		ComputeMortonCodes63_Parallel<T>(points, bounds, codes);
+	else
+		ComputeMortonCodes63<T>(points, bounds, codes);
+}
+
+template<typename T>
+std::vector<uint32_t> Math::GetMortonOrder(Span<const Vector<3, T>> points)
+{
+	return detail::Morton::GetOrder(points, Setup::defaultParallelGrainSize, false, nullptr);
+}
+
+template<typename T>
+std::vector<uint32_t> Math::GetMortonOrder_Parallel(Span<const Vector<3, T>> points, size_t grainSize)
+{
+	return detail::Morton::GetOrder(points, grainSize, true, nullptr);
+}
+
+template<typename T>
+std::vector<uint32_t> Math::GetMortonOrder(Span<const Vector<3, T>> points, Arena& workspace)
+{
+	return detail::Morton::GetOrder(points, Setup::defaultParallelGrainSize, false, &workspace);
+}
+
+template<typename T>
+std::vector<uint32_t> Math::GetMortonOrder_Parallel(Span<const Vector<3, T>> points, Arena& workspace, size_t grainSize)
+{
+	return detail::Morton::GetOrder(points, grainSize, true, &workspace);
+}
+
+template<typename T, typename ExecutionPolicy, typename>
+std::vector<uint32_t> Math::GetMortonOrder(ExecutionPolicy&&, Span<const Vector<3, T>> points)
+{
+	return detail::Morton::GetOrder(points, Setup::defaultParallelGrainSize, detail::Execution::isParallel<ExecutionPolicy>, nullptr);
+}
\ No newline at end of file
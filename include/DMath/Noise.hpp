@@ -0,0 +1,720 @@
+#pragma once
+
+#include "Setup.hpp"
+#include "Enum.hpp"
+#include "Simd.hpp"
+#include "Span.hpp"
+#include "Parallel.hpp"
+#include "Execution.hpp"
+#include "Vector/Vector.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace Math
+{
+	template<typename T = float>
+	struct FractalNoiseSettings
+	{
+		size_t octaveCount = 6;
+		// Frequency of the first octave.
+		T frequency = T(1);
+		// Frequency factor between octaves.
+		T lacunarity = T(2);
+		// Amplitude factor between octaves.
+		T gain = T(0.5);
+	};
+
+	// Gradient noise in roughly [-1, 1], zero at every integer position for Perlin noise.
+	// The lattice repeats every 289 units along each axis (skewed axes for simplex noise).
+	// Scalar and batch versions evaluate the same floating point operations, so their results are identical.
+	// Every multiply-add is written out as one, so the compiler has nothing left to contract differently per path.
+	template<NoiseType type, size_t length, typename T>
+	[[nodiscard]] T Noise(const Vector<length, T>& position);
+	// Also writes the gradient of the noise with respect to position.
+	template<NoiseType type, size_t length, typename T>
+	[[nodiscard]] T Noise(const Vector<length, T>& position, Vector<length, T>& derivative);
+
+	// Fractal Brownian motion, octaves of noise at increasing frequency and decreasing amplitude.
+	// Normalized by the sum of the amplitudes, so it stays in the range of Noise.
+	template<NoiseType type, size_t length, typename T>
+	[[nodiscard]] T FractalNoise(const Vector<length, T>& position, const FractalNoiseSettings<T>& settings);
+	template<NoiseType type, size_t length, typename T>
+	[[nodiscard]] T FractalNoise(const Vector<length, T>& position, const FractalNoiseSettings<T>& settings, Vector<length, T>& derivative);
+
+	// Batch versions over positions in structure of arrays layout, one span per axis: Noise<NoiseType::Simplex>({ x, y, z }, output).
+	// A register of positions at a time.
+	template<NoiseType type, size_t length>
+	void Noise(const Span<const float> (&positions)[length], Span<float> output);
+	template<NoiseType type, size_t length>
+	void Noise(const Span<const float> (&positions)[length], Span<float> output, const Span<float> (&derivatives)[length]);
+	template<NoiseType type, size_t length>
+	void Noise_Parallel(const Span<const float> (&positions)[length], Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	template<NoiseType type, size_t length>
+	void Noise_Parallel(const Span<const float> (&positions)[length], Span<float> output, const Span<float> (&derivatives)[length], size_t grainSize = Setup::defaultParallelGrainSize);
+
+	template<NoiseType type, size_t length>
+	void FractalNoise(const Span<const float> (&positions)[length], const FractalNoiseSettings<float>& settings, Span<float> output);
+	template<NoiseType type, size_t length>
+	void FractalNoise(const Span<const float> (&positions)[length], const FractalNoiseSettings<float>& settings, Span<float> output, const Span<float> (&derivatives)[length]);
+	template<NoiseType type, size_t length>
+	void FractalNoise_Parallel(const Span<const float> (&positions)[length], const FractalNoiseSettings<float>& settings, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	template<NoiseType type, size_t length>
+	void FractalNoise_Parallel(const Span<const float> (&positions)[length], const FractalNoiseSettings<float>& settings, Span<float> output, const Span<float> (&derivatives)[length], size_t grainSize = Setup::defaultParallelGrainSize);
+
+	// std::execution::par and par_unseq run the _Parallel versions, other policies the single thread ones.
+	template<NoiseType type, size_t length, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Noise(ExecutionPolicy&& policy, const Span<const float> (&positions)[length], Span<float> output);
+	template<NoiseType type, size_t length, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Noise(ExecutionPolicy&& policy, const Span<const float> (&positions)[length], Span<float> output, const Span<float> (&derivatives)[length]);
+	template<NoiseType type, size_t length, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void FractalNoise(ExecutionPolicy&& policy, const Span<const float> (&positions)[length], const FractalNoiseSettings<float>& settings, Span<float> output);
+	template<NoiseType type, size_t length, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void FractalNoise(ExecutionPolicy&& policy, const Span<const float> (&positions)[length], const FractalNoiseSettings<float>& settings, Span<float> output, const Span<float> (&derivatives)[length]);
+
+	namespace detail
+	{
+		namespace Noise
+		{
+			// Scalar double precision counterpart of Simd::FloatLanes<1>, for the operations used by the noise kernels.
+			struct DoubleLanes
+			{
+				using Register = double;
+				using Mask = bool;
+
+				static Register Set(double value) { return value; }
+				static Register Add(Register a, Register b) { return a + b; }
+				static Register Sub(Register a, Register b) { return a - b; }
+				static Register Mul(Register a, Register b) { return a * b; }
+				static Register MulAdd(Register a, Register b, Register c)
+				{
+#if defined( DMATH_SIMD_FMA )
+					return std::fma(a, b, c);
+#else
+					return a * b + c;
+#endif
+				}
+				static Register NegMulAdd(Register a, Register b, Register c)
+				{
+#if defined( DMATH_SIMD_FMA )
+					return std::fma(-a, b, c);
+#else
+					return c - a * b;
+#endif
+				}
+				static Register Max(Register a, Register b) { return a > b ? a : b; }
+				static Register Min(Register a, Register b) { return a < b ? a : b; }
+				static Register Floor(Register a) { return std::floor(a); }
+				static Mask Less(Register a, Register b) { return a < b; }
+				static Mask GreaterEqual(Register a, Register b) { return a >= b; }
+				static Mask Equal(Register a, Register b) { return a == b; }
+				static Mask Or(Mask a, Mask b) { return a || b; }
+				static Register Select(Mask mask, Register a, Register b) { return mask ? a : b; }
+			};
+
+			template<typename T>
+			using ScalarLanes = std::conditional_t<std::is_same_v<T, float>, Simd::FloatLanes<1>, DoubleLanes>;
+
+			template<typename L>
+			using ScalarType = std::conditional_t<std::is_same_v<L, DoubleLanes>, double, float>;
+
+			template<typename L>
+			using Register = typename L::Register;
+
+			template<typename L>
+			Register<L> Set(double value)
+			{
+				return L::Set(ScalarType<L>(value));
+			}
+
+			// x mod 289 for integral x below 2^24 in magnitude, in [0, 289).
+			template<typename L>
+			Register<L> Mod289(Register<L> x)
+			{
+				const auto modulus = Set<L>(289.0);
+				// The quotient is off by at most one, the exact remainder is then moved into range.
+				const auto remainder = L::NegMulAdd(L::Floor(L::Mul(x, Set<L>(1.0 / 289.0))), modulus, x);
+				const auto lowered = L::Select(L::GreaterEqual(remainder, modulus), L::Sub(remainder, modulus), remainder);
+				return L::Select(L::Less(lowered, Set<L>(0.0)), L::Add(lowered, modulus), lowered);
+			}
+
+			// Permutation polynomial (34x^2 + x) mod 289 of integral x in [0, 578), exact in floats.
+			// Replaces the usual permutation table, so that hashing needs neither integer lanes nor gathers.
+			template<typename L>
+			Register<L> Permute(Register<L> x)
+			{
+				return Mod289<L>(L::Mul(L::MulAdd(x, Set<L>(34.0), Set<L>(1.0)), x));
+			}
+
+			// Hash of the lattice point (x, y) or (x, y, z), of coordinates in [0, 289] already reduced by Mod289.
+			template<typename L>
+			Register<L> Hash(Register<L> x, Register<L> y)
+			{
+				return Permute<L>(L::Add(Permute<L>(y), x));
+			}
+
+			template<typename L>
+			Register<L> Hash(Register<L> x, Register<L> y, Register<L> z)
+			{
+				return Permute<L>(L::Add(Permute<L>(L::Add(Permute<L>(z), y)), x));
+			}
+
+			// Lowest bits of the integral hash, as 0 or 1.
+			template<typename L>
+			void GetLowBits(Register<L> hash, Register<L>& bit0, Register<L>& bit1)
+			{
+				const auto half = L::Floor(L::Mul(hash, Set<L>(0.5)));
+				bit0 = L::Sub(hash, L::Add(half, half));
+				const auto quarter = L::Floor(L::Mul(hash, Set<L>(0.25)));
+				bit1 = L::Sub(half, L::Add(quarter, quarter));
+			}
+
+			// One of the 8 gradients (+-1, +-2) and (+-2, +-1).
+			template<typename L>
+			void GetGradient(Register<L> hash, Register<L> (&gradient)[2])
+			{
+				const auto h = L::NegMulAdd(L::Floor(L::Mul(hash, Set<L>(1.0 / 8.0))), Set<L>(8.0), hash);
+				Register<L> bit0, bit1;
+				GetLowBits<L>(h, bit0, bit1);
+				const auto u = L::Sub(Set<L>(1.0), L::Add(bit0, bit0));
+				const auto v = L::NegMulAdd(bit1, Set<L>(4.0), Set<L>(2.0));
+				const auto isFirst = L::Less(h, Set<L>(4.0));
+				gradient[0] = L::Select(isFirst, u, v);
+				gradient[1] = L::Select(isFirst, v, u);
+			}
+
+			// One of the 12 cube edge directions of improved Perlin noise, 4 of them twice.
+			template<typename L>
+			void GetGradient(Register<L> hash, Register<L> (&gradient)[3])
+			{
+				const auto h = L::NegMulAdd(L::Floor(L::Mul(hash, Set<L>(1.0 / 16.0))), Set<L>(16.0), hash);
+				Register<L> bit0, bit1;
+				GetLowBits<L>(h, bit0, bit1);
+				const auto zero = Set<L>(0.0);
+				const auto u = L::Sub(Set<L>(1.0), L::Add(bit0, bit0));
+				const auto v = L::Sub(Set<L>(1.0), L::Add(bit1, bit1));
+				// u goes along x below 8 and along y otherwise. v goes along y below 4, along x for 12 and 14, and along z otherwise.
+				const auto isUAlongX = L::Less(h, Set<L>(8.0));
+				const auto isVAlongY = L::Less(h, Set<L>(4.0));
+				const auto isVAlongX = L::Or(L::Equal(h, Set<L>(12.0)), L::Equal(h, Set<L>(14.0)));
+				gradient[0] = L::Add(L::Select(isUAlongX, u, zero), L::Select(isVAlongX, v, zero));
+				gradient[1] = L::Add(L::Select(isUAlongX, zero, u), L::Select(isVAlongY, v, zero));
+				gradient[2] = L::Select(L::Or(isVAlongY, isVAlongX), zero, v);
+			}
+
+			template<typename L, size_t length>
+			Register<L> Dot(const Register<L> (&a)[length], const Register<L> (&b)[length])
+			{
+				auto result = L::Mul(a[0], b[0]);
+				for (size_t i = 1; i < length; i++)
+					result = L::MulAdd(a[i], b[i], result);
+				return result;
+			}
+
+			// Quintic fade 6t^5 - 15t^4 + 10t^3 and its derivative.
+			template<typename L>
+			Register<L> Fade(Register<L> t)
+			{
+				const auto polynomial = L::MulAdd(t, L::MulAdd(t, Set<L>(6.0), Set<L>(-15.0)), Set<L>(10.0));
+				return L::Mul(L::Mul(L::Mul(t, t), t), polynomial);
+			}
+
+			template<typename L>
+			Register<L> GetFadeDerivative(Register<L> t)
+			{
+				const auto polynomial = L::MulAdd(t, L::Sub(t, Set<L>(2.0)), Set<L>(1.0));
+				return L::Mul(L::Mul(L::Mul(t, t), Set<L>(30.0)), polynomial);
+			}
+
+			// Lattice cell of position, reduced for hashing, and the offset from its corner.
+			template<typename L, size_t length>
+			void GetCell(const Register<L> (&position)[length], Register<L> (&cell)[length], Register<L> (&offset)[length])
+			{
+				for (size_t i = 0; i < length; i++)
+				{
+					const auto floor = L::Floor(position[i]);
+					offset[i] = L::Sub(position[i], floor);
+					cell[i] = Mod289<L>(floor);
+				}
+			}
+
+			// Multilinear interpolation of the corner values and gradients, as in Inigo Quilez's analytic derivatives.
+			template<bool hasDerivative, typename L>
+			Register<L> Perlin(const Register<L> (&position)[2], Register<L> (&derivative)[2])
+			{
+				Register<L> cell[2], offset[2];
+				GetCell<L>(position, cell, offset);
+				const auto one = Set<L>(1.0);
+				const Register<L> cellNext[2] = { L::Add(cell[0], one), L::Add(cell[1], one) };
+				const Register<L> offsetNext[2] = { L::Sub(offset[0], one), L::Sub(offset[1], one) };
+
+				Register<L> gradients[4][2];
+				Register<L> values[4];
+				for (size_t corner = 0; corner < 4; corner++)
+				{
+					const size_t cornerX = corner & 1, cornerY = corner >> 1;
+					GetGradient<L>(Hash<L>(cornerX ? cellNext[0] : cell[0], cornerY ? cellNext[1] : cell[1]), gradients[corner]);
+					const Register<L> cornerOffset[2] = { cornerX ? offsetNext[0] : offset[0], cornerY ? offsetNext[1] : offset[1] };
+					values[corner] = Dot<L>(gradients[corner], cornerOffset);
+				}
+
+				const auto u = Fade<L>(offset[0]);
+				const auto v = Fade<L>(offset[1]);
+				const auto k1 = L::Sub(values[1], values[0]);
+				const auto k2 = L::Sub(values[2], values[0]);
+				const auto k3 = L::Sub(L::Sub(values[0], values[1]), L::Sub(values[2], values[3]));
+				const auto uv = L::Mul(u, v);
+				const auto result = L::MulAdd(k3, uv, L::MulAdd(k2, v, L::MulAdd(k1, u, values[0])));
+
+				if constexpr (hasDerivative)
+				{
+					const auto du = GetFadeDerivative<L>(offset[0]);
+					const auto dv = GetFadeDerivative<L>(offset[1]);
+					for (size_t i = 0; i < 2; i++)
+					{
+						const auto g1 = L::Sub(gradients[1][i], gradients[0][i]);
+						const auto g2 = L::Sub(gradients[2][i], gradients[0][i]);
+						const auto g3 = L::Sub(L::Sub(gradients[0][i], gradients[1][i]), L::Sub(gradients[2][i], gradients[3][i]));
+						derivative[i] = L::MulAdd(g3, uv, L::MulAdd(g2, v, L::MulAdd(g1, u, gradients[0][i])));
+					}
+					derivative[0] = L::MulAdd(du, L::MulAdd(k3, v, k1), derivative[0]);
+					derivative[1] = L::MulAdd(dv, L::MulAdd(k3, u, k2), derivative[1]);
+				}
+				return result;
+			}
+
+			template<bool hasDerivative, typename L>
+			Register<L> Perlin(const Register<L> (&position)[3], Register<L> (&derivative)[3])
+			{
+				Register<L> cell[3], offset[3];
+				GetCell<L>(position, cell, offset);
+				const auto one = Set<L>(1.0);
+				const Register<L> cellNext[3] = { L::Add(cell[0], one), L::Add(cell[1], one), L::Add(cell[2], one) };
+				const Register<L> offsetNext[3] = { L::Sub(offset[0], one), L::Sub(offset[1], one), L::Sub(offset[2], one) };
+
+				// Corner index bits are x, y and z.
+				Register<L> gradients[8][3];
+				Register<L> values[8];
+				for (size_t corner = 0; corner < 8; corner++)
+				{
+					const size_t cornerX = corner & 1, cornerY = (corner >> 1) & 1, cornerZ = corner >> 2;
+					GetGradient<L>(Hash<L>(cornerX ? cellNext[0] : cell[0], cornerY ? cellNext[1] : cell[1], cornerZ ? cellNext[2] : cell[2]), gradients[corner]);
+					const Register<L> cornerOffset[3] = { cornerX ? offsetNext[0] : offset[0], cornerY ? offsetNext[1] : offset[1], cornerZ ? offsetNext[2] : offset[2] };
+					values[corner] = Dot<L>(gradients[corner], cornerOffset);
+				}
+
+				// Expanded trilinear interpolation, k0 + k1 u + k2 v + k3 w + k4 uv + k5 vw + k6 wu + k7 uvw.
+				const auto getCoefficients = [](const Register<L> (&c)[8], Register<L> (&k)[8])
+				{
+					k[0] = c[0];
+					k[1] = L::Sub(c[1], c[0]);
+					k[2] = L::Sub(c[2], c[0]);
+					k[3] = L::Sub(c[4], c[0]);
+					k[4] = L::Sub(L::Sub(c[0], c[1]), L::Sub(c[2], c[3]));
+					k[5] = L::Sub(L::Sub(c[0], c[2]), L::Sub(c[4], c[6]));
+					k[6] = L::Sub(L::Sub(c[0], c[1]), L::Sub(c[4], c[5]));
+					k[7] = L::Sub(L::Sub(L::Sub(c[1], c[0]), L::Sub(c[3], c[2])), L::Sub(L::Sub(c[5], c[4]), L::Sub(c[7], c[6])));
+				};
+				const auto u = Fade<L>(offset[0]);
+				const auto v = Fade<L>(offset[1]);
+				const auto w = Fade<L>(offset[2]);
+				const auto uv = L::Mul(u, v);
+				const auto vw = L::Mul(v, w);
+				const auto wu = L::Mul(w, u);
+				const auto uvw = L::Mul(uv, w);
+				const auto interpolate = [&](const Register<L> (&k)[8])
+				{
+					const auto linear = L::MulAdd(k[3], w, L::MulAdd(k[2], v, L::MulAdd(k[1], u, k[0])));
+					return L::MulAdd(k[7], uvw, L::MulAdd(k[6], wu, L::MulAdd(k[5], vw, L::MulAdd(k[4], uv, linear))));
+				};
+				Register<L> k[8];
+				getCoefficients(values, k);
+				const auto result = interpolate(k);
+
+				if constexpr (hasDerivative)
+				{
+					for (size_t i = 0; i < 3; i++)
+					{
+						const Register<L> components[8] = { gradients[0][i], gradients[1][i], gradients[2][i], gradients[3][i], gradients[4][i], gradients[5][i], gradients[6][i], gradients[7][i] };
+						Register<L> g[8];
+						getCoefficients(components, g);
+						derivative[i] = interpolate(g);
+					}
+					const auto du = GetFadeDerivative<L>(offset[0]);
+					const auto dv = GetFadeDerivative<L>(offset[1]);
+					const auto dw = GetFadeDerivative<L>(offset[2]);
+					derivative[0] = L::MulAdd(du, L::MulAdd(k[7], vw, L::MulAdd(k[6], w, L::MulAdd(k[4], v, k[1]))), derivative[0]);
+					derivative[1] = L::MulAdd(dv, L::MulAdd(k[7], wu, L::MulAdd(k[4], u, L::MulAdd(k[5], w, k[2]))), derivative[1]);
+					derivative[2] = L::MulAdd(dw, L::MulAdd(k[7], uv, L::MulAdd(k[5], v, L::MulAdd(k[6], u, k[3]))), derivative[2]);
+				}
+				return result;
+			}
+
+			// Adds the contribution (0.5 - |offset|^2)^4 (gradient . offset) of one simplex corner.
+			template<bool hasDerivative, typename L, size_t length>
+			void AddSimplexCorner(const Register<L> (&gradient)[length], const Register<L> (&offset)[length], Register<L>& result, Register<L> (&derivative)[length])
+			{
+				const auto falloff = L::Max(L::Sub(Set<L>(0.5), Dot<L>(offset, offset)), Set<L>(0.0));
+				const auto falloff2 = L::Mul(falloff, falloff);
+				const auto falloff4 = L::Mul(falloff2, falloff2);
+				const auto value = Dot<L>(gradient, offset);
+				result = L::MulAdd(falloff4, value, result);
+				if constexpr (hasDerivative)
+				{
+					// -8 t^3 (g . d) d + t^4 g
+					const auto scale = L::Mul(L::Mul(falloff2, falloff), L::Mul(value, Set<L>(-8.0)));
+					for (size_t i = 0; i < length; i++)
+						derivative[i] = L::Add(derivative[i], L::MulAdd(scale, offset[i], L::Mul(falloff4, gradient[i])));
+				}
+			}
+
+			template<bool hasDerivative, typename L>
+			Register<L> Simplex(const Register<L> (&position)[2], Register<L> (&derivative)[2])
+			{
+				const double skew = 0.36602540378443865;   // (sqrt(3) - 1) / 2
+				const double unskew = 0.21132486540518713; // (3 - sqrt(3)) / 6
+				const auto one = Set<L>(1.0);
+				const auto zero = Set<L>(0.0);
+
+				const auto sum = L::Add(position[0], position[1]);
+				const Register<L> floor[2] = { L::Floor(L::MulAdd(sum, Set<L>(skew), position[0])), L::Floor(L::MulAdd(sum, Set<L>(skew), position[1])) };
+				const auto floorSum = L::Add(floor[0], floor[1]);
+				const Register<L> offset0[2] =
+				{
+					L::Sub(position[0], L::NegMulAdd(floorSum, Set<L>(unskew), floor[0])),
+					L::Sub(position[1], L::NegMulAdd(floorSum, Set<L>(unskew), floor[1]))
+				};
+
+				// The middle corner is a step along the larger offset.
+				const auto isXLarger = L::Less(offset0[1], offset0[0]);
+				const Register<L> step[2] = { L::Select(isXLarger, one, zero), L::Select(isXLarger, zero, one) };
+				const Register<L> offset1[2] = { L::Add(L::Sub(offset0[0], step[0]), Set<L>(unskew)), L::Add(L::Sub(offset0[1], step[1]), Set<L>(unskew)) };
+				const Register<L> offset2[2] = { L::Add(L::Sub(offset0[0], one), Set<L>(2.0 * unskew)), L::Add(L::Sub(offset0[1], one), Set<L>(2.0 * unskew)) };
+
+				const Register<L> cell[2] = { Mod289<L>(floor[0]), Mod289<L>(floor[1]) };
+				Register<L> gradient0[2], gradient1[2], gradient2[2];
+				GetGradient<L>(Hash<L>(cell[0], cell[1]), gradient0);
+				GetGradient<L>(Hash<L>(L::Add(cell[0], step[0]), L::Add(cell[1], step[1])), gradient1);
+				GetGradient<L>(Hash<L>(L::Add(cell[0], one), L::Add(cell[1], one)), gradient2);
+
+				auto result = zero;
+				if constexpr (hasDerivative)
+					derivative[0] = derivative[1] = zero;
+				AddSimplexCorner<hasDerivative, L>(gradient0, offset0, result, derivative);
+				AddSimplexCorner<hasDerivative, L>(gradient1, offset1, result, derivative);
+				AddSimplexCorner<hasDerivative, L>(gradient2, offset2, result, derivative);
+				return result;
+			}
+
+			template<bool hasDerivative, typename L>
+			Register<L> Simplex(const Register<L> (&position)[3], Register<L> (&derivative)[3])
+			{
+				const double skew = 1.0 / 3.0;
+				const double unskew = 1.0 / 6.0;
+				const auto one = Set<L>(1.0);
+				const auto zero = Set<L>(0.0);
+
+				const auto sum = L::Add(L::Add(position[0], position[1]), position[2]);
+				Register<L> floor[3];
+				for (size_t i = 0; i < 3; i++)
+					floor[i] = L::Floor(L::MulAdd(sum, Set<L>(skew), position[i]));
+				const auto floorSum = L::Add(L::Add(floor[0], floor[1]), floor[2]);
+				Register<L> offset0[3];
+				for (size_t i = 0; i < 3; i++)
+					offset0[i] = L::Sub(position[i], L::NegMulAdd(floorSum, Set<L>(unskew), floor[i]));
+
+				// Order of the offsets. The last comparison is strict, so that ties still pick two distinct corners.
+				const Register<L> isGreater[3] =
+				{
+					L::Select(L::GreaterEqual(offset0[0], offset0[1]), one, zero),
+					L::Select(L::GreaterEqual(offset0[1], offset0[2]), one, zero),
+					L::Select(L::Less(offset0[0], offset0[2]), one, zero)
+				};
+				const Register<L> isLess[3] = { L::Sub(one, isGreater[0]), L::Sub(one, isGreater[1]), L::Sub(one, isGreater[2]) };
+				Register<L> step1[3], step2[3], offset1[3], offset2[3], offset3[3];
+				for (size_t i = 0; i < 3; i++)
+				{
+					step1[i] = L::Min(isGreater[i], isLess[(i + 2) % 3]);
+					step2[i] = L::Max(isGreater[i], isLess[(i + 2) % 3]);
+					offset1[i] = L::Add(L::Sub(offset0[i], step1[i]), Set<L>(unskew));
+					offset2[i] = L::Add(L::Sub(offset0[i], step2[i]), Set<L>(2.0 * unskew));
+					offset3[i] = L::Add(L::Sub(offset0[i], one), Set<L>(3.0 * unskew));
+				}
+
+				const Register<L> cell[3] = { Mod289<L>(floor[0]), Mod289<L>(floor[1]), Mod289<L>(floor[2]) };
+				Register<L> gradient0[3], gradient1[3], gradient2[3], gradient3[3];
+				GetGradient<L>(Hash<L>(cell[0], cell[1], cell[2]), gradient0);
+				GetGradient<L>(Hash<L>(L::Add(cell[0], step1[0]), L::Add(cell[1], step1[1]), L::Add(cell[2], step1[2])), gradient1);
+				GetGradient<L>(Hash<L>(L::Add(cell[0], step2[0]), L::Add(cell[1], step2[1]), L::Add(cell[2], step2[2])), gradient2);
+				GetGradient<L>(Hash<L>(L::Add(cell[0], one), L::Add(cell[1], one), L::Add(cell[2], one)), gradient3);
+
+				auto result = zero;
+				if constexpr (hasDerivative)
+					derivative[0] = derivative[1] = derivative[2] = zero;
+				AddSimplexCorner<hasDerivative, L>(gradient0, offset0, result, derivative);
+				AddSimplexCorner<hasDerivative, L>(gradient1, offset1, result, derivative);
+				AddSimplexCorner<hasDerivative, L>(gradient2, offset2, result, derivative);
+				AddSimplexCorner<hasDerivative, L>(gradient3, offset3, result, derivative);
+				return result;
+			}
+
+			// Brings the raw noise to roughly [-1, 1].
+			template<NoiseType type, size_t length>
+			constexpr double scale = type == NoiseType::Perlin ? (length == 2 ? 0.66 : 1.0) : (length == 2 ? 45.0 : 76.0);
+
+			template<NoiseType type, bool hasDerivative, typename L, size_t length>
+			Register<L> Evaluate(const Register<L> (&position)[length], Register<L> (&derivative)[length])
+			{
+				static_assert(length == 2 || length == 3, "DMath error. Math::Noise is only defined for 2 and 3 dimensions.");
+
+				Register<L> result;
+				if constexpr (type == NoiseType::Perlin)
+					result = Perlin<hasDerivative, L>(position, derivative);
+				else
+					result = Simplex<hasDerivative, L>(position, derivative);
+
+				const auto scaleValue = Set<L>(scale<type, length>);
+				if constexpr (hasDerivative)
+				{
+					for (size_t i = 0; i < length; i++)
+						derivative[i] = L::Mul(derivative[i], scaleValue);
+				}
+				return L::Mul(result, scaleValue);
+			}
+
+			template<NoiseType type, bool hasDerivative, typename L, size_t length, typename T>
+			Register<L> EvaluateFractal(const Register<L> (&position)[length], const FractalNoiseSettings<T>& settings, Register<L> (&derivative)[length])
+			{
+				assert(settings.octaveCount > 0);
+
+				// Octave frequencies and amplitudes are scalars, identical on every path.
+				auto result = Set<L>(0.0);
+				if constexpr (hasDerivative)
+				{
+					for (size_t i = 0; i < length; i++)
+						derivative[i] = result;
+				}
+				T frequency = settings.frequency;
+				T amplitude = T(1);
+				T amplitudeSum = T(0);
+				for (size_t octave = 0; octave < settings.octaveCount; octave++)
+				{
+					const auto frequencyValue = Set<L>(frequency);
+					const auto amplitudeValue = Set<L>(amplitude);
+					Register<L> octavePosition[length], octaveDerivative[length];
+					for (size_t i = 0; i < length; i++)
+						octavePosition[i] = L::Mul(position[i], frequencyValue);
+					result = L::MulAdd(Evaluate<type, hasDerivative, L>(octavePosition, octaveDerivative), amplitudeValue, result);
+					if constexpr (hasDerivative)
+					{
+						const auto derivativeScale = Set<L>(amplitude * frequency);
+						for (size_t i = 0; i < length; i++)
+							derivative[i] = L::MulAdd(octaveDerivative[i], derivativeScale, derivative[i]);
+					}
+					amplitudeSum += amplitude;
+					frequency *= settings.lacunarity;
+					amplitude *= settings.gain;
+				}
+
+				const auto normalization = Set<L>(T(1) / amplitudeSum);
+				if constexpr (hasDerivative)
+				{
+					for (size_t i = 0; i < length; i++)
+						derivative[i] = L::Mul(derivative[i], normalization);
+				}
+				return L::Mul(result, normalization);
+			}
+
+			template<NoiseType type, bool hasDerivative, size_t length, typename T>
+			T EvaluateScalar(const Math::Vector<length, T>& position, const FractalNoiseSettings<T>* settings, Math::Vector<length, T>* derivative)
+			{
+				static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "DMath error. Math::Noise must be of type float or double.");
+
+				using L = ScalarLanes<T>;
+				T positionValues[length];
+				T derivativeValues[length];
+				for (size_t i = 0; i < length; i++)
+					positionValues[i] = position[i];
+				const T result = settings != nullptr
+					? EvaluateFractal<type, hasDerivative, L>(positionValues, *settings, derivativeValues)
+					: Evaluate<type, hasDerivative, L>(positionValues, derivativeValues);
+				if constexpr (hasDerivative)
+				{
+					for (size_t i = 0; i < length; i++)
+						(*derivative)[i] = derivativeValues[i];
+				}
+				return result;
+			}
+
+			template<NoiseType type, bool hasDerivative, size_t length>
+			void EvaluateRange(const float* const (&positions)[length], const FractalNoiseSettings<float>* settings, float* output, float* const (&derivatives)[length], size_t begin, size_t end)
+			{
+				const auto evaluate = [&](auto lanes, size_t i)
+				{
+					using L = decltype(lanes);
+					Register<L> position[length], derivative[length];
+					for (size_t axis = 0; axis < length; axis++)
+						position[axis] = L::LoadUnaligned(positions[axis] + i);
+					const auto result = settings != nullptr
+						? EvaluateFractal<type, hasDerivative, L>(position, *settings, derivative)
+						: Evaluate<type, hasDerivative, L>(position, derivative);
+					L::StoreUnaligned(output + i, result);
+					if constexpr (hasDerivative)
+					{
+						for (size_t axis = 0; axis < length; axis++)
+							L::StoreUnaligned(derivatives[axis] + i, derivative[axis]);
+					}
+				};
+
+				constexpr size_t laneCount = Simd::floatLaneCount;
+				size_t i = begin;
+				if constexpr (laneCount > 1)
+				{
+					for (; i + laneCount <= end; i += laneCount)
+						evaluate(Simd::FloatLanes<laneCount>(), i);
+				}
+				for (; i < end; i++)
+					evaluate(Simd::FloatLanes<1>(), i);
+			}
+
+			template<NoiseType type, size_t length>
+			void EvaluateBatch(const Span<const float> (&positions)[length], const FractalNoiseSettings<float>* settings, Span<float> output, const Span<float>* derivatives, size_t grainSize, bool isParallel)
+			{
+				const float* positionData[length];
+				float* derivativeData[length] = {};
+				for (size_t i = 0; i < length; i++)
+				{
+					assert(positions[i].size() == output.size());
+					positionData[i] = positions[i].data();
+					if (derivatives != nullptr)
+					{
+						assert(derivatives[i].size() == output.size());
+						derivativeData[i] = derivatives[i].data();
+					}
+				}
+
+				const auto evaluateRange = [&](size_t begin, size_t end)
+				{
+					if (derivatives != nullptr)
+						EvaluateRange<type, true, length>(positionData, settings, output.data(), derivativeData, begin, end);
+					else
+						EvaluateRange<type, false, length>(positionData, settings, output.data(), derivativeData, begin, end);
+				};
+				if (isParallel)
+					ParallelFor(0, output.size(), grainSize, evaluateRange);
+				else
+					evaluateRange(0, output.size());
+			}
+		}
+	}
+}
+
+template<Math::NoiseType type, size_t length, typename T>
+T Math::Noise(const Vector<length, T>& position)
+{
+	return detail::Noise::EvaluateScalar<type, false, length, T>(position, nullptr, nullptr);
+}
+
+template<Math::NoiseType type, size_t length, typename T>
+T Math::Noise(const Vector<length, T>& position, Vector<length, T>& derivative)
+{
+	return detail::Noise::EvaluateScalar<type, true, length, T>(position, nullptr, &derivative);
+}
+
+template<Math::NoiseType type, size_t length, typename T>
+T Math::FractalNoise(const Vector<length, T>& position, const FractalNoiseSettings<T>& settings)
+{
+	return detail::Noise::EvaluateScalar<type, false, length, T>(position, &settings, nullptr);
+}
+
+template<Math::NoiseType type, size_t length, typename T>
+T Math::FractalNoise(const Vector<length, T>& position, const FractalNoiseSettings<T>& settings, Vector<length, T>& derivative)
+{
+	return detail::Noise::EvaluateScalar<type, true, length, T>(position, &settings, &derivative);
+}
+
+template<Math::NoiseType type, size_t length>
+void Math::Noise(const Span<const float> (&positions)[length], Span<float> output)
+{
+	detail::Noise::EvaluateBatch<type>(positions, nullptr, output, nullptr, 0, false);
+}
+
+template<Math::NoiseType type, size_t length>
+void Math::Noise(const Span<const float> (&positions)[length], Span<float> output, const Span<float> (&derivatives)[length])
+{
+	detail::Noise::EvaluateBatch<type>(positions, nullptr, output, derivatives, 0, false);
+}
+
+template<Math::NoiseType type, size_t length>
+void Math::Noise_Parallel(const Span<const float> (&positions)[length], Span<float> output, size_t grainSize)
+{
+	detail::Noise::EvaluateBatch<type>(positions, nullptr, output, nullptr, grainSize, true);
+}
+
+template<Math::NoiseType type, size_t length>
+void Math::Noise_Parallel(const Span<const float> (&positions)[length], Span<float> output, const Span<float> (&derivatives)[length], size_t grainSize)
+{
+	detail::Noise::EvaluateBatch<type>(positions, nullptr, output, derivatives, grainSize, true);
+}
+
+template<Math::NoiseType type, size_t length>
+void Math::FractalNoise(const Span<const float> (&positions)[length], const FractalNoiseSettings<float>& settings, Span<float> output)
+{
+	detail::Noise::EvaluateBatch<type>(positions, &settings, output, nullptr, 0, false);
+}
+
+template<Math::NoiseType type, size_t length>
+void Math::FractalNoise(const Span<const float> (&positions)[length], const FractalNoiseSettings<float>& settings, Span<float> output, const Span<float> (&derivatives)[length])
+{
+	detail::Noise::EvaluateBatch<type>(positions, &settings, output, derivatives, 0, false);
+}
+
+template<Math::NoiseType type, size_t length>
+void Math::FractalNoise_Parallel(const Span<const float> (&positions)[length], const FractalNoiseSettings<float>& settings, Span<float> output, size_t grainSize)
+{
+	detail::Noise::EvaluateBatch<type>(positions, &settings, output, nullptr, grainSize, true);
+}
+
+template<Math::NoiseType type, size_t length>
+void Math::FractalNoise_Parallel(const Span<const float> (&positions)[length], const FractalNoiseSettings<float>& settings, Span<float> output, const Span<float> (&derivatives)[length], size_t grainSize)
+{
+	detail::Noise::EvaluateBatch<type>(positions, &settings, output, derivatives, grainSize, true);
+}
+
+template<Math::NoiseType type, size_t length, typename ExecutionPolicy, typename>
+void Math::Noise(ExecutionPolicy&&, const Span<const float> (&positions)[length], Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Noise_Parallel<type>(positions, output);
+	else
+		Noise<type>(positions, output);
+}
+
+template<Math::NoiseType type, size_t length, typename ExecutionPolicy, typename>
+void Math::Noise(ExecutionPolicy&&, const Span<const float> (&positions)[length], Span<float> output, const Span<float> (&derivatives)[length])
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Noise_Parallel<type>(positions, output, derivatives);
+	else
+		Noise<type>(positions, output, derivatives);
+}
+
+template<Math::NoiseType type, size_t length, typename ExecutionPolicy, typename>
+void Math::FractalNoise(ExecutionPolicy&&, const Span<const float> (&positions)[length], const FractalNoiseSettings<float>& settings, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		FractalNoise_Parallel<type>(positions, settings, output);
+	else
+		FractalNoise<type>(positions, settings, output);
+}
+
+template<Math::NoiseType type, size_t length, typename ExecutionPolicy, typename>
+void Math::FractalNoise(ExecutionPolicy&&, const Span<const float> (&positions)[length], const FractalNoiseSettings<float>& settings, Span<float> output, const Span<float> (&derivatives)[length])
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		FractalNoise_Parallel<type>(positions, settings, output, derivatives);
+	else
+		FractalNoise<type>(positions, settings, output, derivatives);
+}
\ No newline at end of file
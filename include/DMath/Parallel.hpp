@@ -0,0 +1,343 @@
+#pragma once
+
+#include "Instrumentation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#	include <emmintrin.h>
+#endif
+
+namespace Math
+{
+	namespace Setup
+	{
+		// Ranges smaller than this many elements are never split across threads.
+		constexpr size_t defaultParallelGrainSize = 16384;
+		// Times an idle ThreadPool worker checks for new work before it goes to sleep.
+		constexpr size_t threadPoolSpinCount = 4096;
+	}
+
+	// Runs the jobs of ParallelFor. Implement it to run DMath's parallel operations on another job system, see SetParallelExecutor.
+	class ParallelExecutor
+	{
+	public:
+		using Job = void(*)(void* context, size_t index);
+
+		virtual ~ParallelExecutor() = default;
+
+		// Number of threads that may run jobs, the calling thread included.
+		[[nodiscard]] virtual size_t GetThreadCount() const = 0;
+		// Calls job(context, index) once for every index in [0, count), in any order and on any thread, and returns once all calls have returned.
+		// Jobs may call Run again, and must not throw.
+		virtual void Run(size_t count, Job job, void* context) = 0;
+	};
+
+	// Work stealing executor with a fixed set of worker threads.
+	// Each Run splits the indices evenly between the threads, and threads that run out take half of the largest remaining range they find.
+	// One Run is in flight at a time, a Run issued while another is in flight, from a job or another thread, runs on its calling thread.
+	class ThreadPool : public ParallelExecutor
+	{
+	public:
+		// Starts threadCount - 1 workers, the thread calling Run is the last one.
+		explicit ThreadPool(size_t threadCount);
+		~ThreadPool() override;
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		[[nodiscard]] size_t GetThreadCount() const override;
+		void Run(size_t count, Job job, void* context) override;
+
+	private:
+		// Remaining indices of one thread, begin in the high and end in the low 32 bits.
+		struct alignas(64) Range
+		{
+			std::atomic<uint64_t> bounds{ 0 };
+		};
+
+		std::vector<std::thread> workers;
+		std::vector<Range> ranges;
+
+		std::atomic<bool> isBusy{ false };
+		std::atomic<bool> isRunning{ false };
+		std::atomic<bool> isStopping{ false };
+		std::atomic<uint64_t> generation{ 0 };
+		std::atomic<size_t> remainingCount{ 0 };
+		std::atomic<size_t> activeWorkerCount{ 0 };
+		std::atomic<size_t> sleepingWorkerCount{ 0 };
+		std::mutex wakeMutex;
+		std::condition_variable wakeCondition;
+
+		Job job = nullptr;
+		void* context = nullptr;
+
+		void RunWorker(size_t rangeIndex);
+		void Work(size_t rangeIndex);
+		[[nodiscard]] bool Pop(size_t rangeIndex, size_t& index);
+		[[nodiscard]] bool Steal(size_t rangeIndex);
+	};
+
+	// Makes ParallelFor, and every _Parallel operation, run on executor. nullptr restores the built-in ThreadPool.
+	// executor must outlive its use, and must not be changed while parallel operations run.
+	void SetParallelExecutor(ParallelExecutor* executor);
+	// The executor set with SetParallelExecutor, or a ThreadPool with a thread per hardware thread, started on first use.
+	[[nodiscard]] ParallelExecutor& GetParallelExecutor();
+
+	// Returns the number of threads ParallelFor may use, including the calling thread.
+	[[nodiscard]] inline size_t GetParallelThreadCount();
+
+	// Splits [begin, end) into chunks of grainSize elements and calls func(chunkBegin, chunkEnd) for each of them.
+	// The calling thread participates. Returns once every chunk has been processed.
+	template<typename Func>
+	void ParallelFor(size_t begin, size_t end, size_t grainSize, Func&& func);
+
+	namespace detail
+	{
+		namespace Parallel
+		{
+			inline std::atomic<ParallelExecutor*> executor{ nullptr };
+
+			inline void Pause()
+			{
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+				_mm_pause();
+#else
+				std::this_thread::yield();
+#endif
+			}
+
+			[[nodiscard]] constexpr uint64_t PackRange(size_t begin, size_t end)
+			{
+				return (uint64_t(begin) << 32) | uint64_t(end);
+			}
+
+			[[nodiscard]] inline ThreadPool& GetDefaultThreadPool()
+			{
+				static ThreadPool threadPool([]()
+				{
+					const size_t hardwareCount = std::thread::hardware_concurrency();
+					return hardwareCount == 0 ? 1 : hardwareCount;
+				}());
+				return threadPool;
+			}
+		}
+	}
+}
+
+inline Math::ThreadPool::ThreadPool(size_t threadCount) :
+	ranges(std::max<size_t>(threadCount, 1))
+{
+	workers.reserve(ranges.size() - 1);
+	for (size_t i = 1; i < ranges.size(); i++)
+		workers.emplace_back([this, i]() { RunWorker(i); });
+}
+
+inline Math::ThreadPool::~ThreadPool()
+{
+	isStopping.store(true);
+	generation.fetch_add(1);
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+		wakeCondition.notify_all();
+	}
+	for (auto& worker : workers)
+		worker.join();
+}
+
+inline size_t Math::ThreadPool::GetThreadCount() const
+{
+	return ranges.size();
+}
+
+inline void Math::ThreadPool::Run(size_t count, Job job, void* context)
+{
+	assert(count <= UINT32_MAX);
+	if (count == 0)
+		return;
+	if (count == 1 || ranges.size() == 1 || isBusy.exchange(true, std::memory_order_acquire))
+	{
+		for (size_t i = 0; i < count; i++)
+			job(context, i);
+		return;
+	}
+
+	this->job = job;
+	this->context = context;
+	remainingCount.store(count, std::memory_order_relaxed);
+	for (size_t i = 0; i < ranges.size(); i++)
+		ranges[i].bounds.store(detail::Parallel::PackRange(count * i / ranges.size(), count * (i + 1) / ranges.size()), std::memory_order_relaxed);
+
+	// Workers register as active before they look at isRunning, so once the run is over and none are active none can start on it.
+	isRunning.store(true);
+	generation.fetch_add(1);
+	if (sleepingWorkerCount.load() > 0)
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+		wakeCondition.notify_all();
+	}
+
+	Work(0);
+	while (remainingCount.load(std::memory_order_acquire) > 0)
+		detail::Parallel::Pause();
+	isRunning.store(false);
+	while (activeWorkerCount.load() > 0)
+		detail::Parallel::Pause();
+	isBusy.store(false, std::memory_order_release);
+}
+
+inline void Math::ThreadPool::RunWorker(size_t rangeIndex)
+{
+	uint64_t seenGeneration = 0;
+	for (;;)
+	{
+		uint64_t currentGeneration = generation.load(std::memory_order_acquire);
+		for (size_t spin = 0; currentGeneration == seenGeneration && spin < Setup::threadPoolSpinCount; spin++)
+		{
+			detail::Parallel::Pause();
+			currentGeneration = generation.load(std::memory_order_acquire);
+		}
+		if (currentGeneration == seenGeneration)
+		{
+			std::unique_lock<std::mutex> lock(wakeMutex);
+			sleepingWorkerCount.fetch_add(1);
+			wakeCondition.wait(lock, [&]() { return generation.load() != seenGeneration; });
+			sleepingWorkerCount.fetch_sub(1);
+			currentGeneration = generation.load();
+		}
+		seenGeneration = currentGeneration;
+
+		if (isStopping.load())
+			return;
+		activeWorkerCount.fetch_add(1);
+		if (isRunning.load())
+			Work(rangeIndex);
+		activeWorkerCount.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+inline void Math::ThreadPool::Work(size_t rangeIndex)
+{
+	for (;;)
+	{
+		size_t index;
+		if (Pop(rangeIndex, index))
+		{
+			job(context, index);
+			remainingCount.fetch_sub(1, std::memory_order_acq_rel);
+		}
+		else if (!Steal(rangeIndex))
+			return;
+	}
+}
+
+inline bool Math::ThreadPool::Pop(size_t rangeIndex, size_t& index)
+{
+	std::atomic<uint64_t>& bounds = ranges[rangeIndex].bounds;
+	uint64_t current = bounds.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		const size_t begin = size_t(current >> 32);
+		const size_t end = size_t(current & UINT32_MAX);
+		if (begin >= end)
+			return false;
+		if (bounds.compare_exchange_weak(current, detail::Parallel::PackRange(begin + 1, end), std::memory_order_relaxed))
+		{
+			index = begin;
+			return true;
+		}
+	}
+}
+
+inline bool Math::ThreadPool::Steal(size_t rangeIndex)
+{
+	// Takes the back half of the largest range, which leaves the owner the part it would reach first.
+	for (;;)
+	{
+		size_t victimIndex = rangeIndex;
+		uint64_t victimBounds = 0;
+		size_t largestSize = 0;
+		for (size_t i = 0; i < ranges.size(); i++)
+		{
+			const uint64_t bounds = ranges[i].bounds.load(std::memory_order_relaxed);
+			const size_t begin = size_t(bounds >> 32);
+			const size_t end = size_t(bounds & UINT32_MAX);
+			if (i != rangeIndex && end > begin && end - begin > largestSize)
+			{
+				victimIndex = i;
+				victimBounds = bounds;
+				largestSize = end - begin;
+			}
+		}
+		if (largestSize == 0)
+			return false;
+
+		const size_t begin = size_t(victimBounds >> 32);
+		const size_t end = size_t(victimBounds & UINT32_MAX);
+		const size_t middle = begin + (end - begin) / 2;
+		if (ranges[victimIndex].bounds.compare_exchange_strong(victimBounds, detail::Parallel::PackRange(begin, middle), std::memory_order_relaxed))
+		{
+			ranges[rangeIndex].bounds.store(detail::Parallel::PackRange(middle, end), std::memory_order_relaxed);
+			return true;
+		}
+	}
+}
+
+inline void Math::SetParallelExecutor(ParallelExecutor* executor)
+{
+	detail::Parallel::executor.store(executor, std::memory_order_release);
+}
+
+inline Math::ParallelExecutor& Math::GetParallelExecutor()
+{
+	ParallelExecutor* const executor = detail::Parallel::executor.load(std::memory_order_acquire);
+	return executor != nullptr ? *executor : detail::Parallel::GetDefaultThreadPool();
+}
+
+inline size_t Math::GetParallelThreadCount()
+{
+	return GetParallelExecutor().GetThreadCount();
+}
+
+template<typename Func>
+void Math::ParallelFor(size_t begin, size_t end, size_t grainSize, Func&& func)
+{
+	assert(grainSize > 0);
+	if (begin >= end)
+		return;
+
+	const size_t chunkCount = (end - begin + grainSize - 1) / grainSize;
+	ParallelExecutor& executor = GetParallelExecutor();
+	if (chunkCount <= 1 || executor.GetThreadCount() <= 1)
+	{
+		func(begin, end);
+		return;
+	}
+
+	struct Context
+	{
+		std::remove_reference_t<Func>& func;
+		size_t begin;
+		size_t end;
+		size_t grainSize;
+		const char* traceName;
+	};
+	const char* const traceName = detail::Instrumentation::GetCurrentTraceName();
+	Context context{ func, begin, end, grainSize, traceName != nullptr ? traceName : "ParallelFor" };
+	executor.Run(chunkCount, [](void* data, size_t chunk)
+	{
+		Context& context = *static_cast<Context*>(data);
+		const size_t chunkBegin = context.begin + chunk * context.grainSize;
+		const size_t chunkEnd = std::min(chunkBegin + context.grainSize, context.end);
+		const TraceScope traceScope(context.traceName, chunkEnd - chunkBegin);
+		context.func(chunkBegin, chunkEnd);
+	}, &context);
+}
\ No newline at end of file
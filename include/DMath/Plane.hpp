@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Common.hpp"
+#include "Vector/Vector.hpp"
+
+#include <type_traits>
+
+namespace Math
+{
+	// Plane in Hessian normal form. Contains every point p where Dot(normal, p) + distance == 0.
+	// Points on the side the normal points towards have positive signed distance.
+	template<typename T = float>
+	struct Plane
+	{
+		using ValueType = T;
+
+		Vector<3, T> normal;
+		T distance;
+
+		[[nodiscard]] static constexpr Plane<T> FromPointNormal(const Vector<3, T>& point, const Vector<3, T>& normal)
+		{
+			return Plane<T>{ normal, -Vector<3, T>::Dot(normal, point) };
+		}
+
+		[[nodiscard]] constexpr T SignedDistance(const Vector<3, T>& point) const
+		{
+			return Vector<3, T>::Dot(normal, point) + distance;
+		}
+
+		[[nodiscard]] Plane<T> GetNormalized() const
+		{
+			static_assert(std::is_floating_point<T>::value, "DMath error. Cannot normalize a plane of integral type.");
+			const T magnitude = normal.Magnitude();
+			return Plane<T>{ Vector<3, T>{ normal.x / magnitude, normal.y / magnitude, normal.z / magnitude }, distance / magnitude };
+		}
+
+		void Normalize()
+		{
+			static_assert(std::is_floating_point<T>::value, "DMath error. Cannot normalize a plane of integral type.");
+			const T magnitude = normal.Magnitude();
+			normal.x /= magnitude;
+			normal.y /= magnitude;
+			normal.z /= magnitude;
+			distance /= magnitude;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "Setup.hpp"
+#include "Simd.hpp"
+#include "Span.hpp"
+#include "Parallel.hpp"
+#include "Execution.hpp"
+#include "Vector/Vector.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace Math
+{
+	namespace detail
+	{
+		namespace Polynomial
+		{
+			// Polynomial coefficients are either arithmetic or Math::Vector, evaluated one component at a time.
+			template<typename T>
+			struct Traits
+			{
+				using ScalarType = T;
+				static constexpr size_t componentCount = 1;
+
+				[[nodiscard]] static constexpr const T& GetComponent(const T& value, size_t) { return value; }
+				[[nodiscard]] static constexpr T& GetComponent(T& value, size_t) { return value; }
+			};
+
+			template<size_t length, typename T>
+			struct Traits<Math::Vector<length, T>>
+			{
+				using ScalarType = T;
+				static constexpr size_t componentCount = length;
+
+				[[nodiscard]] static constexpr const T& GetComponent(const Math::Vector<length, T>& value, size_t index) { return value[index]; }
+				[[nodiscard]] static constexpr T& GetComponent(Math::Vector<length, T>& value, size_t index) { return value[index]; }
+			};
+		}
+	}
+
+	// Polynomial in power basis, coefficients[i] multiplies x^i.
+	// Coefficients are arithmetic, or Math::Vector for polynomial curves in which case the argument is the vector's value type.
+	template<size_t degree, typename T = float>
+	struct Polynomial
+	{
+		using ValueType = T;
+		using ScalarType = typename detail::Polynomial::Traits<T>::ScalarType;
+		static constexpr size_t coefficientCount = degree + 1;
+
+		std::array<T, degree + 1> coefficients;
+
+		// Horner's scheme.
+		[[nodiscard]] constexpr T Evaluate(ScalarType x) const;
+		[[nodiscard]] constexpr T operator()(ScalarType x) const;
+
+		// Batch versions, a register of arguments at a time for float polynomials. Results match the single value Evaluate.
+		void Evaluate(Span<const ScalarType> x, Span<T> output) const;
+		void Evaluate_Parallel(Span<const ScalarType> x, Span<T> output, size_t grainSize = Setup::defaultParallelGrainSize) const;
+		// std::execution::par and par_unseq run Evaluate_Parallel, other policies the single thread Evaluate.
+		template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+		void Evaluate(ExecutionPolicy&& policy, Span<const ScalarType> x, Span<T> output) const;
+
+		[[nodiscard]] constexpr Polynomial<(degree > 0 ? degree - 1 : 0), T> GetDerivative() const;
+
+		// The polynomial through the points (x[i], y[i]) by Newton's divided differences. x must hold degree + 1 distinct values.
+		[[nodiscard]] static constexpr Polynomial<degree, T> Interpolate(Span<const ScalarType> x, Span<const T> y);
+
+		static_assert(std::is_floating_point_v<ScalarType>, "DMath error. Math::Polynomial must be of floating point type.");
+	};
+
+	namespace detail
+	{
+		namespace Polynomial
+		{
+			// Horner's scheme on one component of the coefficients, for a register of arguments.
+			template<typename L, size_t degree, typename T>
+			[[nodiscard]] typename L::Register EvaluateComponent(const Math::Polynomial<degree, T>& polynomial, size_t component, typename L::Register x)
+			{
+				auto result = L::Set(Traits<T>::GetComponent(polynomial.coefficients[degree], component));
+				for (size_t i = degree; i > 0; i--)
+					result = L::Add(L::Mul(result, x), L::Set(Traits<T>::GetComponent(polynomial.coefficients[i - 1], component)));
+				return result;
+			}
+
+			template<size_t degree, typename T>
+			void EvaluateRange(const Math::Polynomial<degree, T>& polynomial, const typename Traits<T>::ScalarType* x, T* output, size_t count)
+			{
+				constexpr size_t laneCount = Simd::floatLaneCount;
+				size_t i = 0;
+				if constexpr (laneCount > 1 && std::is_same_v<typename Traits<T>::ScalarType, float>)
+				{
+					using L = Simd::FloatLanes<laneCount>;
+					constexpr size_t componentCount = Traits<T>::componentCount;
+					alignas(64) float components[componentCount][laneCount];
+					for (; i + laneCount <= count; i += laneCount)
+					{
+						const auto xValues = L::LoadUnaligned(x + i);
+						if constexpr (componentCount == 1)
+							L::StoreUnaligned(output + i, EvaluateComponent<L>(polynomial, 0, xValues));
+						else
+						{
+							for (size_t component = 0; component < componentCount; component++)
+								L::Store(components[component], EvaluateComponent<L>(polynomial, component, xValues));
+							for (size_t lane = 0; lane < laneCount; lane++)
+							{
+								for (size_t component = 0; component < componentCount; component++)
+									Traits<T>::GetComponent(output[i + lane], component) = components[component][lane];
+							}
+						}
+					}
+				}
+
+				for (; i < count; i++)
+					output[i] = polynomial.Evaluate(x[i]);
+			}
+		}
+	}
+}
+
+template<size_t degree, typename T>
+constexpr T Math::Polynomial<degree, T>::Evaluate(ScalarType x) const
+{
+	T result = coefficients[degree];
+	for (size_t i = degree; i > 0; i--)
+		result = result * x + coefficients[i - 1];
+	return result;
+}
+
+template<size_t degree, typename T>
+constexpr T Math::Polynomial<degree, T>::operator()(ScalarType x) const
+{
+	return Evaluate(x);
+}
+
+template<size_t degree, typename T>
+void Math::Polynomial<degree, T>::Evaluate(Span<const ScalarType> x, Span<T> output) const
+{
+	assert(output.size() == x.size());
+
+	detail::Polynomial::EvaluateRange(*this, x.data(), output.data(), x.size());
+}
+
+template<size_t degree, typename T>
+void Math::Polynomial<degree, T>::Evaluate_Parallel(Span<const ScalarType> x, Span<T> output, size_t grainSize) const
+{
+	assert(output.size() == x.size());
+
+	ParallelFor(0, x.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		detail::Polynomial::EvaluateRange(*this, x.data() + begin, output.data() + begin, end - begin);
+	});
+}
+
+template<size_t degree, typename T>
+template<typename ExecutionPolicy, typename>
+void Math::Polynomial<degree, T>::Evaluate(ExecutionPolicy&&, Span<const ScalarType> x, Span<T> output) const
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Evaluate_Parallel(x, output);
+	else
+		Evaluate(x, output);
+}
+
+template<size_t degree, typename T>
+constexpr auto Math::Polynomial<degree, T>::GetDerivative() const -> Polynomial<(degree > 0 ? degree - 1 : 0), T>
+{
+	Polynomial<(degree > 0 ? degree - 1 : 0), T> derivative{};
+	for (size_t i = 1; i <= degree; i++)
+		derivative.coefficients[i - 1] = coefficients[i] * ScalarType(i);
+	return derivative;
+}
+
+template<size_t degree, typename T>
+constexpr Math::Polynomial<degree, T> Math::Polynomial<degree, T>::Interpolate(Span<const ScalarType> x, Span<const T> y)
+{
+	assert(x.size() == degree + 1 && y.size() == degree + 1);
+
+	// Divided differences in place, differences[i] ends up as f[x0, ..., xi].
+	std::array<T, degree + 1> differences{};
+	for (size_t i = 0; i <= degree; i++)
+		differences[i] = y[i];
+	for (size_t order = 1; order <= degree; order++)
+	{
+		for (size_t i = degree; i >= order; i--)
+		{
+			assert(x[i] != x[i - order]);
+			differences[i] = (differences[i] - differences[i - 1]) * (ScalarType(1) / (x[i] - x[i - order]));
+		}
+	}
+
+	// Expands the Newton form from the innermost term, multiplying by (x - x[i]) at every step.
+	Polynomial<degree, T> polynomial{};
+	polynomial.coefficients[0] = differences[degree];
+	for (size_t i = degree; i > 0; i--)
+	{
+		const ScalarType root = x[i - 1];
+		for (size_t power = degree - i + 1; power > 0; power--)
+			polynomial.coefficients[power] = polynomial.coefficients[power - 1] - polynomial.coefficients[power] * root;
+		polynomial.coefficients[0] = differences[i - 1] - polynomial.coefficients[0] * root;
+	}
+	return polynomial;
+}
\ No newline at end of file
@@ -0,0 +1,294 @@
+#pragma once
+
+#include "Span.hpp"
+#include "Memory.hpp"
+#include "Parallel.hpp"
+#include "Execution.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace Math
+{
+	// Stable LSD radix sort of unsigned integer keys, eight bits per pass.
+	// values is reordered along with the keys and may be empty.
+	template<typename Key, typename Value>
+	void RadixSort(Span<Key> keys, Span<Value> values);
+	template<typename Key, typename Value>
+	void RadixSort_Parallel(Span<Key> keys, Span<Value> values, size_t grainSize = Setup::defaultParallelGrainSize);
+
+	template<typename Key>
+	void RadixSort(Span<Key> keys);
+	template<typename Key>
+	void RadixSort_Parallel(Span<Key> keys, size_t grainSize = Setup::defaultParallelGrainSize);
+
+	// Takes the scratch buffers from workspace instead of the heap, and reports them to the allocation hook as "RadixSort".
+	template<typename Key, typename Value>
+	void RadixSort(Span<Key> keys, Span<Value> values, Arena& workspace);
+	template<typename Key, typename Value>
+	void RadixSort_Parallel(Span<Key> keys, Span<Value> values, Arena& workspace, size_t grainSize = Setup::defaultParallelGrainSize);
+
+	template<typename Key>
+	void RadixSort(Span<Key> keys, Arena& workspace);
+	template<typename Key>
+	void RadixSort_Parallel(Span<Key> keys, Arena& workspace, size_t grainSize = Setup::defaultParallelGrainSize);
+
+	// std::execution::par and par_unseq run the _Parallel versions, other policies the single thread ones.
+	template<typename Key, typename Value, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void RadixSort(ExecutionPolicy&& policy, Span<Key> keys, Span<Value> values);
+	template<typename Key, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void RadixSort(ExecutionPolicy&& policy, Span<Key> keys);
+	template<typename Key, typename Value, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void RadixSort(ExecutionPolicy&& policy, Span<Key> keys, Span<Value> values, Arena& workspace);
+	template<typename Key, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void RadixSort(ExecutionPolicy&& policy, Span<Key> keys, Arena& workspace);
+
+	// destination[i] = source[permutation[i]]. destination must not overlap source.
+	template<typename T>
+	void ApplyPermutation(Span<const uint32_t> permutation, Span<const T> source, Span<T> destination);
+	template<typename T>
+	void ApplyPermutation_Parallel(Span<const uint32_t> permutation, Span<const T> source, Span<T> destination, size_t grainSize = Setup::defaultParallelGrainSize);
+	// std::execution::par and par_unseq run ApplyPermutation_Parallel, other policies ApplyPermutation.
+	template<typename T, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void ApplyPermutation(ExecutionPolicy&& policy, Span<const uint32_t> permutation, Span<const T> source, Span<T> destination);
+
+	namespace detail
+	{
+		namespace RadixSort
+		{
+			constexpr size_t digitBitCount = 8;
+			constexpr size_t digitCount = size_t(1) << digitBitCount;
+
+			using Histogram = std::array<size_t, digitCount>;
+
+			template<typename Key>
+			[[nodiscard]] constexpr size_t GetDigit(Key key, size_t pass)
+			{
+				return size_t(key >> (pass * digitBitCount)) & (digitCount - 1);
+			}
+
+			// Sorts in chunks of grainSize elements. Each chunk counts its digits, then scatters them
+			// to offsets that place it after every earlier chunk, which keeps the sort stable.
+			// Passes where every key has the same digit are skipped.
+			template<typename Key, typename Value>
+			void Sort(Span<Key> keys, Span<Value> values, size_t grainSize, Span<Key> keyBuffer, Span<Value> valueBuffer, Span<Histogram> histograms)
+			{
+				const size_t count = keys.size();
+				const bool hasValues = !values.empty();
+				Key* sourceKeys = keys.data();
+				Key* destinationKeys = keyBuffer.data();
+				Value* sourceValues = values.data();
+				Value* destinationValues = valueBuffer.data();
+
+				for (size_t pass = 0; pass < sizeof(Key); pass++)
+				{
+					// ParallelFor may hand several chunks to one call, so chunks are walked explicitly.
+					ParallelFor(0, count, grainSize, [&](size_t begin, size_t end)
+					{
+						for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+						{
+							Histogram& histogram = histograms[chunkBegin / grainSize];
+							histogram.fill(0);
+							for (size_t i = chunkBegin; i < std::min(chunkBegin + grainSize, end); i++)
+								histogram[GetDigit(sourceKeys[i], pass)]++;
+						}
+					});
+
+					// Turns the counts into exclusive offsets, digit major then chunk.
+					size_t offset = 0;
+					bool isTrivial = false;
+					for (size_t digit = 0; digit < digitCount; digit++)
+					{
+						const size_t digitBegin = offset;
+						for (auto& histogram : histograms)
+						{
+							const size_t digitCountInChunk = histogram[digit];
+							histogram[digit] = offset;
+							offset += digitCountInChunk;
+						}
+						if (offset - digitBegin == count)
+						{
+							isTrivial = true;
+							break;
+						}
+					}
+					if (isTrivial)
+						continue;
+
+					ParallelFor(0, count, grainSize, [&](size_t begin, size_t end)
+					{
+						for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+						{
+							Histogram& offsets = histograms[chunkBegin / grainSize];
+							for (size_t i = chunkBegin; i < std::min(chunkBegin + grainSize, end); i++)
+							{
+								const size_t destination = offsets[GetDigit(sourceKeys[i], pass)]++;
+								destinationKeys[destination] = sourceKeys[i];
+								if (hasValues)
+									destinationValues[destination] = sourceValues[i];
+							}
+						}
+					});
+					std::swap(sourceKeys, destinationKeys);
+					std::swap(sourceValues, destinationValues);
+				}
+
+				if (sourceKeys != keys.data())
+				{
+					std::memcpy(keys.data(), sourceKeys, count * sizeof(Key));
+					if (hasValues)
+						std::memcpy(values.data(), sourceValues, count * sizeof(Value));
+				}
+			}
+
+			// Scratch buffers come from workspace when given, otherwise from the heap.
+			template<typename Key, typename Value>
+			void Sort(Span<Key> keys, Span<Value> values, size_t grainSize, Arena* workspace)
+			{
+				static_assert(std::is_integral_v<Key> && std::is_unsigned_v<Key>, "DMath error. Math::RadixSort keys must be of unsigned integral type.");
+				static_assert(std::is_trivially_copyable_v<Value>, "DMath error. Math::RadixSort values must be trivially copyable.");
+				assert(values.empty() || values.size() == keys.size());
+				assert(grainSize > 0);
+
+				const size_t count = keys.size();
+				if (count <= 1)
+					return;
+
+				const size_t valueCount = values.empty() ? 0 : count;
+				const size_t chunkCount = (count + grainSize - 1) / grainSize;
+				if (workspace != nullptr)
+				{
+					ArenaScope scope(*workspace, "RadixSort");
+					Sort(keys, values, grainSize, workspace->Allocate<Key>(count), workspace->Allocate<Value>(valueCount), workspace->Allocate<Histogram>(chunkCount));
+				}
+				else
+				{
+					std::vector<Key> keyBuffer(count);
+					std::vector<Value> valueBuffer(valueCount);
+					std::vector<Histogram> histograms(chunkCount);
+					Sort(keys, values, grainSize, Span<Key>(keyBuffer), Span<Value>(valueBuffer), Span<Histogram>(histograms));
+				}
+			}
+		}
+	}
+}
+
+template<typename Key, typename Value>
+void Math::RadixSort(Span<Key> keys, Span<Value> values)
+{
+	detail::RadixSort::Sort(keys, values, keys.size() == 0 ? 1 : keys.size(), nullptr);
+}
+
+template<typename Key, typename Value>
+void Math::RadixSort_Parallel(Span<Key> keys, Span<Value> values, size_t grainSize)
+{
+	detail::RadixSort::Sort(keys, values, grainSize, nullptr);
+}
+
+template<typename Key>
+void Math::RadixSort(Span<Key> keys)
+{
+	RadixSort(keys, Span<uint32_t>());
+}
+
+template<typename Key>
+void Math::RadixSort_Parallel(Span<Key> keys, size_t grainSize)
+{
+	RadixSort_Parallel(keys, Span<uint32_t>(), grainSize);
+}
+
+template<typename Key, typename Value>
+void Math::RadixSort(Span<Key> keys, Span<Value> values, Arena& workspace)
+{
+	detail::RadixSort::Sort(keys, values, keys.size() == 0 ? 1 : keys.size(), &workspace);
+}
+
+template<typename Key, typename Value>
+void Math::RadixSort_Parallel(Span<Key> keys, Span<Value> values, Arena& workspace, size_t grainSize)
+{
+	detail::RadixSort::Sort(keys, values, grainSize, &workspace);
+}
+
+template<typename Key>
+void Math::RadixSort(Span<Key> keys, Arena& workspace)
+{
+	RadixSort(keys, Span<uint32_t>(), workspace);
+}
+
+template<typename Key>
+void Math::RadixSort_Parallel(Span<Key> keys, Arena& workspace, size_t grainSize)
+{
+	RadixSort_Parallel(keys, Span<uint32_t>(), workspace, grainSize);
+}
+
+template<typename Key, typename Value, typename ExecutionPolicy, typename>
+void Math::RadixSort(ExecutionPolicy&&, Span<Key> keys, Span<Value> values)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		RadixSort_Parallel(keys, values);
+	else
+		RadixSort(keys, values);
+}
+
+template<typename Key, typename ExecutionPolicy, typename>
+void Math::RadixSort(ExecutionPolicy&&, Span<Key> keys)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		RadixSort_Parallel(keys);
+	else
+		RadixSort(keys);
+}
+
+template<typename Key, typename Value, typename ExecutionPolicy, typename>
+void Math::RadixSort(ExecutionPolicy&&, Span<Key> keys, Span<Value> values, Arena& workspace)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		RadixSort_Parallel(keys, values, workspace);
+	else
+		RadixSort(keys, values, workspace);
+}
+
+template<typename Key, typename ExecutionPolicy, typename>
+void Math::RadixSort(ExecutionPolicy&&, Span<Key> keys, Arena& workspace)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		RadixSort_Parallel(keys, workspace);
+	else
+		RadixSort(keys, workspace);
+}
+
+template<typename T>
+void Math::ApplyPermutation(Span<const uint32_t> permutation, Span<const T> source, Span<T> destination)
+{
+	assert(permutation.size() == destination.size());
+
+	for (size_t i = 0; i < permutation.size(); i++)
+		destination[i] = source[permutation[i]];
+}
+
+template<typename T>
+void Math::ApplyPermutation_Parallel(Span<const uint32_t> permutation, Span<const T> source, Span<T> destination, size_t grainSize)
+{
+	assert(permutation.size() == destination.size());
+
+	ParallelFor(0, permutation.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+			destination[i] = source[permutation[i]];
+	});
+}
+
+template<typename T, typename ExecutionPolicy, typename>
+void Math::ApplyPermutation(ExecutionPolicy&&, Span<const uint32_t> permutation, Span<const T> source, Span<T> destination)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		ApplyPermutation_Parallel<T>(permutation, source, destination);
+	else
+		ApplyPermutation<T>(permutation, source, destination);
+}
\ No newline at end of file
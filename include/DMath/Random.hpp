@@ -0,0 +1,415 @@
+#pragma once
+
+#include "Setup.hpp"
+#include "Constant.hpp"
+#include "Simd.hpp"
+#include "Span.hpp"
+#include "ArrayMath.hpp"
+#include "Trigonometric.hpp"
+#include "Vector/Vector.hpp"
+#include "UnitQuaternion.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace Math
+{
+	// xoshiro128+ by Blackman and Vigna, meets the UniformRandomBitGenerator requirements of <random>.
+	// The lowest bits are weak, NextFloat only uses the upper 24.
+	class Xoshiro128Plus
+	{
+	public:
+		using result_type = uint32_t;
+
+		// The state is expanded from seed with SplitMix64.
+		explicit Xoshiro128Plus(uint64_t seed = 0);
+
+		[[nodiscard]] static constexpr result_type min() { return 0; }
+		[[nodiscard]] static constexpr result_type max() { return std::numeric_limits<uint32_t>::max(); }
+		result_type operator()();
+		// Uniform in [0, 1).
+		[[nodiscard]] float NextFloat();
+
+		// Advance by 2^64 and 2^96 steps, the starts of non-overlapping subsequences.
+		void Jump();
+		void LongJump();
+
+	private:
+		uint32_t state[4];
+
+		void Advance(const uint32_t (&polynomial)[4]);
+
+		friend class RandomGenerator;
+	};
+
+	// detail::Simd::blockLength interleaved xoshiro128+ streams, advanced together so that the update vectorizes.
+	// Stream i starts i Jump()s after the seed's state, and each streamIndex a LongJump() further,
+	// so that generators of distinct stream indices, one per thread for example, never overlap.
+	// The sequence depends neither on the instruction set nor on how the requests are split between calls.
+	class RandomGenerator
+	{
+	public:
+		explicit RandomGenerator(uint64_t seed = 0, uint64_t streamIndex = 0);
+
+		void Fill(Span<uint32_t> output);
+		// Uniform in [0, 1).
+		void FillUniform(Span<float> output);
+		// Uniform in [min, max).
+		void FillUniform(Span<float> output, float min, float max);
+		[[nodiscard]] float NextFloat();
+
+	private:
+		static constexpr size_t streamCount = detail::Simd::blockLength;
+
+		alignas(64) uint32_t state[4][streamCount];
+		// Values of the last block not handed out yet.
+		alignas(64) uint32_t buffer[streamCount];
+		size_t bufferIndex = streamCount;
+
+		// Writes blockCount blocks of streamCount values, one from each stream.
+		void Generate(uint32_t* output, size_t blockCount);
+		template<typename Convert>
+		void Fill(Span<float> output, Convert&& convert);
+	};
+
+	// Uniform samplers. Every output element consumes the same amount of random numbers,
+	// and the results match between instruction sets as long as the compiler does not contract floating point operations.
+	// Points on the unit sphere.
+	void SampleUnitSphere(RandomGenerator& generator, Span<Vector<3, float>> output);
+	// Points on the unit hemisphere around +z.
+	void SampleUnitHemisphere(RandomGenerator& generator, Span<Vector<3, float>> output);
+	// Directions on the unit hemisphere around +z with density proportional to z, for cosine weighted Monte Carlo integration.
+	void SampleCosineHemisphere(RandomGenerator& generator, Span<Vector<3, float>> output);
+	// Points inside the unit sphere.
+	void SampleUnitBall(RandomGenerator& generator, Span<Vector<3, float>> output);
+	// Points inside the unit disk.
+	void SampleUnitDisk(RandomGenerator& generator, Span<Vector<2, float>> output);
+	// Rotations uniformly distributed over SO(3), by Shoemake's method.
+	void SampleRotations(RandomGenerator& generator, Span<UnitQuaternion<float>> output);
+
+	namespace detail
+	{
+		namespace Random
+		{
+			[[nodiscard]] inline uint64_t SplitMix64(uint64_t& state)
+			{
+				uint64_t result = (state += 0x9E3779B97F4A7C15ull);
+				result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ull;
+				result = (result ^ (result >> 27)) * 0x94D049BB133111EBull;
+				return result ^ (result >> 31);
+			}
+
+			[[nodiscard]] inline float ToUniformFloat(uint32_t value)
+			{
+				return float(value >> 8) * (1.f / 16777216.f);
+			}
+
+			[[nodiscard]] constexpr uint32_t RotateLeft(uint32_t value, int count)
+			{
+				return (value << count) | (value >> (32 - count));
+			}
+
+			constexpr uint32_t jumpPolynomial[4] = { 0x8764000B, 0xF542D2D3, 0x6FA035C3, 0x77F2DB5B };
+			constexpr uint32_t longJumpPolynomial[4] = { 0xB523952E, 0x0B6F099F, 0xCCF5A0EF, 0x1C580662 };
+
+			// Samplers turn uniforms into points this many at a time, generated together to amortize the generator calls.
+			constexpr size_t sampleBlockLength = 256;
+
+			// Calls kernel(lanes, uniforms, i) for every register of the block, where uniforms holds
+			// uniformCount arrays of random floats in [0, 1), then kernel(FloatLanes<1>, ...) for the rest.
+			template<size_t uniformCount, typename Kernel>
+			void ForEachSample(RandomGenerator& generator, size_t count, Kernel&& kernel)
+			{
+				alignas(64) float uniforms[uniformCount][sampleBlockLength];
+				for (size_t begin = 0; begin < count; begin += sampleBlockLength)
+				{
+					const size_t blockCount = std::min(sampleBlockLength, count - begin);
+					// One array after the other, so that the sequence only depends on the number of elements.
+					for (size_t i = 0; i < uniformCount; i++)
+						generator.FillUniform({ uniforms[i], blockCount });
+
+					constexpr size_t laneCount = Simd::floatLaneCount;
+					size_t i = 0;
+					if constexpr (laneCount > 1)
+					{
+						for (; i + laneCount <= blockCount; i += laneCount)
+							kernel(Simd::FloatLanes<laneCount>(), uniforms, i, begin + i);
+					}
+					for (; i < blockCount; i++)
+						kernel(Simd::FloatLanes<1>(), uniforms, i, begin + i);
+				}
+			}
+
+			// Cosine and sine of 2 pi u, for u in [0, 1).
+			template<typename L>
+			void GetUnitCircle(typename L::Register u, typename L::Register& cos, typename L::Register& sin)
+			{
+				Trigonometric::Evaluate<AngleUnit::Radians, TrigPrecision::Full, L>(L::Mul(u, L::Set(2.f * pi<float>)), sin, cos);
+			}
+
+			template<size_t length, typename L>
+			void Store(Math::Vector<length, float>* output, const typename L::Register (&components)[length])
+			{
+				constexpr size_t laneCount = sizeof(typename L::Register) / sizeof(float);
+				alignas(64) float values[length][laneCount];
+				for (size_t i = 0; i < length; i++)
+					L::Store(values[i], components[i]);
+				for (size_t lane = 0; lane < laneCount; lane++)
+				{
+					for (size_t i = 0; i < length; i++)
+						output[lane][i] = values[i][lane];
+				}
+			}
+
+			// Unit vector of the given z, with azimuth 2 pi u.
+			template<typename L>
+			void GetDirection(typename L::Register z, typename L::Register u, typename L::Register (&direction)[3])
+			{
+				const auto radius = L::Sqrt(L::Max(L::Sub(L::Set(1.f), L::Mul(z, z)), L::Set(0.f)));
+				typename L::Register cos, sin;
+				GetUnitCircle<L>(u, cos, sin);
+				direction[0] = L::Mul(radius, cos);
+				direction[1] = L::Mul(radius, sin);
+				direction[2] = z;
+			}
+		}
+	}
+}
+
+inline Math::Xoshiro128Plus::Xoshiro128Plus(uint64_t seed)
+{
+	for (size_t i = 0; i < 4; i += 2)
+	{
+		const uint64_t value = detail::Random::SplitMix64(seed);
+		state[i] = uint32_t(value);
+		state[i + 1] = uint32_t(value >> 32);
+	}
+}
+
+inline auto Math::Xoshiro128Plus::operator()() -> result_type
+{
+	const uint32_t result = state[0] + state[3];
+	const uint32_t shifted = state[1] << 9;
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+	state[2] ^= shifted;
+	state[3] = detail::Random::RotateLeft(state[3], 11);
+	return result;
+}
+
+inline float Math::Xoshiro128Plus::NextFloat()
+{
+	return detail::Random::ToUniformFloat((*this)());
+}
+
+inline void Math::Xoshiro128Plus::Advance(const uint32_t (&polynomial)[4])
+{
+	uint32_t result[4] = {};
+	for (const uint32_t word : polynomial)
+	{
+		for (int bit = 0; bit < 32; bit++)
+		{
+			if ((word & (uint32_t(1) << bit)) != 0)
+			{
+				for (size_t i = 0; i < 4; i++)
+					result[i] ^= state[i];
+			}
+			(*this)();
+		}
+	}
+	for (size_t i = 0; i < 4; i++)
+		state[i] = result[i];
+}
+
+inline void Math::Xoshiro128Plus::Jump()
+{
+	Advance(detail::Random::jumpPolynomial);
+}
+
+inline void Math::Xoshiro128Plus::LongJump()
+{
+	Advance(detail::Random::longJumpPolynomial);
+}
+
+inline Math::RandomGenerator::RandomGenerator(uint64_t seed, uint64_t streamIndex)
+{
+	Xoshiro128Plus stream(seed);
+	for (uint64_t i = 0; i < streamIndex; i++)
+		stream.LongJump();
+
+	for (size_t lane = 0; lane < streamCount; lane++)
+	{
+		for (size_t i = 0; i < 4; i++)
+			state[i][lane] = stream.state[i];
+		stream.Jump();
+	}
+}
+
+inline void Math::RandomGenerator::Generate(uint32_t* output, size_t blockCount)
+{
+	// Each operation over all streams at once, which compilers turn into vector instructions.
+	for (size_t block = 0; block < blockCount; block++)
+	{
+		uint32_t* const result = output + block * streamCount;
+		uint32_t shifted[streamCount];
+		for (size_t lane = 0; lane < streamCount; lane++)
+		{
+			result[lane] = state[0][lane] + state[3][lane];
+			shifted[lane] = state[1][lane] << 9;
+			state[2][lane] ^= state[0][lane];
+			state[3][lane] ^= state[1][lane];
+			state[1][lane] ^= state[2][lane];
+			state[0][lane] ^= state[3][lane];
+			state[2][lane] ^= shifted[lane];
+			state[3][lane] = detail::Random::RotateLeft(state[3][lane], 11);
+		}
+	}
+}
+
+inline void Math::RandomGenerator::Fill(Span<uint32_t> output)
+{
+	size_t i = 0;
+	for (; i < output.size() && bufferIndex < streamCount; i++)
+		output[i] = buffer[bufferIndex++];
+
+	const size_t blockCount = (output.size() - i) / streamCount;
+	Generate(output.data() + i, blockCount);
+	i += blockCount * streamCount;
+
+	if (i < output.size())
+	{
+		Generate(buffer, 1);
+		bufferIndex = 0;
+		for (; i < output.size(); i++)
+			output[i] = buffer[bufferIndex++];
+	}
+}
+
+template<typename Convert>
+void Math::RandomGenerator::Fill(Span<float> output, Convert&& convert)
+{
+	constexpr size_t chunkLength = 1024;
+	alignas(64) uint32_t values[chunkLength];
+	for (size_t begin = 0; begin < output.size(); begin += chunkLength)
+	{
+		const size_t count = std::min(chunkLength, output.size() - begin);
+		Fill(Span<uint32_t>(values, count));
+		for (size_t i = 0; i < count; i++)
+			output[begin + i] = convert(detail::Random::ToUniformFloat(values[i]));
+	}
+}
+
+inline void Math::RandomGenerator::FillUniform(Span<float> output)
+{
+	Fill(output, [](float value) { return value; });
+}
+
+inline void Math::RandomGenerator::FillUniform(Span<float> output, float min, float max)
+{
+	const float range = max - min;
+	Fill(output, [=](float value) { return value * range + min; });
+}
+
+inline float Math::RandomGenerator::NextFloat()
+{
+	float value;
+	FillUniform(Span<float>(&value, 1));
+	return value;
+}
+
+inline void Math::SampleUnitSphere(RandomGenerator& generator, Span<Vector<3, float>> output)
+{
+	detail::Random::ForEachSample<2>(generator, output.size(), [&](auto lanes, const auto& uniforms, size_t i, size_t outputIndex)
+	{
+		using L = decltype(lanes);
+		// z = 1 - 2u, uniform in (-1, 1] by Archimedes' hat-box theorem.
+		const auto z = L::Sub(L::Set(1.f), L::Mul(L::Load(uniforms[0] + i), L::Set(2.f)));
+		typename L::Register direction[3];
+		detail::Random::GetDirection<L>(z, L::Load(uniforms[1] + i), direction);
+		detail::Random::Store<3, L>(output.data() + outputIndex, direction);
+	});
+}
+
+inline void Math::SampleUnitHemisphere(RandomGenerator& generator, Span<Vector<3, float>> output)
+{
+	detail::Random::ForEachSample<2>(generator, output.size(), [&](auto lanes, const auto& uniforms, size_t i, size_t outputIndex)
+	{
+		using L = decltype(lanes);
+		const auto z = L::Sub(L::Set(1.f), L::Load(uniforms[0] + i));
+		typename L::Register direction[3];
+		detail::Random::GetDirection<L>(z, L::Load(uniforms[1] + i), direction);
+		detail::Random::Store<3, L>(output.data() + outputIndex, direction);
+	});
+}
+
+inline void Math::SampleCosineHemisphere(RandomGenerator& generator, Span<Vector<3, float>> output)
+{
+	detail::Random::ForEachSample<2>(generator, output.size(), [&](auto lanes, const auto& uniforms, size_t i, size_t outputIndex)
+	{
+		using L = decltype(lanes);
+		// Uniform on the disk, projected up onto the hemisphere: z^2 = 1 - r^2 is uniform.
+		const auto z = L::Sqrt(L::Sub(L::Set(1.f), L::Load(uniforms[0] + i)));
+		typename L::Register direction[3];
+		detail::Random::GetDirection<L>(z, L::Load(uniforms[1] + i), direction);
+		detail::Random::Store<3, L>(output.data() + outputIndex, direction);
+	});
+}
+
+inline void Math::SampleUnitBall(RandomGenerator& generator, Span<Vector<3, float>> output)
+{
+	detail::Random::ForEachSample<3>(generator, output.size(), [&](auto lanes, const auto& uniforms, size_t i, size_t outputIndex)
+	{
+		using L = decltype(lanes);
+		const auto one = L::Set(1.f);
+		const auto z = L::Sub(one, L::Mul(L::Load(uniforms[0] + i), L::Set(2.f)));
+		typename L::Register direction[3];
+		detail::Random::GetDirection<L>(z, L::Load(uniforms[1] + i), direction);
+		// Cube root of a uniform in (0, 1], the volume within a radius grows with its cube.
+		const auto radius = detail::ArrayMath::Pow<L>(L::Sub(one, L::Load(uniforms[2] + i)), L::Set(1.f / 3.f));
+		for (auto& component : direction)
+			component = L::Mul(component, radius);
+		detail::Random::Store<3, L>(output.data() + outputIndex, direction);
+	});
+}
+
+inline void Math::SampleUnitDisk(RandomGenerator& generator, Span<Vector<2, float>> output)
+{
+	detail::Random::ForEachSample<2>(generator, output.size(), [&](auto lanes, const auto& uniforms, size_t i, size_t outputIndex)
+	{
+		using L = decltype(lanes);
+		const auto radius = L::Sqrt(L::Load(uniforms[0] + i));
+		typename L::Register point[2];
+		detail::Random::GetUnitCircle<L>(L::Load(uniforms[1] + i), point[0], point[1]);
+		point[0] = L::Mul(point[0], radius);
+		point[1] = L::Mul(point[1], radius);
+		detail::Random::Store<2, L>(output.data() + outputIndex, point);
+	});
+}
+
+inline void Math::SampleRotations(RandomGenerator& generator, Span<UnitQuaternion<float>> output)
+{
+	detail::Random::ForEachSample<3>(generator, output.size(), [&](auto lanes, const auto& uniforms, size_t i, size_t outputIndex)
+	{
+		using L = decltype(lanes);
+		constexpr size_t laneCount = sizeof(typename L::Register) / sizeof(float);
+		const auto u = L::Load(uniforms[0] + i);
+		const auto radius1 = L::Sqrt(L::Sub(L::Set(1.f), u));
+		const auto radius2 = L::Sqrt(u);
+		typename L::Register cos1, sin1, cos2, sin2;
+		detail::Random::GetUnitCircle<L>(L::Load(uniforms[1] + i), cos1, sin1);
+		detail::Random::GetUnitCircle<L>(L::Load(uniforms[2] + i), cos2, sin2);
+
+		alignas(64) float components[4][laneCount];
+		L::Store(components[0], L::Mul(radius2, cos2));
+		L::Store(components[1], L::Mul(radius1, sin1));
+		L::Store(components[2], L::Mul(radius1, cos1));
+		L::Store(components[3], L::Mul(radius2, sin2));
+		for (size_t lane = 0; lane < laneCount; lane++)
+			output[outputIndex + lane] = UnitQuaternion<float>::FromComponents(components[0][lane], components[1][lane], components[2][lane], components[3][lane]);
+	});
+}
\ No newline at end of file
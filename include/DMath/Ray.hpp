@@ -0,0 +1,172 @@
+#pragma once
+
+#include "Common.hpp"
+#include "Vector/Vector.hpp"
+#include "BoundingVolume.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+namespace Math
+{
+	template<typename T = float>
+	struct Ray
+	{
+		using ValueType = T;
+
+		Vector<3, T> origin;
+		Vector<3, T> direction;
+
+		[[nodiscard]] constexpr Vector<3, T> GetPoint(T distance) const
+		{
+			return origin + direction * distance;
+		}
+
+		// Component-wise reciprocal of the direction, as used by the slab test.
+		[[nodiscard]] constexpr Vector<3, T> GetInverseDirection() const
+		{
+			return Vector<3, T>{ T(1) / direction.x, T(1) / direction.y, T(1) / direction.z };
+		}
+
+		static_assert(std::is_floating_point_v<T>, "DMath error. Math::Ray must be of floating point type.");
+	};
+
+	template<typename T = float>
+	struct RayHit
+	{
+		using ValueType = T;
+
+		// Distance along the ray, in units of the ray direction's length.
+		T distance;
+		// Barycentric coordinates of the hit. The hit point is (1 - u - v) * a + u * b + v * c.
+		T u;
+		T v;
+		uint32_t primitiveIndex;
+	};
+
+	template<typename T = float>
+	struct Triangle
+	{
+		using ValueType = T;
+
+		Vector<3, T> a;
+		Vector<3, T> b;
+		Vector<3, T> c;
+
+		[[nodiscard]] constexpr AABB3D<T> GetAABB() const
+		{
+			AABB3D<T> bounds{ a, a };
+			bounds.Merge(b);
+			bounds.Merge(c);
+			return bounds;
+		}
+		[[nodiscard]] constexpr Vector<3, T> GetCentroid() const
+		{
+			return (a + b + c) * (T(1) / T(3));
+		}
+		// Not normalized. The magnitude is twice the triangle's area.
+		[[nodiscard]] constexpr Vector<3, T> GetNormal() const
+		{
+			return Vector<3, T>::Cross(b - a, c - a);
+		}
+
+		// Returns the point on the triangle closest to the given point (Ericson, Real-Time Collision Detection 5.1.5).
+		[[nodiscard]] constexpr Vector<3, T> GetClosestPoint(const Vector<3, T>& point) const
+		{
+			using Vec = Vector<3, T>;
+			const Vec ab = b - a;
+			const Vec ac = c - a;
+			const Vec ap = point - a;
+			const T d1 = Vec::Dot(ab, ap);
+			const T d2 = Vec::Dot(ac, ap);
+			if (d1 <= T(0) && d2 <= T(0))
+				return a;
+
+			const Vec bp = point - b;
+			const T d3 = Vec::Dot(ab, bp);
+			const T d4 = Vec::Dot(ac, bp);
+			if (d3 >= T(0) && d4 <= d3)
+				return b;
+
+			const T vc = d1 * d4 - d3 * d2;
+			if (vc <= T(0) && d1 >= T(0) && d3 <= T(0))
+				return a + ab * (d1 / (d1 - d3));
+
+			const Vec cp = point - c;
+			const T d5 = Vec::Dot(ab, cp);
+			const T d6 = Vec::Dot(ac, cp);
+			if (d6 >= T(0) && d5 <= d6)
+				return c;
+
+			const T vb = d5 * d2 - d1 * d6;
+			if (vb <= T(0) && d2 >= T(0) && d6 <= T(0))
+				return a + ac * (d2 / (d2 - d6));
+
+			const T va = d3 * d6 - d5 * d4;
+			if (va <= T(0) && (d4 - d3) >= T(0) && (d5 - d6) >= T(0))
+				return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+			const T denominator = T(1) / (va + vb + vc);
+			return a + ab * (vb * denominator) + ac * (vc * denominator);
+		}
+
+		static_assert(std::is_floating_point_v<T>, "DMath error. Math::Triangle must be of floating point type.");
+	};
+
+	// Moller-Trumbore ray-triangle intersection. Double sided.
+	// Returns a hit with primitiveIndex set to 0 when the ray hits the triangle within [tMin, tMax].
+	template<typename T>
+	[[nodiscard]] constexpr std::optional<RayHit<T>> IntersectRayTriangle(const Ray<T>& ray, const Triangle<T>& triangle, T tMin = T(0), T tMax = std::numeric_limits<T>::max())
+	{
+		using Vec = Vector<3, T>;
+		const Vec edge1 = triangle.b - triangle.a;
+		const Vec edge2 = triangle.c - triangle.a;
+		const Vec p = Vec::Cross(ray.direction, edge2);
+		const T determinant = Vec::Dot(edge1, p);
+		if (Abs(determinant) < std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon())
+			return {};
+
+		const T inverseDeterminant = T(1) / determinant;
+		const Vec s = ray.origin - triangle.a;
+		const T u = Vec::Dot(s, p) * inverseDeterminant;
+		if (u < T(0) || u > T(1))
+			return {};
+
+		const Vec q = Vec::Cross(s, edge1);
+		const T v = Vec::Dot(ray.direction, q) * inverseDeterminant;
+		if (v < T(0) || u + v > T(1))
+			return {};
+
+		const T distance = Vec::Dot(edge2, q) * inverseDeterminant;
+		if (distance < tMin || distance > tMax)
+			return {};
+
+		return RayHit<T>{ distance, u, v, 0 };
+	}
+
+	// Slab test. Returns the entry distance when the ray overlaps the box within [tMin, tMax].
+	template<typename T>
+	[[nodiscard]] constexpr std::optional<T> IntersectRayAABB(const Ray<T>& ray, const Vector<3, T>& inverseDirection, const AABB3D<T>& box, T tMin = T(0), T tMax = std::numeric_limits<T>::max())
+	{
+		for (size_t i = 0; i < 3; i++)
+		{
+			T t1 = (box.min[i] - ray.origin[i]) * inverseDirection[i];
+			T t2 = (box.max[i] - ray.origin[i]) * inverseDirection[i];
+			if (t1 > t2)
+				std::swap(t1, t2);
+			tMin = t1 > tMin ? t1 : tMin;
+			tMax = t2 < tMax ? t2 : tMax;
+		}
+		if (tMin > tMax)
+			return {};
+		return tMin;
+	}
+
+	template<typename T>
+	[[nodiscard]] constexpr std::optional<T> IntersectRayAABB(const Ray<T>& ray, const AABB3D<T>& box, T tMin = T(0), T tMax = std::numeric_limits<T>::max())
+	{
+		return IntersectRayAABB(ray, ray.GetInverseDirection(), box, tMin, tMax);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,548 @@
+#pragma once
+
+#include "Ray.hpp"
+#include "Simd.hpp"
+#include "Span.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+namespace Math
+{
+	// Structure of arrays holding Width rays, each with its own [tMin, tMax] interval.
+	// Lanes that are not in use have an empty interval and never report a hit.
+	template<size_t Width, typename T = float>
+	struct RayPacket
+	{
+		using ValueType = T;
+		static constexpr size_t width = Width;
+
+		alignas(64) T originX[Width];
+		alignas(64) T originY[Width];
+		alignas(64) T originZ[Width];
+		alignas(64) T directionX[Width];
+		alignas(64) T directionY[Width];
+		alignas(64) T directionZ[Width];
+		alignas(64) T inverseDirectionX[Width];
+		alignas(64) T inverseDirectionY[Width];
+		alignas(64) T inverseDirectionZ[Width];
+		alignas(64) T tMin[Width];
+		alignas(64) T tMax[Width];
+
+		// Packs up to Width rays. Remaining lanes are disabled.
+		[[nodiscard]] static RayPacket<Width, T> FromRays(Span<const Ray<T>> rays, T tMin = T(0), T tMax = std::numeric_limits<T>::max());
+
+		void SetRay(size_t lane, const Ray<T>& ray, T tMin = T(0), T tMax = std::numeric_limits<T>::max());
+		void DisableLane(size_t lane);
+		[[nodiscard]] Ray<T> GetRay(size_t lane) const;
+
+		static_assert(Width == 4 || Width == 8 || Width == 16, "DMath error. Math::RayPacket width must be 4, 8 or 16.");
+		static_assert(std::is_floating_point_v<T>, "DMath error. Math::RayPacket must be of floating point type.");
+	};
+
+	template<size_t Width, typename T = float>
+	struct RayPacketHit
+	{
+		using ValueType = T;
+		static constexpr size_t width = Width;
+		static constexpr uint32_t missIndex = std::numeric_limits<uint32_t>::max();
+
+		alignas(64) T distance[Width];
+		alignas(64) T u[Width];
+		alignas(64) T v[Width];
+		alignas(64) uint32_t primitiveIndex[Width];
+
+		// Returns a result where every lane is a miss.
+		[[nodiscard]] static RayPacketHit<Width, T> Miss();
+
+		[[nodiscard]] bool IsHit(size_t lane) const { return primitiveIndex[lane] != missIndex; }
+		[[nodiscard]] std::optional<RayHit<T>> Get(size_t lane) const;
+	};
+
+	// Structure of arrays holding Width triangles, stored as a vertex and two edges
+	// since that is what the Moller-Trumbore test consumes.
+	template<size_t Width, typename T = float>
+	struct TrianglePacket
+	{
+		using ValueType = T;
+		static constexpr size_t width = Width;
+
+		alignas(64) T aX[Width];
+		alignas(64) T aY[Width];
+		alignas(64) T aZ[Width];
+		alignas(64) T edge1X[Width];
+		alignas(64) T edge1Y[Width];
+		alignas(64) T edge1Z[Width];
+		alignas(64) T edge2X[Width];
+		alignas(64) T edge2Y[Width];
+		alignas(64) T edge2Z[Width];
+		alignas(64) uint32_t primitiveIndex[Width];
+
+		// Packs up to Width triangles, numbered from firstPrimitiveIndex onwards.
+		// Remaining lanes hold degenerate triangles that are never hit.
+		[[nodiscard]] static TrianglePacket<Width, T> FromTriangles(Span<const Triangle<T>> triangles, uint32_t firstPrimitiveIndex = 0);
+
+		void SetTriangle(size_t lane, const Triangle<T>& triangle, uint32_t primitiveIndex);
+		void DisableLane(size_t lane);
+
+		static_assert(Width == 4 || Width == 8 || Width == 16, "DMath error. Math::TrianglePacket width must be 4, 8 or 16.");
+		static_assert(std::is_floating_point_v<T>, "DMath error. Math::TrianglePacket must be of floating point type.");
+	};
+
+	// Tests every ray of the packet against a single triangle.
+	// Lanes that hit closer than their current tMax get their hit record updated and their tMax shortened,
+	// so calling this once per triangle yields the closest hit of each ray.
+	// Returns the bitmask of the lanes that were updated.
+	template<size_t Width, typename T>
+	uint32_t IntersectRayPacketTriangle(RayPacket<Width, T>& packet, const Triangle<T>& triangle, uint32_t primitiveIndex, RayPacketHit<Width, T>& hit);
+
+	// Slab test of every ray of the packet against a single box.
+	// Returns the bitmask of the lanes that overlap the box within their [tMin, tMax]. Entry distances are written for every lane.
+	template<size_t Width, typename T>
+	uint32_t IntersectRayPacketAABB(const RayPacket<Width, T>& packet, const AABB3D<T>& box, T(&entryDistance)[Width]);
+
+	// Tests a single ray against every triangle of the packet and returns the closest hit,
+	// with primitiveIndex taken from the packet.
+	template<size_t Width, typename T>
+	[[nodiscard]] std::optional<RayHit<T>> IntersectRayTrianglePacket(const Ray<T>& ray, const TrianglePacket<Width, T>& triangles, T tMin = T(0), T tMax = std::numeric_limits<T>::max());
+
+	namespace detail
+	{
+		namespace RayPacket
+		{
+			using Simd::FloatLanes;
+
+			// Widest enabled register width that evenly divides a packet of Width floats. 1 means scalar.
+			template<size_t Width>
+			[[nodiscard]] constexpr size_t GetLaneCount()
+			{
+				if constexpr (Width % 16 == 0 && FloatLanes<16>::enabled)
+					return 16;
+				else if constexpr (Width % 8 == 0 && FloatLanes<8>::enabled)
+					return 8;
+				else if constexpr (Width % 4 == 0 && FloatLanes<4>::enabled)
+					return 4;
+				else
+					return 1;
+			}
+
+			// Smallest determinant magnitude treated as a non-degenerate triangle. Matches IntersectRayTriangle.
+			template<typename T>
+			constexpr T determinantEpsilon = std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon();
+
+			template<typename T>
+			struct TriangleTestResult
+			{
+				bool hit;
+				T distance;
+				T u;
+				T v;
+			};
+
+			// Moller-Trumbore on already extracted components. Written without early outs
+			// so the scalar path computes exactly what each SIMD lane computes.
+			template<typename T>
+			[[nodiscard]] inline TriangleTestResult<T> TestTriangle(
+				T ox, T oy, T oz, T dx, T dy, T dz,
+				T ax, T ay, T az, T e1x, T e1y, T e1z, T e2x, T e2y, T e2z,
+				T tMin, T tMax)
+			{
+				const T px = dy * e2z - dz * e2y;
+				const T py = dz * e2x - dx * e2z;
+				const T pz = dx * e2y - dy * e2x;
+				const T determinant = e1x * px + e1y * py + e1z * pz;
+				const T inverseDeterminant = T(1) / determinant;
+				const T sx = ox - ax;
+				const T sy = oy - ay;
+				const T sz = oz - az;
+				const T u = (sx * px + sy * py + sz * pz) * inverseDeterminant;
+				const T qx = sy * e1z - sz * e1y;
+				const T qy = sz * e1x - sx * e1z;
+				const T qz = sx * e1y - sy * e1x;
+				const T v = (dx * qx + dy * qy + dz * qz) * inverseDeterminant;
+				const T distance = (e2x * qx + e2y * qy + e2z * qz) * inverseDeterminant;
+				const bool hit = !(Abs(determinant) < determinantEpsilon<T>)
+					&& u >= T(0) && v >= T(0) && u + v <= T(1)
+					&& distance >= tMin && distance <= tMax;
+				return { hit, distance, u, v };
+			}
+
+			// Same arithmetic as TestTriangle on one register of lanes. Returns the hit mask.
+			template<typename Lanes>
+			[[nodiscard]] inline typename Lanes::Mask TestTriangle(
+				typename Lanes::Register ox, typename Lanes::Register oy, typename Lanes::Register oz,
+				typename Lanes::Register dx, typename Lanes::Register dy, typename Lanes::Register dz,
+				typename Lanes::Register ax, typename Lanes::Register ay, typename Lanes::Register az,
+				typename Lanes::Register e1x, typename Lanes::Register e1y, typename Lanes::Register e1z,
+				typename Lanes::Register e2x, typename Lanes::Register e2y, typename Lanes::Register e2z,
+				typename Lanes::Register tMin, typename Lanes::Register tMax,
+				typename Lanes::Register& distance, typename Lanes::Register& u, typename Lanes::Register& v)
+			{
+				using L = Lanes;
+				const auto px = L::Sub(L::Mul(dy, e2z), L::Mul(dz, e2y));
+				const auto py = L::Sub(L::Mul(dz, e2x), L::Mul(dx, e2z));
+				const auto pz = L::Sub(L::Mul(dx, e2y), L::Mul(dy, e2x));
+				const auto determinant = L::Add(L::Add(L::Mul(e1x, px), L::Mul(e1y, py)), L::Mul(e1z, pz));
+				const auto inverseDeterminant = L::Div(L::Set(1.f), determinant);
+				const auto sx = L::Sub(ox, ax);
+				const auto sy = L::Sub(oy, ay);
+				const auto sz = L::Sub(oz, az);
+				u = L::Mul(L::Add(L::Add(L::Mul(sx, px), L::Mul(sy, py)), L::Mul(sz, pz)), inverseDeterminant);
+				const auto qx = L::Sub(L::Mul(sy, e1z), L::Mul(sz, e1y));
+				const auto qy = L::Sub(L::Mul(sz, e1x), L::Mul(sx, e1z));
+				const auto qz = L::Sub(L::Mul(sx, e1y), L::Mul(sy, e1x));
+				v = L::Mul(L::Add(L::Add(L::Mul(dx, qx), L::Mul(dy, qy)), L::Mul(dz, qz)), inverseDeterminant);
+				distance = L::Mul(L::Add(L::Add(L::Mul(e2x, qx), L::Mul(e2y, qy)), L::Mul(e2z, qz)), inverseDeterminant);
+
+				const auto zero = L::Set(0.f);
+				auto mask = L::AndNot(L::GreaterEqual(u, zero), L::Less(L::Abs(determinant), L::Set(determinantEpsilon<float>)));
+				mask = L::And(mask, L::GreaterEqual(v, zero));
+				mask = L::And(mask, L::LessEqual(L::Add(u, v), L::Set(1.f)));
+				mask = L::And(mask, L::GreaterEqual(distance, tMin));
+				return L::And(mask, L::LessEqual(distance, tMax));
+			}
+
+			// Slab test on extracted components, using the same min/max operand order as IntersectRayAABB.
+			template<typename T>
+			[[nodiscard]] inline bool TestAABB(T ox, T oy, T oz, T ix, T iy, T iz, const AABB3D<T>& box, T tMin, T tMax, T& entryDistance)
+			{
+				const T origin[3] = { ox, oy, oz };
+				const T inverseDirection[3] = { ix, iy, iz };
+				for (size_t i = 0; i < 3; i++)
+				{
+					const T t1 = (box.min[i] - origin[i]) * inverseDirection[i];
+					const T t2 = (box.max[i] - origin[i]) * inverseDirection[i];
+					const T tNear = t2 < t1 ? t2 : t1;
+					const T tFar = t1 > t2 ? t1 : t2;
+					tMin = tNear > tMin ? tNear : tMin;
+					tMax = tFar < tMax ? tFar : tMax;
+				}
+				entryDistance = tMin;
+				return tMin <= tMax;
+			}
+		}
+	}
+}
+
+template<size_t Width, typename T>
+Math::RayPacket<Width, T> Math::RayPacket<Width, T>::FromRays(Span<const Ray<T>> rays, T tMin, T tMax)
+{
+	assert(rays.size() <= Width);
+
+	RayPacket<Width, T> packet;
+	for (size_t lane = 0; lane < Width; lane++)
+	{
+		if (lane < rays.size())
+			packet.SetRay(lane, rays[lane], tMin, tMax);
+		else
+			packet.DisableLane(lane);
+	}
+	return packet;
+}
+
+template<size_t Width, typename T>
+void Math::RayPacket<Width, T>::SetRay(size_t lane, const Ray<T>& ray, T tMin, T tMax)
+{
+	assert(lane < Width);
+
+	const Vector<3, T> inverseDirection = ray.GetInverseDirection();
+	originX[lane] = ray.origin.x;
+	originY[lane] = ray.origin.y;
+	originZ[lane] = ray.origin.z;
+	directionX[lane] = ray.direction.x;
+	directionY[lane] = ray.direction.y;
+	directionZ[lane] = ray.direction.z;
+	inverseDirectionX[lane] = inverseDirection.x;
+	inverseDirectionY[lane] = inverseDirection.y;
+	inverseDirectionZ[lane] = inverseDirection.z;
+	this->tMin[lane] = tMin;
+	this->tMax[lane] = tMax;
+}
+
+template<size_t Width, typename T>
+void Math::RayPacket<Width, T>::DisableLane(size_t lane)
+{
+	assert(lane < Width);
+
+	originX[lane] = T(0);
+	originY[lane] = T(0);
+	originZ[lane] = T(0);
+	directionX[lane] = T(0);
+	directionY[lane] = T(0);
+	directionZ[lane] = T(0);
+	inverseDirectionX[lane] = T(0);
+	inverseDirectionY[lane] = T(0);
+	inverseDirectionZ[lane] = T(0);
+	tMin[lane] = std::numeric_limits<T>::max();
+	tMax[lane] = std::numeric_limits<T>::lowest();
+}
+
+template<size_t Width, typename T>
+Math::Ray<T> Math::RayPacket<Width, T>::GetRay(size_t lane) const
+{
+	assert(lane < Width);
+
+	return Ray<T>{ Vector<3, T>{ originX[lane], originY[lane], originZ[lane] }, Vector<3, T>{ directionX[lane], directionY[lane], directionZ[lane] } };
+}
+
+template<size_t Width, typename T>
+Math::RayPacketHit<Width, T> Math::RayPacketHit<Width, T>::Miss()
+{
+	RayPacketHit<Width, T> hit;
+	for (size_t lane = 0; lane < Width; lane++)
+	{
+		hit.distance[lane] = std::numeric_limits<T>::max();
+		hit.u[lane] = T(0);
+		hit.v[lane] = T(0);
+		hit.primitiveIndex[lane] = missIndex;
+	}
+	return hit;
+}
+
+template<size_t Width, typename T>
+std::optional<Math::RayHit<T>> Math::RayPacketHit<Width, T>::Get(size_t lane) const
+{
+	assert(lane < Width);
+
+	if (!IsHit(lane))
+		return {};
+	return RayHit<T>{ distance[lane], u[lane], v[lane], primitiveIndex[lane] };
+}
+
+template<size_t Width, typename T>
+Math::TrianglePacket<Width, T> Math::TrianglePacket<Width, T>::FromTriangles(Span<const Triangle<T>> triangles, uint32_t firstPrimitiveIndex)
+{
+	assert(triangles.size() <= Width);
+
+	TrianglePacket<Width, T> packet;
+	for (size_t lane = 0; lane < Width; lane++)
+	{
+		if (lane < triangles.size())
+			packet.SetTriangle(lane, triangles[lane], firstPrimitiveIndex + uint32_t(lane));
+		else
+			packet.DisableLane(lane);
+	}
+	return packet;
+}
+
+template<size_t Width, typename T>
+void Math::TrianglePacket<Width, T>::SetTriangle(size_t lane, const Triangle<T>& triangle, uint32_t primitiveIndex)
+{
+	assert(lane < Width);
+
+	const Vector<3, T> edge1 = triangle.b - triangle.a;
+	const Vector<3, T> edge2 = triangle.c - triangle.a;
+	aX[lane] = triangle.a.x;
+	aY[lane] = triangle.a.y;
+	aZ[lane] = triangle.a.z;
+	edge1X[lane] = edge1.x;
+	edge1Y[lane] = edge1.y;
+	edge1Z[lane] = edge1.z;
+	edge2X[lane] = edge2.x;
+	edge2Y[lane] = edge2.y;
+	edge2Z[lane] = edge2.z;
+	this->primitiveIndex[lane] = primitiveIndex;
+}
+
+template<size_t Width, typename T>
+void Math::TrianglePacket<Width, T>::DisableLane(size_t lane)
+{
+	assert(lane < Width);
+
+	aX[lane] = T(0);
+	aY[lane] = T(0);
+	aZ[lane] = T(0);
+	edge1X[lane] = T(0);
+	edge1Y[lane] = T(0);
+	edge1Z[lane] = T(0);
+	edge2X[lane] = T(0);
+	edge2Y[lane] = T(0);
+	edge2Z[lane] = T(0);
+	primitiveIndex[lane] = RayPacketHit<Width, T>::missIndex;
+}
+
+template<size_t Width, typename T>
+uint32_t Math::IntersectRayPacketTriangle(RayPacket<Width, T>& packet, const Triangle<T>& triangle, uint32_t primitiveIndex, RayPacketHit<Width, T>& hit)
+{
+	using namespace detail::RayPacket;
+
+	const Vector<3, T> edge1 = triangle.b - triangle.a;
+	const Vector<3, T> edge2 = triangle.c - triangle.a;
+
+	uint32_t mask = 0;
+	if constexpr (std::is_same_v<T, float> && GetLaneCount<Width>() > 1)
+	{
+		constexpr size_t laneCount = GetLaneCount<Width>();
+		using L = FloatLanes<laneCount>;
+		const auto ax = L::Set(triangle.a.x);
+		const auto ay = L::Set(triangle.a.y);
+		const auto az = L::Set(triangle.a.z);
+		const auto e1x = L::Set(edge1.x);
+		const auto e1y = L::Set(edge1.y);
+		const auto e1z = L::Set(edge1.z);
+		const auto e2x = L::Set(edge2.x);
+		const auto e2y = L::Set(edge2.y);
+		const auto e2z = L::Set(edge2.z);
+		for (size_t offset = 0; offset < Width; offset += laneCount)
+		{
+			typename L::Register distance, u, v;
+			const auto tMax = L::Load(packet.tMax + offset);
+			const auto hitMask = TestTriangle<L>(
+				L::Load(packet.originX + offset), L::Load(packet.originY + offset), L::Load(packet.originZ + offset),
+				L::Load(packet.directionX + offset), L::Load(packet.directionY + offset), L::Load(packet.directionZ + offset),
+				ax, ay, az, e1x, e1y, e1z, e2x, e2y, e2z,
+				L::Load(packet.tMin + offset), tMax,
+				distance, u, v);
+			const uint32_t bits = L::ToBits(hitMask);
+			if (bits == 0)
+				continue;
+
+			L::Store(packet.tMax + offset, L::Select(hitMask, distance, tMax));
+			L::Store(hit.distance + offset, L::Select(hitMask, distance, L::Load(hit.distance + offset)));
+			L::Store(hit.u + offset, L::Select(hitMask, u, L::Load(hit.u + offset)));
+			L::Store(hit.v + offset, L::Select(hitMask, v, L::Load(hit.v + offset)));
+			for (size_t lane = 0; lane < laneCount; lane++)
+			{
+				if (bits & (1u << lane))
+					hit.primitiveIndex[offset + lane] = primitiveIndex;
+			}
+			mask |= bits << offset;
+		}
+	}
+	else
+	{
+		for (size_t lane = 0; lane < Width; lane++)
+		{
+			const auto result = TestTriangle<T>(
+				packet.originX[lane], packet.originY[lane], packet.originZ[lane],
+				packet.directionX[lane], packet.directionY[lane], packet.directionZ[lane],
+				triangle.a.x, triangle.a.y, triangle.a.z, edge1.x, edge1.y, edge1.z, edge2.x, edge2.y, edge2.z,
+				packet.tMin[lane], packet.tMax[lane]);
+			if (!result.hit)
+				continue;
+
+			packet.tMax[lane] = result.distance;
+			hit.distance[lane] = result.distance;
+			hit.u[lane] = result.u;
+			hit.v[lane] = result.v;
+			hit.primitiveIndex[lane] = primitiveIndex;
+			mask |= 1u << lane;
+		}
+	}
+	return mask;
+}
+
+template<size_t Width, typename T>
+uint32_t Math::IntersectRayPacketAABB(const RayPacket<Width, T>& packet, const AABB3D<T>& box, T(&entryDistance)[Width])
+{
+	using namespace detail::RayPacket;
+
+	uint32_t mask = 0;
+	if constexpr (std::is_same_v<T, float> && GetLaneCount<Width>() > 1)
+	{
+		constexpr size_t laneCount = GetLaneCount<Width>();
+		using L = FloatLanes<laneCount>;
+		const typename L::Register boxMin[3] = { L::Set(box.min.x), L::Set(box.min.y), L::Set(box.min.z) };
+		const typename L::Register boxMax[3] = { L::Set(box.max.x), L::Set(box.max.y), L::Set(box.max.z) };
+		const float* const origins[3] = { packet.originX, packet.originY, packet.originZ };
+		const float* const inverseDirections[3] = { packet.inverseDirectionX, packet.inverseDirectionY, packet.inverseDirectionZ };
+		for (size_t offset = 0; offset < Width; offset += laneCount)
+		{
+			auto tMin = L::Load(packet.tMin + offset);
+			auto tMax = L::Load(packet.tMax + offset);
+			for (size_t i = 0; i < 3; i++)
+			{
+				const auto origin = L::Load(origins[i] + offset);
+				const auto inverseDirection = L::Load(inverseDirections[i] + offset);
+				const auto t1 = L::Mul(L::Sub(boxMin[i], origin), inverseDirection);
+				const auto t2 = L::Mul(L::Sub(boxMax[i], origin), inverseDirection);
+				tMin = L::Max(L::Min(t2, t1), tMin);
+				tMax = L::Min(L::Max(t1, t2), tMax);
+			}
+			L::Store(entryDistance + offset, tMin);
+			mask |= L::ToBits(L::LessEqual(tMin, tMax)) << offset;
+		}
+	}
+	else
+	{
+		for (size_t lane = 0; lane < Width; lane++)
+		{
+			const bool hit = TestAABB<T>(
+				packet.originX[lane], packet.originY[lane], packet.originZ[lane],
+				packet.inverseDirectionX[lane], packet.inverseDirectionY[lane], packet.inverseDirectionZ[lane],
+				box, packet.tMin[lane], packet.tMax[lane], entryDistance[lane]);
+			mask |= uint32_t(hit) << lane;
+		}
+	}
+	return mask;
+}
+
+template<size_t Width, typename T>
+std::optional<Math::RayHit<T>> Math::IntersectRayTrianglePacket(const Ray<T>& ray, const TrianglePacket<Width, T>& triangles, T tMin, T tMax)
+{
+	using namespace detail::RayPacket;
+
+	alignas(64) T distances[Width];
+	alignas(64) T us[Width];
+	alignas(64) T vs[Width];
+	uint32_t mask = 0;
+	if constexpr (std::is_same_v<T, float> && GetLaneCount<Width>() > 1)
+	{
+		constexpr size_t laneCount = GetLaneCount<Width>();
+		using L = FloatLanes<laneCount>;
+		const auto ox = L::Set(ray.origin.x);
+		const auto oy = L::Set(ray.origin.y);
+		const auto oz = L::Set(ray.origin.z);
+		const auto dx = L::Set(ray.direction.x);
+		const auto dy = L::Set(ray.direction.y);
+		const auto dz = L::Set(ray.direction.z);
+		const auto tMinLanes = L::Set(tMin);
+		const auto tMaxLanes = L::Set(tMax);
+		for (size_t offset = 0; offset < Width; offset += laneCount)
+		{
+			typename L::Register distance, u, v;
+			const auto hitMask = TestTriangle<L>(
+				ox, oy, oz, dx, dy, dz,
+				L::Load(triangles.aX + offset), L::Load(triangles.aY + offset), L::Load(triangles.aZ + offset),
+				L::Load(triangles.edge1X + offset), L::Load(triangles.edge1Y + offset), L::Load(triangles.edge1Z + offset),
+				L::Load(triangles.edge2X + offset), L::Load(triangles.edge2Y + offset), L::Load(triangles.edge2Z + offset),
+				tMinLanes, tMaxLanes,
+				distance, u, v);
+			L::Store(distances + offset, distance);
+			L::Store(us + offset, u);
+			L::Store(vs + offset, v);
+			mask |= L::ToBits(hitMask) << offset;
+		}
+	}
+	else
+	{
+		for (size_t lane = 0; lane < Width; lane++)
+		{
+			const auto result = TestTriangle<T>(
+				ray.origin.x, ray.origin.y, ray.origin.z, ray.direction.x, ray.direction.y, ray.direction.z,
+				triangles.aX[lane], triangles.aY[lane], triangles.aZ[lane],
+				triangles.edge1X[lane], triangles.edge1Y[lane], triangles.edge1Z[lane],
+				triangles.edge2X[lane], triangles.edge2Y[lane], triangles.edge2Z[lane],
+				tMin, tMax);
+			distances[lane] = result.distance;
+			us[lane] = result.u;
+			vs[lane] = result.v;
+			mask |= uint32_t(result.hit) << lane;
+		}
+	}
+
+	if (mask == 0)
+		return {};
+
+	size_t closest = Width;
+	for (size_t lane = 0; lane < Width; lane++)
+	{
+		if ((mask & (1u << lane)) && (closest == Width || distances[lane] < distances[closest]))
+			closest = lane;
+	}
+	return RayHit<T>{ distances[closest], us[closest], vs[closest], triangles.primitiveIndex[closest] };
+}
\ No newline at end of file
@@ -1,5 +1,10 @@
 #pragma once
 
+// True while a constexpr function is being evaluated at compile time. Lets functions that
+// call into the C library at run time fall back to a constexpr implementation.
+// The builtin is available in C++17 mode from GCC 9, Clang 9 and MSVC 19.25.
+#define DMATH_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+
 namespace Math
 {
 	enum class AngleUnit : unsigned char
@@ -8,8 +13,18 @@ namespace Math
 		Degrees
 	};
 
+	// Accuracy of the polynomial sine, cosine and tangent.
+	// Fast is within about 6e-4 relative error, Medium within about 2e-6 and Full within a few ULP.
+	enum class TrigPrecision : unsigned char
+	{
+		Fast,
+		Medium,
+		Full
+	};
+
 	namespace Setup
 	{
 		constexpr AngleUnit defaultAngleUnit = AngleUnit::Degrees;
+		constexpr TrigPrecision defaultTrigPrecision = TrigPrecision::Full;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,397 @@
+#pragma once
+
+#include "Setup.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Instruction set detection for the batch kernels.
+// Each kernel has a portable scalar path; the intrinsic paths are enabled
+// by compiling with the matching architecture flag (/arch:AVX2, -mavx2, -mavx512f etc.)
+#if defined( __AVX512F__ )
+#	define DMATH_SIMD_AVX512
+#endif
+
+#if defined( __AVX2__ )
+#	define DMATH_SIMD_AVX2
+#endif
+
+#if defined( __AVX__ )
+#	define DMATH_SIMD_AVX
+#endif
+
+// Fused multiply-add ships with every AVX2 capable x86 processor as well.
+#if defined( __FMA__ ) || ( defined( _MSC_VER ) && defined( __AVX2__ ) )
+#	define DMATH_SIMD_FMA
+#endif
+
+// BMI2 (pdep/pext) ships with every AVX2 capable x86 processor. MSVC has no dedicated macro for it.
+#if defined( __BMI2__ ) || ( defined( _MSC_VER ) && defined( __AVX2__ ) )
+#	define DMATH_SIMD_BMI2
+#endif
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#	define DMATH_SIMD_SSE2
+#endif
+
+#if defined( DMATH_SIMD_SSE2 ) || defined( DMATH_SIMD_BMI2 )
+#	include <immintrin.h>
+#endif
+
+namespace Math
+{
+	namespace detail
+	{
+		namespace Simd
+		{
+			// Number of 32-bit float lanes in the widest enabled register.
+#if defined( DMATH_SIMD_AVX512 )
+			constexpr size_t floatLaneCount = 16;
+#elif defined( DMATH_SIMD_AVX )
+			constexpr size_t floatLaneCount = 8;
+#elif defined( DMATH_SIMD_SSE2 )
+			constexpr size_t floatLaneCount = 4;
+#else
+			constexpr size_t floatLaneCount = 1;
+#endif
+
+			// Batch kernels process objects in blocks of this many elements,
+			// regardless of the enabled instruction set. Keeps output bitmasks identical across paths.
+			constexpr size_t blockLength = 16;
+
+			// Thin wrappers over one float register. Only the widths enabled by the
+			// instruction set are specialized, wider packets are processed as several registers.
+			// FloatLanes<1> is the scalar fallback, so a kernel written against this interface
+			// gives the same results on every path.
+			template<size_t LaneCount>
+			struct FloatLanes
+			{
+				static constexpr bool enabled = false;
+			};
+
+			template<>
+			struct FloatLanes<1>
+			{
+				static constexpr bool enabled = true;
+				using Register = float;
+				using Mask = bool;
+
+				static constexpr Register Load(const float* source) { return *source; }
+				static constexpr Register LoadUnaligned(const float* source) { return *source; }
+				static constexpr void Store(float* destination, Register value) { *destination = value; }
+				static constexpr void StoreUnaligned(float* destination, Register value) { *destination = value; }
+				static constexpr Register Set(float value) { return value; }
+				static constexpr Register Add(Register a, Register b) { return a + b; }
+				static constexpr Register Sub(Register a, Register b) { return a - b; }
+				static constexpr Register Mul(Register a, Register b) { return a * b; }
+				static constexpr Register Div(Register a, Register b) { return a / b; }
+				static constexpr Register Min(Register a, Register b) { return a < b ? a : b; }
+				static constexpr Register Max(Register a, Register b) { return a > b ? a : b; }
+				static constexpr Register Abs(Register a) { return a < 0.f ? -a : a; }
+				static constexpr Register Negate(Register a) { return -a; }
+				static Register Sqrt(Register a) { return std::sqrt(a); }
+#if defined( DMATH_SIMD_FMA )
+				// a * b - c with a single rounding.
+				static Register MulSub(Register a, Register b, Register c) { return std::fma(a, b, -c); }
+#endif
+				// a * b + c and c - a * b, with a single rounding on every path where fused multiply-add is enabled and with two on none.
+				// Kernels that write every multiply-add with them give the same results on every path, however the compiler contracts.
+				static Register MulAdd(Register a, Register b, Register c)
+				{
+#if defined( DMATH_SIMD_FMA )
+					return std::fma(a, b, c);
+#else
+					return a * b + c;
+#endif
+				}
+				static Register NegMulAdd(Register a, Register b, Register c)
+				{
+#if defined( DMATH_SIMD_FMA )
+					return std::fma(-a, b, c);
+#else
+					return c - a * b;
+#endif
+				}
+				// At least 12 bits, the same estimate as the widest vector path.
+				static Register RSqrtEstimate(Register a)
+				{
+#if defined( DMATH_SIMD_AVX512 )
+					return _mm_cvtss_f32(_mm_rsqrt14_ss(_mm_set_ss(a), _mm_set_ss(a)));
+#elif defined( DMATH_SIMD_SSE2 )
+					return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(a)));
+#else
+					uint32_t bits;
+					std::memcpy(&bits, &a, sizeof(bits));
+					bits = 0x5F375A86u - (bits >> 1);
+					float estimate;
+					std::memcpy(&estimate, &bits, sizeof(estimate));
+					estimate *= 1.5f - 0.5f * a * estimate * estimate;
+					return estimate * (1.5f - 0.5f * a * estimate * estimate);
+#endif
+				}
+				// Round to nearest even, like the vector paths.
+				// std::nearbyint is a library call that saves and restores the floating point environment, too slow for the kernels.
+				static constexpr Register Round(Register a)
+				{
+					if (!DMATH_IS_CONSTANT_EVALUATED())
+					{
+#if defined( DMATH_SIMD_AVX )
+						return _mm_cvtss_f32(_mm_round_ss(_mm_set_ss(a), _mm_set_ss(a), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+#elif defined( DMATH_SIMD_SSE2 )
+						// Floats from 2^23 on are already integers. NaN fails the comparison and passes through.
+						if (Abs(a) < 2147483648.f)
+							return float(_mm_cvtss_si32(_mm_set_ss(a)));
+						return a;
+#else
+						// Adding and subtracting 1.5 * 2^23 leaves the nearest integer, the addition rounds to nearest even.
+						if (Abs(a) < 4194304.f)
+							return (a + 12582912.f) - 12582912.f;
+						return a;
+#endif
+					}
+
+					// Floats of this magnitude are already integers.
+					if (!(Abs(a) < 8388608.f))
+						return a;
+					const auto truncated = float(int32_t(a));
+					const float remainder = a - truncated;
+					const float step = a < 0.f ? -1.f : 1.f;
+					if (Abs(remainder) > 0.5f || (Abs(remainder) == 0.5f && int32_t(truncated) % 2 != 0))
+						return truncated + step;
+					return truncated;
+				}
+				static Register Floor(Register a) { return std::floor(a); }
+				static Register Ceil(Register a) { return std::ceil(a); }
+				static Register Truncate(Register a) { return std::trunc(a); }
+				// Unbiased exponent and mantissa in [1, 2) of a positive normal float.
+				static Register GetExponent(Register a)
+				{
+					uint32_t bits;
+					std::memcpy(&bits, &a, sizeof(bits));
+					return float(int32_t((bits >> 23) & 0xFF) - 127);
+				}
+				static Register GetMantissa(Register a)
+				{
+					uint32_t bits;
+					std::memcpy(&bits, &a, sizeof(bits));
+					bits = (bits & 0x007FFFFFu) | 0x3F800000u;
+					float mantissa;
+					std::memcpy(&mantissa, &bits, sizeof(mantissa));
+					return mantissa;
+				}
+				// a * 2^exponent, for integral exponents in [-126, 127].
+				static Register Ldexp(Register a, Register exponent)
+				{
+					const uint32_t bits = uint32_t(int32_t(exponent) + 127) << 23;
+					float scale;
+					std::memcpy(&scale, &bits, sizeof(scale));
+					return a * scale;
+				}
+				static constexpr Mask Less(Register a, Register b) { return a < b; }
+				static constexpr Mask LessEqual(Register a, Register b) { return a <= b; }
+				static constexpr Mask GreaterEqual(Register a, Register b) { return a >= b; }
+				static constexpr Mask Equal(Register a, Register b) { return a == b; }
+				static constexpr Mask And(Mask a, Mask b) { return a && b; }
+				static constexpr Mask AndNot(Mask a, Mask b) { return a && !b; }
+				static constexpr Mask Or(Mask a, Mask b) { return a || b; }
+				// Blends the bits instead of branching, the kernels select on data such as the quadrant of an angle, which branch prediction cannot follow.
+				static constexpr Register Select(Mask mask, Register a, Register b)
+				{
+					if (DMATH_IS_CONSTANT_EVALUATED())
+						return mask ? a : b;
+
+					const uint32_t blend = uint32_t(0) - uint32_t(mask);
+					uint32_t aBits = 0;
+					uint32_t bBits = 0;
+					std::memcpy(&aBits, &a, sizeof(aBits));
+					std::memcpy(&bBits, &b, sizeof(bBits));
+					const uint32_t bits = (aBits & blend) | (bBits & ~blend);
+					float result = 0.f;
+					std::memcpy(&result, &bits, sizeof(result));
+					return result;
+				}
+				static constexpr uint32_t ToBits(Mask mask) { return uint32_t(mask); }
+			};
+
+#if defined( DMATH_SIMD_SSE2 )
+			template<>
+			struct FloatLanes<4>
+			{
+				static constexpr bool enabled = true;
+				using Register = __m128;
+				using Mask = __m128;
+
+				static Register Load(const float* source) { return _mm_load_ps(source); }
+				static Register LoadUnaligned(const float* source) { return _mm_loadu_ps(source); }
+				static void Store(float* destination, Register value) { _mm_store_ps(destination, value); }
+				static void StoreUnaligned(float* destination, Register value) { _mm_storeu_ps(destination, value); }
+				static Register Set(float value) { return _mm_set1_ps(value); }
+				static Register Add(Register a, Register b) { return _mm_add_ps(a, b); }
+				static Register Sub(Register a, Register b) { return _mm_sub_ps(a, b); }
+				static Register Mul(Register a, Register b) { return _mm_mul_ps(a, b); }
+				static Register Div(Register a, Register b) { return _mm_div_ps(a, b); }
+				// Same operand order semantics as (a < b ? a : b) and (a > b ? a : b).
+				static Register Min(Register a, Register b) { return _mm_min_ps(a, b); }
+				static Register Max(Register a, Register b) { return _mm_max_ps(a, b); }
+				static Register Abs(Register a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+				static Register Negate(Register a) { return _mm_xor_ps(_mm_set1_ps(-0.f), a); }
+				static Register Sqrt(Register a) { return _mm_sqrt_ps(a); }
+#if defined( DMATH_SIMD_FMA )
+				static Register MulSub(Register a, Register b, Register c) { return _mm_fmsub_ps(a, b, c); }
+				static Register MulAdd(Register a, Register b, Register c) { return _mm_fmadd_ps(a, b, c); }
+				static Register NegMulAdd(Register a, Register b, Register c) { return _mm_fnmadd_ps(a, b, c); }
+#else
+				static Register MulAdd(Register a, Register b, Register c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+				static Register NegMulAdd(Register a, Register b, Register c) { return _mm_sub_ps(c, _mm_mul_ps(a, b)); }
+#endif
+				static Register RSqrtEstimate(Register a) { return _mm_rsqrt_ps(a); }
+				// SSE2 has no rounding instruction, the conversion rounds to nearest even. Only valid below 2^31.
+				static Register Round(Register a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+				static Register Truncate(Register a)
+				{
+					// The sign is put back so that zero results keep it. Floats of 2^23 and above are already integers.
+					const __m128 truncated = _mm_or_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(a)), _mm_and_ps(a, _mm_set1_ps(-0.f)));
+					return Select(_mm_cmplt_ps(Abs(a), _mm_set1_ps(8388608.f)), truncated, a);
+				}
+				static Register Floor(Register a)
+				{
+					const __m128 truncated = Truncate(a);
+					return Select(_mm_cmpgt_ps(truncated, a), _mm_sub_ps(truncated, _mm_set1_ps(1.f)), truncated);
+				}
+				static Register Ceil(Register a)
+				{
+					const __m128 truncated = Truncate(a);
+					return Select(_mm_cmplt_ps(truncated, a), _mm_add_ps(truncated, _mm_set1_ps(1.f)), truncated);
+				}
+				static Register GetExponent(Register a)
+				{
+					const __m128 biased = _mm_cvtepi32_ps(_mm_castps_si128(_mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x7F800000)))));
+					return _mm_sub_ps(_mm_mul_ps(biased, _mm_set1_ps(1.f / 8388608.f)), _mm_set1_ps(127.f));
+				}
+				static Register GetMantissa(Register a) { return _mm_or_ps(_mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x007FFFFF))), _mm_set1_ps(1.f)); }
+				static Register Ldexp(Register a, Register exponent)
+				{
+					const __m128 biased = _mm_mul_ps(_mm_add_ps(exponent, _mm_set1_ps(127.f)), _mm_set1_ps(8388608.f));
+					return _mm_mul_ps(a, _mm_castsi128_ps(_mm_cvtps_epi32(biased)));
+				}
+				static Mask Less(Register a, Register b) { return _mm_cmplt_ps(a, b); }
+				static Mask LessEqual(Register a, Register b) { return _mm_cmple_ps(a, b); }
+				static Mask GreaterEqual(Register a, Register b) { return _mm_cmpge_ps(a, b); }
+				static Mask Equal(Register a, Register b) { return _mm_cmpeq_ps(a, b); }
+				static Mask And(Mask a, Mask b) { return _mm_and_ps(a, b); }
+				static Mask AndNot(Mask a, Mask b) { return _mm_andnot_ps(b, a); }
+				static Mask Or(Mask a, Mask b) { return _mm_or_ps(a, b); }
+				static Register Select(Mask mask, Register a, Register b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+				static uint32_t ToBits(Mask mask) { return uint32_t(_mm_movemask_ps(mask)); }
+			};
+#endif
+
+#if defined( DMATH_SIMD_AVX )
+			template<>
+			struct FloatLanes<8>
+			{
+				static constexpr bool enabled = true;
+				using Register = __m256;
+				using Mask = __m256;
+
+				static Register Load(const float* source) { return _mm256_load_ps(source); }
+				static Register LoadUnaligned(const float* source) { return _mm256_loadu_ps(source); }
+				static void Store(float* destination, Register value) { _mm256_store_ps(destination, value); }
+				static void StoreUnaligned(float* destination, Register value) { _mm256_storeu_ps(destination, value); }
+				static Register Set(float value) { return _mm256_set1_ps(value); }
+				static Register Add(Register a, Register b) { return _mm256_add_ps(a, b); }
+				static Register Sub(Register a, Register b) { return _mm256_sub_ps(a, b); }
+				static Register Mul(Register a, Register b) { return _mm256_mul_ps(a, b); }
+				static Register Div(Register a, Register b) { return _mm256_div_ps(a, b); }
+				static Register Min(Register a, Register b) { return _mm256_min_ps(a, b); }
+				static Register Max(Register a, Register b) { return _mm256_max_ps(a, b); }
+				static Register Abs(Register a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+				static Register Negate(Register a) { return _mm256_xor_ps(_mm256_set1_ps(-0.f), a); }
+				static Register Sqrt(Register a) { return _mm256_sqrt_ps(a); }
+#if defined( DMATH_SIMD_FMA )
+				static Register MulSub(Register a, Register b, Register c) { return _mm256_fmsub_ps(a, b, c); }
+				static Register MulAdd(Register a, Register b, Register c) { return _mm256_fmadd_ps(a, b, c); }
+				static Register NegMulAdd(Register a, Register b, Register c) { return _mm256_fnmadd_ps(a, b, c); }
+#else
+				static Register MulAdd(Register a, Register b, Register c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+				static Register NegMulAdd(Register a, Register b, Register c) { return _mm256_sub_ps(c, _mm256_mul_ps(a, b)); }
+#endif
+				static Register RSqrtEstimate(Register a) { return _mm256_rsqrt_ps(a); }
+				static Register Round(Register a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+				static Register Floor(Register a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+				static Register Ceil(Register a) { return _mm256_round_ps(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+				static Register Truncate(Register a) { return _mm256_round_ps(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+				// Through float conversions, AVX has no 256-bit integer arithmetic.
+				static Register GetExponent(Register a)
+				{
+					const __m256 biased = _mm256_cvtepi32_ps(_mm256_castps_si256(_mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x7F800000)))));
+					return _mm256_sub_ps(_mm256_mul_ps(biased, _mm256_set1_ps(1.f / 8388608.f)), _mm256_set1_ps(127.f));
+				}
+				static Register GetMantissa(Register a) { return _mm256_or_ps(_mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x007FFFFF))), _mm256_set1_ps(1.f)); }
+				static Register Ldexp(Register a, Register exponent)
+				{
+					const __m256 biased = _mm256_mul_ps(_mm256_add_ps(exponent, _mm256_set1_ps(127.f)), _mm256_set1_ps(8388608.f));
+					return _mm256_mul_ps(a, _mm256_castsi256_ps(_mm256_cvtps_epi32(biased)));
+				}
+				static Mask Less(Register a, Register b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+				static Mask LessEqual(Register a, Register b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+				static Mask GreaterEqual(Register a, Register b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+				static Mask Equal(Register a, Register b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+				static Mask And(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+				static Mask AndNot(Mask a, Mask b) { return _mm256_andnot_ps(b, a); }
+				static Mask Or(Mask a, Mask b) { return _mm256_or_ps(a, b); }
+				static Register Select(Mask mask, Register a, Register b) { return _mm256_blendv_ps(b, a, mask); }
+				static uint32_t ToBits(Mask mask) { return uint32_t(_mm256_movemask_ps(mask)); }
+			};
+#endif
+
+#if defined( DMATH_SIMD_AVX512 )
+			template<>
+			struct FloatLanes<16>
+			{
+				static constexpr bool enabled = true;
+				using Register = __m512;
+				using Mask = __mmask16;
+
+				static Register Load(const float* source) { return _mm512_load_ps(source); }
+				static Register LoadUnaligned(const float* source) { return _mm512_loadu_ps(source); }
+				static void Store(float* destination, Register value) { _mm512_store_ps(destination, value); }
+				static void StoreUnaligned(float* destination, Register value) { _mm512_storeu_ps(destination, value); }
+				static Register Set(float value) { return _mm512_set1_ps(value); }
+				static Register Add(Register a, Register b) { return _mm512_add_ps(a, b); }
+				static Register Sub(Register a, Register b) { return _mm512_sub_ps(a, b); }
+				static Register Mul(Register a, Register b) { return _mm512_mul_ps(a, b); }
+				static Register Div(Register a, Register b) { return _mm512_div_ps(a, b); }
+				static Register Min(Register a, Register b) { return _mm512_min_ps(a, b); }
+				static Register Max(Register a, Register b) { return _mm512_max_ps(a, b); }
+				static Register Abs(Register a) { return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a), _mm512_set1_epi32(0x7FFFFFFF))); }
+				static Register Negate(Register a) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_set1_epi32(int(0x80000000)))); }
+				static Register Sqrt(Register a) { return _mm512_sqrt_ps(a); }
+				static Register MulSub(Register a, Register b, Register c) { return _mm512_fmsub_ps(a, b, c); }
+				static Register MulAdd(Register a, Register b, Register c) { return _mm512_fmadd_ps(a, b, c); }
+				static Register NegMulAdd(Register a, Register b, Register c) { return _mm512_fnmadd_ps(a, b, c); }
+				// 14 bits.
+				static Register RSqrtEstimate(Register a) { return _mm512_rsqrt14_ps(a); }
+				static Register Round(Register a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+				static Register Floor(Register a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+				static Register Ceil(Register a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+				static Register Truncate(Register a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+				static Register GetExponent(Register a) { return _mm512_getexp_ps(a); }
+				static Register GetMantissa(Register a) { return _mm512_getmant_ps(a, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero); }
+				static Register Ldexp(Register a, Register exponent) { return _mm512_scalef_ps(a, exponent); }
+				static Mask Less(Register a, Register b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+				static Mask LessEqual(Register a, Register b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+				static Mask GreaterEqual(Register a, Register b) { return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ); }
+				static Mask Equal(Register a, Register b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+				static Mask And(Mask a, Mask b) { return Mask(a & b); }
+				static Mask AndNot(Mask a, Mask b) { return Mask(a & ~b); }
+				static Mask Or(Mask a, Mask b) { return Mask(a | b); }
+				static Register Select(Mask mask, Register a, Register b) { return _mm512_mask_blend_ps(mask, b, a); }
+				static uint32_t ToBits(Mask mask) { return uint32_t(mask); }
+			};
+#endif
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<span>)
+#	include <span>
+#endif
+
+namespace Math
+{
+#if defined( __cpp_lib_span )
+	template<typename T>
+	using Span = std::span<T>;
+#else
+	// Minimal stand-in for std::span when compiling as C++17.
+	// Only the subset of the std::span interface used by DMath is provided.
+	template<typename T>
+	class Span
+	{
+	public:
+		using element_type = T;
+		using value_type = std::remove_cv_t<T>;
+		using size_type = size_t;
+		using pointer = T*;
+		using reference = T&;
+		using iterator = T*;
+
+		constexpr Span() noexcept = default;
+		constexpr Span(T* data, size_t count) noexcept :
+			ptr(data),
+			count(count) {}
+		template<size_t n>
+		constexpr Span(T(&array)[n]) noexcept :
+			ptr(array),
+			count(n) {}
+		template<typename U, size_t n, typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+		constexpr Span(std::array<U, n>& array) noexcept :
+			ptr(array.data()),
+			count(n) {}
+		template<typename U, size_t n, typename = std::enable_if_t<std::is_convertible_v<const U(*)[], T(*)[]>>>
+		constexpr Span(const std::array<U, n>& array) noexcept :
+			ptr(array.data()),
+			count(n) {}
+		template<typename U, typename Alloc, typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+		Span(std::vector<U, Alloc>& vector) noexcept :
+			ptr(vector.data()),
+			count(vector.size()) {}
+		template<typename U, typename Alloc, typename = std::enable_if_t<std::is_convertible_v<const U(*)[], T(*)[]>>>
+		Span(const std::vector<U, Alloc>& vector) noexcept :
+			ptr(vector.data()),
+			count(vector.size()) {}
+		template<typename U, typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+		constexpr Span(const Span<U>& other) noexcept :
+			ptr(other.data()),
+			count(other.size()) {}
+
+		[[nodiscard]] constexpr T* data() const noexcept { return ptr; }
+		[[nodiscard]] constexpr size_t size() const noexcept { return count; }
+		[[nodiscard]] constexpr size_t size_bytes() const noexcept { return count * sizeof(T); }
+		[[nodiscard]] constexpr bool empty() const noexcept { return count == 0; }
+
+		[[nodiscard]] constexpr T* begin() const noexcept { return ptr; }
+		[[nodiscard]] constexpr T* end() const noexcept { return ptr + count; }
+
+		[[nodiscard]] constexpr T& front() const
+		{
+			assert(count > 0);
+			return ptr[0];
+		}
+		[[nodiscard]] constexpr T& back() const
+		{
+			assert(count > 0);
+			return ptr[count - 1];
+		}
+
+		[[nodiscard]] constexpr Span<T> first(size_t n) const
+		{
+			assert(n <= count);
+			return Span<T>{ ptr, n };
+		}
+		[[nodiscard]] constexpr Span<T> last(size_t n) const
+		{
+			assert(n <= count);
+			return Span<T>{ ptr + count - n, n };
+		}
+		[[nodiscard]] constexpr Span<T> subspan(size_t offset, size_t n = size_t(-1)) const
+		{
+			assert(offset <= count);
+			return Span<T>{ ptr + offset, n == size_t(-1) ? count - offset : n };
+		}
+
+		[[nodiscard]] constexpr T& operator[](size_t index) const
+		{
+#if defined( _MSC_VER )
+			__assume(index < count);
+#endif
+			assert(index < count);
+			return ptr[index];
+		}
+
+	private:
+		T* ptr = nullptr;
+		size_t count = 0;
+	};
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,423 @@
+#pragma once
+
+#include "Common.hpp"
+#include "Vector/Vector.hpp"
+#include "RadixSort.hpp"
+#include "Span.hpp"
+#include "Parallel.hpp"
+#include "Execution.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace Math
+{
+	// Uniform grid over unbounded space, with cells hashed into a fixed size table.
+	// The hash wraps cell coordinates around a power of two sized block of buckets, so cells that are
+	// neighbors along x are neighbors in the table and a query scans one contiguous range per row of cells.
+	// Points are stored sorted by bucket (counting sort), so a rebuild only touches flat arrays
+	// and every bucket is a contiguous range of indices and positions.
+	// Queries test every point in the buckets the query overlaps, so hash collisions only cost time.
+	template<typename T = float>
+	class SpatialHashGrid
+	{
+	public:
+		using ValueType = T;
+
+		SpatialHashGrid() = default;
+		// A cell size close to the query radius is usually the best choice.
+		// A tableSize of 0 sizes the table on every build to the power of two at or above the point count.
+		explicit SpatialHashGrid(T cellSize, uint32_t tableSize = 0);
+
+		void Build(Span<const Vector<3, T>> points);
+		// Same result as Build.
+		void Build_Parallel(Span<const Vector<3, T>> points, size_t grainSize = Setup::defaultParallelGrainSize);
+		// std::execution::par and par_unseq run Build_Parallel, other policies Build.
+		template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+		void Build(ExecutionPolicy&& policy, Span<const Vector<3, T>> points);
+
+		// Calls visit(pointIndex, distanceSqrd) for every point within radius of center.
+		template<typename Func>
+		void ForEachInRadius(const Vector<3, T>& center, T radius, Func&& visit) const;
+		// Appends the indices of every point within radius of center.
+		void QueryRadius(const Vector<3, T>& center, T radius, std::vector<uint32_t>& pointIndices) const;
+		// Batched queries. The neighbors of centers[i] are pointIndices[offsets[i]] to pointIndices[offsets[i + 1]].
+		void QueryRadius(Span<const Vector<3, T>> centers, T radius, std::vector<uint32_t>& offsets, std::vector<uint32_t>& pointIndices) const;
+		void QueryRadius_Parallel(Span<const Vector<3, T>> centers, T radius, std::vector<uint32_t>& offsets, std::vector<uint32_t>& pointIndices, size_t grainSize = 1024) const;
+		// std::execution::par and par_unseq run QueryRadius_Parallel, other policies the single thread batched QueryRadius.
+		template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+		void QueryRadius(ExecutionPolicy&& policy, Span<const Vector<3, T>> centers, T radius, std::vector<uint32_t>& offsets, std::vector<uint32_t>& pointIndices) const;
+
+		// Calls visit(i, j, distanceSqrd) once for every pair of points with i < j that are within radius of each other.
+		template<typename Func>
+		void ForEachPairInRadius(T radius, Func&& visit) const;
+		// visit may be called concurrently from several threads.
+		template<typename Func>
+		void ForEachPairInRadius_Parallel(T radius, Func&& visit, size_t grainSize = 1024) const;
+		// std::execution::par and par_unseq run ForEachPairInRadius_Parallel, so visit may then be called concurrently.
+		template<typename ExecutionPolicy, typename Func, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+		void ForEachPairInRadius(ExecutionPolicy&& policy, T radius, Func&& visit) const;
+
+		[[nodiscard]] T GetCellSize() const;
+		[[nodiscard]] size_t GetPointCount() const;
+		// Point indices in bucket order.
+		[[nodiscard]] Span<const uint32_t> GetSortedIndices() const;
+		// Positions in bucket order, parallel to GetSortedIndices().
+		[[nodiscard]] Span<const Vector<3, T>> GetSortedPositions() const;
+
+	private:
+		T cellSize = T(1);
+		T inverseCellSize = T(1);
+		uint32_t requestedTableSize = 0;
+		// Bits of the bucket index used by each cell coordinate.
+		uint32_t bitCounts[3] = {};
+		// bucketStarts[b] to bucketStarts[b + 1] is the range of bucket b in the sorted arrays.
+		std::vector<uint32_t> bucketStarts;
+		std::vector<uint32_t> sortedIndices;
+		std::vector<Vector<3, T>> sortedPositions;
+		// Build scratch, kept to avoid reallocating every tick.
+		std::vector<uint32_t> pointBuckets;
+
+		void PrepareBuild(size_t pointCount);
+		[[nodiscard]] uint32_t GetBucket(int32_t x, int32_t y, int32_t z) const;
+		[[nodiscard]] uint32_t GetBucket(const Vector<3, T>& point) const;
+
+		static_assert(std::is_floating_point_v<T>, "DMath error. Math::SpatialHashGrid must be of floating point type.");
+	};
+
+	namespace detail
+	{
+		namespace SpatialHash
+		{
+			template<typename T>
+			[[nodiscard]] inline int32_t GetCellCoordinate(T value, T inverseCellSize)
+			{
+				return int32_t(std::floor(value * inverseCellSize));
+			}
+
+			[[nodiscard]] constexpr uint32_t GetTableSize(size_t pointCount)
+			{
+				uint32_t size = 1;
+				while (size < pointCount && size < (1u << 30))
+					size <<= 1;
+				return size;
+			}
+
+			// Cells [first, first + count) along one axis, wrapped into the table. count never exceeds the table's
+			// extent along the axis, so no bucket is visited twice.
+			struct AxisRange
+			{
+				uint32_t first;
+				uint32_t count;
+			};
+
+			[[nodiscard]] inline AxisRange GetAxisRange(int32_t min, int32_t max, uint32_t bitCount)
+			{
+				const uint32_t extent = 1u << bitCount;
+				const uint64_t count = uint64_t(int64_t(max) - int64_t(min) + 1);
+				if (count >= extent)
+					return AxisRange{ 0, extent };
+				return AxisRange{ uint32_t(min) & (extent - 1), uint32_t(count) };
+			}
+		}
+	}
+}
+
+template<typename T>
+Math::SpatialHashGrid<T>::SpatialHashGrid(T cellSize, uint32_t tableSize) :
+	cellSize(cellSize),
+	inverseCellSize(T(1) / cellSize),
+	requestedTableSize(tableSize)
+{
+	assert(cellSize > T(0));
+	assert(tableSize == 0 || (tableSize & (tableSize - 1)) == 0);
+}
+
+template<typename T>
+void Math::SpatialHashGrid<T>::PrepareBuild(size_t pointCount)
+{
+	assert(pointCount < std::numeric_limits<uint32_t>::max());
+
+	const uint32_t tableSize = requestedTableSize != 0 ? requestedTableSize : detail::SpatialHash::GetTableSize(pointCount);
+	uint32_t bitCount = 0;
+	while ((1u << bitCount) < tableSize)
+		bitCount++;
+	// x gets the spare bits, since rows along x are the contiguous ranges.
+	bitCounts[0] = (bitCount + 2) / 3;
+	bitCounts[1] = (bitCount + 1) / 3;
+	bitCounts[2] = bitCount / 3;
+	bucketStarts.assign(size_t(tableSize) + 1, 0);
+	sortedIndices.resize(pointCount);
+	sortedPositions.resize(pointCount);
+	pointBuckets.resize(pointCount);
+}
+
+template<typename T>
+uint32_t Math::SpatialHashGrid<T>::GetBucket(int32_t x, int32_t y, int32_t z) const
+{
+	const uint32_t wrappedX = uint32_t(x) & ((1u << bitCounts[0]) - 1);
+	const uint32_t wrappedY = uint32_t(y) & ((1u << bitCounts[1]) - 1);
+	const uint32_t wrappedZ = uint32_t(z) & ((1u << bitCounts[2]) - 1);
+	return wrappedX | (wrappedY << bitCounts[0]) | (wrappedZ << (bitCounts[0] + bitCounts[1]));
+}
+
+template<typename T>
+uint32_t Math::SpatialHashGrid<T>::GetBucket(const Vector<3, T>& point) const
+{
+	using namespace detail::SpatialHash;
+	return GetBucket(GetCellCoordinate(point.x, inverseCellSize), GetCellCoordinate(point.y, inverseCellSize), GetCellCoordinate(point.z, inverseCellSize));
+}
+
+template<typename T>
+void Math::SpatialHashGrid<T>::Build(Span<const Vector<3, T>> points)
+{
+	PrepareBuild(points.size());
+
+	// Counting sort: count per bucket, exclusive prefix sum, then a stable scatter.
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		const uint32_t bucket = GetBucket(points[i]);
+		pointBuckets[i] = bucket;
+		bucketStarts[bucket + 1]++;
+	}
+	for (size_t bucket = 1; bucket < bucketStarts.size(); bucket++)
+		bucketStarts[bucket] += bucketStarts[bucket - 1];
+
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		const uint32_t slot = bucketStarts[pointBuckets[i]]++;
+		sortedIndices[slot] = uint32_t(i);
+	}
+	// The scatter advanced every start to the end of its bucket. Shifting restores them.
+	for (size_t bucket = bucketStarts.size() - 1; bucket > 0; bucket--)
+		bucketStarts[bucket] = bucketStarts[bucket - 1];
+	bucketStarts[0] = 0;
+
+	for (size_t slot = 0; slot < points.size(); slot++)
+		sortedPositions[slot] = points[sortedIndices[slot]];
+}
+
+template<typename T>
+void Math::SpatialHashGrid<T>::Build_Parallel(Span<const Vector<3, T>> points, size_t grainSize)
+{
+	PrepareBuild(points.size());
+	const size_t pointCount = points.size();
+
+	ParallelFor(0, pointCount, grainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			pointBuckets[i] = GetBucket(points[i]);
+			sortedIndices[i] = uint32_t(i);
+		}
+	});
+
+	// A stable radix sort of (bucket, index) pairs is the counting sort split into digit passes,
+	// which parallelizes without a per-thread copy of the bucket table.
+	RadixSort_Parallel(Span<uint32_t>(pointBuckets), Span<uint32_t>(sortedIndices), grainSize);
+
+	// Every bucket boundary in the sorted keys sets the starts of the buckets it skips over.
+	const auto bucketCount = uint32_t(bucketStarts.size() - 1);
+	ParallelFor(0, pointCount, grainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t slot = begin; slot < end; slot++)
+		{
+			sortedPositions[slot] = points[sortedIndices[slot]];
+			const uint32_t previous = slot == 0 ? 0 : pointBuckets[slot - 1] + 1;
+			for (uint32_t bucket = previous; bucket <= pointBuckets[slot]; bucket++)
+				bucketStarts[bucket] = uint32_t(slot);
+		}
+	});
+	const uint32_t lastBucket = pointCount == 0 ? 0 : pointBuckets[pointCount - 1] + 1;
+	for (uint32_t bucket = lastBucket; bucket <= bucketCount; bucket++)
+		bucketStarts[bucket] = uint32_t(pointCount);
+}
+
+template<typename T>
+template<typename ExecutionPolicy, typename>
+void Math::SpatialHashGrid<T>::Build(ExecutionPolicy&&, Span<const Vector<3, T>> points)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Build_Parallel(points);
+	else
+		Build(points);
+}
+
+template<typename T>
+template<typename Func>
+void Math::SpatialHashGrid<T>::ForEachInRadius(const Vector<3, T>& center, T radius, Func&& visit) const
+{
+	using namespace detail::SpatialHash;
+	if (sortedIndices.empty())
+		return;
+
+	const int32_t minX = GetCellCoordinate(center.x - radius, inverseCellSize);
+	const int32_t minY = GetCellCoordinate(center.y - radius, inverseCellSize);
+	const int32_t minZ = GetCellCoordinate(center.z - radius, inverseCellSize);
+	const int32_t maxX = GetCellCoordinate(center.x + radius, inverseCellSize);
+	const int32_t maxY = GetCellCoordinate(center.y + radius, inverseCellSize);
+	const int32_t maxZ = GetCellCoordinate(center.z + radius, inverseCellSize);
+
+	const AxisRange rangeX = GetAxisRange(minX, maxX, bitCounts[0]);
+	const AxisRange rangeY = GetAxisRange(minY, maxY, bitCounts[1]);
+	const AxisRange rangeZ = GetAxisRange(minZ, maxZ, bitCounts[2]);
+	const uint32_t extentX = 1u << bitCounts[0];
+	// The x range of a row is at most two runs of buckets, split where it wraps.
+	const uint32_t firstRunLength = std::min(rangeX.count, extentX - rangeX.first);
+	const uint32_t secondRunLength = rangeX.count - firstRunLength;
+
+	const T radiusSqrd = radius * radius;
+	const auto visitBuckets = [&](uint32_t firstBucket, uint32_t bucketCount)
+	{
+		const uint32_t end = bucketStarts[firstBucket + bucketCount];
+		for (uint32_t slot = bucketStarts[firstBucket]; slot < end; slot++)
+		{
+			const Vector<3, T> delta = sortedPositions[slot] - center;
+			const T distanceSqrd = Vector<3, T>::Dot(delta, delta);
+			if (distanceSqrd <= radiusSqrd)
+				visit(sortedIndices[slot], distanceSqrd);
+		}
+	};
+	for (uint32_t z = 0; z < rangeZ.count; z++)
+	{
+		for (uint32_t y = 0; y < rangeY.count; y++)
+		{
+			const uint32_t rowBucket = GetBucket(0, int32_t(rangeY.first + y), int32_t(rangeZ.first + z));
+			visitBuckets(rowBucket + rangeX.first, firstRunLength);
+			if (secondRunLength != 0)
+				visitBuckets(rowBucket, secondRunLength);
+		}
+	}
+}
+
+template<typename T>
+void Math::SpatialHashGrid<T>::QueryRadius(const Vector<3, T>& center, T radius, std::vector<uint32_t>& pointIndices) const
+{
+	ForEachInRadius(center, radius, [&](uint32_t pointIndex, T)
+	{
+		pointIndices.push_back(pointIndex);
+	});
+}
+
+template<typename T>
+void Math::SpatialHashGrid<T>::QueryRadius(Span<const Vector<3, T>> centers, T radius, std::vector<uint32_t>& offsets, std::vector<uint32_t>& pointIndices) const
+{
+	offsets.resize(centers.size() + 1);
+	pointIndices.clear();
+	for (size_t i = 0; i < centers.size(); i++)
+	{
+		offsets[i] = uint32_t(pointIndices.size());
+		QueryRadius(centers[i], radius, pointIndices);
+	}
+	offsets[centers.size()] = uint32_t(pointIndices.size());
+}
+
+template<typename T>
+void Math::SpatialHashGrid<T>::QueryRadius_Parallel(Span<const Vector<3, T>> centers, T radius, std::vector<uint32_t>& offsets, std::vector<uint32_t>& pointIndices, size_t grainSize) const
+{
+	assert(grainSize > 0);
+
+	// Each chunk of queries gathers its results locally, then the chunks are concatenated in order.
+	// ParallelFor may hand several chunks to one call, so chunks are walked explicitly.
+	const size_t chunkCount = (centers.size() + grainSize - 1) / grainSize;
+	std::vector<std::vector<uint32_t>> chunkIndices(chunkCount);
+	offsets.resize(centers.size() + 1);
+	ParallelFor(0, centers.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+		{
+			auto& indices = chunkIndices[chunkBegin / grainSize];
+			for (size_t i = chunkBegin; i < std::min(chunkBegin + grainSize, end); i++)
+			{
+				offsets[i] = uint32_t(indices.size());
+				QueryRadius(centers[i], radius, indices);
+			}
+		}
+	});
+
+	std::vector<size_t> chunkStarts(chunkCount + 1, 0);
+	for (size_t chunk = 0; chunk < chunkCount; chunk++)
+		chunkStarts[chunk + 1] = chunkStarts[chunk] + chunkIndices[chunk].size();
+	pointIndices.resize(chunkStarts[chunkCount]);
+
+	ParallelFor(0, centers.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+		{
+			const size_t chunk = chunkBegin / grainSize;
+			std::copy(chunkIndices[chunk].begin(), chunkIndices[chunk].end(), pointIndices.begin() + chunkStarts[chunk]);
+			for (size_t i = chunkBegin; i < std::min(chunkBegin + grainSize, end); i++)
+				offsets[i] += uint32_t(chunkStarts[chunk]);
+		}
+	});
+	offsets[centers.size()] = uint32_t(pointIndices.size());
+}
+
+template<typename T>
+template<typename ExecutionPolicy, typename>
+void Math::SpatialHashGrid<T>::QueryRadius(ExecutionPolicy&&, Span<const Vector<3, T>> centers, T radius, std::vector<uint32_t>& offsets, std::vector<uint32_t>& pointIndices) const
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		QueryRadius_Parallel(centers, radius, offsets, pointIndices);
+	else
+		QueryRadius(centers, radius, offsets, pointIndices);
+}
+
+template<typename T>
+template<typename Func>
+void Math::SpatialHashGrid<T>::ForEachPairInRadius(T radius, Func&& visit) const
+{
+	for (size_t slot = 0; slot < sortedIndices.size(); slot++)
+	{
+		const uint32_t i = sortedIndices[slot];
+		ForEachInRadius(sortedPositions[slot], radius, [&](uint32_t j, T distanceSqrd)
+		{
+			if (i < j)
+				visit(i, j, distanceSqrd);
+		});
+	}
+}
+
+template<typename T>
+template<typename Func>
+void Math::SpatialHashGrid<T>::ForEachPairInRadius_Parallel(T radius, Func&& visit, size_t grainSize) const
+{
+	ParallelFor(0, sortedIndices.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		for (size_t slot = begin; slot < end; slot++)
+		{
+			const uint32_t i = sortedIndices[slot];
+			ForEachInRadius(sortedPositions[slot], radius, [&](uint32_t j, T distanceSqrd)
+			{
+				if (i < j)
+					visit(i, j, distanceSqrd);
+			});
+		}
+	});
+}
+
+template<typename T>
+template<typename ExecutionPolicy, typename Func, typename>
+void Math::SpatialHashGrid<T>::ForEachPairInRadius(ExecutionPolicy&&, T radius, Func&& visit) const
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		ForEachPairInRadius_Parallel(radius, std::forward<Func>(visit));
+	else
+		ForEachPairInRadius(radius, std::forward<Func>(visit));
+}
+
+template<typename T>
+T Math::SpatialHashGrid<T>::GetCellSize() const { return cellSize; }
+
+template<typename T>
+size_t Math::SpatialHashGrid<T>::GetPointCount() const { return sortedIndices.size(); }
+
+template<typename T>
+Math::Span<const uint32_t> Math::SpatialHashGrid<T>::GetSortedIndices() const { return sortedIndices; }
+
+template<typename T>
+Math::Span<const Math::Vector<3, T>> Math::SpatialHashGrid<T>::GetSortedPositions() const { return sortedPositions; }
\ No newline at end of file
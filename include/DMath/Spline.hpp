@@ -0,0 +1,394 @@
+#pragma once
+
+#include "Setup.hpp"
+#include "Enum.hpp"
+#include "Simd.hpp"
+#include "Span.hpp"
+#include "Parallel.hpp"
+#include "Execution.hpp"
+#include "Polynomial.hpp"
+#include "Vector/Vector.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace Math
+{
+	// Piecewise cubic curve through control points of any dimension.
+	// Every segment is converted to a cubic polynomial in power basis when the spline is created,
+	// so evaluating is a segment lookup followed by Horner's scheme.
+	// Segment i covers times[i] to times[i + 1], times outside of the spline are clamped to its ends.
+	template<SplineType type, size_t length, typename T = float>
+	class Spline
+	{
+	public:
+		using ValueType = T;
+		using PointType = Vector<length, T>;
+		using SegmentType = Polynomial<3, PointType>;
+		static constexpr SplineType splineType = type;
+
+		// Remembers the segment of the last lookup, so that sampling at increasing or decreasing times
+		// only steps to the neighboring segment instead of searching every time.
+		class Cursor
+		{
+		public:
+			explicit Cursor(const Spline<type, length, T>& spline);
+
+			[[nodiscard]] PointType Evaluate(T time);
+			// Derivative with respect to time.
+			[[nodiscard]] PointType EvaluateDerivative(T time);
+			// Segment of the last lookup.
+			[[nodiscard]] size_t GetSegment() const;
+
+		private:
+			const Spline<type, length, T>* spline;
+			size_t segment = 0;
+
+			friend class Spline<type, length, T>;
+		};
+
+		Spline() = default;
+		// Segment i covers the times i to i + 1.
+		explicit Spline(Span<const PointType> controlPoints);
+		// times holds one more time than there are segments, strictly increasing.
+		Spline(Span<const PointType> controlPoints, Span<const T> times);
+
+		// Number of segments made from controlPointCount control points, 0 if the count is invalid for the spline type.
+		[[nodiscard]] static constexpr size_t GetSegmentCount(size_t controlPointCount);
+
+		[[nodiscard]] PointType Evaluate(T time) const;
+		// Derivative with respect to time.
+		[[nodiscard]] PointType EvaluateDerivative(T time) const;
+		[[nodiscard]] Cursor GetCursor() const;
+
+		// Batch versions. Sorted times are looked up in constant time each, any order gives the same results as the single value Evaluate.
+		void Evaluate(Span<const T> times, Span<PointType> output) const;
+		void Evaluate_Parallel(Span<const T> times, Span<PointType> output, size_t grainSize = Setup::defaultParallelGrainSize) const;
+		// std::execution::par and par_unseq run Evaluate_Parallel, other policies the single thread Evaluate.
+		template<typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+		void Evaluate(ExecutionPolicy&& policy, Span<const T> times, Span<PointType> output) const;
+		// output.size() points evenly spaced in time from the start to the end of the spline, both included.
+		void Sample(Span<PointType> output) const;
+
+		// Index of the segment covering time.
+		[[nodiscard]] size_t FindSegment(T time) const;
+		[[nodiscard]] size_t GetSegmentCount() const;
+		[[nodiscard]] bool IsEmpty() const;
+		[[nodiscard]] const SegmentType& GetSegment(size_t index) const;
+		[[nodiscard]] T GetStartTime() const;
+		[[nodiscard]] T GetEndTime() const;
+		[[nodiscard]] Span<const T> GetTimes() const;
+
+	private:
+		std::vector<SegmentType> segments;
+		std::vector<T> times;
+		std::vector<T> inverseDurations;
+
+		// Parameter of time within the segment, in [0, 1].
+		[[nodiscard]] T GetSegmentParameter(size_t segment, T time) const;
+		// Moves segment to the one covering time, starting from its current value.
+		void UpdateSegment(size_t& segment, T time) const;
+
+		static_assert(std::is_floating_point_v<T>, "DMath error. Math::Spline must be of floating point type.");
+	};
+
+	namespace detail
+	{
+		namespace Spline
+		{
+			// Power basis coefficients of the segment starting at points[0].
+			template<SplineType type, size_t length, typename T>
+			[[nodiscard]] Math::Polynomial<3, Math::Vector<length, T>> GetSegment(const Math::Vector<length, T>* points)
+			{
+				const auto& p0 = points[0];
+				const auto& p1 = points[1];
+				const auto& p2 = points[2];
+				const auto& p3 = points[3];
+				// -p0 + 3p1 - 3p2 + p3 is the cubic term of all three bases, up to a factor.
+				const auto cubic = (p1 - p2) * T(3) + p3 - p0;
+				if constexpr (type == SplineType::Bezier)
+					return { p0, (p1 - p0) * T(3), (p0 - p1 * T(2) + p2) * T(3), cubic };
+				else if constexpr (type == SplineType::CatmullRom)
+					return { p1, (p2 - p0) * T(0.5), (p0 * T(2) - p1 * T(5) + p2 * T(4) - p3) * T(0.5), cubic * T(0.5) };
+				else
+					return { (p0 + p1 * T(4) + p2) * (T(1) / T(6)), (p2 - p0) * T(0.5), (p0 - p1 * T(2) + p2) * T(0.5), cubic * (T(1) / T(6)) };
+			}
+
+			// Control points between the starts of consecutive segments.
+			template<SplineType type>
+			constexpr size_t segmentStride = type == SplineType::Bezier ? 3 : 1;
+		}
+	}
+}
+
+template<Math::SplineType type, size_t length, typename T>
+constexpr size_t Math::Spline<type, length, T>::GetSegmentCount(size_t controlPointCount)
+{
+	if (controlPointCount < 4)
+		return 0;
+	if constexpr (type == SplineType::Bezier)
+		return (controlPointCount - 1) % 3 == 0 ? (controlPointCount - 1) / 3 : 0;
+	else
+		return controlPointCount - 3;
+}
+
+template<Math::SplineType type, size_t length, typename T>
+Math::Spline<type, length, T>::Spline(Span<const PointType> controlPoints)
+{
+	const size_t segmentCount = GetSegmentCount(controlPoints.size());
+	assert(segmentCount > 0);
+
+	std::vector<T> uniformTimes(segmentCount + 1);
+	for (size_t i = 0; i <= segmentCount; i++)
+		uniformTimes[i] = T(i);
+	*this = Spline(controlPoints, uniformTimes);
+}
+
+template<Math::SplineType type, size_t length, typename T>
+Math::Spline<type, length, T>::Spline(Span<const PointType> controlPoints, Span<const T> times) :
+	times(times.begin(), times.end())
+{
+	const size_t segmentCount = GetSegmentCount(controlPoints.size());
+	assert(segmentCount > 0 && times.size() == segmentCount + 1);
+
+	segments.reserve(segmentCount);
+	inverseDurations.reserve(segmentCount);
+	for (size_t i = 0; i < segmentCount; i++)
+	{
+		assert(times[i] < times[i + 1]);
+		segments.push_back(detail::Spline::GetSegment<type>(controlPoints.data() + i * detail::Spline::segmentStride<type>));
+		inverseDurations.push_back(T(1) / (times[i + 1] - times[i]));
+	}
+}
+
+template<Math::SplineType type, size_t length, typename T>
+T Math::Spline<type, length, T>::GetSegmentParameter(size_t segment, T time) const
+{
+	const T parameter = (time - times[segment]) * inverseDurations[segment];
+	return std::clamp(parameter, T(0), T(1));
+}
+
+template<Math::SplineType type, size_t length, typename T>
+size_t Math::Spline<type, length, T>::FindSegment(T time) const
+{
+	assert(!IsEmpty());
+
+	// The first segment also covers earlier times, the last one later times.
+	const auto inner = std::upper_bound(times.begin() + 1, times.end() - 1, time);
+	return size_t(inner - (times.begin() + 1));
+}
+
+template<Math::SplineType type, size_t length, typename T>
+void Math::Spline<type, length, T>::UpdateSegment(size_t& segment, T time) const
+{
+	// A few steps cover monotonic sampling, anything further is searched.
+	constexpr size_t maxStepCount = 4;
+	const size_t lastSegment = segments.size() - 1;
+	for (size_t step = 0; step < maxStepCount; step++)
+	{
+		if (segment < lastSegment && time >= times[segment + 1])
+			segment++;
+		else if (segment > 0 && time < times[segment])
+			segment--;
+		else
+			return;
+	}
+	segment = FindSegment(time);
+}
+
+template<Math::SplineType type, size_t length, typename T>
+auto Math::Spline<type, length, T>::Evaluate(T time) const -> PointType
+{
+	const size_t segment = FindSegment(time);
+	return segments[segment].Evaluate(GetSegmentParameter(segment, time));
+}
+
+template<Math::SplineType type, size_t length, typename T>
+auto Math::Spline<type, length, T>::EvaluateDerivative(T time) const -> PointType
+{
+	const size_t segment = FindSegment(time);
+	return segments[segment].GetDerivative().Evaluate(GetSegmentParameter(segment, time)) * inverseDurations[segment];
+}
+
+template<Math::SplineType type, size_t length, typename T>
+auto Math::Spline<type, length, T>::GetCursor() const -> Cursor
+{
+	return Cursor(*this);
+}
+
+template<Math::SplineType type, size_t length, typename T>
+void Math::Spline<type, length, T>::Evaluate(Span<const T> times, Span<PointType> output) const
+{
+	assert(output.size() == times.size());
+	assert(!IsEmpty());
+
+	constexpr size_t laneCount = detail::Simd::floatLaneCount;
+	size_t segment = 0;
+	size_t i = 0;
+	if constexpr (laneCount > 1 && std::is_same_v<T, float>)
+	{
+		// Densely sampled curves have whole registers of times within one segment,
+		// which are evaluated together with the segment's coefficients broadcast.
+		using L = detail::Simd::FloatLanes<laneCount>;
+		constexpr uint32_t allLanes = uint32_t((uint64_t(1) << laneCount) - 1);
+		const size_t lastSegment = segments.size() - 1;
+		alignas(64) float components[length][laneCount];
+		for (; i + laneCount <= times.size(); i += laneCount)
+		{
+			// Times before the start belong to the first segment, times after the end to the last.
+			UpdateSegment(segment, times[i]);
+			const float lowerBound = segment > 0 ? this->times[segment] : -std::numeric_limits<float>::infinity();
+			const float upperBound = segment < lastSegment ? this->times[segment + 1] : std::numeric_limits<float>::infinity();
+			const auto timeValues = L::LoadUnaligned(times.data() + i);
+			const auto isInSegment = L::And(L::GreaterEqual(timeValues, L::Set(lowerBound)), L::Less(timeValues, L::Set(upperBound)));
+			if (L::ToBits(isInSegment) != allLanes)
+			{
+				for (size_t lane = 0; lane < laneCount; lane++)
+				{
+					UpdateSegment(segment, times[i + lane]);
+					output[i + lane] = segments[segment].Evaluate(GetSegmentParameter(segment, times[i + lane]));
+				}
+				continue;
+			}
+
+			// Same operations and clamping order as GetSegmentParameter.
+			const auto zero = L::Set(0.f);
+			const auto one = L::Set(1.f);
+			auto parameterValues = L::Mul(L::Sub(timeValues, L::Set(this->times[segment])), L::Set(inverseDurations[segment]));
+			parameterValues = L::Select(L::Less(parameterValues, zero), zero, L::Select(L::Less(one, parameterValues), one, parameterValues));
+			for (size_t component = 0; component < length; component++)
+				L::Store(components[component], detail::Polynomial::EvaluateComponent<L>(segments[segment], component, parameterValues));
+			for (size_t lane = 0; lane < laneCount; lane++)
+			{
+				for (size_t component = 0; component < length; component++)
+					output[i + lane][component] = components[component][lane];
+			}
+		}
+	}
+
+	for (; i < times.size(); i++)
+	{
+		UpdateSegment(segment, times[i]);
+		output[i] = segments[segment].Evaluate(GetSegmentParameter(segment, times[i]));
+	}
+}
+
+template<Math::SplineType type, size_t length, typename T>
+void Math::Spline<type, length, T>::Evaluate_Parallel(Span<const T> times, Span<PointType> output, size_t grainSize) const
+{
+	assert(output.size() == times.size());
+
+	ParallelFor(0, times.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		Evaluate(times.subspan(begin, end - begin), output.subspan(begin, end - begin));
+	});
+}
+
+template<Math::SplineType type, size_t length, typename T>
+template<typename ExecutionPolicy, typename>
+void Math::Spline<type, length, T>::Evaluate(ExecutionPolicy&&, Span<const T> times, Span<PointType> output) const
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Evaluate_Parallel(times, output);
+	else
+		Evaluate(times, output);
+}
+
+template<Math::SplineType type, size_t length, typename T>
+void Math::Spline<type, length, T>::Sample(Span<PointType> output) const
+{
+	assert(!IsEmpty());
+
+	if (output.empty())
+		return;
+	if (output.size() == 1)
+	{
+		output[0] = Evaluate(GetStartTime());
+		return;
+	}
+
+	constexpr size_t blockLength = 1024;
+	T sampleTimes[blockLength];
+	const T step = (GetEndTime() - GetStartTime()) / T(output.size() - 1);
+	for (size_t begin = 0; begin < output.size(); begin += blockLength)
+	{
+		const size_t count = std::min(blockLength, output.size() - begin);
+		for (size_t i = 0; i < count; i++)
+			sampleTimes[i] = GetStartTime() + T(begin + i) * step;
+		if (begin + count == output.size())
+			sampleTimes[count - 1] = GetEndTime();
+		Evaluate(Span<const T>(sampleTimes, count), output.subspan(begin, count));
+	}
+}
+
+template<Math::SplineType type, size_t length, typename T>
+size_t Math::Spline<type, length, T>::GetSegmentCount() const
+{
+	return segments.size();
+}
+
+template<Math::SplineType type, size_t length, typename T>
+bool Math::Spline<type, length, T>::IsEmpty() const
+{
+	return segments.empty();
+}
+
+template<Math::SplineType type, size_t length, typename T>
+auto Math::Spline<type, length, T>::GetSegment(size_t index) const -> const SegmentType&
+{
+	assert(index < segments.size());
+	return segments[index];
+}
+
+template<Math::SplineType type, size_t length, typename T>
+T Math::Spline<type, length, T>::GetStartTime() const
+{
+	assert(!IsEmpty());
+	return times.front();
+}
+
+template<Math::SplineType type, size_t length, typename T>
+T Math::Spline<type, length, T>::GetEndTime() const
+{
+	assert(!IsEmpty());
+	return times.back();
+}
+
+template<Math::SplineType type, size_t length, typename T>
+auto Math::Spline<type, length, T>::GetTimes() const -> Span<const T>
+{
+	return Span<const T>(times.data(), times.size());
+}
+
+template<Math::SplineType type, size_t length, typename T>
+Math::Spline<type, length, T>::Cursor::Cursor(const Spline<type, length, T>& spline) :
+	spline(&spline) {}
+
+template<Math::SplineType type, size_t length, typename T>
+auto Math::Spline<type, length, T>::Cursor::Evaluate(T time) -> PointType
+{
+	assert(!spline->IsEmpty());
+
+	spline->UpdateSegment(segment, time);
+	return spline->segments[segment].Evaluate(spline->GetSegmentParameter(segment, time));
+}
+
+template<Math::SplineType type, size_t length, typename T>
+auto Math::Spline<type, length, T>::Cursor::EvaluateDerivative(T time) -> PointType
+{
+	assert(!spline->IsEmpty());
+
+	spline->UpdateSegment(segment, time);
+	return spline->segments[segment].GetDerivative().Evaluate(spline->GetSegmentParameter(segment, time)) * spline->inverseDurations[segment];
+}
+
+template<Math::SplineType type, size_t length, typename T>
+size_t Math::Spline<type, length, T>::Cursor::GetSegment() const
+{
+	return segment;
+}
\ No newline at end of file
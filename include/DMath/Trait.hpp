@@ -1,8 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <type_traits>
-#include <cstdint>
 
 namespace Math
 {
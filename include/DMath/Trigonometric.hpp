@@ -2,35 +2,438 @@
 
 #include "Setup.hpp"
 #include "Constant.hpp"
+#include "Simd.hpp"
+#include "Span.hpp"
+#include "Parallel.hpp"
+#include "Execution.hpp"
 
+#include <cassert>
 #include <cmath>
+#include <cstdint>
 
 namespace Math
-{	
-	template<AngleUnit angleUnit = Setup::defaultAngleUnit>
-	[[nodiscard]] auto Sin(float input)
+{
+	struct SinCosPair
 	{
-		if constexpr (angleUnit == AngleUnit::Radians)
-			return std::sin(input);
-		else if constexpr (angleUnit == AngleUnit::Degrees)
-			return std::sin(input * degToRad);
-	}
+		float sin;
+		float cos;
+	};
+
+	// Sine, cosine and tangent use a shared range reduction to [-45, 45] degrees followed by a minimax polynomial.
+	// Arguments too large for the reduction (beyond 8192 radians or 2^20 degrees), infinities and NaNs go to the standard library.
+	// Usable in constant expressions for arguments within the reduction range, with the same results as at run time.
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision>
+	[[nodiscard]] constexpr float Sin(float input);
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision>
+	[[nodiscard]] constexpr float Cos(float input);
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision>
+	[[nodiscard]] constexpr float Tan(float input);
+	// Sine and cosine of the same angle, for the cost of one range reduction.
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision>
+	[[nodiscard]] constexpr SinCosPair SinCos(float input);
+
+	// Batch versions. Results match the single value functions. output may be the same span as input.
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision>
+	void Sin(Span<const float> input, Span<float> output);
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision>
+	void Cos(Span<const float> input, Span<float> output);
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision>
+	void Tan(Span<const float> input, Span<float> output);
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision>
+	void SinCos(Span<const float> input, Span<float> sin, Span<float> cos);
+
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision>
+	void Sin_Parallel(Span<const float> input, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision>
+	void Cos_Parallel(Span<const float> input, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision>
+	void Tan_Parallel(Span<const float> input, Span<float> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision>
+	void SinCos_Parallel(Span<const float> input, Span<float> sin, Span<float> cos, size_t grainSize = Setup::defaultParallelGrainSize);
+	// std::execution::par and par_unseq run the _Parallel versions, other policies the single thread ones.
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Sin(ExecutionPolicy&& policy, Span<const float> input, Span<float> output);
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Cos(ExecutionPolicy&& policy, Span<const float> input, Span<float> output);
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void Tan(ExecutionPolicy&& policy, Span<const float> input, Span<float> output);
+	template<AngleUnit angleUnit = Setup::defaultAngleUnit, TrigPrecision precision = Setup::defaultTrigPrecision, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void SinCos(ExecutionPolicy&& policy, Span<const float> input, Span<float> sin, Span<float> cos);
 
-	template<AngleUnit angleUnit = Setup::defaultAngleUnit>
-	[[nodiscard]] auto Cos(float input)
+	namespace detail
 	{
-		if constexpr (angleUnit == AngleUnit::Radians)
-			return std::cos(input);
-		else if constexpr (angleUnit == AngleUnit::Degrees)
-			return std::cos(input * degToRad);
+		namespace Trigonometric
+		{
+			template<AngleUnit angleUnit>
+			constexpr float reductionLimit = angleUnit == AngleUnit::Radians ? 8192.f : 1048576.f;
+
+			// pi / 2 split in four parts (Cody-Waite). The first three have few enough significant bits
+			// that multiplying them by any quadrant count below the radian limit is exact.
+			constexpr float piOverTwo[4] = { 1.5703125f, 4.837512969970703125e-4f, 7.549533620476722717e-8f, 2.563344068257089603e-12f };
+			constexpr float twoOverPi = 0.636619772367581343f;
+
+			template<AngleUnit angleUnit>
+			[[nodiscard]] inline double ToLibraryRadians(float input)
+			{
+				if constexpr (angleUnit == AngleUnit::Radians)
+					return input;
+				else
+					return double(input) * degToRad<double>;
+			}
+
+			template<AngleUnit angleUnit, typename L>
+			[[nodiscard]] constexpr typename L::Mask IsInRange(typename L::Register input)
+			{
+				// Written so that NaN is out of range.
+				return L::LessEqual(L::Abs(input), L::Set(reductionLimit<angleUnit>));
+			}
+
+			// Minimax polynomials on [-pi/4, pi/4]. r2 is r * r.
+			// Sine minimizes relative error, cosine minimizes absolute error.
+			template<TrigPrecision precision, typename L>
+			[[nodiscard]] constexpr typename L::Register SinPolynomial(typename L::Register r, typename L::Register r2)
+			{
+				typename L::Register polynomial{};
+				if constexpr (precision == TrigPrecision::Fast)
+					polynomial = L::Set(-1.62427915e-1f);
+				else if constexpr (precision == TrigPrecision::Medium)
+					polynomial = L::Add(L::Mul(L::Set(8.16328192e-3f), r2), L::Set(-1.66633904e-1f));
+				else
+				{
+					polynomial = L::Add(L::Mul(L::Set(-1.95152832e-4f), r2), L::Set(8.33216076e-3f));
+					polynomial = L::Add(L::Mul(polynomial, r2), L::Set(-1.66666546e-1f));
+				}
+				return L::Add(L::Mul(L::Mul(polynomial, r2), r), r);
+			}
+
+			template<TrigPrecision precision, typename L>
+			[[nodiscard]] constexpr typename L::Register CosPolynomial(typename L::Register r2)
+			{
+				typename L::Register polynomial{};
+				if constexpr (precision == TrigPrecision::Fast)
+				{
+					polynomial = L::Add(L::Mul(L::Set(4.04584523e-2f), r2), L::Set(-4.99760557e-1f));
+					return L::Add(L::Mul(polynomial, r2), L::Set(1.f));
+				}
+				else if constexpr (precision == TrigPrecision::Medium)
+					polynomial = L::Add(L::Mul(L::Set(-1.36487144e-3f), r2), L::Set(4.16610713e-2f));
+				else
+				{
+					polynomial = L::Add(L::Mul(L::Set(2.44331571e-5f), r2), L::Set(-1.38873163e-3f));
+					polynomial = L::Add(L::Mul(polynomial, r2), L::Set(4.16666457e-2f));
+				}
+				// 1 - r2 / 2 is kept exact, which matters most close to zero.
+				return L::Add(L::Sub(L::Mul(L::Mul(polynomial, r2), r2), L::Mul(r2, L::Set(0.5f))), L::Set(1.f));
+			}
+
+			// Only valid for arguments in range.
+			template<AngleUnit angleUnit, TrigPrecision precision, typename L>
+			constexpr void Evaluate(typename L::Register input, typename L::Register& sinOut, typename L::Register& cosOut)
+			{
+				// Nearest multiple of a right angle, and the remainder in radians.
+				typename L::Register quadrant{};
+				typename L::Register r{};
+				if constexpr (angleUnit == AngleUnit::Radians)
+				{
+					quadrant = L::Round(L::Mul(input, L::Set(twoOverPi)));
+					r = input;
+					for (const float part : piOverTwo)
+						r = L::Sub(r, L::Mul(quadrant, L::Set(part)));
+				}
+				else
+				{
+					// Exact in degrees, so multiples of 90 give exact results.
+					quadrant = L::Round(L::Mul(input, L::Set(1.f / 90.f)));
+					r = L::Mul(L::Sub(input, L::Mul(quadrant, L::Set(90.f))), L::Set(degToRad<float>));
+				}
+
+				// quadrant mod 4, using floor(q / 4) == round(q / 4 - 3 / 8) for integer q.
+				const auto turns = L::Round(L::Sub(L::Mul(quadrant, L::Set(0.25f)), L::Set(0.375f)));
+				quadrant = L::Sub(quadrant, L::Mul(turns, L::Set(4.f)));
+
+				const auto r2 = L::Mul(r, r);
+				const auto sin = SinPolynomial<precision, L>(r, r2);
+				const auto cos = CosPolynomial<precision, L>(r2);
+
+				const auto isOne = L::Equal(quadrant, L::Set(1.f));
+				const auto isTwo = L::Equal(quadrant, L::Set(2.f));
+				const auto isThree = L::Equal(quadrant, L::Set(3.f));
+				const auto swap = L::Or(isOne, isThree);
+				sinOut = L::Select(swap, cos, sin);
+				cosOut = L::Select(swap, sin, cos);
+				// Negated by subtraction so that exact zeros at right angles stay positive.
+				const auto zero = L::Set(0.f);
+				sinOut = L::Select(L::Or(isTwo, isThree), L::Sub(zero, sinOut), sinOut);
+				cosOut = L::Select(L::Or(isOne, isTwo), L::Sub(zero, cosOut), cosOut);
+			}
+
+			// Calls kernel(lanes, offset, x) for every register of input, where lanes is the
+			// Simd::FloatLanes type in use, and fallback(offset, x) for elements out of range.
+			template<AngleUnit angleUnit, typename Kernel, typename Fallback>
+			void ForEachRegister(const float* input, size_t count, Kernel&& kernel, Fallback&& fallback)
+			{
+				constexpr size_t laneCount = Simd::floatLaneCount;
+				size_t i = 0;
+				if constexpr (laneCount > 1)
+				{
+					using L = Simd::FloatLanes<laneCount>;
+					constexpr uint32_t allLanes = uint32_t((uint64_t(1) << laneCount) - 1);
+					for (; i + laneCount <= count; i += laneCount)
+					{
+						const auto x = L::LoadUnaligned(input + i);
+						const uint32_t inRange = L::ToBits(IsInRange<angleUnit, L>(x));
+						if (inRange == allLanes)
+						{
+							kernel(L(), i, x);
+							continue;
+						}
+
+						// The output may alias the input, so the inputs are kept aside first.
+						alignas(64) float inputs[laneCount];
+						L::Store(inputs, x);
+						kernel(L(), i, x);
+						for (size_t lane = 0; lane < laneCount; lane++)
+						{
+							if ((inRange & (uint32_t(1) << lane)) == 0)
+								fallback(i + lane, inputs[lane]);
+						}
+					}
+				}
+
+				using Scalar = Simd::FloatLanes<1>;
+				for (; i < count; i++)
+				{
+					const float x = input[i];
+					if (IsInRange<angleUnit, Scalar>(x))
+						kernel(Scalar(), i, x);
+					else
+						fallback(i, x);
+				}
+			}
+
+			template<AngleUnit angleUnit, TrigPrecision precision>
+			void SinRange(const float* input, float* output, size_t count)
+			{
+				ForEachRegister<angleUnit>(input, count, [=](auto lanes, size_t offset, auto x)
+				{
+					using L = decltype(lanes);
+					typename L::Register sin, cos;
+					Evaluate<angleUnit, precision, L>(x, sin, cos);
+					L::StoreUnaligned(output + offset, sin);
+				}, [=](size_t offset, float x) { output[offset] = float(std::sin(ToLibraryRadians<angleUnit>(x))); });
+			}
+
+			template<AngleUnit angleUnit, TrigPrecision precision>
+			void CosRange(const float* input, float* output, size_t count)
+			{
+				ForEachRegister<angleUnit>(input, count, [=](auto lanes, size_t offset, auto x)
+				{
+					using L = decltype(lanes);
+					typename L::Register sin, cos;
+					Evaluate<angleUnit, precision, L>(x, sin, cos);
+					L::StoreUnaligned(output + offset, cos);
+				}, [=](size_t offset, float x) { output[offset] = float(std::cos(ToLibraryRadians<angleUnit>(x))); });
+			}
+
+			template<AngleUnit angleUnit, TrigPrecision precision>
+			void TanRange(const float* input, float* output, size_t count)
+			{
+				ForEachRegister<angleUnit>(input, count, [=](auto lanes, size_t offset, auto x)
+				{
+					using L = decltype(lanes);
+					typename L::Register sin, cos;
+					Evaluate<angleUnit, precision, L>(x, sin, cos);
+					L::StoreUnaligned(output + offset, L::Div(sin, cos));
+				}, [=](size_t offset, float x) { output[offset] = float(std::tan(ToLibraryRadians<angleUnit>(x))); });
+			}
+
+			template<AngleUnit angleUnit, TrigPrecision precision>
+			void SinCosRange(const float* input, float* sinOutput, float* cosOutput, size_t count)
+			{
+				ForEachRegister<angleUnit>(input, count, [=](auto lanes, size_t offset, auto x)
+				{
+					using L = decltype(lanes);
+					typename L::Register sin, cos;
+					Evaluate<angleUnit, precision, L>(x, sin, cos);
+					L::StoreUnaligned(sinOutput + offset, sin);
+					L::StoreUnaligned(cosOutput + offset, cos);
+				}, [=](size_t offset, float x)
+				{
+					const double radians = ToLibraryRadians<angleUnit>(x);
+					sinOutput[offset] = float(std::sin(radians));
+					cosOutput[offset] = float(std::cos(radians));
+				});
+			}
+		}
 	}
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision>
+constexpr float Math::Sin(float input)
+{
+	using namespace detail::Trigonometric;
+	using L = detail::Simd::FloatLanes<1>;
+	if (!IsInRange<angleUnit, L>(input))
+		return float(std::sin(ToLibraryRadians<angleUnit>(input)));
+
+	float sin = 0.f;
+	float cos = 0.f;
+	Evaluate<angleUnit, precision, L>(input, sin, cos);
+	return sin;
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision>
+constexpr float Math::Cos(float input)
+{
+	using namespace detail::Trigonometric;
+	using L = detail::Simd::FloatLanes<1>;
+	if (!IsInRange<angleUnit, L>(input))
+		return float(std::cos(ToLibraryRadians<angleUnit>(input)));
+
+	float sin = 0.f;
+	float cos = 0.f;
+	Evaluate<angleUnit, precision, L>(input, sin, cos);
+	return cos;
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision>
+constexpr float Math::Tan(float input)
+{
+	using namespace detail::Trigonometric;
+	using L = detail::Simd::FloatLanes<1>;
+	if (!IsInRange<angleUnit, L>(input))
+		return float(std::tan(ToLibraryRadians<angleUnit>(input)));
+
+	float sin = 0.f;
+	float cos = 0.f;
+	Evaluate<angleUnit, precision, L>(input, sin, cos);
+	return sin / cos;
+}
 
-	template<AngleUnit angleUnit = Setup::defaultAngleUnit>
-	[[nodiscard]] auto Tan(float input)
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision>
+constexpr Math::SinCosPair Math::SinCos(float input)
+{
+	using namespace detail::Trigonometric;
+	using L = detail::Simd::FloatLanes<1>;
+	if (!IsInRange<angleUnit, L>(input))
 	{
-		if constexpr (angleUnit == AngleUnit::Radians)
-			return std::tan(input);
-		else if constexpr (angleUnit == AngleUnit::Degrees)
-			return std::tan(input * degToRad);
+		const double radians = ToLibraryRadians<angleUnit>(input);
+		return { float(std::sin(radians)), float(std::cos(radians)) };
 	}
-} 
+
+	SinCosPair output{};
+	Evaluate<angleUnit, precision, L>(input, output.sin, output.cos);
+	return output;
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision>
+void Math::Sin(Span<const float> input, Span<float> output)
+{
+	assert(output.size() == input.size());
+
+	detail::Trigonometric::SinRange<angleUnit, precision>(input.data(), output.data(), input.size());
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision>
+void Math::Cos(Span<const float> input, Span<float> output)
+{
+	assert(output.size() == input.size());
+
+	detail::Trigonometric::CosRange<angleUnit, precision>(input.data(), output.data(), input.size());
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision>
+void Math::Tan(Span<const float> input, Span<float> output)
+{
+	assert(output.size() == input.size());
+
+	detail::Trigonometric::TanRange<angleUnit, precision>(input.data(), output.data(), input.size());
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision>
+void Math::SinCos(Span<const float> input, Span<float> sin, Span<float> cos)
+{
+	assert(sin.size() == input.size() && cos.size() == input.size());
+
+	detail::Trigonometric::SinCosRange<angleUnit, precision>(input.data(), sin.data(), cos.data(), input.size());
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision>
+void Math::Sin_Parallel(Span<const float> input, Span<float> output, size_t grainSize)
+{
+	assert(output.size() == input.size());
+
+	ParallelFor(0, input.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		detail::Trigonometric::SinRange<angleUnit, precision>(input.data() + begin, output.data() + begin, end - begin);
+	});
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision>
+void Math::Cos_Parallel(Span<const float> input, Span<float> output, size_t grainSize)
+{
+	assert(output.size() == input.size());
+
+	ParallelFor(0, input.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		detail::Trigonometric::CosRange<angleUnit, precision>(input.data() + begin, output.data() + begin, end - begin);
+	});
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision>
+void Math::Tan_Parallel(Span<const float> input, Span<float> output, size_t grainSize)
+{
+	assert(output.size() == input.size());
+
+	ParallelFor(0, input.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		detail::Trigonometric::TanRange<angleUnit, precision>(input.data() + begin, output.data() + begin, end - begin);
+	});
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision>
+void Math::SinCos_Parallel(Span<const float> input, Span<float> sin, Span<float> cos, size_t grainSize)
+{
+	assert(sin.size() == input.size() && cos.size() == input.size());
+
+	ParallelFor(0, input.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		detail::Trigonometric::SinCosRange<angleUnit, precision>(input.data() + begin, sin.data() + begin, cos.data() + begin, end - begin);
+	});
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision, typename ExecutionPolicy, typename>
+void Math::Sin(ExecutionPolicy&&, Span<const float> input, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Sin_Parallel<angleUnit, precision>(input, output);
+	else
+		Sin<angleUnit, precision>(input, output);
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision, typename ExecutionPolicy, typename>
+void Math::Cos(ExecutionPolicy&&, Span<const float> input, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Cos_Parallel<angleUnit, precision>(input, output);
+	else
+		Cos<angleUnit, precision>(input, output);
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision, typename ExecutionPolicy, typename>
+void Math::Tan(ExecutionPolicy&&, Span<const float> input, Span<float> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		Tan_Parallel<angleUnit, precision>(input, output);
+	else
+		Tan<angleUnit, precision>(input, output);
+}
+
+template<Math::AngleUnit angleUnit, Math::TrigPrecision precision, typename ExecutionPolicy, typename>
+void Math::SinCos(ExecutionPolicy&&, Span<const float> input, Span<float> sin, Span<float> cos)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		SinCos_Parallel<angleUnit, precision>(input, sin, cos);
+	else
+		SinCos<angleUnit, precision>(input, sin, cos);
+}
\ No newline at end of file
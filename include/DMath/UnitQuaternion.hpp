@@ -2,13 +2,17 @@
 
 #include <cassert>
 #include "Matrix/Matrix.hpp"
-#include "Vector/Vector3D.hpp"
+#include "Vector/Vector.hpp"
 #include "Common.hpp"
 #include "Trigonometric.hpp"
+#include "Span.hpp"
+#include "Parallel.hpp"
+#include "Execution.hpp"
+#include "Instrumentation.hpp"
 
 namespace Math
 {
-	template<size_t width, size_t height, typename T>
+	template<size_t width, size_t height, typename T, MatrixLayout layout>
 	struct Matrix;
 
 	template<typename T = float>
@@ -18,8 +22,10 @@ namespace Math
 		using ValueType = T;
 
 		constexpr UnitQuaternion() noexcept;
-		inline UnitQuaternion(const Vector<3, T>& axis, const T& degrees);
-		inline UnitQuaternion(const Vector<3, T>& eulerAngles);
+		constexpr UnitQuaternion(const Vector<3, T>& axis, const T& degrees);
+		constexpr UnitQuaternion(const Vector<3, T>& eulerAngles);
+		// The components must already form a unit quaternion.
+		static constexpr UnitQuaternion<T> FromComponents(const T& s, const T& x, const T& y, const T& z) noexcept;
 
 		constexpr T GetS() const;
 		constexpr T GetX() const;
@@ -48,6 +54,24 @@ namespace Math
 	};
 	static_assert(sizeof(UnitQuaternion<float>) == sizeof(float) * 4, "Error. Math::UnitQuaternion's members must be tightly packed.");
 
+	// output[i] = left[i] * right[i]. output may alias left or right.
+	template<typename T>
+	void MultiplyQuaternions(Span<const UnitQuaternion<T>> left, Span<const UnitQuaternion<T>> right, Span<UnitQuaternion<T>> output);
+	template<typename T>
+	void MultiplyQuaternions_Parallel(Span<const UnitQuaternion<T>> left, Span<const UnitQuaternion<T>> right, Span<UnitQuaternion<T>> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	// std::execution::par and par_unseq run MultiplyQuaternions_Parallel, other policies MultiplyQuaternions.
+	template<typename T, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void MultiplyQuaternions(ExecutionPolicy&& policy, Span<const UnitQuaternion<T>> left, Span<const UnitQuaternion<T>> right, Span<UnitQuaternion<T>> output);
+
+	// output[i] = Matrix<4, 3, T>(input[i]).
+	template<typename T>
+	void QuaternionsToMatrices(Span<const UnitQuaternion<T>> input, Span<Matrix<4, 3, T>> output);
+	template<typename T>
+	void QuaternionsToMatrices_Parallel(Span<const UnitQuaternion<T>> input, Span<Matrix<4, 3, T>> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	// std::execution::par and par_unseq run QuaternionsToMatrices_Parallel, other policies QuaternionsToMatrices.
+	template<typename T, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void QuaternionsToMatrices(ExecutionPolicy&& policy, Span<const UnitQuaternion<T>> input, Span<Matrix<4, 3, T>> output);
+
 	template<typename T>
 	inline constexpr UnitQuaternion<T>::UnitQuaternion() noexcept :
 		s(T(1)), x(), y(), z() {}
@@ -57,27 +81,26 @@ namespace Math
 		s(s), x(x), y(y), z(z) {}
 
 	template<typename T>
-	inline UnitQuaternion<T>::UnitQuaternion(const Vector<3, T>& axis, const T& degrees)
+	constexpr UnitQuaternion<T>::UnitQuaternion(const Vector<3, T>& axis, const T& degrees) :
+		s(), x(), y(), z()
 	{
-		s = Cos<AngleUnit::Degrees>(degrees / 2);
+		const auto [sin, cos] = SinCos<AngleUnit::Degrees>(degrees / 2);
+		s = cos;
 
 		assert(axis.Magnitude() > 0.f);
-		Math::Vector3D normalizedAxis = axis.GetNormalized();
-		const T sin = Sin<AngleUnit::Degrees>(degrees / 2);
+		Vector<3, T> normalizedAxis = axis.GetNormalized();
 		x = normalizedAxis.x * sin;
 		y = normalizedAxis.y * sin;
 		z = normalizedAxis.z * sin;
 	}
 
 	template<typename T>
-	inline UnitQuaternion<T>::UnitQuaternion(const Vector<3, T>& eulerAngles)
+	constexpr UnitQuaternion<T>::UnitQuaternion(const Vector<3, T>& eulerAngles) :
+		s(), x(), y(), z()
 	{
-		T c1 = Cos<AngleUnit::Degrees>(eulerAngles.y / 2);
-		T c2 = Cos<AngleUnit::Degrees>(eulerAngles.x / 2);
-		T c3 = Cos<AngleUnit::Degrees>(eulerAngles.z / 2);
-		T s1 = Sin<AngleUnit::Degrees>(eulerAngles.y / 2);
-		T s2 = Sin<AngleUnit::Degrees>(eulerAngles.x / 2);
-		T s3 = Sin<AngleUnit::Degrees>(eulerAngles.z / 2);
+		const auto [s1, c1] = SinCos<AngleUnit::Degrees>(eulerAngles.y / 2);
+		const auto [s2, c2] = SinCos<AngleUnit::Degrees>(eulerAngles.x / 2);
+		const auto [s3, c3] = SinCos<AngleUnit::Degrees>(eulerAngles.z / 2);
 
 		s = c1*c2*c3 - s1*s2*s3;
 		y = s1*c2*c3 + c1*s2*s3;
@@ -85,6 +108,12 @@ namespace Math
 		z = s1 * s2 * c3 + c1 * c2 * s3;
 	}
 
+	template<typename T>
+	constexpr UnitQuaternion<T> UnitQuaternion<T>::FromComponents(const T& s, const T& x, const T& y, const T& z) noexcept
+	{
+		return UnitQuaternion<T>{ s, x, y, z };
+	}
+
 	template<typename T>
 	constexpr T UnitQuaternion<T>::GetS() const { return s; }
 
@@ -119,6 +148,7 @@ namespace Math
 	template<typename T>
 	constexpr UnitQuaternion<T> UnitQuaternion<T>::operator*(const UnitQuaternion<T>& right) const
 	{
+		detail::Instrumentation::Count(InstrumentedOperation::QuaternionMultiply, 28);
 		return UnitQuaternion<T>
 		{
 			s * right.s - x * right.x - y * right.y - z * right.z,
@@ -131,6 +161,7 @@ namespace Math
 	template<typename T>
 	constexpr UnitQuaternion<T>::operator Matrix<4, 3, T>() const
 	{
+		detail::Instrumentation::Count(InstrumentedOperation::QuaternionToMatrix, 48);
 		return Matrix<4, 3, T>
 		{
 			1 - 2 * Sqrd(y) - 2 * Sqrd(z), 2 * x*y + 2 * z*s, 2 * x*z - 2 * y*s,
@@ -143,6 +174,7 @@ namespace Math
 	template<typename T>
 	constexpr UnitQuaternion<T>::operator Matrix<4, 4, T>() const
 	{
+		detail::Instrumentation::Count(InstrumentedOperation::QuaternionToMatrix, 48);
 		return Matrix<4, 4, T>
 		{
 			1 - 2*Sqrd(y) - 2*Sqrd(z), 2*x*y + 2*z*s, 2*x*z - 2*y*s, 0,
@@ -157,4 +189,74 @@ namespace Math
 
 	template<typename T>
 	constexpr UnitQuaternion<T> UnitQuaternion<T>::GetInverse() const { return UnitQuaternion{ s ,-x, -y, -z }; }
+
+#if defined( DMATH_COMPILED )
+	// Instantiated in src/Compiled.cpp, see the DMath::Compiled target.
+	extern template class UnitQuaternion<float>;
+	extern template class UnitQuaternion<double>;
+#endif
+
+	template<typename T>
+	void MultiplyQuaternions(Span<const UnitQuaternion<T>> left, Span<const UnitQuaternion<T>> right, Span<UnitQuaternion<T>> output)
+	{
+		assert(left.size() == output.size() && right.size() == output.size());
+
+		const TraceScope traceScope("MultiplyQuaternions", output.size());
+		for (size_t i = 0; i < output.size(); i++)
+			output[i] = left[i] * right[i];
+	}
+
+	template<typename T>
+	void MultiplyQuaternions_Parallel(Span<const UnitQuaternion<T>> left, Span<const UnitQuaternion<T>> right, Span<UnitQuaternion<T>> output, size_t grainSize)
+	{
+		assert(left.size() == output.size() && right.size() == output.size());
+
+		const TraceScope traceScope("MultiplyQuaternions", output.size());
+		ParallelFor(0, output.size(), grainSize, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+				output[i] = left[i] * right[i];
+		});
+	}
+
+	template<typename T, typename ExecutionPolicy, typename>
+	void MultiplyQuaternions(ExecutionPolicy&&, Span<const UnitQuaternion<T>> left, Span<const UnitQuaternion<T>> right, Span<UnitQuaternion<T>> output)
+	{
+		if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+			MultiplyQuaternions_Parallel<T>(left, right, output);
+		else
+			MultiplyQuaternions<T>(left, right, output);
+	}
+
+	template<typename T>
+	void QuaternionsToMatrices(Span<const UnitQuaternion<T>> input, Span<Matrix<4, 3, T>> output)
+	{
+		assert(input.size() == output.size());
+
+		const TraceScope traceScope("QuaternionsToMatrices", input.size());
+		for (size_t i = 0; i < input.size(); i++)
+			output[i] = Matrix<4, 3, T>(input[i]);
+	}
+
+	template<typename T>
+	void QuaternionsToMatrices_Parallel(Span<const UnitQuaternion<T>> input, Span<Matrix<4, 3, T>> output, size_t grainSize)
+	{
+		assert(input.size() == output.size());
+
+		const TraceScope traceScope("QuaternionsToMatrices", input.size());
+		ParallelFor(0, input.size(), grainSize, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+				output[i] = Matrix<4, 3, T>(input[i]);
+		});
+	}
+
+	template<typename T, typename ExecutionPolicy, typename>
+	void QuaternionsToMatrices(ExecutionPolicy&&, Span<const UnitQuaternion<T>> input, Span<Matrix<4, 3, T>> output)
+	{
+		if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+			QuaternionsToMatrices_Parallel<T>(input, output);
+		else
+			QuaternionsToMatrices<T>(input, output);
+	}
 }
\ No newline at end of file
@@ -1,13 +1,15 @@
 #pragma once
 
 #include "../Common.hpp"
+#include "../Trigonometric.hpp"
+#include "../Format.hpp"
+#include "../Instrumentation.hpp"
 #include "../Matrix/Matrix.hpp"
 #include "../Vector/Vector.hpp"
 
 #include <array>
 #include <cassert>
 #include <initializer_list>
-#include <sstream>
 #include <string>
 #include <type_traits>
 #include <utility>
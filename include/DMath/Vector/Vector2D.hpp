@@ -56,12 +56,15 @@ namespace Math
 			default:
 #if defined( _MSC_VER )
 				__assume(0);
+#elif defined( __GNUC__ )
+				__builtin_unreachable();
 #endif
 			}
 		}
 
 		[[nodiscard]] static constexpr T Dot(const Vector<2, T>& lhs, const Vector<2, T>& rhs)
 		{
+			detail::Instrumentation::Count(InstrumentedOperation::VectorDot, 3);
 			return (lhs.x * rhs.x) + (lhs.y * rhs.y);
 		}
 
@@ -75,14 +78,24 @@ namespace Math
 			return &x;
 		}
 
-		[[nodiscard]] auto GetNormalized() const -> Vector<2, typename std::conditional<std::is_integral<T>::value, float, T>::type>
+		[[nodiscard]] constexpr auto GetNormalized() const -> Vector<2, typename std::conditional<std::is_integral<T>::value, float, T>::type>
 		{
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 6);
 			using ReturnValueType = typename std::conditional<std::is_integral<T>::value, float, T>::type;
 			const auto& magnitude = Magnitude();
 			return Vector<2, ReturnValueType>{ x / magnitude, y / magnitude };
 		}
 
-		[[nodiscard]] auto Magnitude() const -> typename std::conditional<std::is_integral<T>::value, float, T>::type
+		// Multiplies by RSqrt of the squared magnitude instead of dividing by the magnitude.
+		[[nodiscard]] constexpr auto GetNormalized_Fast() const -> Vector<2, typename std::conditional<std::is_integral<T>::value, float, T>::type>
+		{
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 6);
+			using ReturnValueType = typename std::conditional<std::is_integral<T>::value, float, T>::type;
+			const auto inverseMagnitude = RSqrt(ReturnValueType(MagnitudeSqrd()));
+			return Vector<2, ReturnValueType>{ x * inverseMagnitude, y * inverseMagnitude };
+		}
+
+		[[nodiscard]] constexpr auto Magnitude() const -> typename std::conditional<std::is_integral<T>::value, float, T>::type
 		{
 			if constexpr (std::is_integral<T>::value)
 				return Sqrt(float((x * x) + (y * y)));
@@ -95,31 +108,27 @@ namespace Math
 			return (x * x) + (y * y);
 		}
 
-		void Normalize()
+		constexpr void Normalize()
 		{
 			static_assert(std::is_floating_point<T>::value, "Cannot normalize an integral vector.");
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 6);
 			const auto& magnitude = Magnitude();
 			x /= magnitude;
 			y /= magnitude;
 		}
 
-		[[nodiscard]] std::string ToString() const
+		constexpr void Normalize_Fast()
 		{
-			std::ostringstream stream;
+			static_assert(std::is_floating_point<T>::value, "Cannot normalize an integral vector.");
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 6);
+			const T inverseMagnitude = RSqrt(MagnitudeSqrd());
+			x *= inverseMagnitude;
+			y *= inverseMagnitude;
+		}
 
-			if constexpr (std::is_floating_point<T>::value)
-			{
-				stream.flags(std::ios::fixed);
-				stream.precision(4);
-			}
-			
-			stream << '(';
-			if constexpr (std::is_same<char, T>::value || std::is_same<unsigned char, T>::value)
-				stream << +x << ", " << +y;
-			else
-				stream << x << ", " << y;
-			stream << ')';
-			return stream.str();
+		[[nodiscard]] std::string ToString() const
+		{
+			return detail::Format::ToString(*this);
 		}
 
 		[[nodiscard]] static constexpr Vector<2, T> SingleValue(const T& input)
@@ -255,4 +264,9 @@ namespace Math
 	{
 		return Vector<2, T>{ lhs * rhs.x, lhs * rhs.y };
 	}
+
+#if defined( DMATH_COMPILED )
+	// Instantiated in src/Compiled.cpp, see the DMath::Compiled target.
+	extern template struct Vector<2, float>;
+#endif
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Core.hpp"
 
 #include "../Enum.hpp"
+#include "../Trigonometric.hpp"
 
 namespace Math
 {
@@ -63,11 +64,13 @@ namespace Math
 
 		[[nodiscard]] static constexpr Vector<3, T> Cross(const Vector<3, T>& lhs, const Vector<3, T>& rhs)
 		{
+			detail::Instrumentation::Count(InstrumentedOperation::VectorCross, 9);
 			return { lhs.y * rhs.z - lhs.z * rhs.y, lhs.z * rhs.x - lhs.x * rhs.z, lhs.x * rhs.y - lhs.y * rhs.x };
 		}
 
 		[[nodiscard]] static constexpr T Dot(const Vector<3, T>& lhs, const Vector<3, T>& rhs)
 		{
+			detail::Instrumentation::Count(InstrumentedOperation::VectorDot, 5);
 			return (lhs.x * rhs.x) + (lhs.y * rhs.y) + (lhs.z * rhs.z);
 		}
 
@@ -81,21 +84,30 @@ namespace Math
 			return &x;
 		}
 
-		[[nodiscard]] auto GetNormalized() const -> Vector<3, typename std::conditional<std::is_integral<T>::value, float, T>::type>
+		[[nodiscard]] constexpr auto GetNormalized() const -> Vector<3, typename std::conditional<std::is_integral<T>::value, float, T>::type>
 		{
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 9);
 			using ReturnValueType = typename std::conditional<std::is_integral<T>::value, float, T>::type;
 			const auto& magnitude = Magnitude();
 			return Vector<3, ReturnValueType>{ x / magnitude, y / magnitude, z / magnitude };
 		}
 
-		[[nodiscard]] Vector<3, T> GetRotated(ElementaryAxis axis, float degrees) const
+		// Multiplies by RSqrt of the squared magnitude instead of dividing by the magnitude.
+		[[nodiscard]] constexpr auto GetNormalized_Fast() const -> Vector<3, typename std::conditional<std::is_integral<T>::value, float, T>::type>
+		{
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 9);
+			using ReturnValueType = typename std::conditional<std::is_integral<T>::value, float, T>::type;
+			const auto inverseMagnitude = RSqrt(ReturnValueType(MagnitudeSqrd()));
+			return Vector<3, ReturnValueType>{ x * inverseMagnitude, y * inverseMagnitude, z * inverseMagnitude };
+		}
+
+		[[nodiscard]] constexpr Vector<3, T> GetRotated(ElementaryAxis axis, float degrees) const
 		{
 #if defined( _MSC_VER )
 			__assume(axis == ElementaryAxis::X || axis == ElementaryAxis::Y || axis == ElementaryAxis::Z);
 #endif
 			assert(axis == ElementaryAxis::X || axis == ElementaryAxis::Y || axis == ElementaryAxis::Z);
-			const float cos = Cos<AngleUnit::Degrees>(degrees);
-			const float sin = Sin<AngleUnit::Degrees>(degrees);
+			const auto [sin, cos] = SinCos<AngleUnit::Degrees>(degrees);
 			switch (axis)
 			{
 			case ElementaryAxis::X:
@@ -113,7 +125,7 @@ namespace Math
 			}
 		}
 
-		[[nodiscard]] auto Magnitude() const -> typename std::conditional<std::is_integral<T>::value, float, T>::type
+		[[nodiscard]] constexpr auto Magnitude() const -> typename std::conditional<std::is_integral<T>::value, float, T>::type
 		{
 			if constexpr (std::is_integral<T>::value)
 				return Sqrt(float((x * x) + (y * y) + (z * z)));
@@ -126,32 +138,29 @@ namespace Math
 			return (x * x) + (y * y) + (z * z);
 		}
 
-		void Normalize()
+		constexpr void Normalize()
 		{
 			static_assert(std::is_floating_point<T>::value, "Cannot normalize an integral vector.");
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 9);
 			const auto& magnitude = Magnitude();
 			x /= magnitude;
 			y /= magnitude;
 			z /= magnitude;
 		}
 
-		[[nodiscard]] std::string ToString() const
+		constexpr void Normalize_Fast()
 		{
-			std::ostringstream stream;
-
-			if constexpr (std::is_floating_point<T>::value)
-			{
-				stream.flags(std::ios::fixed);
-				stream.precision(4);
-			}
+			static_assert(std::is_floating_point<T>::value, "Cannot normalize an integral vector.");
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 9);
+			const T inverseMagnitude = RSqrt(MagnitudeSqrd());
+			x *= inverseMagnitude;
+			y *= inverseMagnitude;
+			z *= inverseMagnitude;
+		}
 
-			stream << '(';
-			if constexpr (std::is_same<char, T>::value || std::is_same<unsigned char, T>::value)
-				stream << +x << ", " << +y << ", " << +z;
-			else
-				stream << x << ", " << y << ", " << z;
-			stream << ')';
-			return stream.str();
+		[[nodiscard]] std::string ToString() const
+		{
+			return detail::Format::ToString(*this);
 		}
 
 		[[nodiscard]] static constexpr Vector<3, T> SingleValue(const T& input)
@@ -302,4 +311,9 @@ namespace Math
 	{
 		return Vector<3, T>{ lhs * rhs.x, lhs * rhs.y, lhs * rhs.z };
 	}
+
+#if defined( DMATH_COMPILED )
+	// Instantiated in src/Compiled.cpp, see the DMath::Compiled target.
+	extern template struct Vector<3, float>;
+#endif
 }
\ No newline at end of file
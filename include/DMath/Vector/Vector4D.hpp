@@ -64,6 +64,7 @@ namespace Math
 
 		[[nodiscard]] static constexpr T Dot(const Vector<4, T>& lhs, const Vector<4, T>& rhs)
 		{
+			detail::Instrumentation::Count(InstrumentedOperation::VectorDot, 7);
 			return (lhs.x * rhs.x) + (lhs.y * rhs.y) + (lhs.z * rhs.z) + (lhs.w * rhs.w);
 		}
 
@@ -77,14 +78,24 @@ namespace Math
 			return &x;
 		}
 
-		[[nodiscard]] auto GetNormalized() const -> Vector<4, typename std::conditional<std::is_integral<T>::value, float, T>::type>
+		[[nodiscard]] constexpr auto GetNormalized() const -> Vector<4, typename std::conditional<std::is_integral<T>::value, float, T>::type>
 		{
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 12);
 			using ReturnValueType = typename std::conditional<std::is_integral<T>::value, float, T>::type;
 			const auto& magnitude = Magnitude();
-			return Vector<3, ReturnValueType>{ x / magnitude, y / magnitude, z / magnitude, w / magnitude };
+			return Vector<4, ReturnValueType>{ x / magnitude, y / magnitude, z / magnitude, w / magnitude };
 		}
 
-		[[nodiscard]] auto Magnitude() const -> typename std::conditional<std::is_integral<T>::value, float, T>::type
+		// Multiplies by RSqrt of the squared magnitude instead of dividing by the magnitude.
+		[[nodiscard]] constexpr auto GetNormalized_Fast() const -> Vector<4, typename std::conditional<std::is_integral<T>::value, float, T>::type>
+		{
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 12);
+			using ReturnValueType = typename std::conditional<std::is_integral<T>::value, float, T>::type;
+			const auto inverseMagnitude = RSqrt(ReturnValueType(MagnitudeSqrd()));
+			return Vector<4, ReturnValueType>{ x * inverseMagnitude, y * inverseMagnitude, z * inverseMagnitude, w * inverseMagnitude };
+		}
+
+		[[nodiscard]] constexpr auto Magnitude() const -> typename std::conditional<std::is_integral<T>::value, float, T>::type
 		{
 			if constexpr (std::is_integral<T>::value)
 				return Sqrt(float((x * x) + (y * y) + (z * z) + (w * w)));
@@ -97,9 +108,10 @@ namespace Math
 			return (x * x) + (y * y) + (z * z) + (w * w);
 		}
 
-		void Normalize()
+		constexpr void Normalize()
 		{
 			static_assert(std::is_floating_point<T>::value, "Cannot normalize an integral vector.");
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 12);
 			const auto& magnitude = Magnitude();
 			x /= magnitude;
 			y /= magnitude;
@@ -107,23 +119,20 @@ namespace Math
 			w /= magnitude;
 		}
 
-		[[nodiscard]] std::string ToString() const
+		constexpr void Normalize_Fast()
 		{
-			std::ostringstream stream;
-
-			if constexpr (std::is_floating_point<T>::value)
-			{
-				stream.flags(std::ios::fixed);
-				stream.precision(4);
-			}
+			static_assert(std::is_floating_point<T>::value, "Cannot normalize an integral vector.");
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 12);
+			const T inverseMagnitude = RSqrt(MagnitudeSqrd());
+			x *= inverseMagnitude;
+			y *= inverseMagnitude;
+			z *= inverseMagnitude;
+			w *= inverseMagnitude;
+		}
 
-			stream << '(';
-			if constexpr (std::is_same<char, T>::value || std::is_same<unsigned char, T>::value)
-				stream << +x << ", " << +y << ", " << +z << ", " << +w;
-			else
-				stream << x << ", " << y << ", " << z << ", " << w;
-			stream << ')';
-			return stream.str();
+		[[nodiscard]] std::string ToString() const
+		{
+			return detail::Format::ToString(*this);
 		}
 
 		[[nodiscard]] static constexpr Vector<4, T> SingleValue(const T& input)
@@ -200,6 +209,8 @@ namespace Math
 				return y;
 			case 2:
 				return z;
+			case 3:
+				return w;
 			default:
 #if defined( _MSC_VER )
 				__assume(0);
@@ -252,4 +263,9 @@ namespace Math
 	{
 		return Vector<4, T>{ lhs * rhs.x, lhs * rhs.y, lhs * rhs.z, lhs * rhs.w };
 	}
+
+#if defined( DMATH_COMPILED )
+	// Instantiated in src/Compiled.cpp, see the DMath::Compiled target.
+	extern template struct Vector<4, float>;
+#endif
 }
\ No newline at end of file
@@ -38,9 +38,11 @@ namespace Math
 
 		[[nodiscard]] static constexpr T Dot(const Vector<length, T>& lhs, const Vector<length, T>& rhs)
 		{
+			detail::Instrumentation::Count(InstrumentedOperation::VectorDot, 2 * length - 1);
 			T sum = T(0);
 			for (size_t i = 0; i < length; i++)
 				sum += lhs[i] * rhs[i];
+			return sum;
 		}
 
 		[[nodiscard]] constexpr T* GetData()
@@ -53,17 +55,30 @@ namespace Math
 			return data.data();
 		}
 
-		[[nodiscard]] auto GetNormalized() const -> Vector<length, typename std::conditional<std::is_integral<T>::value, float, T>::type>
+		[[nodiscard]] constexpr auto GetNormalized() const -> Vector<length, typename std::conditional<std::is_integral<T>::value, float, T>::type>
 		{
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 3 * length);
 			using ReturnValueType = typename std::conditional<std::is_integral<T>::value, float, T>::type;
 			const auto& magnitude = Magnitude();
-			Vector<length, ReturnValueType> temp;
+			Vector<length, ReturnValueType> temp{};
 			for (size_t i = 0; i < length; i++)
 				temp[i] = data[i] / magnitude;
 			return temp;
 		}
 
-		[[nodiscard]] auto Magnitude() const -> typename std::conditional<std::is_integral<T>::value, float, T>::type
+		// Multiplies by RSqrt of the squared magnitude instead of dividing by the magnitude.
+		[[nodiscard]] constexpr auto GetNormalized_Fast() const -> Vector<length, typename std::conditional<std::is_integral<T>::value, float, T>::type>
+		{
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 3 * length);
+			using ReturnValueType = typename std::conditional<std::is_integral<T>::value, float, T>::type;
+			const auto inverseMagnitude = RSqrt(ReturnValueType(MagnitudeSqrd()));
+			Vector<length, ReturnValueType> temp{};
+			for (size_t i = 0; i < length; i++)
+				temp[i] = data[i] * inverseMagnitude;
+			return temp;
+		}
+
+		[[nodiscard]] constexpr auto Magnitude() const -> typename std::conditional<std::is_integral<T>::value, float, T>::type
 		{
 			if constexpr (std::is_integral<T>::value)
 			{
@@ -71,7 +86,7 @@ namespace Math
 				for (size_t i = 0; i < length; i++)
 				{
 					const T& temp = data[i];
-					sumSqrd = temp * temp;
+					sumSqrd += temp * temp;
 				}
 				return Sqrt(float(sumSqrd));
 			}
@@ -81,7 +96,7 @@ namespace Math
 				for (size_t i = 0; i < length; i++)
 				{
 					const T& temp = data[i];
-					sumSqrd = temp * temp;
+					sumSqrd += temp * temp;
 				}
 				return Sqrt(sumSqrd);
 			}
@@ -93,49 +108,39 @@ namespace Math
 			for (size_t i = 0; i < length; i++)
 			{
 				const T& temp = data[i];
-				sumSqrd = temp * temp;
+				sumSqrd += temp * temp;
 			}
 			return sumSqrd;
 		}
 
-		void Normalize()
+		constexpr void Normalize()
 		{
 			static_assert(std::is_floating_point<T>::value, "Cannot normalize an integral vector.");
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 3 * length);
 			const auto& magnitude = Magnitude();
 			for (size_t i = 0; i < length; i++)
 				data[i] /= magnitude;
 		}
 
-		[[nodiscard]] std::string ToString() const
+		constexpr void Normalize_Fast()
 		{
-			std::ostringstream stream;
-
-			if constexpr (std::is_floating_point<T>::value)
-			{
-				stream.flags(std::ios::fixed);
-				stream.precision(4);
-			}
-
-			stream << '(';
+			static_assert(std::is_floating_point<T>::value, "Cannot normalize an integral vector.");
+			detail::Instrumentation::Count(InstrumentedOperation::VectorNormalize, 3 * length);
+			const T inverseMagnitude = RSqrt(MagnitudeSqrd());
 			for (size_t i = 0; i < length; i++)
-			{
-				if constexpr (std::is_same<char, T>::value || std::is_same<unsigned char, T>::value)
-					stream << +data[i];
-				else
-					stream << data[i];
+				data[i] *= inverseMagnitude;
+		}
 
-				if (i < length - 1)
-					stream << ", ";
-			}
-			stream << ')';
-			return stream.str();
+		[[nodiscard]] std::string ToString() const
+		{
+			return detail::Format::ToString(*this);
 		}
 
 		[[nodiscard]] static constexpr Vector<length, T> SingleValue(const T& input)
 		{
 			Vector<length, T> temp;
 			for (size_t i = 0; i < length; i++)
-				data[i] = input;
+				temp.data[i] = input;
 			return temp;
 		}
 		[[nodiscard]] static constexpr Vector<length, T> Zero()
@@ -146,7 +151,7 @@ namespace Math
 		{
 			Vector<length, T> temp;
 			for (size_t i = 0; i < length; i++)
-				data[i] = T(1);
+				temp.data[i] = T(1);
 			return temp;
 		}
 
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Setup.hpp"
+#include "Enum.hpp"
+#include "Common.hpp"
+#include "Simd.hpp"
+#include "Span.hpp"
+#include "Parallel.hpp"
+#include "Execution.hpp"
+#include "Instrumentation.hpp"
+#include "Vector/Vector.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace Math
+{
+	// Normalizes every vector of input into output. output may be the same span as input.
+	// Full gives the same results as GetNormalized, Fast the same as GetNormalized_Fast within a few ULP.
+	// Float vectors are normalized a register of vectors at a time, other types one at a time.
+	template<size_t length, typename T, NormalizePrecision precision = NormalizePrecision::Full>
+	void NormalizeVectors(Span<const Vector<length, T>> input, Span<Vector<length, T>> output);
+	template<size_t length, typename T, NormalizePrecision precision = NormalizePrecision::Full>
+	void NormalizeVectors_Parallel(Span<const Vector<length, T>> input, Span<Vector<length, T>> output, size_t grainSize = Setup::defaultParallelGrainSize);
+	// std::execution::par and par_unseq run NormalizeVectors_Parallel, other policies NormalizeVectors.
+	template<size_t length, typename T, NormalizePrecision precision = NormalizePrecision::Full, typename ExecutionPolicy, typename = detail::Execution::EnableIfPolicy<ExecutionPolicy>>
+	void NormalizeVectors(ExecutionPolicy&& policy, Span<const Vector<length, T>> input, Span<Vector<length, T>> output);
+
+	namespace detail
+	{
+		namespace VectorBatch
+		{
+			template<typename L>
+			typename L::Register GetInverseMagnitude(typename L::Register magnitudeSqrd)
+			{
+				const auto estimate = L::RSqrtEstimate(magnitudeSqrd);
+				// Same Newton step as RSqrt.
+				const auto correction = L::NegMulAdd(L::Mul(L::Mul(L::Set(0.5f), magnitudeSqrd), estimate), estimate, L::Set(1.5f));
+				return L::Mul(estimate, correction);
+			}
+
+			// Normalizes laneCount vectors, transposed into one register per component.
+			// Every multiply-add is explicit, so that the vector registers and the remainder, FloatLanes<1>, round alike.
+			template<size_t laneCount, size_t length, NormalizePrecision precision>
+			void NormalizeLanes(const Vector<length, float>* input, Vector<length, float>* output)
+			{
+				using L = Simd::FloatLanes<laneCount>;
+				alignas(64) float components[length][laneCount];
+				for (size_t lane = 0; lane < laneCount; lane++)
+				{
+					for (size_t component = 0; component < length; component++)
+						components[component][lane] = input[lane][component];
+				}
+
+				typename L::Register values[length];
+				for (size_t component = 0; component < length; component++)
+					values[component] = L::Load(components[component]);
+
+				// Summed in the same order as MagnitudeSqrd.
+				auto magnitudeSqrd = L::Mul(values[0], values[0]);
+				for (size_t component = 1; component < length; component++)
+					magnitudeSqrd = L::MulAdd(values[component], values[component], magnitudeSqrd);
+
+				if constexpr (precision == NormalizePrecision::Full)
+				{
+					const auto magnitude = L::Sqrt(magnitudeSqrd);
+					for (size_t component = 0; component < length; component++)
+						L::Store(components[component], L::Div(values[component], magnitude));
+				}
+				else
+				{
+					const auto inverseMagnitude = GetInverseMagnitude<L>(magnitudeSqrd);
+					for (size_t component = 0; component < length; component++)
+						L::Store(components[component], L::Mul(values[component], inverseMagnitude));
+				}
+
+				for (size_t lane = 0; lane < laneCount; lane++)
+				{
+					for (size_t component = 0; component < length; component++)
+						output[lane][component] = components[component][lane];
+				}
+			}
+
+			template<size_t length, NormalizePrecision precision>
+			void NormalizeRange(const Vector<length, float>* input, Vector<length, float>* output, size_t count)
+			{
+				Instrumentation::Count(InstrumentedOperation::VectorNormalize, 3 * length, count);
+
+				constexpr size_t laneCount = Simd::floatLaneCount;
+				size_t i = 0;
+				if constexpr (laneCount > 1)
+				{
+					for (; i + laneCount <= count; i += laneCount)
+						NormalizeLanes<laneCount, length, precision>(input + i, output + i);
+				}
+				// The remainder runs the same kernel one vector at a time, so every element gets the same result wherever it is.
+				for (; i < count; i++)
+					NormalizeLanes<1, length, precision>(input + i, output + i);
+			}
+
+			template<size_t length, typename T, NormalizePrecision precision>
+			void NormalizeRange(const Vector<length, T>* input, Vector<length, T>* output, size_t count)
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					if constexpr (precision == NormalizePrecision::Full)
+						output[i] = input[i].GetNormalized();
+					else
+						output[i] = input[i].GetNormalized_Fast();
+				}
+			}
+
+			template<size_t length, typename T, NormalizePrecision precision>
+			void Normalize(const Vector<length, T>* input, Vector<length, T>* output, size_t count)
+			{
+				if constexpr (std::is_same<T, float>::value)
+					NormalizeRange<length, precision>(input, output, count);
+				else
+					NormalizeRange<length, T, precision>(input, output, count);
+			}
+		}
+	}
+}
+
+template<size_t length, typename T, Math::NormalizePrecision precision>
+void Math::NormalizeVectors(Span<const Vector<length, T>> input, Span<Vector<length, T>> output)
+{
+	static_assert(std::is_floating_point<T>::value, "DMath error. Cannot normalize an integral vector.");
+	assert(output.size() == input.size());
+
+	const TraceScope traceScope("NormalizeVectors", input.size());
+	detail::VectorBatch::Normalize<length, T, precision>(input.data(), output.data(), input.size());
+}
+
+template<size_t length, typename T, Math::NormalizePrecision precision>
+void Math::NormalizeVectors_Parallel(Span<const Vector<length, T>> input, Span<Vector<length, T>> output, size_t grainSize)
+{
+	static_assert(std::is_floating_point<T>::value, "DMath error. Cannot normalize an integral vector.");
+	assert(output.size() == input.size());
+
+	const TraceScope traceScope("NormalizeVectors", input.size());
+	ParallelFor(0, input.size(), grainSize, [&](size_t begin, size_t end)
+	{
+		detail::VectorBatch::Normalize<length, T, precision>(input.data() + begin, output.data() + begin, end - begin);
+	});
+}
+
+template<size_t length, typename T, Math::NormalizePrecision precision, typename ExecutionPolicy, typename>
+void Math::NormalizeVectors(ExecutionPolicy&&, Span<const Vector<length, T>> input, Span<Vector<length, T>> output)
+{
+	if constexpr (detail::Execution::isParallel<ExecutionPolicy>)
+		NormalizeVectors_Parallel<length, T, precision>(input, output);
+	else
+		NormalizeVectors<length, T, precision>(input, output);
+}
\ No newline at end of file
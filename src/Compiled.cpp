@@ -0,0 +1,33 @@
+// Explicit instantiations of the common types for the DMath::Compiled target.
+// The headers declare them extern template when DMATH_COMPILED is defined, so translation units linking DMath::Compiled
+// reference these instead of emitting their own copies.
+
+#include "DMath/Matrix/Matrix.hpp"
+#include "DMath/Vector/Vector.hpp"
+#include "DMath/UnitQuaternion.hpp"
+
+#if !defined( DMATH_COMPILED )
+#	error "DMath error. src/Compiled.cpp must be built with DMATH_COMPILED defined, through the DMath::Compiled target."
+#endif
+
+namespace Math
+{
+	template struct detail::MatrixBase<2, 2, float, MatrixLayout::ColumnMajor>;
+	template struct detail::MatrixBase<3, 3, float, MatrixLayout::ColumnMajor>;
+	template struct detail::MatrixBase<4, 4, float, MatrixLayout::ColumnMajor>;
+	template struct detail::MatrixBase<4, 3, float, MatrixLayout::ColumnMajor>;
+	template struct detail::MatrixBaseSquare<2, float, MatrixLayout::ColumnMajor>;
+	template struct detail::MatrixBaseSquare<3, float, MatrixLayout::ColumnMajor>;
+	template struct detail::MatrixBaseSquare<4, float, MatrixLayout::ColumnMajor>;
+	template struct Matrix<2, 2, float>;
+	template struct Matrix<3, 3, float>;
+	template struct Matrix<4, 4, float>;
+	template struct Matrix<4, 3, float>;
+
+	template struct Vector<2, float>;
+	template struct Vector<3, float>;
+	template struct Vector<4, float>;
+
+	template class UnitQuaternion<float>;
+	template class UnitQuaternion<double>;
+}
\ No newline at end of file